@@ -619,7 +619,7 @@ TEST (active_transactions, dropped_cleanup)
 
 	// Not yet removed
 	ASSERT_TRUE (node.network.publish_filter.apply (block_bytes.data (), block_bytes.size ()));
-	ASSERT_EQ (1, node.active.blocks.count (vxlnetwork::dev::genesis->hash ()));
+	ASSERT_TRUE (node.active.active (vxlnetwork::dev::genesis->hash ()));
 
 	// Now simulate dropping the election
 	ASSERT_FALSE (election->confirmed ());
@@ -632,7 +632,7 @@ TEST (active_transactions, dropped_cleanup)
 	ASSERT_EQ (1, node.stats.count (vxlnetwork::stat::type::election, vxlnetwork::stat::detail::election_drop_all));
 
 	// Block cleared from active
-	ASSERT_EQ (0, node.active.blocks.count (vxlnetwork::dev::genesis->hash ()));
+	ASSERT_FALSE (node.active.active (vxlnetwork::dev::genesis->hash ()));
 
 	// Repeat test for a confirmed election
 	ASSERT_TRUE (node.network.publish_filter.apply (block_bytes.data (), block_bytes.size ()));
@@ -651,7 +651,7 @@ TEST (active_transactions, dropped_cleanup)
 	ASSERT_EQ (1, node.stats.count (vxlnetwork::stat::type::election, vxlnetwork::stat::detail::election_drop_all));
 
 	// Block cleared from active
-	ASSERT_EQ (0, node.active.blocks.count (vxlnetwork::dev::genesis->hash ()));
+	ASSERT_FALSE (node.active.active (vxlnetwork::dev::genesis->hash ()));
 }
 
 TEST (active_transactions, republish_winner)
@@ -1392,8 +1392,17 @@ TEST (active_transactions, list_active)
 	ASSERT_EQ (3, node.active.list_active (4).size ());
 	ASSERT_EQ (3, node.active.list_active (99999).size ());
 	ASSERT_EQ (3, node.active.list_active ().size ());
+	ASSERT_EQ (3, node.active.blocks_size ());
 
+	// Elections are listed oldest first, whichever shard holds them
 	auto active = node.active.list_active ();
+	ASSERT_EQ (send->qualified_root (), active[0]->qualified_root);
+	ASSERT_EQ (send2->qualified_root (), active[1]->qualified_root);
+	ASSERT_EQ (open->qualified_root (), active[2]->qualified_root);
+	ASSERT_TRUE (node.active.active (send2->hash ()));
+	node.active.erase_oldest ();
+	ASSERT_FALSE (node.active.active (send->hash ()));
+	ASSERT_EQ (2, node.active.list_active ().size ());
 }
 
 TEST (active_transactions, vacancy)
@@ -163,6 +163,177 @@ TEST (block_store, clear_successor)
 	}
 }
 
+TEST (block_store, block_cache_hit)
+{
+	vxlnetwork::logger_mt logger;
+	auto store = vxlnetwork::make_store (logger, vxlnetwork::unique_path (), vxlnetwork::dev::constants);
+	ASSERT_TRUE (!store->init_error ());
+	vxlnetwork::open_block block (0, 1, 0, vxlnetwork::keypair ().prv, 0, 0);
+	block.sideband_set ({});
+	{
+		auto transaction (store->tx_begin_write ());
+		store->block.put (transaction, block.hash (), block);
+	}
+	auto transaction (store->tx_begin_read ());
+	auto block1 (store->block.get (transaction, block.hash ()));
+	ASSERT_NE (nullptr, block1);
+	auto hits (store->block_cache.hits.load ());
+	auto block2 (store->block.get (transaction, block.hash ()));
+	ASSERT_EQ (block1, block2);
+	ASSERT_EQ (hits + 1, store->block_cache.hits);
+}
+
+TEST (block_store, block_cache_invalidate)
+{
+	vxlnetwork::logger_mt logger;
+	auto store = vxlnetwork::make_store (logger, vxlnetwork::unique_path (), vxlnetwork::dev::constants);
+	ASSERT_TRUE (!store->init_error ());
+	vxlnetwork::open_block block1 (0, 1, 0, vxlnetwork::keypair ().prv, 0, 0);
+	block1.sideband_set ({});
+	vxlnetwork::block_hash successor (1);
+	{
+		auto transaction (store->tx_begin_write ());
+		store->block.put (transaction, block1.hash (), block1);
+		// Not admitted before the write is committed
+		ASSERT_NE (nullptr, store->block.get (transaction, block1.hash ()));
+		ASSERT_EQ (0, store->block_cache.size ());
+	}
+	{
+		auto transaction (store->tx_begin_read ());
+		ASSERT_NE (nullptr, store->block.get (transaction, block1.hash ()));
+		ASSERT_EQ (1, store->block_cache.size ());
+	}
+	// A read transaction opened before the modification keeps its snapshot but must not repopulate the cache
+	auto old_transaction (store->tx_begin_read ());
+	{
+		auto transaction (store->tx_begin_write ());
+		auto sideband (block1.sideband ());
+		sideband.successor = successor;
+		auto modified (block1);
+		modified.sideband_set (sideband);
+		std::vector<uint8_t> data;
+		{
+			vxlnetwork::vectorstream stream (data);
+			vxlnetwork::serialize_block (stream, modified);
+			modified.sideband ().serialize (stream, modified.type ());
+		}
+		store->block.raw_put (transaction, data, block1.hash ());
+		ASSERT_EQ (0, store->block_cache.size ());
+	}
+	ASSERT_EQ (0, store->block.get (old_transaction, block1.hash ())->sideband ().successor.number ());
+	ASSERT_EQ (0, store->block_cache.size ());
+	old_transaction.reset ();
+	{
+		auto transaction (store->tx_begin_read ());
+		ASSERT_EQ (successor, store->block.get (transaction, block1.hash ())->sideband ().successor);
+		ASSERT_EQ (successor, store->block.get (transaction, block1.hash ())->sideband ().successor);
+	}
+	{
+		auto transaction (store->tx_begin_write ());
+		store->block.del (transaction, block1.hash ());
+		ASSERT_EQ (nullptr, store->block.get (transaction, block1.hash ()));
+	}
+	auto transaction (store->tx_begin_read ());
+	ASSERT_EQ (nullptr, store->block.get (transaction, block1.hash ()));
+	ASSERT_EQ (0, store->block_cache.size ());
+}
+
+// Readers keep filling the cache with blocks a concurrent write transaction did not touch
+TEST (block_store, block_cache_concurrent_write)
+{
+	vxlnetwork::logger_mt logger;
+	auto store = vxlnetwork::make_store (logger, vxlnetwork::unique_path (), vxlnetwork::dev::constants);
+	ASSERT_TRUE (!store->init_error ());
+	vxlnetwork::open_block block1 (0, 1, 0, vxlnetwork::keypair ().prv, 0, 0);
+	block1.sideband_set ({});
+	vxlnetwork::open_block block2 (0, 2, 0, vxlnetwork::keypair ().prv, 0, 0);
+	block2.sideband_set ({});
+	{
+		auto transaction (store->tx_begin_write ());
+		store->block.put (transaction, block1.hash (), block1);
+	}
+	auto transaction (store->tx_begin_write ());
+	store->block.put (transaction, block2.hash (), block2);
+	{
+		auto read_transaction (store->tx_begin_read ());
+		ASSERT_NE (nullptr, store->block.get (read_transaction, block1.hash ()));
+		ASSERT_EQ (nullptr, store->block.get (read_transaction, block2.hash ()));
+		ASSERT_EQ (1, store->block_cache.size ());
+	}
+	// Rolling the write back deletes the block again, it must never become visible through the cache
+	store->block.del (transaction, block2.hash ());
+	transaction.commit ();
+	auto read_transaction (store->tx_begin_read ());
+	ASSERT_EQ (nullptr, store->block.get (read_transaction, block2.hash ()));
+	ASSERT_EQ (1, store->block_cache.size ());
+}
+
+TEST (block_cache, eviction)
+{
+	vxlnetwork::open_block block (0, 1, 0, vxlnetwork::keypair ().prv, 0, 0);
+	block.sideband_set ({});
+	auto entry_size (vxlnetwork::block_cache::entry_size (block));
+	// Single shard holding two entries
+	vxlnetwork::block_cache cache (2 * entry_size, 1);
+	std::vector<std::shared_ptr<vxlnetwork::block>> blocks;
+	for (auto i (0); i < 3; ++i)
+	{
+		auto block_l (std::make_shared<vxlnetwork::open_block> (0, i, 0, vxlnetwork::keypair ().prv, 0, 0));
+		block_l->sideband_set ({});
+		blocks.push_back (block_l);
+	}
+	cache.put (blocks[0], 1);
+	cache.put (blocks[1], 1);
+	// Touch the first entry so the second becomes least recently used
+	ASSERT_EQ (blocks[0], cache.get (blocks[0]->hash (), 1));
+	cache.put (blocks[2], 1);
+	ASSERT_EQ (2, cache.size ());
+	ASSERT_EQ (1, cache.evictions);
+	ASSERT_EQ (nullptr, cache.get (blocks[1]->hash (), 1));
+	ASSERT_EQ (blocks[2], cache.get (blocks[2]->hash (), 1));
+	cache.set_max_size (0);
+	ASSERT_EQ (0, cache.size ());
+	ASSERT_FALSE (cache.enabled ());
+}
+
+TEST (block_cache, versions)
+{
+	vxlnetwork::block_cache cache;
+	auto block (std::make_shared<vxlnetwork::open_block> (0, 1, 0, vxlnetwork::keypair ().prv, 0, 0));
+	block->sideband_set ({});
+	auto const hash (block->hash ());
+	cache.put (block, 5);
+	// Snapshots older than the one the block was read from may not contain it
+	ASSERT_EQ (nullptr, cache.get (hash, 4));
+	ASSERT_EQ (block, cache.get (hash, 5));
+	// Nothing is admitted while the write is pending
+	cache.invalidate (hash);
+	ASSERT_EQ (nullptr, cache.get (hash, 5));
+	cache.put (block, 100);
+	ASSERT_EQ (0, cache.size ());
+	cache.commit (hash, 10);
+	cache.put (block, 9);
+	ASSERT_EQ (0, cache.size ());
+	cache.put (block, 10);
+	ASSERT_EQ (block, cache.get (hash, 10));
+	ASSERT_EQ (0, cache.tombstone_count ());
+	// Dropping resolved tombstones raises the admission floor of the shard
+	for (std::size_t i (0); i <= vxlnetwork::block_cache::max_tombstones; ++i)
+	{
+		auto hash_l (hash);
+		hash_l.qwords[3] ^= i + 1;
+		cache.invalidate (hash_l);
+		cache.commit (hash_l, 20);
+	}
+	ASSERT_EQ (vxlnetwork::block_cache::max_tombstones, cache.tombstone_count ());
+	cache.invalidate (hash);
+	cache.commit (hash, 11);
+	cache.put (block, 19);
+	ASSERT_EQ (0, cache.size ());
+	cache.put (block, 20);
+	ASSERT_EQ (1, cache.size ());
+}
+
 TEST (block_store, add_nonempty_block)
 {
 	vxlnetwork::logger_mt logger;
@@ -465,10 +636,9 @@ TEST (unchecked, multiple_get)
 	auto count_unchecked_blocks_one_by_one = [&store, &unchecked] () {
 		size_t count = 0;
 		auto transaction = store->tx_begin_read ();
-		for (auto [i, end] = unchecked.full_range (transaction); i != end; ++i)
-		{
+		unchecked.for_each (transaction, [&count] (vxlnetwork::unchecked_key const & key, vxlnetwork::unchecked_info const & info) {
 			++count;
-		}
+		});
 		return count;
 	};
 
@@ -542,8 +712,11 @@ TEST (block_store, empty_bootstrap)
 	vxlnetwork::unchecked_map unchecked{ *store, false };
 	ASSERT_TRUE (!store->init_error ());
 	auto transaction (store->tx_begin_read ());
-	auto [begin, end] = unchecked.full_range (transaction);
-	ASSERT_EQ (end, begin);
+	size_t count = 0;
+	unchecked.for_each (transaction, [&count] (vxlnetwork::unchecked_key const & key, vxlnetwork::unchecked_info const & info) {
+		++count;
+	});
+	ASSERT_EQ (count, 0);
 }
 
 TEST (block_store, unchecked_begin_search)
@@ -571,6 +744,70 @@ TEST (block_store, frontier_retrieval)
 	ASSERT_EQ (info1, info2);
 }
 
+TEST (block_store, batch_get)
+{
+	vxlnetwork::logger_mt logger;
+	auto store = vxlnetwork::make_store (logger, vxlnetwork::unique_path (), vxlnetwork::dev::constants);
+	ASSERT_TRUE (!store->init_error ());
+	// Disable the cache so blocks come from the database
+	store->block_cache.set_max_size (0);
+	std::vector<std::shared_ptr<vxlnetwork::block>> blocks;
+	std::vector<vxlnetwork::account> accounts;
+	std::vector<vxlnetwork::pending_key> pending_keys;
+	{
+		auto transaction (store->tx_begin_write ());
+		for (uint64_t i (0); i < 16; ++i)
+		{
+			auto block (std::make_shared<vxlnetwork::open_block> (0, i, i, vxlnetwork::keypair ().prv, 0, 0));
+			block->sideband_set ({});
+			store->block.put (transaction, block->hash (), *block);
+			blocks.push_back (block);
+			vxlnetwork::account account (i + 1);
+			store->account.put (transaction, account, { block->hash (), account, block->hash (), i, 100, 1, vxlnetwork::epoch::epoch_0 });
+			accounts.push_back (account);
+			vxlnetwork::pending_key key (account, block->hash ());
+			store->pending.put (transaction, key, { account, i, vxlnetwork::epoch::epoch_0 });
+			pending_keys.push_back (key);
+		}
+	}
+	// Results follow the input order, including missing and duplicate keys
+	std::vector<vxlnetwork::block_hash> hashes{ blocks[5]->hash (), 42, blocks[0]->hash (), blocks[15]->hash (), blocks[5]->hash () };
+	accounts.insert (accounts.begin () + 3, vxlnetwork::account (1000));
+	pending_keys.push_back (vxlnetwork::pending_key (1000, 0));
+	auto transaction (store->tx_begin_read ());
+	auto blocks_l (store->block.batch_get (transaction, hashes));
+	ASSERT_EQ (hashes.size (), blocks_l.size ());
+	ASSERT_EQ (*blocks[5], *blocks_l[0]);
+	ASSERT_EQ (nullptr, blocks_l[1]);
+	ASSERT_EQ (*blocks[0], *blocks_l[2]);
+	ASSERT_EQ (*blocks[15], *blocks_l[3]);
+	ASSERT_EQ (*blocks[5], *blocks_l[4]);
+	ASSERT_TRUE (blocks_l[0]->has_sideband ());
+	auto infos (store->account.batch_get (transaction, accounts));
+	ASSERT_EQ (accounts.size (), infos.size ());
+	for (std::size_t i = 0; i < accounts.size (); ++i)
+	{
+		vxlnetwork::account_info info;
+		auto error (store->account.get (transaction, accounts[i], info));
+		ASSERT_EQ (!error, infos[i].is_initialized ());
+		if (!error)
+		{
+			ASSERT_EQ (info, *infos[i]);
+		}
+	}
+	ASSERT_FALSE (infos[3].is_initialized ());
+	auto pending (store->pending.batch_get (transaction, pending_keys));
+	ASSERT_EQ (pending_keys.size (), pending.size ());
+	for (std::size_t i = 0; i < pending_keys.size () - 1; ++i)
+	{
+		ASSERT_TRUE (pending[i].is_initialized ());
+		ASSERT_EQ (pending_keys[i].account, pending[i]->source);
+		ASSERT_EQ (i, pending[i]->amount.number ());
+	}
+	ASSERT_FALSE (pending.back ().is_initialized ());
+	ASSERT_TRUE (store->block.batch_get (transaction, {}).empty ());
+}
+
 TEST (block_store, one_account)
 {
 	vxlnetwork::logger_mt logger;
@@ -909,6 +1146,23 @@ TEST (block_store, account_count)
 	ASSERT_EQ (1, store->account.count (transaction));
 }
 
+// An exception thrown while traversing a range reaches the caller once every range has finished
+TEST (block_store, for_each_par_exception)
+{
+	vxlnetwork::logger_mt logger;
+	auto store = vxlnetwork::make_store (logger, vxlnetwork::unique_path (), vxlnetwork::dev::constants);
+	ASSERT_TRUE (!store->init_error ());
+	std::atomic<unsigned> ranges{ 0 };
+	ASSERT_THROW (store->account.for_each_par ([&ranges] (vxlnetwork::read_transaction const &, auto, auto) {
+		if (ranges++ == 0)
+		{
+			throw std::runtime_error ("range failed");
+		}
+	}),
+	std::runtime_error);
+	ASSERT_LT (1, ranges);
+}
+
 TEST (block_store, cemented_count_cache)
 {
 	vxlnetwork::logger_mt logger;
@@ -970,7 +1224,7 @@ TEST (block_store, DISABLED_change_dupsort) // Unchecked is no longer dupsort ta
 	unchecked.put (send1->hash (), send1);
 	unchecked.put (send1->hash (), send2);
 	ASSERT_EQ (0, mdb_drop (store.env.tx (transaction), store.unchecked_handle, 0));
-	mdb_dbi_close (store.env, store.unchecked_handle);
+	mdb_dbi_close (mdb_txn_env (store.env.tx (transaction)), store.unchecked_handle);
 	ASSERT_EQ (0, mdb_dbi_open (store.env.tx (transaction), "unchecked", MDB_CREATE | MDB_DUPSORT, &store.unchecked_handle));
 	unchecked.put (send1->hash (), send1);
 	unchecked.put (send1->hash (), send2);
@@ -1930,6 +2184,120 @@ TEST (block_store, confirmation_height)
 	ASSERT_TRUE (store->confirmation_height.get (transaction, account3, confirmation_height_info));
 }
 
+TEST (mdb_block_store, online_compaction)
+{
+	if (vxlnetwork::rocksdb_config::using_rocksdb_in_tests ())
+	{
+		// Don't test this in rocksdb mode
+		return;
+	}
+	auto path (vxlnetwork::unique_path ());
+	vxlnetwork::logger_mt logger;
+	vxlnetwork::lmdb_config config;
+	config.compaction_rate_limit = 0;
+	vxlnetwork::mdb_store store (logger, path, vxlnetwork::dev::constants, vxlnetwork::txn_tracking_config{}, std::chrono::milliseconds (5000), config);
+	ASSERT_FALSE (store.init_error ());
+	uint64_t const initial (100000);
+	{
+		auto transaction (store.tx_begin_write ());
+		for (uint64_t i (0); i < initial; ++i)
+		{
+			store.online_weight.put (transaction, i, vxlnetwork::amount (i));
+		}
+	}
+	{
+		auto transaction (store.tx_begin_write ());
+		for (uint64_t i (0); i < initial; ++i)
+		{
+			if (i % 100 != 0)
+			{
+				store.online_weight.del (transaction, i);
+			}
+		}
+	}
+	auto size_before (boost::filesystem::file_size (path));
+	ASSERT_GT (store.compaction.free_ratio (), 0.5);
+	// A reader from before the switch keeps reading its snapshot
+	auto old_transaction (store.tx_begin_read ());
+	// Keep writing while the tables are copied, each write adds a new key and removes an existing one
+	std::atomic<bool> done{ false };
+	uint64_t writes (0);
+	std::thread writer ([&store, &done, &writes, initial] () {
+		for (; !done && writes < initial / 100; ++writes)
+		{
+			auto transaction (store.tx_begin_write ());
+			store.online_weight.put (transaction, initial + writes, vxlnetwork::amount (initial + writes));
+			store.online_weight.del (transaction, writes * 100);
+		}
+	});
+	ASSERT_FALSE (store.compaction.run ());
+	done = true;
+	writer.join ();
+	ASSERT_LT (boost::filesystem::file_size (path), size_before);
+	ASSERT_EQ (initial / 100, store.online_weight.count (old_transaction));
+	ASSERT_EQ (0, store.online_weight.begin (old_transaction)->first);
+	std::vector<uint64_t> expected;
+	for (auto i (writes); i < initial / 100; ++i)
+	{
+		expected.push_back (i * 100);
+	}
+	for (uint64_t i (0); i < writes; ++i)
+	{
+		expected.push_back (initial + i);
+	}
+	auto transaction (store.tx_begin_read ());
+	std::vector<uint64_t> actual;
+	for (auto i (store.online_weight.begin (transaction)), n (store.online_weight.end ()); i != n; ++i)
+	{
+		ASSERT_EQ (vxlnetwork::amount (i->first), i->second);
+		actual.push_back (i->first);
+	}
+	ASSERT_EQ (expected, actual);
+	// Renewing moves the old reader to the new file
+	old_transaction.refresh ();
+	ASSERT_EQ (expected.front (), store.online_weight.begin (old_transaction)->first);
+	vxlnetwork::stat stats;
+	store.export_stats (stats);
+	ASSERT_EQ (1, stats.count (vxlnetwork::stat::type::lmdb_compaction, vxlnetwork::stat::detail::compaction_switch));
+	ASSERT_EQ (0, stats.count (vxlnetwork::stat::type::lmdb_compaction, vxlnetwork::stat::detail::compaction_abort));
+}
+
+// Stopping waits for a running compaction, which leaves the database unchanged, and no compaction starts afterwards
+TEST (mdb_block_store, online_compaction_stop)
+{
+	if (vxlnetwork::rocksdb_config::using_rocksdb_in_tests ())
+	{
+		// Don't test this in rocksdb mode
+		return;
+	}
+	auto path (vxlnetwork::unique_path ());
+	vxlnetwork::logger_mt logger;
+	vxlnetwork::lmdb_config config;
+	config.compaction = true;
+	config.compaction_threshold = 0;
+	// Slow enough for the copy to still be running when stopping
+	config.compaction_rate_limit = 1;
+	vxlnetwork::mdb_store store (logger, path, vxlnetwork::dev::constants, vxlnetwork::txn_tracking_config{}, std::chrono::milliseconds (5000), config);
+	ASSERT_FALSE (store.init_error ());
+	uint64_t const initial (100000);
+	{
+		auto transaction (store.tx_begin_write ());
+		for (uint64_t i (0); i < initial; ++i)
+		{
+			store.online_weight.put (transaction, i, vxlnetwork::amount (i));
+		}
+	}
+	store.compact_if_needed ();
+	store.stop_compaction ();
+	store.compact_if_needed ();
+	vxlnetwork::stat stats;
+	store.export_stats (stats);
+	ASSERT_EQ (1, stats.count (vxlnetwork::stat::type::lmdb_compaction, vxlnetwork::stat::detail::compaction_start));
+	ASSERT_EQ (1, stats.count (vxlnetwork::stat::type::lmdb_compaction, vxlnetwork::stat::detail::compaction_abort));
+	ASSERT_EQ (0, stats.count (vxlnetwork::stat::type::lmdb_compaction, vxlnetwork::stat::detail::compaction_switch));
+	ASSERT_EQ (initial, store.online_weight.count (store.tx_begin_read ()));
+}
+
 // Test various confirmation height values as well as clearing them
 TEST (block_store, final_vote)
 {
@@ -2065,6 +2433,47 @@ TEST (rocksdb_block_store, tombstone_count)
 		ASSERT_EQ (store->tombstone_map.at (vxlnetwork::tables::unchecked).num_since_last_flush.load (), 1);
 	}
 }
+
+// Pending has a prefix extractor, prefix lookups must stay exact and full scans must still cross accounts
+TEST (rocksdb_block_store, pending_prefix)
+{
+	if (vxlnetwork::rocksdb_config::using_rocksdb_in_tests ())
+	{
+		vxlnetwork::logger_mt logger{};
+		auto store = std::make_unique<vxlnetwork::rocksdb_store> (logger, vxlnetwork::unique_path (), vxlnetwork::dev::constants);
+		ASSERT_TRUE (!store->init_error ());
+		{
+			auto transaction (store->tx_begin_write ());
+			for (auto account : { 1, 3, 5 })
+			{
+				store->pending.put (transaction, vxlnetwork::pending_key (account, 10), vxlnetwork::pending_info (2, 100, vxlnetwork::epoch::epoch_0));
+				store->pending.put (transaction, vxlnetwork::pending_key (account, 11), vxlnetwork::pending_info (2, 100, vxlnetwork::epoch::epoch_0));
+			}
+		}
+		store->flush_table (vxlnetwork::tables::pending);
+		auto transaction (store->tx_begin_read ());
+		ASSERT_TRUE (store->pending.any (transaction, 1));
+		ASSERT_FALSE (store->pending.any (transaction, 2));
+		ASSERT_TRUE (store->pending.any (transaction, 5));
+		ASSERT_FALSE (store->pending.any (transaction, 6));
+		ASSERT_TRUE (store->pending.exists (transaction, vxlnetwork::pending_key (3, 11)));
+		ASSERT_FALSE (store->pending.exists (transaction, vxlnetwork::pending_key (3, 12)));
+		ASSERT_FALSE (store->pending.exists (transaction, vxlnetwork::pending_key (4, 10)));
+		size_t count{ 0 };
+		for (auto i (store->pending.begin (transaction, vxlnetwork::pending_key (2, 0))), n (store->pending.end ()); i != n; ++i)
+		{
+			++count;
+		}
+		ASSERT_EQ (4, count);
+		vxlnetwork::stat stats;
+		store->export_stats (stats);
+		ASSERT_GT (stats.count (vxlnetwork::stat::type::rocksdb), 0);
+		// Counters are reset by every export
+		vxlnetwork::stat stats_again;
+		store->export_stats (stats_again);
+		ASSERT_LT (stats_again.count (vxlnetwork::stat::type::rocksdb), stats.count (vxlnetwork::stat::type::rocksdb));
+	}
+}
 }
 
 namespace
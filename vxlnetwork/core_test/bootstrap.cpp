@@ -5,6 +5,9 @@
 
 #include <gtest/gtest.h>
 
+#include <boost/format.hpp>
+#include <boost/property_tree/ptree.hpp>
+
 using namespace std::chrono_literals;
 
 // If the account doesn't exist, current == end so there's no iteration
@@ -1313,6 +1316,96 @@ TEST (bootstrap_processor, wallet_lazy_pending)
 	node1->stop ();
 }
 
+TEST (bootstrap_processor, ascending)
+{
+	vxlnetwork::system system;
+	vxlnetwork::node_config config (vxlnetwork::get_available_port (), system.logging);
+	config.frontiers_confirmation = vxlnetwork::frontiers_confirmation_mode::disabled;
+	vxlnetwork::node_flags node_flags;
+	node_flags.disable_bootstrap_bulk_push_client = true;
+	node_flags.disable_legacy_bootstrap = true;
+	auto node0 = system.add_node (config, node_flags);
+	vxlnetwork::keypair key1;
+	vxlnetwork::keypair key2;
+	// Generating test chain
+
+	vxlnetwork::state_block_builder builder;
+
+	auto send1 = builder
+				 .account (vxlnetwork::dev::genesis_key.pub)
+				 .previous (vxlnetwork::dev::genesis->hash ())
+				 .representative (vxlnetwork::dev::genesis_key.pub)
+				 .balance (vxlnetwork::dev::constants.genesis_amount - vxlnetwork::Gxrb_ratio)
+				 .link (key1.pub)
+				 .sign (vxlnetwork::dev::genesis_key.prv, vxlnetwork::dev::genesis_key.pub)
+				 .work (*node0->work_generate_blocking (vxlnetwork::dev::genesis->hash ()))
+				 .build_shared ();
+	auto receive1 = builder
+					.make_block ()
+					.account (key1.pub)
+					.previous (0)
+					.representative (key1.pub)
+					.balance (vxlnetwork::Gxrb_ratio)
+					.link (send1->hash ())
+					.sign (key1.prv, key1.pub)
+					.work (*node0->work_generate_blocking (key1.pub))
+					.build_shared ();
+	auto send2 = builder
+				 .make_block ()
+				 .account (key1.pub)
+				 .previous (receive1->hash ())
+				 .representative (key1.pub)
+				 .balance (0)
+				 .link (key2.pub)
+				 .sign (key1.prv, key1.pub)
+				 .work (*node0->work_generate_blocking (receive1->hash ()))
+				 .build_shared ();
+	auto receive2 = builder
+					.make_block ()
+					.account (key2.pub)
+					.previous (0)
+					.representative (key2.pub)
+					.balance (vxlnetwork::Gxrb_ratio)
+					.link (send2->hash ())
+					.sign (key2.prv, key2.pub)
+					.work (*node0->work_generate_blocking (key2.pub))
+					.build_shared ();
+
+	// Processing test chain
+	node0->block_processor.add (send1);
+	node0->block_processor.add (receive1);
+	node0->block_processor.add (send2);
+	node0->block_processor.add (receive2);
+	node0->block_processor.flush ();
+	// Start ascending bootstrap, only the genesis account is known locally and the other accounts are found through send destinations
+	auto node1 (std::make_shared<vxlnetwork::node> (system.io_ctx, vxlnetwork::get_available_port (), vxlnetwork::unique_path (), system.logging, system.work));
+	node1->network.udp_channels.insert (node0->network.endpoint (), node1->network_params.network.protocol_version);
+	node1->bootstrap_initiator.bootstrap_ascending (false, "ascending_id");
+	auto ascending_attempt (node1->bootstrap_initiator.current_ascending_attempt ());
+	ASSERT_NE (nullptr, ascending_attempt);
+	ASSERT_EQ ("ascending_id", ascending_attempt->id);
+	ASSERT_EQ ("ascending", ascending_attempt->mode_text ());
+	// Check processed blocks
+	ASSERT_TIMELY (10s, node1->ledger.block_or_pruned_exists (receive2->hash ()));
+	ASSERT_EQ (1, node1->stats.count (vxlnetwork::stat::type::bootstrap, vxlnetwork::stat::detail::initiate_ascending, vxlnetwork::stat::dir::out));
+	// All pulls went to node0, which delivered the four blocks missing from node1
+	auto peers = [&ascending_attempt] () {
+		boost::property_tree::ptree tree;
+		ascending_attempt->get_information (tree);
+		return tree.get_child ("peers");
+	};
+	ASSERT_TIMELY (5s, peers ().size () == 1 && peers ().front ().second.get<uint64_t> ("blocks") >= 4 && peers ().front ().second.get<unsigned> ("in_flight") == 0);
+	auto peer (peers ().front ().second);
+	ASSERT_EQ (boost::str (boost::format ("%1%") % vxlnetwork::transport::map_endpoint_to_tcp (node0->network.endpoint ())), peer.get<std::string> ("endpoint"));
+	auto pulls (peer.get<uint64_t> ("pulls"));
+	ASSERT_GE (pulls, 3);
+	ASSERT_EQ (0, peer.get<uint64_t> ("failures"));
+	ASSERT_LE (peer.get<uint64_t> ("empty"), pulls);
+	ASSERT_GE (peer.get<double> ("rate"), vxlnetwork::bootstrap_limits::ascending_peer_rate_initial);
+	ASSERT_DOUBLE_EQ (static_cast<double> (peer.get<uint64_t> ("blocks")) / pulls, peer.get<double> ("efficiency"));
+	node1->stop ();
+}
+
 TEST (bootstrap_processor, multiple_attempts)
 {
 	vxlnetwork::system system;
@@ -1038,10 +1038,7 @@ TEST (confirmation_height, callback_confirmed_history)
 			election->force_confirm ();
 			ASSERT_TIMELY (10s, node->active.size () == 0);
 			ASSERT_EQ (0, node->active.list_recently_cemented ().size ());
-			{
-				vxlnetwork::lock_guard<vxlnetwork::mutex> guard (node->active.mutex);
-				ASSERT_EQ (0, node->active.blocks.size ());
-			}
+			ASSERT_EQ (0, node->active.blocks_size ());
 
 			auto transaction = node->store.tx_begin_read ();
 			ASSERT_FALSE (node->ledger.block_confirmed (transaction, send->hash ()));
@@ -1061,7 +1058,7 @@ TEST (confirmation_height, callback_confirmed_history)
 		ASSERT_TIMELY (10s, node->stats.count (vxlnetwork::stat::type::confirmation_observer, vxlnetwork::stat::detail::active_quorum, vxlnetwork::stat::dir::out) == 1);
 
 		ASSERT_EQ (1, node->active.list_recently_cemented ().size ());
-		ASSERT_EQ (0, node->active.blocks.size ());
+		ASSERT_EQ (0, node->active.blocks_size ());
 
 		// Confirm the callback is not called under this circumstance
 		ASSERT_EQ (2, node->stats.count (vxlnetwork::stat::type::http_callback, vxlnetwork::stat::detail::http_callback, vxlnetwork::stat::dir::out));
@@ -1476,3 +1473,107 @@ TEST (confirmation_height, pruned_source)
 	[] (auto const &) {}, [] () { return 0; });
 	bounded_processor.process (open2);
 }
+
+// Independent accounts confirmed at the same time are walked in parallel, groups depending on the same account fall back to serial processing
+TEST (confirmation_height, parallel_walk)
+{
+	vxlnetwork::logger_mt logger;
+	auto path (vxlnetwork::unique_path ());
+	auto store = vxlnetwork::make_store (logger, path, vxlnetwork::dev::constants);
+	ASSERT_TRUE (!store->init_error ());
+	vxlnetwork::stat stats;
+	vxlnetwork::ledger ledger (*store, stats, vxlnetwork::dev::constants);
+	vxlnetwork::write_database_queue write_database_queue (false);
+	boost::latch initialized_latch{ 0 };
+	vxlnetwork::work_pool pool{ vxlnetwork::dev::network_params.network, std::numeric_limits<unsigned>::max () };
+	vxlnetwork::logging logging;
+	vxlnetwork::keypair key1;
+	vxlnetwork::keypair key2;
+	vxlnetwork::keypair key3;
+	auto send1 = std::make_shared<vxlnetwork::send_block> (vxlnetwork::dev::genesis->hash (), key1.pub, vxlnetwork::dev::constants.genesis_amount - vxlnetwork::Gxrb_ratio, vxlnetwork::dev::genesis_key.prv, vxlnetwork::dev::genesis_key.pub, *pool.generate (vxlnetwork::dev::genesis->hash ()));
+	auto send2 = std::make_shared<vxlnetwork::send_block> (send1->hash (), key2.pub, vxlnetwork::dev::constants.genesis_amount - vxlnetwork::Gxrb_ratio * 2, vxlnetwork::dev::genesis_key.prv, vxlnetwork::dev::genesis_key.pub, *pool.generate (send1->hash ()));
+	auto send3 = std::make_shared<vxlnetwork::send_block> (send2->hash (), key3.pub, vxlnetwork::dev::constants.genesis_amount - vxlnetwork::Gxrb_ratio * 3, vxlnetwork::dev::genesis_key.prv, vxlnetwork::dev::genesis_key.pub, *pool.generate (send2->hash ()));
+	auto open1 = std::make_shared<vxlnetwork::open_block> (send1->hash (), key1.pub, key1.pub, key1.prv, key1.pub, *pool.generate (key1.pub));
+	auto open2 = std::make_shared<vxlnetwork::open_block> (send2->hash (), key2.pub, key2.pub, key2.prv, key2.pub, *pool.generate (key2.pub));
+	auto open3 = std::make_shared<vxlnetwork::open_block> (send3->hash (), key3.pub, key3.pub, key3.prv, key3.pub, *pool.generate (key3.pub));
+	auto send4 = std::make_shared<vxlnetwork::send_block> (open1->hash (), key2.pub, vxlnetwork::Gxrb_ratio - 1, key1.prv, key1.pub, *pool.generate (open1->hash ()));
+	auto send5 = std::make_shared<vxlnetwork::send_block> (send4->hash (), key3.pub, vxlnetwork::Gxrb_ratio - 2, key1.prv, key1.pub, *pool.generate (send4->hash ()));
+	auto receive = std::make_shared<vxlnetwork::receive_block> (open2->hash (), send4->hash (), key2.prv, key2.pub, *pool.generate (open2->hash ()));
+	{
+		auto transaction (store->tx_begin_write ());
+		store->initialize (transaction, ledger.cache);
+		for (auto const & block : { send1, send2, send3 })
+		{
+			ASSERT_EQ (vxlnetwork::process_result::progress, ledger.process (transaction, *block).code);
+		}
+		for (auto const & block : { open1, open2, open3 })
+		{
+			ASSERT_EQ (vxlnetwork::process_result::progress, ledger.process (transaction, *block).code);
+		}
+		ASSERT_EQ (vxlnetwork::process_result::progress, ledger.process (transaction, *send4).code);
+		ASSERT_EQ (vxlnetwork::process_result::progress, ledger.process (transaction, *send5).code);
+		ASSERT_EQ (vxlnetwork::process_result::progress, ledger.process (transaction, *receive).code);
+	}
+
+	vxlnetwork::confirmation_height_processor confirmation_height_processor (ledger, write_database_queue, 10ms, logging, logger, initialized_latch, vxlnetwork::confirmation_height_mode::unbounded, 4);
+	vxlnetwork::mutex mutex;
+	std::vector<vxlnetwork::block_hash> cemented;
+	confirmation_height_processor.add_cemented_observer ([&mutex, &cemented] (auto const & block_a) {
+		vxlnetwork::lock_guard<vxlnetwork::mutex> guard (mutex);
+		cemented.push_back (block_a->hash ());
+	});
+	auto cemented_size = [&mutex, &cemented] () {
+		vxlnetwork::lock_guard<vxlnetwork::mutex> guard (mutex);
+		return cemented.size ();
+	};
+	vxlnetwork::timer<> timer;
+	timer.start ();
+
+	// A single block is processed serially
+	confirmation_height_processor.add (send3);
+	while (cemented_size () < 3)
+	{
+		ASSERT_LT (timer.since_start (), 10s);
+	}
+	ASSERT_EQ (0, stats.count (vxlnetwork::stat::type::confirmation_height, vxlnetwork::stat::detail::parallel_batch));
+
+	// Opens only depend on cemented sends, every account is walked by a different worker
+	confirmation_height_processor.pause ();
+	confirmation_height_processor.add (open1);
+	confirmation_height_processor.add (open2);
+	confirmation_height_processor.add (open3);
+	confirmation_height_processor.unpause ();
+	while (cemented_size () < 6)
+	{
+		ASSERT_LT (timer.since_start (), 10s);
+	}
+	ASSERT_EQ (1, stats.count (vxlnetwork::stat::type::confirmation_height, vxlnetwork::stat::detail::parallel_batch));
+	ASSERT_EQ (0, stats.count (vxlnetwork::stat::type::confirmation_height, vxlnetwork::stat::detail::parallel_conflict));
+
+	// Both walks cement send4, the second group is processed again after the first one is written
+	confirmation_height_processor.pause ();
+	confirmation_height_processor.add (receive);
+	confirmation_height_processor.add (send5);
+	confirmation_height_processor.unpause ();
+	while (cemented_size () < 9)
+	{
+		ASSERT_LT (timer.since_start (), 10s);
+	}
+	ASSERT_EQ (2, stats.count (vxlnetwork::stat::type::confirmation_height, vxlnetwork::stat::detail::parallel_batch));
+	ASSERT_EQ (1, stats.count (vxlnetwork::stat::type::confirmation_height, vxlnetwork::stat::detail::parallel_conflict));
+	ASSERT_EQ (9, stats.count (vxlnetwork::stat::type::confirmation_height, vxlnetwork::stat::detail::blocks_confirmed, vxlnetwork::stat::dir::in));
+	ASSERT_EQ (10, ledger.cache.cemented_count);
+
+	// Every block is reported once and never before the blocks it depends on
+	vxlnetwork::lock_guard<vxlnetwork::mutex> guard (mutex);
+	ASSERT_EQ (cemented.size (), std::unordered_set<vxlnetwork::block_hash> (cemented.begin (), cemented.end ()).size ());
+	auto position = [&cemented] (std::shared_ptr<vxlnetwork::block> const & block_a) {
+		return std::distance (cemented.begin (), std::find (cemented.begin (), cemented.end (), block_a->hash ()));
+	};
+	ASSERT_LT (position (send1), position (open1));
+	ASSERT_LT (position (send2), position (open2));
+	ASSERT_LT (position (send3), position (open3));
+	ASSERT_LT (position (open1), position (send4));
+	ASSERT_LT (position (send4), position (receive));
+	ASSERT_LT (position (send4), position (send5));
+}
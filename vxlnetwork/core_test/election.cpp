@@ -256,3 +256,51 @@ TEST (election, quorum_minimum_update_weight_before_quorum_checks)
 	ASSERT_NE (nullptr, node1.block (send1->hash ()));
 }
 }
+
+// The incrementally maintained tally matches a full recomputation, weights are frozen from online_reps until it samples again
+TEST (election, tally_incremental)
+{
+	vxlnetwork::system system{};
+	vxlnetwork::node_config node_config{ vxlnetwork::get_available_port (), system.logging };
+	node_config.online_weight_minimum = vxlnetwork::dev::constants.genesis_amount;
+	node_config.frontiers_confirmation = vxlnetwork::frontiers_confirmation_mode::disabled;
+	auto & node = *system.add_node (node_config);
+	std::array<std::shared_ptr<vxlnetwork::block>, 2> forks;
+	auto election (vxlnetwork::start_fork_election (system, node, forks));
+	ASSERT_NE (nullptr, election);
+
+	// Far below quorum so the election keeps tallying
+	auto const weight = vxlnetwork::dev::constants.genesis_amount / 1000;
+	std::vector<vxlnetwork::account> reps (20);
+	for (std::size_t i (0); i < reps.size (); ++i)
+	{
+		reps[i] = vxlnetwork::keypair{}.pub;
+		node.ledger.cache.rep_weights.representation_put (reps[i], weight * (i + 1));
+	}
+	// The election tallies with the weights it started with, the new representatives count from the next sample
+	vxlnetwork::keypair late;
+	node.ledger.cache.rep_weights.representation_put (late.pub, weight);
+	ASSERT_TRUE (election->vote (late.pub, 1, forks[0]->hash ()).processed);
+	ASSERT_EQ (vxlnetwork::uint128_t{ 0 }, vxlnetwork::tally_weights (election->tally ())[forks[0]->hash ()]);
+	node.online_reps.sample ();
+	ASSERT_EQ (weight, vxlnetwork::tally_weights (election->tally ())[forks[0]->hash ()]);
+	for (std::size_t i (0); i < reps.size (); ++i)
+	{
+		ASSERT_TRUE (election->vote (reps[i], 1, forks[i % 2]->hash ()).processed);
+		ASSERT_EQ (vxlnetwork::recompute_tally (node.ledger, election->votes ()), vxlnetwork::tally_weights (election->tally ()));
+	}
+	// Final votes bypass the cooldown, move every third representative to the other fork
+	for (std::size_t i (0); i < reps.size (); i += 3)
+	{
+		ASSERT_TRUE (election->vote (reps[i], vxlnetwork::vote::timestamp_max, forks[(i + 1) % 2]->hash ()).processed);
+		ASSERT_EQ (vxlnetwork::recompute_tally (node.ledger, election->votes ()), vxlnetwork::tally_weights (election->tally ()));
+	}
+	auto const frozen (vxlnetwork::tally_weights (election->tally ()));
+
+	// Weight changes are ignored until the next sample
+	node.ledger.cache.rep_weights.representation_put (reps[0], weight * 100);
+	ASSERT_EQ (frozen, vxlnetwork::tally_weights (election->tally ()));
+	ASSERT_NE (vxlnetwork::recompute_tally (node.ledger, election->votes ()), frozen);
+	node.online_reps.sample ();
+	ASSERT_EQ (vxlnetwork::recompute_tally (node.ledger, election->votes ()), vxlnetwork::tally_weights (election->tally ()));
+}
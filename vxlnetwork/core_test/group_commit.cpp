@@ -0,0 +1,181 @@
+#include <vxlnetwork/lib/logger_mt.hpp>
+#include <vxlnetwork/lib/stats.hpp>
+#include <vxlnetwork/node/group_commit.hpp>
+#include <vxlnetwork/secure/store.hpp>
+#include <vxlnetwork/secure/utility.hpp>
+#include <vxlnetwork/test_common/system.hpp>
+#include <vxlnetwork/test_common/testutil.hpp>
+
+#include <gtest/gtest.h>
+
+#include <boost/asio/ip/address_v6.hpp>
+
+#include <future>
+#include <memory>
+
+using namespace std::chrono_literals;
+
+namespace
+{
+class context
+{
+public:
+	explicit context (vxlnetwork::group_commit::config const & config_a = vxlnetwork::group_commit::config{}) :
+		store{ vxlnetwork::make_store (logger, vxlnetwork::unique_path (), vxlnetwork::dev::constants) },
+		group_commit{ *store, stats, config_a }
+	{
+	}
+	vxlnetwork::logger_mt logger;
+	std::unique_ptr<vxlnetwork::store> store;
+	vxlnetwork::stat stats;
+	vxlnetwork::group_commit group_commit;
+};
+vxlnetwork::endpoint_key peer (uint16_t port_a)
+{
+	return vxlnetwork::endpoint_key{ boost::asio::ip::address_v6::loopback ().to_bytes (), port_a };
+}
+}
+
+TEST (group_commit, construction)
+{
+	context context;
+}
+
+TEST (group_commit, submit)
+{
+	context context;
+	ASSERT_FALSE (context.store->init_error ());
+	context.group_commit.submit (vxlnetwork::writer::peers, { vxlnetwork::tables::peers }, [&context] (vxlnetwork::write_transaction const & transaction_a) {
+		context.store->peer.put (transaction_a, peer (100));
+	})
+	.wait ();
+	ASSERT_TRUE (context.store->peer.exists (context.store->tx_begin_read (), peer (100)));
+	ASSERT_EQ (1, context.group_commit.commits);
+	ASSERT_EQ (1, context.group_commit.actions);
+}
+
+// Actions waiting within their latency budget are committed together once the batch is full
+TEST (group_commit, coalesce)
+{
+	vxlnetwork::group_commit::config config;
+	config.max_batch = 8;
+	config.set_budget (vxlnetwork::writer::peers, 1h);
+	context context{ config };
+	std::vector<std::future<void>> futures;
+	for (uint16_t i = 0; i < config.max_batch; ++i)
+	{
+		futures.push_back (context.group_commit.submit (vxlnetwork::writer::peers, { vxlnetwork::tables::peers }, [&context, i] (vxlnetwork::write_transaction const & transaction_a) {
+			context.store->peer.put (transaction_a, peer (i));
+		}));
+	}
+	for (auto & future : futures)
+	{
+		ASSERT_EQ (std::future_status::ready, future.wait_for (5s));
+	}
+	ASSERT_EQ (config.max_batch, context.store->peer.count (context.store->tx_begin_read ()));
+	ASSERT_EQ (1, context.group_commit.commits);
+	ASSERT_EQ (config.max_batch, context.group_commit.actions);
+	ASSERT_EQ (1, context.stats.count (vxlnetwork::stat::type::group_commit, vxlnetwork::stat::detail::commit));
+}
+
+// An action whose budget has run out commits the whole group, including actions that could have waited longer
+TEST (group_commit, budget)
+{
+	vxlnetwork::group_commit::config config;
+	config.set_budget (vxlnetwork::writer::peers, 1h);
+	config.set_budget (vxlnetwork::writer::final_votes, 0ms);
+	config.set_budget (vxlnetwork::writer::online_weight, 0ms);
+	context context{ config };
+	// Keep the writer thread busy with a first group so the next actions queue up behind it
+	std::promise<void> started;
+	std::promise<void> release;
+	auto blocker (context.group_commit.submit (vxlnetwork::writer::online_weight, {}, [&started, released = release.get_future ().share ()] (vxlnetwork::write_transaction const &) {
+		started.set_value ();
+		released.wait ();
+	}));
+	started.get_future ().wait ();
+	auto peers (context.group_commit.submit (vxlnetwork::writer::peers, { vxlnetwork::tables::peers }, [&context] (vxlnetwork::write_transaction const & transaction_a) {
+		context.store->peer.put (transaction_a, peer (100));
+	}));
+	ASSERT_EQ (std::future_status::timeout, peers.wait_for (100ms));
+	auto final_votes (context.group_commit.submit (vxlnetwork::writer::final_votes, { vxlnetwork::tables::final_votes }, [&context] (vxlnetwork::write_transaction const & transaction_a) {
+		context.store->final_vote.put (transaction_a, vxlnetwork::qualified_root{ 1 }, vxlnetwork::block_hash (2));
+	}));
+	release.set_value ();
+	ASSERT_EQ (std::future_status::ready, blocker.wait_for (5s));
+	ASSERT_EQ (std::future_status::ready, final_votes.wait_for (5s));
+	ASSERT_EQ (std::future_status::ready, peers.wait_for (5s));
+	ASSERT_EQ (2, context.group_commit.commits);
+	ASSERT_EQ (3, context.group_commit.actions);
+}
+
+// Writers are drained round-robin so a writer with many queued actions does not starve the others
+TEST (group_commit, fairness)
+{
+	vxlnetwork::group_commit::config config;
+	config.max_batch = 5;
+	config.set_budget (vxlnetwork::writer::peers, 1h);
+	config.set_budget (vxlnetwork::writer::online_weight, 1h);
+	context context{ config };
+	vxlnetwork::mutex mutex;
+	std::vector<vxlnetwork::writer> order;
+	auto submit = [&] (vxlnetwork::writer writer_a) {
+		return context.group_commit.submit (writer_a, {}, [&mutex, &order, writer_a] (vxlnetwork::write_transaction const &) {
+			vxlnetwork::lock_guard<vxlnetwork::mutex> guard (mutex);
+			order.push_back (writer_a);
+		});
+	};
+	submit (vxlnetwork::writer::peers);
+	submit (vxlnetwork::writer::peers);
+	submit (vxlnetwork::writer::peers);
+	submit (vxlnetwork::writer::online_weight);
+	ASSERT_EQ (std::future_status::ready, submit (vxlnetwork::writer::online_weight).wait_for (5s));
+	std::vector<vxlnetwork::writer> expected{ vxlnetwork::writer::online_weight, vxlnetwork::writer::peers, vxlnetwork::writer::online_weight, vxlnetwork::writer::peers, vxlnetwork::writer::peers };
+	vxlnetwork::lock_guard<vxlnetwork::mutex> guard (mutex);
+	ASSERT_EQ (expected, order);
+}
+
+// A throwing action fails its whole group and the writer thread keeps committing later groups
+TEST (group_commit, exception)
+{
+	vxlnetwork::group_commit::config config;
+	config.max_batch = 2;
+	config.set_budget (vxlnetwork::writer::peers, 1h);
+	config.set_budget (vxlnetwork::writer::online_weight, 1h);
+	context context{ config };
+	auto peers (context.group_commit.submit (vxlnetwork::writer::peers, { vxlnetwork::tables::peers }, [&context] (vxlnetwork::write_transaction const & transaction_a) {
+		context.store->peer.put (transaction_a, peer (100));
+	}));
+	auto failing (context.group_commit.submit (vxlnetwork::writer::online_weight, {}, [] (vxlnetwork::write_transaction const &) {
+		throw std::runtime_error ("action failed");
+	}));
+	ASSERT_EQ (std::future_status::ready, failing.wait_for (5s));
+	ASSERT_THROW (failing.get (), std::runtime_error);
+	ASSERT_EQ (std::future_status::ready, peers.wait_for (5s));
+	ASSERT_THROW (peers.get (), std::runtime_error);
+	ASSERT_EQ (0, context.group_commit.commits);
+	auto after (context.group_commit.submit (vxlnetwork::writer::final_votes, { vxlnetwork::tables::final_votes }, [&context] (vxlnetwork::write_transaction const & transaction_a) {
+		context.store->final_vote.put (transaction_a, vxlnetwork::qualified_root{ 1 }, vxlnetwork::block_hash (2));
+	}));
+	ASSERT_EQ (std::future_status::ready, after.wait_for (5s));
+	ASSERT_NO_THROW (after.get ());
+	ASSERT_EQ (1, context.group_commit.commits);
+}
+
+TEST (group_commit, stop)
+{
+	vxlnetwork::group_commit::config config;
+	config.set_budget (vxlnetwork::writer::peers, 1h);
+	context context{ config };
+	auto pending (context.group_commit.submit (vxlnetwork::writer::peers, { vxlnetwork::tables::peers }, [&context] (vxlnetwork::write_transaction const & transaction_a) {
+		context.store->peer.put (transaction_a, peer (100));
+	}));
+	// Pending actions are committed when stopping and later ones on the calling thread
+	context.group_commit.stop ();
+	ASSERT_EQ (std::future_status::ready, pending.wait_for (0s));
+	auto after (context.group_commit.submit (vxlnetwork::writer::peers, { vxlnetwork::tables::peers }, [&context] (vxlnetwork::write_transaction const & transaction_a) {
+		context.store->peer.put (transaction_a, peer (101));
+	}));
+	ASSERT_EQ (std::future_status::ready, after.wait_for (0s));
+	ASSERT_EQ (2, context.store->peer.count (context.store->tx_begin_read ()));
+}
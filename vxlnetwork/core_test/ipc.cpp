@@ -1,4 +1,5 @@
 #include <vxlnetwork/lib/ipc_client.hpp>
+#include <vxlnetwork/lib/ipc_shm.hpp>
 #include <vxlnetwork/lib/tomlconfig.hpp>
 #include <vxlnetwork/node/ipc/ipc_access_config.hpp>
 #include <vxlnetwork/node/ipc/ipc_server.hpp>
@@ -13,8 +14,14 @@
 #include <chrono>
 #include <memory>
 #include <sstream>
+#include <thread>
 #include <vector>
 
+#ifndef _WIN32
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
 using namespace std::chrono_literals;
 
 TEST (ipc, asynchronous)
@@ -204,4 +211,113 @@ TEST (ipc, invalid_endpoint)
 		call_completed = true;
 	});
 	ASSERT_TIMELY (5s, call_completed);
-}
\ No newline at end of file
+}
+
+#ifndef _WIN32
+namespace
+{
+std::string shm_test_name ()
+{
+	return "/vxlnetwork_test_" + std::to_string (std::chrono::steady_clock::now ().time_since_epoch ().count ());
+}
+}
+
+TEST (ipc, shm_ring)
+{
+	vxlnetwork::ipc::shm_segment segment;
+	ASSERT_FALSE (segment.create (shm_test_name (), 1, 4096));
+	auto & ring (segment.channels[0].requests);
+	ASSERT_EQ (nullptr, ring.reserve (ring.max_message_size () + 1, 0ms));
+
+	// Messages of varying size wrap around the end of the ring many times, the producer waits for the consumer to release space
+	std::size_t constexpr count{ 10000 };
+	std::thread producer ([&ring] () {
+		std::vector<uint8_t> message;
+		for (std::size_t i (0); i < count; ++i)
+		{
+			message.assign (1 + i % 1500, static_cast<uint8_t> (i));
+			ASSERT_FALSE (ring.write (message.data (), message.size (), 5s));
+		}
+	});
+	for (std::size_t i (0); i < count; ++i)
+	{
+		std::size_t size{ 0 };
+		uint8_t last{ 0 };
+		ASSERT_FALSE (ring.read ([&size, &last] (uint8_t const * data_a, std::size_t size_a) {
+			size = size_a;
+			last = data_a[size_a - 1];
+		},
+		5s));
+		ASSERT_EQ (1 + i % 1500, size);
+		ASSERT_EQ (static_cast<uint8_t> (i), last);
+	}
+	producer.join ();
+	ASSERT_TRUE (ring.read ([] (uint8_t const *, std::size_t) {}, 0ms));
+}
+
+// A segment of a running process is never replaced, one left behind by a process which exited is
+TEST (ipc, shm_create_existing)
+{
+	auto name (shm_test_name ());
+	vxlnetwork::ipc::shm_segment segment;
+	ASSERT_FALSE (segment.create (name, 1, 4096));
+	vxlnetwork::ipc::shm_segment duplicate;
+	ASSERT_TRUE (duplicate.create (name, 1, 4096));
+	vxlnetwork::ipc::shm_segment client;
+	ASSERT_FALSE (client.open (name));
+	client.close ();
+	segment.close ();
+
+	auto child (::fork ());
+	ASSERT_NE (-1, child);
+	if (child == 0)
+	{
+		vxlnetwork::ipc::shm_segment orphan;
+		// Exit without removing the segment, as after a crash
+		::_exit (orphan.create (name, 1, 4096) ? 1 : 0);
+	}
+	int status{ 0 };
+	ASSERT_EQ (child, ::waitpid (child, &status, 0));
+	ASSERT_TRUE (WIFEXITED (status));
+	ASSERT_EQ (0, WEXITSTATUS (status));
+	ASSERT_FALSE (segment.create (name, 1, 4096));
+}
+
+TEST (ipc, shm_flatbuffers)
+{
+	vxlnetwork::system system (1);
+	auto name (shm_test_name ());
+	auto & shared_memory (system.nodes[0]->config.ipc_config.transport_shared_memory);
+	shared_memory.enabled = true;
+	shared_memory.name = name;
+	shared_memory.channels = 1;
+	shared_memory.ring_size = 64 * 1024;
+	vxlnetwork::node_rpc_config node_rpc_config;
+	vxlnetwork::ipc::ipc_server ipc (*system.nodes[0], node_rpc_config);
+
+	vxlnetwork::ipc::shm_client client;
+	ASSERT_FALSE (client.connect (name));
+	// The only channel is taken
+	vxlnetwork::ipc::shm_client client2;
+	ASSERT_TRUE (client2.connect (name));
+
+	vxlnetworkapi::IsAliveT alive;
+	auto request (vxlnetwork::ipc::flatbuffer_producer::make_buffer (alive));
+	ASSERT_FALSE (client.write (vxlnetwork::ipc::payload_encoding::flatbuffers, request->GetBufferPointer (), request->GetSize (), 5s));
+	auto verified (false);
+	auto type (vxlnetworkapi::Message::Message_NONE);
+	ASSERT_FALSE (client.read ([&verified, &type] (uint8_t const * data_a, std::size_t size_a) {
+		auto verifier (flatbuffers::Verifier (data_a, size_a));
+		verified = vxlnetworkapi::VerifyEnvelopeBuffer (verifier);
+		type = vxlnetworkapi::GetEnvelope (data_a)->message_type ();
+	},
+	5s));
+	ASSERT_TRUE (verified);
+	ASSERT_EQ (vxlnetworkapi::Message::Message_IsAlive, type);
+
+	// Once released, the node frees the channel for the next client
+	client.close ();
+	ASSERT_TIMELY (5s, !client2.connect (name));
+	ipc.stop ();
+}
+#endif
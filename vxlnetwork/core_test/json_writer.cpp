@@ -0,0 +1,143 @@
+#include <vxlnetwork/lib/json_writer.hpp>
+
+#include <gtest/gtest.h>
+
+#include <boost/property_tree/json_parser.hpp>
+
+#include <sstream>
+
+namespace
+{
+std::string write_json (boost::property_tree::ptree const & tree_a)
+{
+	std::stringstream stream;
+	boost::property_tree::write_json (stream, tree_a);
+	return stream.str ();
+}
+}
+
+TEST (json_writer, empty)
+{
+	vxlnetwork::json_writer writer;
+	ASSERT_TRUE (writer.empty ());
+	boost::property_tree::ptree tree;
+	ASSERT_EQ (write_json (tree), writer.finish ());
+	ASSERT_EQ (write_json (tree), vxlnetwork::json_writer::write (tree));
+}
+
+TEST (json_writer, values)
+{
+	boost::property_tree::ptree tree;
+	vxlnetwork::json_writer writer;
+	tree.put ("string", "value");
+	writer.put ("string", "value");
+	tree.put ("empty", "");
+	writer.put ("empty", "");
+	tree.put ("number", uint64_t{ 18446744073709551615ULL });
+	writer.put ("number", uint64_t{ 18446744073709551615ULL });
+	tree.put ("negative", -42);
+	writer.put ("negative", -42);
+	tree.put ("true", true);
+	writer.put ("true", true);
+	tree.put ("false", false);
+	writer.put ("false", false);
+	tree.put ("double", 0.1);
+	writer.put ("double", 0.1);
+	ASSERT_FALSE (writer.empty ());
+	auto expected (write_json (tree));
+	ASSERT_EQ (expected, writer.finish ());
+	ASSERT_EQ (expected, vxlnetwork::json_writer::write (tree));
+	// The writer starts a new document after finishing
+	ASSERT_TRUE (writer.empty ());
+}
+
+TEST (json_writer, escapes)
+{
+	std::string special ("\"quote\" back\\slash /slash \b\f\n\r\t \x01\x1f \x7f \xc3\xa9 \xff");
+	boost::property_tree::ptree tree;
+	tree.put (special, special);
+	vxlnetwork::json_writer writer;
+	writer.put (special, special);
+	auto expected (write_json (tree));
+	ASSERT_EQ (expected, writer.finish ());
+	ASSERT_EQ (expected, vxlnetwork::json_writer::write (tree));
+}
+
+TEST (json_writer, nested)
+{
+	boost::property_tree::ptree tree;
+	vxlnetwork::json_writer writer;
+	tree.put ("account", "vxl_1");
+	writer.put ("account", "vxl_1");
+
+	boost::property_tree::ptree history;
+	writer.begin_array ("history");
+	for (auto i (0); i < 3; ++i)
+	{
+		boost::property_tree::ptree entry;
+		entry.put ("height", i);
+		entry.put ("hash", std::to_string (i));
+		history.push_back (std::make_pair ("", entry));
+		if (i % 2 == 0)
+		{
+			writer.push_back_child (entry);
+		}
+		else
+		{
+			writer.begin_object ();
+			writer.put ("height", i);
+			writer.put ("hash", std::to_string (i));
+			writer.end_object ();
+		}
+	}
+	boost::property_tree::ptree values;
+	values.push_back (std::make_pair ("", boost::property_tree::ptree ("a")));
+	values.push_back (std::make_pair ("", boost::property_tree::ptree ("b")));
+	history.push_back (std::make_pair ("", values));
+	writer.begin_array ();
+	writer.push_back ("a");
+	writer.push_back ("b");
+	writer.end_array ();
+	tree.add_child ("history", history);
+	writer.end_array ();
+
+	boost::property_tree::ptree accounts;
+	writer.begin_object ("accounts");
+	boost::property_tree::ptree account;
+	account.put ("balance", "100");
+	accounts.add_child ("vxl_2", account);
+	writer.begin_object ("vxl_2");
+	writer.put ("balance", "100");
+	writer.end_object ();
+	tree.add_child ("accounts", accounts);
+	writer.end_object ();
+
+	tree.put ("previous", "0");
+	writer.put ("previous", "0");
+	auto expected (write_json (tree));
+	ASSERT_EQ (expected, writer.finish ());
+	ASSERT_EQ (expected, vxlnetwork::json_writer::write (tree));
+}
+
+// Objects and arrays without members are written like an empty ptree child, which is a "" value
+TEST (json_writer, empty_children)
+{
+	boost::property_tree::ptree tree;
+	vxlnetwork::json_writer writer;
+	tree.add_child ("blocks", boost::property_tree::ptree ());
+	writer.begin_object ("blocks");
+	writer.end_object ();
+	boost::property_tree::ptree list;
+	list.push_back (std::make_pair ("", boost::property_tree::ptree ()));
+	tree.add_child ("list", list);
+	writer.begin_array ("list");
+	writer.begin_array ();
+	writer.end_array ();
+	writer.end_array ();
+	tree.add_child ("history", boost::property_tree::ptree ());
+	writer.begin_array ("history");
+	writer.end_array ();
+	auto expected (write_json (tree));
+	ASSERT_EQ (expected, writer.finish ());
+	ASSERT_EQ (expected, vxlnetwork::json_writer::write (tree));
+}
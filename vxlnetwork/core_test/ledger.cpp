@@ -1,12 +1,15 @@
 #include <vxlnetwork/lib/stats.hpp>
 #include <vxlnetwork/lib/threading.hpp>
 #include <vxlnetwork/node/election.hpp>
+#include <vxlnetwork/node/ledger_export.hpp>
 #include <vxlnetwork/node/rocksdb/rocksdb.hpp>
 #include <vxlnetwork/test_common/system.hpp>
 #include <vxlnetwork/test_common/testutil.hpp>
 
 #include <gtest/gtest.h>
 
+#include <fstream>
+
 using namespace std::chrono_literals;
 
 // Init returns an error if it can't open files at the path
@@ -516,6 +519,86 @@ TEST (ledger, representation_changes)
 	ASSERT_EQ (2, rep_weights.representation_get (key1.pub));
 }
 
+TEST (ledger, representation_batch)
+{
+	vxlnetwork::keypair key1;
+	vxlnetwork::keypair key2;
+	vxlnetwork::rep_weights rep_weights;
+	rep_weights.representation_put (key1.pub, 10);
+	rep_weights.representation_add_batch ({ { key1.pub, 0 - vxlnetwork::uint128_t{ 4 } }, { key2.pub, 4 }, { key2.pub, 1 } });
+	ASSERT_EQ (6, rep_weights.representation_get (key1.pub));
+	ASSERT_EQ (5, rep_weights.representation_get (key2.pub));
+	ASSERT_EQ (2, rep_weights.size ());
+}
+
+// Weights stay readable through table growth and snapshots are sorted copies which don't follow later changes
+TEST (ledger, representation_snapshot)
+{
+	vxlnetwork::rep_weights rep_weights;
+	std::vector<vxlnetwork::account> representatives;
+	for (auto i (0); i < 1000; ++i)
+	{
+		representatives.push_back (vxlnetwork::keypair{}.pub);
+		rep_weights.representation_put (representatives.back (), i + 1);
+	}
+	ASSERT_EQ (1000, rep_weights.size ());
+	for (auto i (0); i < 1000; ++i)
+	{
+		ASSERT_EQ (i + 1, rep_weights.representation_get (representatives[i]));
+	}
+	auto snapshot (rep_weights.get_snapshot ());
+	rep_weights.representation_add (representatives[0], 100);
+	ASSERT_EQ (1000, snapshot.size ());
+	ASSERT_EQ (1, snapshot.get (representatives[0]));
+	ASSERT_EQ (101, rep_weights.representation_get (representatives[0]));
+	ASSERT_EQ (0, snapshot.get (vxlnetwork::keypair{}.pub));
+	ASSERT_TRUE (std::is_sorted (snapshot.begin (), snapshot.end (), [] (auto const & first_a, auto const & second_a) { return first_a.first < second_a.first; }));
+	ASSERT_EQ (rep_weights.get_rep_amounts ().size (), snapshot.size ());
+}
+
+// Readers running concurrently with the writer never observe a torn weight
+TEST (ledger, representation_concurrent)
+{
+	vxlnetwork::rep_weights rep_weights;
+	std::vector<vxlnetwork::account> representatives;
+	// Both halves of the 128 bit weight change on every update
+	vxlnetwork::uint128_t const low{ std::numeric_limits<uint64_t>::max () };
+	vxlnetwork::uint128_t const high{ vxlnetwork::uint128_t{ 1 } << 64 };
+	for (auto i (0); i < 100; ++i)
+	{
+		representatives.push_back (vxlnetwork::keypair{}.pub);
+		rep_weights.representation_put (representatives.back (), low);
+	}
+	std::atomic<bool> stop{ false };
+	std::atomic<unsigned> torn{ 0 };
+	std::vector<std::thread> readers;
+	for (auto i (0); i < 4; ++i)
+	{
+		readers.emplace_back ([&] () {
+			while (!stop)
+			{
+				for (auto const & representative : representatives)
+				{
+					auto weight (rep_weights.representation_get (representative));
+					torn += weight != low && weight != high;
+				}
+			}
+		});
+	}
+	for (auto i (0); i < 10000; ++i)
+	{
+		auto const & representative (representatives[i % representatives.size ()]);
+		rep_weights.representation_add (representative, high - low);
+		rep_weights.representation_add (representative, low - high);
+	}
+	stop = true;
+	for (auto & reader : readers)
+	{
+		reader.join ();
+	}
+	ASSERT_EQ (0, torn);
+}
+
 TEST (ledger, representation)
 {
 	vxlnetwork::logger_mt logger;
@@ -3215,6 +3298,193 @@ TEST (ledger, cache)
 	}
 }
 
+// Weights summed per key range while rebuilding the cache are merged into the same totals the ledger maintained incrementally
+TEST (ledger, cache_rebuild)
+{
+	vxlnetwork::logger_mt logger;
+	auto store = vxlnetwork::make_store (logger, vxlnetwork::unique_path (), vxlnetwork::dev::constants);
+	ASSERT_TRUE (!store->init_error ());
+	vxlnetwork::stat stats;
+	vxlnetwork::ledger ledger (*store, stats, vxlnetwork::dev::constants);
+	store->initialize (store->tx_begin_write (), ledger.cache);
+	vxlnetwork::work_pool pool{ vxlnetwork::dev::network_params.network, std::numeric_limits<unsigned>::max () };
+	std::vector<vxlnetwork::keypair> representatives (4);
+	auto latest (vxlnetwork::dev::genesis->hash ());
+	auto balance (vxlnetwork::dev::constants.genesis_amount);
+	{
+		auto transaction (store->tx_begin_write ());
+		for (auto i (0); i < 50; ++i)
+		{
+			vxlnetwork::keypair key;
+			balance -= i + 1;
+			vxlnetwork::state_block send (vxlnetwork::dev::genesis_key.pub, latest, vxlnetwork::dev::genesis_key.pub, balance, key.pub, vxlnetwork::dev::genesis_key.prv, vxlnetwork::dev::genesis_key.pub, *pool.generate (latest));
+			ASSERT_EQ (vxlnetwork::process_result::progress, ledger.process (transaction, send).code);
+			latest = send.hash ();
+			auto const & representative (representatives[i % representatives.size ()].pub);
+			vxlnetwork::state_block open (key.pub, 0, representative, i + 1, send.hash (), key.prv, key.pub, *pool.generate (key.pub));
+			ASSERT_EQ (vxlnetwork::process_result::progress, ledger.process (transaction, open).code);
+		}
+	}
+	vxlnetwork::ledger rebuilt (*store, stats, vxlnetwork::dev::constants);
+	ASSERT_EQ (ledger.cache.account_count, rebuilt.cache.account_count);
+	ASSERT_EQ (ledger.cache.block_count, rebuilt.cache.block_count);
+	auto expected (ledger.cache.rep_weights.get_snapshot ());
+	auto actual (rebuilt.cache.rep_weights.get_snapshot ());
+	ASSERT_TRUE (std::equal (expected.begin (), expected.end (), actual.begin (), actual.end ()));
+	std::vector<std::string> phases;
+	for (auto const & timing : rebuilt.initialize_timings)
+	{
+		phases.push_back (timing.first);
+	}
+	ASSERT_EQ ((std::vector<std::string>{ "accounts", "representative weights", "confirmation heights", "pruned" }), phases);
+}
+
+TEST (ledger, export_import)
+{
+	vxlnetwork::logger_mt logger;
+	auto store = vxlnetwork::make_store (logger, vxlnetwork::unique_path (), vxlnetwork::dev::constants);
+	ASSERT_TRUE (!store->init_error ());
+	vxlnetwork::stat stats;
+	vxlnetwork::ledger ledger (*store, stats, vxlnetwork::dev::constants);
+	store->initialize (store->tx_begin_write (), ledger.cache);
+	vxlnetwork::work_pool pool{ vxlnetwork::dev::network_params.network, std::numeric_limits<unsigned>::max () };
+	auto latest (vxlnetwork::dev::genesis->hash ());
+	auto balance (vxlnetwork::dev::constants.genesis_amount);
+	{
+		auto transaction (store->tx_begin_write ());
+		for (auto i (0); i < 20; ++i)
+		{
+			vxlnetwork::keypair key;
+			balance -= i + 1;
+			vxlnetwork::state_block send (vxlnetwork::dev::genesis_key.pub, latest, vxlnetwork::dev::genesis_key.pub, balance, key.pub, vxlnetwork::dev::genesis_key.prv, vxlnetwork::dev::genesis_key.pub, *pool.generate (latest));
+			ASSERT_EQ (vxlnetwork::process_result::progress, ledger.process (transaction, send).code);
+			latest = send.hash ();
+			// Every other send is left pending
+			if (i % 2 == 0)
+			{
+				vxlnetwork::state_block open (key.pub, 0, key.pub, i + 1, send.hash (), key.prv, key.pub, *pool.generate (key.pub));
+				ASSERT_EQ (vxlnetwork::process_result::progress, ledger.process (transaction, open).code);
+			}
+		}
+	}
+	auto path (vxlnetwork::unique_path ());
+	vxlnetwork::ledger_export exporter (*store, vxlnetwork::dev::constants);
+	ASSERT_FALSE (exporter.write (path, 4));
+	ASSERT_EQ (ledger.cache.block_count, exporter.entries[vxlnetwork::tables::blocks]);
+	ASSERT_EQ (ledger.cache.account_count, exporter.entries[vxlnetwork::tables::accounts]);
+	ASSERT_EQ (10, exporter.entries[vxlnetwork::tables::pending]);
+
+	auto imported_store = vxlnetwork::make_store (logger, vxlnetwork::unique_path (), vxlnetwork::dev::constants);
+	ASSERT_TRUE (!imported_store->init_error ());
+	vxlnetwork::ledger_export importer (*imported_store, vxlnetwork::dev::constants);
+	ASSERT_FALSE (importer.read (path, 4));
+	ASSERT_EQ (exporter.entries, importer.entries);
+	vxlnetwork::ledger imported (*imported_store, stats, vxlnetwork::dev::constants);
+	ASSERT_EQ (ledger.cache.block_count, imported.cache.block_count);
+	ASSERT_EQ (ledger.cache.account_count, imported.cache.account_count);
+	ASSERT_EQ (ledger.cache.cemented_count, imported.cache.cemented_count);
+	auto expected (ledger.cache.rep_weights.get_snapshot ());
+	auto actual (imported.cache.rep_weights.get_snapshot ());
+	ASSERT_TRUE (std::equal (expected.begin (), expected.end (), actual.begin (), actual.end ()));
+	auto transaction (imported_store->tx_begin_read ());
+	ASSERT_EQ (latest, imported.latest (transaction, vxlnetwork::dev::genesis_key.pub));
+	ASSERT_NE (nullptr, imported_store->block.get (transaction, latest));
+	size_t pending_count{ 0 };
+	for (auto i (imported_store->pending.begin (transaction)), n (imported_store->pending.end ()); i != n; ++i)
+	{
+		++pending_count;
+	}
+	ASSERT_EQ (10, pending_count);
+	// A second import is refused as the ledger is no longer empty
+	vxlnetwork::ledger_export again (*imported_store, vxlnetwork::dev::constants);
+	ASSERT_TRUE (again.read (path, 4));
+}
+
+TEST (ledger, export_import_corrupted)
+{
+	vxlnetwork::logger_mt logger;
+	auto store = vxlnetwork::make_store (logger, vxlnetwork::unique_path (), vxlnetwork::dev::constants);
+	ASSERT_TRUE (!store->init_error ());
+	vxlnetwork::stat stats;
+	vxlnetwork::ledger ledger (*store, stats, vxlnetwork::dev::constants);
+	store->initialize (store->tx_begin_write (), ledger.cache);
+	auto path (vxlnetwork::unique_path ());
+	ASSERT_FALSE (vxlnetwork::ledger_export (*store, vxlnetwork::dev::constants).write (path, 1));
+	std::vector<char> contents;
+	{
+		std::ifstream stream (path.string (), std::ios::binary);
+		contents.assign (std::istreambuf_iterator<char> (stream), std::istreambuf_iterator<char> ());
+	}
+	// Flip a byte in the first chunk payload, after the file header and chunk header
+	auto corrupted (contents);
+	corrupted[45 + 13 + 10] ^= 1;
+	{
+		std::ofstream stream (path.string (), std::ios::binary | std::ios::trunc);
+		stream.write (corrupted.data (), corrupted.size ());
+	}
+	auto imported_store = vxlnetwork::make_store (logger, vxlnetwork::unique_path (), vxlnetwork::dev::constants);
+	ASSERT_TRUE (!imported_store->init_error ());
+	vxlnetwork::ledger_export importer (*imported_store, vxlnetwork::dev::constants);
+	ASSERT_TRUE (importer.read (path, 2));
+	ASSERT_FALSE (importer.error_message.empty ());
+	// A truncated file misses its end record
+	{
+		std::ofstream stream (path.string (), std::ios::binary | std::ios::trunc);
+		stream.write (contents.data (), contents.size () - 1);
+	}
+	auto truncated_store = vxlnetwork::make_store (logger, vxlnetwork::unique_path (), vxlnetwork::dev::constants);
+	ASSERT_TRUE (!truncated_store->init_error ());
+	ASSERT_TRUE (vxlnetwork::ledger_export (*truncated_store, vxlnetwork::dev::constants).read (path, 2));
+}
+
+TEST (ledger, export_import_swap)
+{
+	vxlnetwork::logger_mt logger;
+	auto store = vxlnetwork::make_store (logger, vxlnetwork::unique_path (), vxlnetwork::dev::constants);
+	ASSERT_TRUE (!store->init_error ());
+	vxlnetwork::stat stats;
+	vxlnetwork::ledger ledger (*store, stats, vxlnetwork::dev::constants);
+	store->initialize (store->tx_begin_write (), ledger.cache);
+	auto path (vxlnetwork::unique_path ());
+	ASSERT_FALSE (vxlnetwork::ledger_export (*store, vxlnetwork::dev::constants).write (path, 1));
+	std::vector<char> contents;
+	{
+		std::ifstream stream (path.string (), std::ios::binary);
+		contents.assign (std::istreambuf_iterator<char> (stream), std::istreambuf_iterator<char> ());
+	}
+	auto truncated (vxlnetwork::unique_path ());
+	{
+		std::ofstream stream (truncated.string (), std::ios::binary | std::ios::trunc);
+		stream.write (contents.data (), contents.size () - 1);
+	}
+	auto data_path (vxlnetwork::unique_path ());
+	boost::filesystem::create_directories (data_path);
+	auto make_store = [&logger] (boost::filesystem::path const & path_a) {
+		return vxlnetwork::make_store (logger, path_a, vxlnetwork::dev::constants, false, true);
+	};
+	std::unordered_map<vxlnetwork::tables, uint64_t> entries;
+	std::string error_message;
+	// A failed import leaves the database in data_path empty and removes the temporary store
+	ASSERT_TRUE (vxlnetwork::ledger_export::import (data_path, truncated, 2, vxlnetwork::dev::constants, make_store, entries, error_message));
+	ASSERT_FALSE (error_message.empty ());
+	ASSERT_FALSE (boost::filesystem::exists (data_path / "ledger_import"));
+	{
+		auto imported_store (make_store (data_path));
+		ASSERT_TRUE (!imported_store->init_error ());
+		ASSERT_TRUE (vxlnetwork::ledger_export (*imported_store, vxlnetwork::dev::constants).empty ());
+	}
+	ASSERT_FALSE (vxlnetwork::ledger_export::import (data_path, path, 2, vxlnetwork::dev::constants, make_store, entries, error_message));
+	ASSERT_EQ (1, entries[vxlnetwork::tables::blocks]);
+	ASSERT_FALSE (boost::filesystem::exists (data_path / "ledger_import"));
+	{
+		auto imported_store (make_store (data_path));
+		ASSERT_TRUE (!imported_store->init_error ());
+		ASSERT_TRUE (imported_store->block.exists (imported_store->tx_begin_read (), vxlnetwork::dev::genesis->hash ()));
+	}
+	// The imported ledger is not replaced by a second import
+	ASSERT_TRUE (vxlnetwork::ledger_export::import (data_path, path, 2, vxlnetwork::dev::constants, make_store, entries, error_message));
+}
+
 TEST (ledger, pruning_action)
 {
 	vxlnetwork::logger_mt logger;
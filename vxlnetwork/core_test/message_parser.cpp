@@ -67,7 +67,7 @@ TEST (message_parser, exact_confirm_ack_size)
 	vxlnetwork::network_filter filter (1);
 	vxlnetwork::block_uniquer block_uniquer;
 	vxlnetwork::vote_uniquer vote_uniquer (block_uniquer);
-	vxlnetwork::message_parser parser (filter, block_uniquer, vote_uniquer, visitor, system.work, vxlnetwork::dev::network_params.network);
+	vxlnetwork::message_parser parser (filter, filter, block_uniquer, vote_uniquer, visitor, system.work, vxlnetwork::dev::network_params.network);
 	auto block (std::make_shared<vxlnetwork::send_block> (1, 1, 2, vxlnetwork::keypair ().prv, 4, *system.work.generate (vxlnetwork::root (1))));
 	auto vote (std::make_shared<vxlnetwork::vote> (0, vxlnetwork::keypair ().prv, 0, 0, std::move (block)));
 	vxlnetwork::confirm_ack message{ vxlnetwork::dev::network_params.network, vote };
@@ -94,6 +94,41 @@ TEST (message_parser, exact_confirm_ack_size)
 	ASSERT_NE (parser.status, vxlnetwork::message_parser::parse_status::success);
 }
 
+// A confirm_ack already seen is rejected from its wire bytes, without constructing the vote again
+TEST (message_parser, duplicate_confirm_ack)
+{
+	vxlnetwork::system system (1);
+	dev_visitor visitor;
+	vxlnetwork::network_filter publish_filter (1);
+	vxlnetwork::network_filter vote_filter (1);
+	vxlnetwork::block_uniquer block_uniquer;
+	vxlnetwork::vote_uniquer vote_uniquer (block_uniquer);
+	vxlnetwork::message_parser parser (publish_filter, vote_filter, block_uniquer, vote_uniquer, visitor, system.work, vxlnetwork::dev::network_params.network);
+	auto vote (std::make_shared<vxlnetwork::vote> (0, vxlnetwork::keypair ().prv, 0, 0, std::vector<vxlnetwork::block_hash>{ 1 }));
+	vxlnetwork::confirm_ack message{ vxlnetwork::dev::network_params.network, vote };
+	std::vector<uint8_t> bytes;
+	{
+		vxlnetwork::vectorstream stream (bytes);
+		message.serialize (stream);
+	}
+	parser.deserialize_buffer (bytes.data (), bytes.size ());
+	ASSERT_EQ (parser.status, vxlnetwork::message_parser::parse_status::success);
+	ASSERT_EQ (1, visitor.confirm_ack_count);
+	parser.deserialize_buffer (bytes.data (), bytes.size ());
+	ASSERT_EQ (parser.status, vxlnetwork::message_parser::parse_status::duplicate_confirm_ack_message);
+	ASSERT_EQ (1, visitor.confirm_ack_count);
+	// Once cleared, for instance after the vote processor dropped it, the same vote is accepted again
+	vote_filter.clear (bytes.data () + vxlnetwork::message_header::size, bytes.size () - vxlnetwork::message_header::size);
+	parser.deserialize_buffer (bytes.data (), bytes.size ());
+	ASSERT_EQ (parser.status, vxlnetwork::message_parser::parse_status::success);
+	ASSERT_EQ (2, visitor.confirm_ack_count);
+	// Duplicates are still delivered while exempt, as for a representative answering a rep crawler query
+	parser.vote_filter_exempt = [] () { return true; };
+	parser.deserialize_buffer (bytes.data (), bytes.size ());
+	ASSERT_EQ (parser.status, vxlnetwork::message_parser::parse_status::success);
+	ASSERT_EQ (3, visitor.confirm_ack_count);
+}
+
 TEST (message_parser, exact_confirm_req_size)
 {
 	vxlnetwork::system system (1);
@@ -101,7 +136,7 @@ TEST (message_parser, exact_confirm_req_size)
 	vxlnetwork::network_filter filter (1);
 	vxlnetwork::block_uniquer block_uniquer;
 	vxlnetwork::vote_uniquer vote_uniquer (block_uniquer);
-	vxlnetwork::message_parser parser (filter, block_uniquer, vote_uniquer, visitor, system.work, vxlnetwork::dev::network_params.network);
+	vxlnetwork::message_parser parser (filter, filter, block_uniquer, vote_uniquer, visitor, system.work, vxlnetwork::dev::network_params.network);
 	auto block (std::make_shared<vxlnetwork::send_block> (1, 1, 2, vxlnetwork::keypair ().prv, 4, *system.work.generate (vxlnetwork::root (1))));
 	vxlnetwork::confirm_req message{ vxlnetwork::dev::network_params.network, block };
 	std::vector<uint8_t> bytes;
@@ -134,7 +169,7 @@ TEST (message_parser, exact_confirm_req_hash_size)
 	vxlnetwork::network_filter filter (1);
 	vxlnetwork::block_uniquer block_uniquer;
 	vxlnetwork::vote_uniquer vote_uniquer (block_uniquer);
-	vxlnetwork::message_parser parser (filter, block_uniquer, vote_uniquer, visitor, system.work, vxlnetwork::dev::network_params.network);
+	vxlnetwork::message_parser parser (filter, filter, block_uniquer, vote_uniquer, visitor, system.work, vxlnetwork::dev::network_params.network);
 	vxlnetwork::send_block block (1, 1, 2, vxlnetwork::keypair ().prv, 4, *system.work.generate (vxlnetwork::root (1)));
 	vxlnetwork::confirm_req message{ vxlnetwork::dev::network_params.network, block.hash (), block.root () };
 	std::vector<uint8_t> bytes;
@@ -167,7 +202,7 @@ TEST (message_parser, exact_publish_size)
 	vxlnetwork::network_filter filter (1);
 	vxlnetwork::block_uniquer block_uniquer;
 	vxlnetwork::vote_uniquer vote_uniquer (block_uniquer);
-	vxlnetwork::message_parser parser (filter, block_uniquer, vote_uniquer, visitor, system.work, vxlnetwork::dev::network_params.network);
+	vxlnetwork::message_parser parser (filter, filter, block_uniquer, vote_uniquer, visitor, system.work, vxlnetwork::dev::network_params.network);
 	auto block (std::make_shared<vxlnetwork::send_block> (1, 1, 2, vxlnetwork::keypair ().prv, 4, *system.work.generate (vxlnetwork::root (1))));
 	vxlnetwork::publish message{ vxlnetwork::dev::network_params.network, block };
 	std::vector<uint8_t> bytes;
@@ -200,7 +235,7 @@ TEST (message_parser, exact_keepalive_size)
 	vxlnetwork::network_filter filter (1);
 	vxlnetwork::block_uniquer block_uniquer;
 	vxlnetwork::vote_uniquer vote_uniquer (block_uniquer);
-	vxlnetwork::message_parser parser (filter, block_uniquer, vote_uniquer, visitor, system.work, vxlnetwork::dev::network_params.network);
+	vxlnetwork::message_parser parser (filter, filter, block_uniquer, vote_uniquer, visitor, system.work, vxlnetwork::dev::network_params.network);
 	vxlnetwork::keepalive message{ vxlnetwork::dev::network_params.network };
 	std::vector<uint8_t> bytes;
 	{
@@ -1015,6 +1015,41 @@ TEST (network, duplicate_revert_publish)
 	ASSERT_FALSE (node.network.publish_filter.apply (bytes.data (), bytes.size ()));
 }
 
+TEST (network, vote_digests)
+{
+	vxlnetwork::network_filter filter (1024);
+	vxlnetwork::vote_digests digests (filter, 2, std::chrono::hours (1));
+	vxlnetwork::keypair key;
+	std::vector<std::vector<uint8_t>> bytes;
+	std::vector<vxlnetwork::uint128_t> digest;
+	for (uint64_t i (0); i < 3; ++i)
+	{
+		vxlnetwork::vote vote (key.pub, key.prv, i, 0, std::vector<vxlnetwork::block_hash> (1, i));
+		bytes.emplace_back ();
+		{
+			vxlnetwork::vectorstream stream (bytes.back ());
+			vote.serialize (stream);
+		}
+		digest.emplace_back ();
+		ASSERT_FALSE (filter.apply (bytes.back ().data (), bytes.back ().size (), &digest.back ()));
+		digests.add (digest.back (), vote);
+	}
+	// Only the two newest digests are kept, the oldest one is cleared from the filter
+	ASSERT_EQ (2, digests.size ());
+	ASSERT_FALSE (filter.apply (bytes[0].data (), bytes[0].size ()));
+	ASSERT_TRUE (filter.apply (bytes[1].data (), bytes[1].size ()));
+	ASSERT_TRUE (filter.apply (bytes[2].data (), bytes[2].size ()));
+	// Starting an election for a voted hash lets the same vote through again
+	digests.erase (1);
+	ASSERT_EQ (1, digests.size ());
+	ASSERT_FALSE (filter.apply (bytes[1].data (), bytes[1].size ()));
+	ASSERT_TRUE (filter.apply (bytes[2].data (), bytes[2].size ()));
+	// Expired digests are cleared
+	digests.purge (std::chrono::steady_clock::now () + 1s);
+	ASSERT_EQ (0, digests.size ());
+	ASSERT_FALSE (filter.apply (bytes[2].data (), bytes[2].size ()));
+}
+
 // The test must be completed in less than 1 second
 TEST (network, bandwidth_limiter)
 {
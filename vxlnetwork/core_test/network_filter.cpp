@@ -6,6 +6,8 @@
 
 #include <gtest/gtest.h>
 
+#include <thread>
+
 TEST (network_filter, unit)
 {
 	vxlnetwork::network_filter filter (1);
@@ -126,3 +128,52 @@ TEST (network_filter, optional_digest)
 	filter.clear (digest);
 	ASSERT_FALSE (filter.apply (bytes1.data (), bytes1.size ()));
 }
+
+TEST (network_filter, associative)
+{
+	vxlnetwork::network_filter filter (4, 4);
+	ASSERT_EQ (4, filter.size ());
+	std::vector<std::vector<uint8_t>> items{ { 1 }, { 2 }, { 3 }, { 4 }, { 5 } };
+	// A single bucket holds all four digests
+	for (auto i (0); i < 4; ++i)
+	{
+		ASSERT_FALSE (filter.apply (items[i].data (), items[i].size ()));
+	}
+	for (auto i (0); i < 4; ++i)
+	{
+		ASSERT_TRUE (filter.apply (items[i].data (), items[i].size ()));
+	}
+	ASSERT_EQ (0, filter.evictions ());
+	ASSERT_EQ (4, filter.duplicates ());
+	// The fifth digest replaces exactly one of them
+	ASSERT_FALSE (filter.apply (items[4].data (), items[4].size ()));
+	ASSERT_EQ (1, filter.evictions ());
+	ASSERT_TRUE (filter.apply (items[4].data (), items[4].size ()));
+}
+
+TEST (network_filter, concurrent)
+{
+	vxlnetwork::network_filter filter (64 * 1024);
+	std::vector<std::thread> threads;
+	std::atomic<unsigned> unique{ 0 };
+	for (auto t (0); t < 4; ++t)
+	{
+		threads.emplace_back ([&filter, &unique] () {
+			for (uint32_t i (0); i < 256; ++i)
+			{
+				if (!filter.apply (reinterpret_cast<uint8_t const *> (&i), sizeof (i)))
+				{
+					++unique;
+				}
+			}
+		});
+	}
+	for (auto & thread : threads)
+	{
+		thread.join ();
+	}
+	// Every digest fits, so each one is new for exactly one thread
+	ASSERT_EQ (0, filter.evictions ());
+	ASSERT_EQ (256, unique);
+	ASSERT_EQ (3 * 256, filter.duplicates ());
+}
@@ -450,13 +450,8 @@ TEST (node, search_receivable_confirmed)
 	}
 	system.wallet (0)->insert_adhoc (key2.prv);
 	ASSERT_FALSE (system.wallet (0)->search_receivable (system.wallet (0)->wallets.tx_begin_read ()));
-	{
-		vxlnetwork::lock_guard<vxlnetwork::mutex> guard (node->active.mutex);
-		auto existing1 (node->active.blocks.find (send1->hash ()));
-		ASSERT_EQ (node->active.blocks.end (), existing1);
-		auto existing2 (node->active.blocks.find (send2->hash ()));
-		ASSERT_EQ (node->active.blocks.end (), existing2);
-	}
+	ASSERT_FALSE (node->active.active (send1->hash ()));
+	ASSERT_FALSE (node->active.active (send2->hash ()));
 	ASSERT_TIMELY (10s, node->balance (key2.pub) == 2 * node->config.receive_minimum.number ());
 }
 
@@ -1662,11 +1657,7 @@ TEST (node, bootstrap_confirm_frontiers)
 		ASSERT_NO_ERROR (system0.poll ());
 		ASSERT_NO_ERROR (system1.poll ());
 	}
-	{
-		vxlnetwork::lock_guard<vxlnetwork::mutex> guard (node1->active.mutex);
-		auto existing1 (node1->active.blocks.find (send0->hash ()));
-		ASSERT_NE (node1->active.blocks.end (), existing1);
-	}
+	ASSERT_TRUE (node1->active.active (send0->hash ()));
 	// Wait for confirmation height update
 	system1.deadline_set (10s);
 	bool done (false);
@@ -2795,11 +2786,8 @@ TEST (node, epoch_conflict_confirm)
 	// Start elections for node0
 	vxlnetwork::blocks_confirm (*node0, { change, epoch_open });
 	ASSERT_EQ (2, node0->active.size ());
-	{
-		vxlnetwork::lock_guard<vxlnetwork::mutex> lock (node0->active.mutex);
-		ASSERT_TRUE (node0->active.blocks.find (change->hash ()) != node0->active.blocks.end ());
-		ASSERT_TRUE (node0->active.blocks.find (epoch_open->hash ()) != node0->active.blocks.end ());
-	}
+	ASSERT_TRUE (node0->active.active (change->hash ()));
+	ASSERT_TRUE (node0->active.active (epoch_open->hash ()));
 	system.wallet (1)->insert_adhoc (vxlnetwork::dev::genesis_key.prv);
 	ASSERT_TIMELY (5s, node0->active.election (change->qualified_root ()) == nullptr);
 	ASSERT_TIMELY (5s, node0->active.empty ());
@@ -3937,11 +3925,10 @@ TEST (node, dependency_graph)
 	ASSERT_NO_ERROR (system.poll_until_true (15s, [&] {
 		// Not many blocks should be active simultaneously
 		EXPECT_LT (node.active.size (), 6);
-		vxlnetwork::lock_guard<vxlnetwork::mutex> guard (node.active.mutex);
 
 		// Ensure that active blocks have their ancestors confirmed
 		auto error = std::any_of (dependency_graph.cbegin (), dependency_graph.cend (), [&] (auto entry) {
-			if (node.active.blocks.count (entry.first))
+			if (node.active.active (entry.first))
 			{
 				for (auto ancestor : entry.second)
 				{
@@ -0,0 +1,116 @@
+#include <vxlnetwork/lib/stats.hpp>
+#include <vxlnetwork/node/rpc_executor.hpp>
+#include <vxlnetwork/test_common/system.hpp>
+#include <vxlnetwork/test_common/testutil.hpp>
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <future>
+
+using namespace std::chrono_literals;
+
+TEST (rpc_executor, classify)
+{
+	ASSERT_EQ (vxlnetwork::rpc_cost::heavy, vxlnetwork::rpc_executor::classify ("ledger"));
+	ASSERT_EQ (vxlnetwork::rpc_cost::heavy, vxlnetwork::rpc_executor::classify ("wallet_history"));
+	ASSERT_EQ (vxlnetwork::rpc_cost::heavy, vxlnetwork::rpc_executor::classify ("delegators"));
+	ASSERT_EQ (vxlnetwork::rpc_cost::light, vxlnetwork::rpc_executor::classify ("account_balance"));
+	ASSERT_EQ (vxlnetwork::rpc_cost::light, vxlnetwork::rpc_executor::classify ("unknown_action"));
+}
+
+// A full heavy queue rejects further heavy requests straight away while light requests still execute
+TEST (rpc_executor, admission)
+{
+	vxlnetwork::system system;
+	vxlnetwork::rpc_executor_config config;
+	config[vxlnetwork::rpc_cost::heavy].threads = 1;
+	config[vxlnetwork::rpc_cost::heavy].max_queued = 1;
+	vxlnetwork::stat stats;
+	vxlnetwork::rpc_executor executor (config, stats);
+	std::promise<void> release;
+	auto released (release.get_future ().share ());
+	std::atomic<unsigned> executed{ 0 };
+	std::atomic<unsigned> rejected{ 0 };
+	auto blocking_task ([&executed, released] () {
+		released.wait ();
+		++executed;
+	});
+	auto reject ([&rejected] (std::string const &) {
+		++rejected;
+	});
+	executor.execute ("ledger", blocking_task, reject);
+	// Wait for the only heavy thread to pick up the first request, the second one stays queued
+	ASSERT_TIMELY (5s, executor.size () == 0);
+	executor.execute ("ledger", blocking_task, reject);
+	std::string error;
+	executor.execute ("ledger", [&executed] () { ++executed; }, [&error] (std::string const & error_a) { error = error_a; });
+	ASSERT_EQ ("RPC server busy, too many queued requests", error);
+	ASSERT_EQ (1, stats.count (vxlnetwork::stat::type::rpc, vxlnetwork::stat::detail::overflow));
+
+	std::promise<void> light_done;
+	executor.execute ("account_balance", [&light_done] () { light_done.set_value (); }, reject);
+	ASSERT_EQ (std::future_status::ready, light_done.get_future ().wait_for (5s));
+
+	release.set_value ();
+	ASSERT_TIMELY (5s, executor.actions ()["ledger"].executed == 2);
+	ASSERT_TIMELY (5s, executor.actions ()["account_balance"].executed == 1);
+	ASSERT_EQ (2, executed);
+	ASSERT_EQ (0, rejected);
+	ASSERT_EQ (1, executor.actions ()["ledger"].rejected);
+}
+
+TEST (rpc_executor, queue_timeout)
+{
+	vxlnetwork::rpc_executor_config config;
+	config[vxlnetwork::rpc_cost::light].threads = 1;
+	config[vxlnetwork::rpc_cost::light].queue_timeout = 10ms;
+	vxlnetwork::stat stats;
+	vxlnetwork::rpc_executor executor (config, stats);
+	std::promise<void> started;
+	std::promise<void> release;
+	std::atomic<bool> executed{ false };
+	executor.execute (
+	"version", [&started, future = release.get_future ().share ()] () { started.set_value (); future.wait (); }, [] (std::string const &) {});
+	started.get_future ().wait ();
+	executor.execute (
+	"version", [&executed] () { executed = true; }, [] (std::string const &) {});
+	std::promise<std::string> error;
+	executor.execute (
+	"version", [] () {}, [&error] (std::string const & error_a) { error.set_value (error_a); });
+	std::this_thread::sleep_for (50ms);
+	release.set_value ();
+	auto error_future (error.get_future ());
+	ASSERT_EQ (std::future_status::ready, error_future.wait_for (5s));
+	ASSERT_EQ ("RPC server busy, request timed out in queue", error_future.get ());
+	ASSERT_FALSE (executed);
+	ASSERT_EQ (2, stats.count (vxlnetwork::stat::type::rpc, vxlnetwork::stat::detail::queue_timeout));
+}
+
+// Requests still queued when the executor stops are rejected
+TEST (rpc_executor, stop)
+{
+	vxlnetwork::system system;
+	vxlnetwork::rpc_executor_config config;
+	config[vxlnetwork::rpc_cost::light].threads = 1;
+	vxlnetwork::stat stats;
+	vxlnetwork::rpc_executor executor (config, stats);
+	std::promise<void> started;
+	std::promise<void> release;
+	executor.execute (
+	"version", [&started, future = release.get_future ().share ()] () { started.set_value (); future.wait (); }, [] (std::string const &) {});
+	started.get_future ().wait ();
+	std::string error;
+	executor.execute (
+	"version", [] () {}, [&error] (std::string const & error_a) { error = error_a; });
+	std::thread stopper ([&executor] () { executor.stop (); });
+	// The queued request is taken out of the queue once stop begins, it waits for the executing one
+	ASSERT_TIMELY (5s, executor.size () == 0);
+	release.set_value ();
+	stopper.join ();
+	ASSERT_EQ ("Node is stopping", error);
+	std::string after_stop;
+	executor.execute (
+	"version", [] () {}, [&after_stop] (std::string const & error_a) { after_stop = error_a; });
+	ASSERT_EQ ("Node is stopping", after_stop);
+}
@@ -9,6 +9,7 @@
 
 #include <boost/asio/read.hpp>
 
+#include <cstring>
 #include <map>
 #include <memory>
 #include <utility>
@@ -608,6 +609,214 @@ TEST (socket, concurrent_writes)
 	}
 }
 
+/**
+ * Queue many writes at once so they are gathered into vectored writes, and check that the peer receives
+ * every message intact and in order and that each write callback reports the size of its own buffer
+ */
+TEST (socket, coalesced_writes)
+{
+	auto node_flags = vxlnetwork::inactive_node_flag_defaults ();
+	node_flags.read_only = false;
+	vxlnetwork::inactive_node inactivenode (vxlnetwork::unique_path (), node_flags);
+	auto node = inactivenode.node;
+
+	vxlnetwork::thread_runner runner (node->io_ctx, 1);
+
+	constexpr uint32_t message_count = 200;
+	auto server_port (vxlnetwork::get_available_port ());
+	boost::asio::ip::tcp::endpoint endpoint (boost::asio::ip::address_v6::any (), server_port);
+	auto server_socket = std::make_shared<vxlnetwork::server_socket> (*node, endpoint, 1);
+	boost::system::error_code ec;
+	server_socket->start (ec);
+	ASSERT_FALSE (ec);
+
+	auto received (std::make_shared<std::vector<uint8_t>> (message_count * sizeof (uint32_t)));
+	vxlnetwork::util::counted_completion read_completion (1);
+	std::shared_ptr<vxlnetwork::socket> connection;
+	server_socket->on_connection ([&connection, &read_completion, received] (std::shared_ptr<vxlnetwork::socket> const & new_connection, boost::system::error_code const & ec_a) {
+		connection = new_connection;
+		new_connection->async_read (received, received->size (), [&read_completion] (boost::system::error_code const & ec, size_t size_a) {
+			if (!ec)
+			{
+				read_completion.increment ();
+			}
+		});
+		return true;
+	});
+
+	auto client = std::make_shared<vxlnetwork::client_socket> (*node);
+	vxlnetwork::util::counted_completion write_completion (message_count);
+	std::atomic<uint32_t> size_mismatches{ 0 };
+	client->async_connect (boost::asio::ip::tcp::endpoint (boost::asio::ip::address_v6::loopback (), server_socket->listening_port ()),
+	[client, &write_completion, &size_mismatches] (boost::system::error_code const & ec_a) {
+		ASSERT_FALSE (ec_a);
+		for (uint32_t i = 0; i < message_count; ++i)
+		{
+			std::vector<uint8_t> buff (reinterpret_cast<uint8_t const *> (&i), reinterpret_cast<uint8_t const *> (&i) + sizeof (i));
+			client->async_write (vxlnetwork::shared_const_buffer (std::move (buff)), [&write_completion, &size_mismatches] (boost::system::error_code const & ec, size_t size_a) {
+				if (ec || size_a != sizeof (uint32_t))
+				{
+					++size_mismatches;
+				}
+				write_completion.increment ();
+			});
+		}
+	});
+	ASSERT_FALSE (write_completion.await_count_for (10s));
+	ASSERT_EQ (0, size_mismatches);
+	ASSERT_FALSE (read_completion.await_count_for (10s));
+
+	for (uint32_t i = 0; i < message_count; ++i)
+	{
+		uint32_t value;
+		std::memcpy (&value, received->data () + i * sizeof (uint32_t), sizeof (value));
+		ASSERT_EQ (i, value);
+	}
+	// Writes queued while the first one was in flight are sent together
+	ASSERT_LT (0, node->stats.count (vxlnetwork::stat::type::tcp, vxlnetwork::stat::detail::tcp_write_coalesced, vxlnetwork::stat::dir::out));
+	ASSERT_EQ (message_count * sizeof (uint32_t), node->stats.count (vxlnetwork::stat::type::traffic_tcp, vxlnetwork::stat::dir::out));
+	ASSERT_FALSE (client->max ());
+
+	node->stop ();
+	runner.stop_event_processing ();
+	runner.join ();
+}
+
+TEST (socket, traffic_class_priority)
+{
+	auto node_flags = vxlnetwork::inactive_node_flag_defaults ();
+	node_flags.read_only = false;
+	vxlnetwork::inactive_node inactivenode (vxlnetwork::unique_path (), node_flags);
+	auto node = inactivenode.node;
+	// Gather all writes into the first batch so the scheduler decides the order
+	node->config.tcp_write_coalesce_delay = std::chrono::milliseconds (200);
+
+	vxlnetwork::thread_runner runner (node->io_ctx, 1);
+
+	constexpr uint32_t generic_count = 20;
+	constexpr std::size_t message_size = 400;
+	auto server_port (vxlnetwork::get_available_port ());
+	boost::asio::ip::tcp::endpoint endpoint (boost::asio::ip::address_v6::any (), server_port);
+	auto server_socket = std::make_shared<vxlnetwork::server_socket> (*node, endpoint, 1);
+	boost::system::error_code ec;
+	server_socket->start (ec);
+	ASSERT_FALSE (ec);
+
+	auto received (std::make_shared<std::vector<uint8_t>> ((generic_count + 1) * message_size));
+	vxlnetwork::util::counted_completion read_completion (1);
+	std::shared_ptr<vxlnetwork::socket> connection;
+	server_socket->on_connection ([&connection, &read_completion, received] (std::shared_ptr<vxlnetwork::socket> const & new_connection, boost::system::error_code const & ec_a) {
+		connection = new_connection;
+		new_connection->async_read (received, received->size (), [&read_completion] (boost::system::error_code const & ec, size_t size_a) {
+			if (!ec)
+			{
+				read_completion.increment ();
+			}
+		});
+		return true;
+	});
+
+	auto message = [] (uint32_t value_a) {
+		std::vector<uint8_t> buff (message_size, 0);
+		std::memcpy (buff.data (), &value_a, sizeof (value_a));
+		return vxlnetwork::shared_const_buffer (std::move (buff));
+	};
+	auto client = std::make_shared<vxlnetwork::client_socket> (*node);
+	vxlnetwork::util::counted_completion write_completion (generic_count + 1);
+	client->async_connect (boost::asio::ip::tcp::endpoint (boost::asio::ip::address_v6::loopback (), server_socket->listening_port ()),
+	[client, &write_completion, &message] (boost::system::error_code const & ec_a) {
+		ASSERT_FALSE (ec_a);
+		auto callback = [&write_completion] (boost::system::error_code const & ec, size_t size_a) {
+			write_completion.increment ();
+		};
+		for (uint32_t i = 0; i < generic_count; ++i)
+		{
+			client->async_write (message (i), callback, vxlnetwork::traffic_class::generic);
+		}
+		ASSERT_EQ (static_cast<std::size_t> (generic_count), client->queued (vxlnetwork::traffic_class::generic));
+		client->async_write (message (generic_count), callback, vxlnetwork::traffic_class::vote);
+	});
+	ASSERT_FALSE (write_completion.await_count_for (10s));
+	ASSERT_FALSE (read_completion.await_count_for (10s));
+
+	// The vote queued last is written first, generic messages keep their relative order
+	auto value_at = [&received] (std::size_t index_a) {
+		uint32_t value;
+		std::memcpy (&value, received->data () + index_a * message_size, sizeof (value));
+		return value;
+	};
+	ASSERT_EQ (generic_count, value_at (0));
+	for (uint32_t i = 0; i < generic_count; ++i)
+	{
+		ASSERT_EQ (i, value_at (i + 1));
+	}
+	ASSERT_EQ (0, client->queued (vxlnetwork::traffic_class::generic));
+	ASSERT_EQ (0, client->queued (vxlnetwork::traffic_class::vote));
+
+	node->stop ();
+	runner.stop_event_processing ();
+	runner.join ();
+}
+
+TEST (socket, io_shards)
+{
+	vxlnetwork::system system;
+	vxlnetwork::node_config config (vxlnetwork::get_available_port (), system.logging);
+	config.io_shards = 2;
+	vxlnetwork::node_flags flags;
+	flags.disable_tcp_realtime = true;
+	flags.disable_bootstrap_listener = true;
+	auto node = system.add_node (config, flags);
+	ASSERT_EQ (2, node->io_shards.size ());
+	ASSERT_EQ (0, node->io_shards.socket_count (0) + node->io_shards.socket_count (1));
+
+	// Client sockets are counted in the least loaded shard when created
+	auto client = std::make_shared<vxlnetwork::client_socket> (*node);
+	ASSERT_EQ (1, node->io_shards.socket_count (0));
+	ASSERT_EQ (0, node->io_shards.socket_count (1));
+
+	auto server_port (vxlnetwork::get_available_port ());
+	boost::asio::ip::tcp::endpoint endpoint (boost::asio::ip::address_v6::any (), server_port);
+	auto server_socket = std::make_shared<vxlnetwork::server_socket> (*node, endpoint, 1);
+	boost::system::error_code ec;
+	server_socket->start (ec);
+	ASSERT_FALSE (ec);
+
+	auto received (std::make_shared<std::vector<uint8_t>> (4));
+	std::atomic<bool> read_done{ false };
+	std::shared_ptr<vxlnetwork::socket> connection;
+	server_socket->on_connection ([&connection, &read_done, received] (std::shared_ptr<vxlnetwork::socket> const & new_connection, boost::system::error_code const & ec_a) {
+		connection = new_connection;
+		new_connection->async_read (received, received->size (), [&read_done] (boost::system::error_code const & ec, size_t size_a) {
+			read_done = !ec && size_a == 4;
+		});
+		return true;
+	});
+	// Neither the listening socket nor the connection waiting to be accepted are counted
+	ASSERT_EQ (1, node->io_shards.socket_count (0) + node->io_shards.socket_count (1));
+
+	std::atomic<bool> write_done{ false };
+	client->async_connect (boost::asio::ip::tcp::endpoint (boost::asio::ip::address_v6::loopback (), server_socket->listening_port ()),
+	[client, &write_done] (boost::system::error_code const & ec_a) {
+		ASSERT_FALSE (ec_a);
+		client->async_write (vxlnetwork::shared_const_buffer (std::vector<uint8_t>{ 1, 2, 3, 4 }), [&write_done] (boost::system::error_code const & ec, size_t size_a) {
+			write_done = !ec && size_a == 4;
+		});
+	});
+	ASSERT_TIMELY (5s, write_done && read_done);
+	ASSERT_EQ ((std::vector<uint8_t>{ 1, 2, 3, 4 }), *received);
+	// The accepted connection went to the other shard
+	ASSERT_EQ (1, node->io_shards.socket_count (0));
+	ASSERT_EQ (1, node->io_shards.socket_count (1));
+
+	server_socket->close ();
+	client->close ();
+	connection->close ();
+	client.reset ();
+	connection.reset ();
+	ASSERT_TIMELY (5s, node->io_shards.socket_count (0) + node->io_shards.socket_count (1) == 0);
+}
+
 /**
  * Check that the socket correctly handles a tcp_io_timeout during tcp connect
  * Steps:
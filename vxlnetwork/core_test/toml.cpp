@@ -118,6 +118,7 @@ TEST (toml, daemon_config_deserialize_defaults)
 	[node.diagnostics.txn_tracking]
 	[node.httpcallback]
 	[node.ipc.local]
+	[node.ipc.shared_memory]
 	[node.ipc.tcp]
 	[node.logging]
 	[node.statistics.log]
@@ -152,6 +153,7 @@ TEST (toml, daemon_config_deserialize_defaults)
 	ASSERT_EQ (conf.node.backup_before_upgrade, defaults.node.backup_before_upgrade);
 	ASSERT_EQ (conf.node.bandwidth_limit, defaults.node.bandwidth_limit);
 	ASSERT_EQ (conf.node.bandwidth_limit_burst_ratio, defaults.node.bandwidth_limit_burst_ratio);
+	ASSERT_EQ (conf.node.block_cache_max_size, defaults.node.block_cache_max_size);
 	ASSERT_EQ (conf.node.block_processor_batch_max_time, defaults.node.block_processor_batch_max_time);
 	ASSERT_EQ (conf.node.bootstrap_connections, defaults.node.bootstrap_connections);
 	ASSERT_EQ (conf.node.bootstrap_connections_max, defaults.node.bootstrap_connections_max);
@@ -159,11 +161,13 @@ TEST (toml, daemon_config_deserialize_defaults)
 	ASSERT_EQ (conf.node.bootstrap_frontier_request_count, defaults.node.bootstrap_frontier_request_count);
 	ASSERT_EQ (conf.node.bootstrap_fraction_numerator, defaults.node.bootstrap_fraction_numerator);
 	ASSERT_EQ (conf.node.conf_height_processor_batch_min_time, defaults.node.conf_height_processor_batch_min_time);
+	ASSERT_EQ (conf.node.conf_height_processor_threads, defaults.node.conf_height_processor_threads);
 	ASSERT_EQ (conf.node.confirmation_history_size, defaults.node.confirmation_history_size);
 	ASSERT_EQ (conf.node.enable_voting, defaults.node.enable_voting);
 	ASSERT_EQ (conf.node.external_address, defaults.node.external_address);
 	ASSERT_EQ (conf.node.external_port, defaults.node.external_port);
 	ASSERT_EQ (conf.node.io_threads, defaults.node.io_threads);
+	ASSERT_EQ (conf.node.io_shards, defaults.node.io_shards);
 	ASSERT_EQ (conf.node.max_work_generate_multiplier, defaults.node.max_work_generate_multiplier);
 	ASSERT_EQ (conf.node.network_threads, defaults.node.network_threads);
 	ASSERT_EQ (conf.node.secondary_work_peers, defaults.node.secondary_work_peers);
@@ -177,8 +181,11 @@ TEST (toml, daemon_config_deserialize_defaults)
 	ASSERT_EQ (conf.node.preconfigured_representatives, defaults.node.preconfigured_representatives);
 	ASSERT_EQ (conf.node.receive_minimum, defaults.node.receive_minimum);
 	ASSERT_EQ (conf.node.signature_checker_threads, defaults.node.signature_checker_threads);
+	ASSERT_EQ (conf.node.vote_processor_threads, defaults.node.vote_processor_threads);
 	ASSERT_EQ (conf.node.tcp_incoming_connections_max, defaults.node.tcp_incoming_connections_max);
 	ASSERT_EQ (conf.node.tcp_io_timeout, defaults.node.tcp_io_timeout);
+	ASSERT_EQ (conf.node.tcp_write_coalesce_max_bytes, defaults.node.tcp_write_coalesce_max_bytes);
+	ASSERT_EQ (conf.node.tcp_write_coalesce_delay, defaults.node.tcp_write_coalesce_delay);
 	ASSERT_EQ (conf.node.unchecked_cutoff_time, defaults.node.unchecked_cutoff_time);
 	ASSERT_EQ (conf.node.use_memory_pools, defaults.node.use_memory_pools);
 	ASSERT_EQ (conf.node.vote_generator_delay, defaults.node.vote_generator_delay);
@@ -188,6 +195,8 @@ TEST (toml, daemon_config_deserialize_defaults)
 	ASSERT_EQ (conf.node.work_threads, defaults.node.work_threads);
 	ASSERT_EQ (conf.node.max_queued_requests, defaults.node.max_queued_requests);
 	ASSERT_EQ (conf.node.confirm_req_batches_max, defaults.node.confirm_req_batches_max);
+	ASSERT_EQ (conf.node.network_filter_size, defaults.node.network_filter_size);
+	ASSERT_EQ (conf.node.network_filter_ways, defaults.node.network_filter_ways);
 
 	ASSERT_EQ (conf.node.logging.bulk_pull_logging_value, defaults.node.logging.bulk_pull_logging_value);
 	ASSERT_EQ (conf.node.logging.flush, defaults.node.logging.flush);
@@ -221,6 +230,7 @@ TEST (toml, daemon_config_deserialize_defaults)
 	ASSERT_EQ (conf.node.websocket_config.enabled, defaults.node.websocket_config.enabled);
 	ASSERT_EQ (conf.node.websocket_config.address, defaults.node.websocket_config.address);
 	ASSERT_EQ (conf.node.websocket_config.port, defaults.node.websocket_config.port);
+	ASSERT_EQ (conf.node.websocket_config.max_queued_bytes, defaults.node.websocket_config.max_queued_bytes);
 
 	ASSERT_EQ (conf.node.callback_address, defaults.node.callback_address);
 	ASSERT_EQ (conf.node.callback_port, defaults.node.callback_port);
@@ -235,6 +245,11 @@ TEST (toml, daemon_config_deserialize_defaults)
 	ASSERT_EQ (conf.node.ipc_config.transport_tcp.io_timeout, defaults.node.ipc_config.transport_tcp.io_timeout);
 	ASSERT_EQ (conf.node.ipc_config.transport_tcp.io_threads, defaults.node.ipc_config.transport_tcp.io_threads);
 	ASSERT_EQ (conf.node.ipc_config.transport_tcp.port, defaults.node.ipc_config.transport_tcp.port);
+	ASSERT_EQ (conf.node.ipc_config.transport_shared_memory.enabled, defaults.node.ipc_config.transport_shared_memory.enabled);
+	ASSERT_EQ (conf.node.ipc_config.transport_shared_memory.name, defaults.node.ipc_config.transport_shared_memory.name);
+	ASSERT_EQ (conf.node.ipc_config.transport_shared_memory.channels, defaults.node.ipc_config.transport_shared_memory.channels);
+	ASSERT_EQ (conf.node.ipc_config.transport_shared_memory.ring_size, defaults.node.ipc_config.transport_shared_memory.ring_size);
+	ASSERT_EQ (conf.node.ipc_config.transport_shared_memory.io_timeout, defaults.node.ipc_config.transport_shared_memory.io_timeout);
 	ASSERT_EQ (conf.node.ipc_config.flatbuffers.skip_unexpected_fields_in_json, defaults.node.ipc_config.flatbuffers.skip_unexpected_fields_in_json);
 	ASSERT_EQ (conf.node.ipc_config.flatbuffers.verify_buffers, defaults.node.ipc_config.flatbuffers.verify_buffers);
 
@@ -256,10 +271,21 @@ TEST (toml, daemon_config_deserialize_defaults)
 	ASSERT_EQ (conf.node.lmdb_config.sync, defaults.node.lmdb_config.sync);
 	ASSERT_EQ (conf.node.lmdb_config.max_databases, defaults.node.lmdb_config.max_databases);
 	ASSERT_EQ (conf.node.lmdb_config.map_size, defaults.node.lmdb_config.map_size);
+	ASSERT_EQ (conf.node.lmdb_config.compaction, defaults.node.lmdb_config.compaction);
+	ASSERT_EQ (conf.node.lmdb_config.compaction_threshold, defaults.node.lmdb_config.compaction_threshold);
+	ASSERT_EQ (conf.node.lmdb_config.compaction_rate_limit, defaults.node.lmdb_config.compaction_rate_limit);
+
+	ASSERT_EQ (conf.node.traffic[vxlnetwork::traffic_class::vote].weight, defaults.node.traffic[vxlnetwork::traffic_class::vote].weight);
+	ASSERT_EQ (conf.node.traffic[vxlnetwork::traffic_class::vote].drop_policy, defaults.node.traffic[vxlnetwork::traffic_class::vote].drop_policy);
+	ASSERT_EQ (conf.node.traffic[vxlnetwork::traffic_class::vote].queue_max, defaults.node.traffic[vxlnetwork::traffic_class::vote].queue_max);
+	ASSERT_EQ (conf.node.rpc_execution[vxlnetwork::rpc_cost::heavy].threads, defaults.node.rpc_execution[vxlnetwork::rpc_cost::heavy].threads);
+	ASSERT_EQ (conf.node.rpc_execution[vxlnetwork::rpc_cost::heavy].max_queued, defaults.node.rpc_execution[vxlnetwork::rpc_cost::heavy].max_queued);
+	ASSERT_EQ (conf.node.rpc_execution[vxlnetwork::rpc_cost::heavy].queue_timeout, defaults.node.rpc_execution[vxlnetwork::rpc_cost::heavy].queue_timeout);
 
 	ASSERT_EQ (conf.node.rocksdb_config.enable, defaults.node.rocksdb_config.enable);
 	ASSERT_EQ (conf.node.rocksdb_config.memory_multiplier, defaults.node.rocksdb_config.memory_multiplier);
 	ASSERT_EQ (conf.node.rocksdb_config.io_threads, defaults.node.rocksdb_config.io_threads);
+	ASSERT_EQ (conf.node.rocksdb_config.block_cache, defaults.node.rocksdb_config.block_cache);
 }
 
 TEST (toml, optional_child)
@@ -394,6 +420,7 @@ TEST (toml, daemon_config_deserialize_no_defaults)
 	backup_before_upgrade = true
 	bandwidth_limit = 999
 	bandwidth_limit_burst_ratio = 999.9
+	block_cache_max_size = 999
 	block_processor_batch_max_time = 999
 	bootstrap_connections = 999
 	bootstrap_connections_max = 999
@@ -401,11 +428,13 @@ TEST (toml, daemon_config_deserialize_no_defaults)
 	bootstrap_frontier_request_count = 9999
 	bootstrap_fraction_numerator = 999
 	conf_height_processor_batch_min_time = 999
+	conf_height_processor_threads = 999
 	confirmation_history_size = 999
 	enable_voting = false
 	external_address = "0:0:0:0:0:ffff:7f01:101"
 	external_port = 999
 	io_threads = 999
+	io_shards = 999
 	lmdb_max_dbs = 999
 	network_threads = 999
 	online_weight_minimum = "999"
@@ -418,8 +447,11 @@ TEST (toml, daemon_config_deserialize_no_defaults)
 	preconfigured_representatives = ["vxlc_3arg3asgtigae3xckabaaewkx3bzsh7nwz7jkmjos79ihyaxwphhm6qgjps4"]
 	receive_minimum = "999"
 	signature_checker_threads = 999
+	vote_processor_threads = 999
 	tcp_incoming_connections_max = 999
 	tcp_io_timeout = 999
+	tcp_write_coalesce_max_bytes = 999
+	tcp_write_coalesce_delay = 999
 	unchecked_cutoff_time = 999
 	use_memory_pools = false
 	vote_generator_delay = 999
@@ -429,6 +461,8 @@ TEST (toml, daemon_config_deserialize_no_defaults)
 	work_threads = 999
 	max_work_generate_multiplier = 1.0
 	max_queued_requests = 999
+	network_filter_size = 999
+	network_filter_ways = 2
 	frontiers_confirmation = "always"
 	[node.diagnostics.txn_tracking]
 	enable = true
@@ -448,6 +482,13 @@ TEST (toml, daemon_config_deserialize_no_defaults)
 	io_threads = 999
 	path = "/tmp/dev"
 
+	[node.ipc.shared_memory]
+	channels = 999
+	enable = true
+	io_timeout = 999
+	name = "/dev"
+	ring_size = 999
+
 	[node.ipc.tcp]
 	enable = true
 	io_timeout = 999
@@ -504,17 +545,32 @@ TEST (toml, daemon_config_deserialize_no_defaults)
 	[node.websocket]
 	address = "0:0:0:0:0:ffff:7f01:101"
 	enable = true
+	max_queued_bytes = 999
 	port = 999
 
 	[node.lmdb]
 	sync = "nosync_safe"
 	max_databases = 999
 	map_size = 999
+	compaction = true
+	compaction_threshold = 99
+	compaction_rate_limit = 999
+
+	[node.traffic.vote]
+	weight = 999
+	drop_policy = "no_socket_drop"
+	queue_max = 999
+
+	[node.rpc_execution.heavy]
+	threads = 999
+	max_queued = 999
+	queue_timeout = 999
 
 	[node.rocksdb]
 	enable = true
 	memory_multiplier = 3
 	io_threads = 99
+	block_cache = 999
 
 	[node.experimental]
 	secondary_work_peers = ["dev.org:998"]
@@ -558,6 +614,7 @@ TEST (toml, daemon_config_deserialize_no_defaults)
 	ASSERT_NE (conf.node.backup_before_upgrade, defaults.node.backup_before_upgrade);
 	ASSERT_NE (conf.node.bandwidth_limit, defaults.node.bandwidth_limit);
 	ASSERT_NE (conf.node.bandwidth_limit_burst_ratio, defaults.node.bandwidth_limit_burst_ratio);
+	ASSERT_NE (conf.node.block_cache_max_size, defaults.node.block_cache_max_size);
 	ASSERT_NE (conf.node.block_processor_batch_max_time, defaults.node.block_processor_batch_max_time);
 	ASSERT_NE (conf.node.bootstrap_connections, defaults.node.bootstrap_connections);
 	ASSERT_NE (conf.node.bootstrap_connections_max, defaults.node.bootstrap_connections_max);
@@ -565,11 +622,13 @@ TEST (toml, daemon_config_deserialize_no_defaults)
 	ASSERT_NE (conf.node.bootstrap_frontier_request_count, defaults.node.bootstrap_frontier_request_count);
 	ASSERT_NE (conf.node.bootstrap_fraction_numerator, defaults.node.bootstrap_fraction_numerator);
 	ASSERT_NE (conf.node.conf_height_processor_batch_min_time, defaults.node.conf_height_processor_batch_min_time);
+	ASSERT_NE (conf.node.conf_height_processor_threads, defaults.node.conf_height_processor_threads);
 	ASSERT_NE (conf.node.confirmation_history_size, defaults.node.confirmation_history_size);
 	ASSERT_NE (conf.node.enable_voting, defaults.node.enable_voting);
 	ASSERT_NE (conf.node.external_address, defaults.node.external_address);
 	ASSERT_NE (conf.node.external_port, defaults.node.external_port);
 	ASSERT_NE (conf.node.io_threads, defaults.node.io_threads);
+	ASSERT_NE (conf.node.io_shards, defaults.node.io_shards);
 	ASSERT_NE (conf.node.max_work_generate_multiplier, defaults.node.max_work_generate_multiplier);
 	ASSERT_NE (conf.node.frontiers_confirmation, defaults.node.frontiers_confirmation);
 	ASSERT_NE (conf.node.network_threads, defaults.node.network_threads);
@@ -586,8 +645,11 @@ TEST (toml, daemon_config_deserialize_no_defaults)
 	ASSERT_NE (conf.node.preconfigured_representatives, defaults.node.preconfigured_representatives);
 	ASSERT_NE (conf.node.receive_minimum, defaults.node.receive_minimum);
 	ASSERT_NE (conf.node.signature_checker_threads, defaults.node.signature_checker_threads);
+	ASSERT_NE (conf.node.vote_processor_threads, defaults.node.vote_processor_threads);
 	ASSERT_NE (conf.node.tcp_incoming_connections_max, defaults.node.tcp_incoming_connections_max);
 	ASSERT_NE (conf.node.tcp_io_timeout, defaults.node.tcp_io_timeout);
+	ASSERT_NE (conf.node.tcp_write_coalesce_max_bytes, defaults.node.tcp_write_coalesce_max_bytes);
+	ASSERT_NE (conf.node.tcp_write_coalesce_delay, defaults.node.tcp_write_coalesce_delay);
 	ASSERT_NE (conf.node.unchecked_cutoff_time, defaults.node.unchecked_cutoff_time);
 	ASSERT_NE (conf.node.use_memory_pools, defaults.node.use_memory_pools);
 	ASSERT_NE (conf.node.vote_generator_delay, defaults.node.vote_generator_delay);
@@ -597,6 +659,8 @@ TEST (toml, daemon_config_deserialize_no_defaults)
 	ASSERT_NE (conf.node.work_threads, defaults.node.work_threads);
 	ASSERT_NE (conf.node.max_queued_requests, defaults.node.max_queued_requests);
 	ASSERT_EQ (conf.node.confirm_req_batches_max, defaults.node.confirm_req_batches_max);
+	ASSERT_NE (conf.node.network_filter_size, defaults.node.network_filter_size);
+	ASSERT_NE (conf.node.network_filter_ways, defaults.node.network_filter_ways);
 
 	ASSERT_NE (conf.node.logging.bulk_pull_logging_value, defaults.node.logging.bulk_pull_logging_value);
 	ASSERT_NE (conf.node.logging.flush, defaults.node.logging.flush);
@@ -630,6 +694,7 @@ TEST (toml, daemon_config_deserialize_no_defaults)
 	ASSERT_NE (conf.node.websocket_config.enabled, defaults.node.websocket_config.enabled);
 	ASSERT_NE (conf.node.websocket_config.address, defaults.node.websocket_config.address);
 	ASSERT_NE (conf.node.websocket_config.port, defaults.node.websocket_config.port);
+	ASSERT_NE (conf.node.websocket_config.max_queued_bytes, defaults.node.websocket_config.max_queued_bytes);
 
 	ASSERT_NE (conf.node.callback_address, defaults.node.callback_address);
 	ASSERT_NE (conf.node.callback_port, defaults.node.callback_port);
@@ -644,6 +709,11 @@ TEST (toml, daemon_config_deserialize_no_defaults)
 	ASSERT_NE (conf.node.ipc_config.transport_tcp.io_timeout, defaults.node.ipc_config.transport_tcp.io_timeout);
 	ASSERT_NE (conf.node.ipc_config.transport_tcp.io_threads, defaults.node.ipc_config.transport_tcp.io_threads);
 	ASSERT_NE (conf.node.ipc_config.transport_tcp.port, defaults.node.ipc_config.transport_tcp.port);
+	ASSERT_NE (conf.node.ipc_config.transport_shared_memory.enabled, defaults.node.ipc_config.transport_shared_memory.enabled);
+	ASSERT_NE (conf.node.ipc_config.transport_shared_memory.name, defaults.node.ipc_config.transport_shared_memory.name);
+	ASSERT_NE (conf.node.ipc_config.transport_shared_memory.channels, defaults.node.ipc_config.transport_shared_memory.channels);
+	ASSERT_NE (conf.node.ipc_config.transport_shared_memory.ring_size, defaults.node.ipc_config.transport_shared_memory.ring_size);
+	ASSERT_NE (conf.node.ipc_config.transport_shared_memory.io_timeout, defaults.node.ipc_config.transport_shared_memory.io_timeout);
 	ASSERT_NE (conf.node.ipc_config.flatbuffers.skip_unexpected_fields_in_json, defaults.node.ipc_config.flatbuffers.skip_unexpected_fields_in_json);
 	ASSERT_NE (conf.node.ipc_config.flatbuffers.verify_buffers, defaults.node.ipc_config.flatbuffers.verify_buffers);
 
@@ -665,11 +735,22 @@ TEST (toml, daemon_config_deserialize_no_defaults)
 	ASSERT_NE (conf.node.lmdb_config.sync, defaults.node.lmdb_config.sync);
 	ASSERT_NE (conf.node.lmdb_config.max_databases, defaults.node.lmdb_config.max_databases);
 	ASSERT_NE (conf.node.lmdb_config.map_size, defaults.node.lmdb_config.map_size);
+	ASSERT_NE (conf.node.lmdb_config.compaction, defaults.node.lmdb_config.compaction);
+	ASSERT_NE (conf.node.lmdb_config.compaction_threshold, defaults.node.lmdb_config.compaction_threshold);
+	ASSERT_NE (conf.node.lmdb_config.compaction_rate_limit, defaults.node.lmdb_config.compaction_rate_limit);
+
+	ASSERT_NE (conf.node.traffic[vxlnetwork::traffic_class::vote].weight, defaults.node.traffic[vxlnetwork::traffic_class::vote].weight);
+	ASSERT_NE (conf.node.traffic[vxlnetwork::traffic_class::vote].drop_policy, defaults.node.traffic[vxlnetwork::traffic_class::vote].drop_policy);
+	ASSERT_NE (conf.node.traffic[vxlnetwork::traffic_class::vote].queue_max, defaults.node.traffic[vxlnetwork::traffic_class::vote].queue_max);
+	ASSERT_NE (conf.node.rpc_execution[vxlnetwork::rpc_cost::heavy].threads, defaults.node.rpc_execution[vxlnetwork::rpc_cost::heavy].threads);
+	ASSERT_NE (conf.node.rpc_execution[vxlnetwork::rpc_cost::heavy].max_queued, defaults.node.rpc_execution[vxlnetwork::rpc_cost::heavy].max_queued);
+	ASSERT_NE (conf.node.rpc_execution[vxlnetwork::rpc_cost::heavy].queue_timeout, defaults.node.rpc_execution[vxlnetwork::rpc_cost::heavy].queue_timeout);
 
 	ASSERT_TRUE (conf.node.rocksdb_config.enable);
 	ASSERT_EQ (vxlnetwork::rocksdb_config::using_rocksdb_in_tests (), defaults.node.rocksdb_config.enable);
 	ASSERT_NE (conf.node.rocksdb_config.memory_multiplier, defaults.node.rocksdb_config.memory_multiplier);
 	ASSERT_NE (conf.node.rocksdb_config.io_threads, defaults.node.rocksdb_config.io_threads);
+	ASSERT_NE (conf.node.rocksdb_config.block_cache, defaults.node.rocksdb_config.block_cache);
 }
 
 /** There should be no required values **/
@@ -683,6 +764,7 @@ TEST (toml, daemon_config_no_required)
 	[node.diagnostics.txn_tracking]
 	[node.httpcallback]
 	[node.ipc.local]
+	[node.ipc.shared_memory]
 	[node.ipc.tcp]
 	[node.logging]
 	[node.statistics.log]
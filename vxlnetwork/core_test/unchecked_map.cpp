@@ -68,14 +68,105 @@ TEST (block_store, one_bootstrap)
 	// Waits for the block1 to get saved in the database
 	ASSERT_TIMELY (10s, check_block_is_listed (store->tx_begin_read (), block1->hash ()));
 	auto transaction = store->tx_begin_read ();
-	auto [begin, end] = unchecked.full_range (transaction);
-	ASSERT_NE (end, begin);
-	auto hash1 = begin->first.key ();
+	std::vector<vxlnetwork::unchecked_key> keys;
+	unchecked.for_each (transaction, [&keys] (vxlnetwork::unchecked_key const & key, vxlnetwork::unchecked_info const & info) {
+		keys.push_back (key);
+	});
+	ASSERT_EQ (1, keys.size ());
+	auto hash1 = keys[0].key ();
 	ASSERT_EQ (block1->hash (), hash1);
 	auto blocks = unchecked.get (transaction, hash1);
 	ASSERT_EQ (1, blocks.size ());
 	auto block2 = blocks[0].block;
 	ASSERT_EQ (*block1, *block2);
-	++begin;
-	ASSERT_EQ (end, begin);
+}
+
+// Entries kept in memory are found and satisfied like stored ones, without writing to the store
+TEST (unchecked_map, memory_trigger)
+{
+	vxlnetwork::logger_mt logger;
+	auto store = vxlnetwork::make_store (logger, vxlnetwork::unique_path (), vxlnetwork::dev::constants);
+	ASSERT_FALSE (store->init_error ());
+	bool disable_delete{ false };
+	vxlnetwork::unchecked_map unchecked{ *store, disable_delete, 1024 * 1024 };
+	ASSERT_TRUE (unchecked.use_memory);
+	std::atomic<size_t> satisfied{ 0 };
+	unchecked.satisfied = [&satisfied] (vxlnetwork::unchecked_info const &) { ++satisfied; };
+	vxlnetwork::unchecked_info info{ block (), vxlnetwork::dev::genesis_key.pub };
+	unchecked.put (info.block->previous (), info);
+	unchecked.put (info.block->previous (), info);
+	unchecked.flush ();
+	auto transaction = store->tx_begin_read ();
+	ASSERT_EQ (1, unchecked.count (transaction));
+	ASSERT_EQ (1, unchecked.drops);
+	ASSERT_TRUE (unchecked.exists (transaction, vxlnetwork::unchecked_key{ info.block->previous (), info.block->hash () }));
+	ASSERT_EQ (1, unchecked.get (transaction, info.block->previous ()).size ());
+	unchecked.trigger (info.block->previous ());
+	unchecked.flush ();
+	ASSERT_EQ (1, satisfied);
+	ASSERT_EQ (1, unchecked.satisfied_count);
+	ASSERT_EQ (0, unchecked.count (transaction));
+	ASSERT_EQ (0, unchecked.memory_size ());
+}
+
+// The oldest entries are evicted once the memory limit is reached
+TEST (unchecked_map, memory_limit)
+{
+	vxlnetwork::logger_mt logger;
+	auto store = vxlnetwork::make_store (logger, vxlnetwork::unique_path (), vxlnetwork::dev::constants);
+	ASSERT_FALSE (store->init_error ());
+	vxlnetwork::unchecked_info info{ block (), vxlnetwork::dev::genesis_key.pub };
+	auto const entry_size = vxlnetwork::unchecked_map::entry_size (info);
+	bool disable_delete{ false };
+	vxlnetwork::unchecked_map unchecked{ *store, disable_delete, 3 * entry_size };
+	for (uint64_t i = 1; i <= 5; ++i)
+	{
+		unchecked.put (vxlnetwork::block_hash{ i }, info);
+	}
+	unchecked.flush ();
+	auto transaction = store->tx_begin_read ();
+	ASSERT_EQ (3, unchecked.count (transaction));
+	ASSERT_EQ (2, unchecked.evictions);
+	ASSERT_EQ (0, unchecked.drops);
+	ASSERT_LE (unchecked.memory_size (), 3 * entry_size);
+	ASSERT_TRUE (unchecked.get (transaction, vxlnetwork::block_hash{ 1 }).empty ());
+	ASSERT_TRUE (unchecked.get (transaction, vxlnetwork::block_hash{ 2 }).empty ());
+	std::vector<vxlnetwork::block_hash> dependencies;
+	unchecked.for_each (transaction, [&dependencies] (vxlnetwork::unchecked_key const & key, vxlnetwork::unchecked_info const &) {
+		dependencies.push_back (key.key ());
+	});
+	ASSERT_EQ ((std::vector<vxlnetwork::block_hash>{ 3, 4, 5 }), dependencies);
+}
+
+// Entries are visited in batches without holding the map locked, the callback can use the map itself
+TEST (unchecked_map, memory_for_each)
+{
+	vxlnetwork::logger_mt logger;
+	auto store = vxlnetwork::make_store (logger, vxlnetwork::unique_path (), vxlnetwork::dev::constants);
+	ASSERT_FALSE (store->init_error ());
+	bool disable_delete{ false };
+	vxlnetwork::unchecked_map unchecked{ *store, disable_delete, 16 * 1024 * 1024 };
+	vxlnetwork::unchecked_info info{ block (), vxlnetwork::dev::genesis_key.pub };
+	uint64_t const count (2 * vxlnetwork::unchecked_map::for_each_batch_size + 10);
+	for (uint64_t i = 1; i <= count; ++i)
+	{
+		unchecked.put (vxlnetwork::block_hash{ i }, info);
+	}
+	unchecked.flush ();
+	auto transaction = store->tx_begin_read ();
+	std::vector<vxlnetwork::block_hash> dependencies;
+	unchecked.for_each (transaction, [&] (vxlnetwork::unchecked_key const & key, vxlnetwork::unchecked_info const &) {
+		dependencies.push_back (key.key ());
+		ASSERT_TRUE (unchecked.exists (transaction, key));
+	});
+	ASSERT_EQ (count, dependencies.size ());
+	for (uint64_t i = 1; i <= count; ++i)
+	{
+		ASSERT_EQ (vxlnetwork::block_hash{ i }, dependencies[i - 1]);
+	}
+	// The predicate is checked before every entry
+	std::size_t visited (0);
+	unchecked.for_each (
+	transaction, [&visited] (vxlnetwork::unchecked_key const &, vxlnetwork::unchecked_info const &) { ++visited; }, [&visited] () { return visited < 300; });
+	ASSERT_EQ (300, visited);
 }
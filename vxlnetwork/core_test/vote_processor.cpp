@@ -148,22 +148,46 @@ TEST (vote_processor, weights)
 	ASSERT_TIMELY (10s, node.ledger.cache.rep_weights.get_rep_amounts ().size () == 4);
 	node.vote_processor.calculate_weights ();
 
-	ASSERT_EQ (node.vote_processor.representatives_1.end (), node.vote_processor.representatives_1.find (key0.pub));
-	ASSERT_EQ (node.vote_processor.representatives_2.end (), node.vote_processor.representatives_2.find (key0.pub));
-	ASSERT_EQ (node.vote_processor.representatives_3.end (), node.vote_processor.representatives_3.find (key0.pub));
-
-	ASSERT_NE (node.vote_processor.representatives_1.end (), node.vote_processor.representatives_1.find (key1.pub));
-	ASSERT_EQ (node.vote_processor.representatives_2.end (), node.vote_processor.representatives_2.find (key1.pub));
-	ASSERT_EQ (node.vote_processor.representatives_3.end (), node.vote_processor.representatives_3.find (key1.pub));
-
-	ASSERT_NE (node.vote_processor.representatives_1.end (), node.vote_processor.representatives_1.find (key2.pub));
-	ASSERT_NE (node.vote_processor.representatives_2.end (), node.vote_processor.representatives_2.find (key2.pub));
-	ASSERT_EQ (node.vote_processor.representatives_3.end (), node.vote_processor.representatives_3.find (key2.pub));
-
-	ASSERT_NE (node.vote_processor.representatives_1.end (), node.vote_processor.representatives_1.find (vxlnetwork::dev::genesis_key.pub));
-	ASSERT_NE (node.vote_processor.representatives_2.end (), node.vote_processor.representatives_2.find (vxlnetwork::dev::genesis_key.pub));
-	ASSERT_NE (node.vote_processor.representatives_3.end (), node.vote_processor.representatives_3.find (vxlnetwork::dev::genesis_key.pub));
+	ASSERT_EQ (0, node.vote_processor.tier (key0.pub));
+	ASSERT_EQ (1, node.vote_processor.tier (key1.pub));
+	ASSERT_EQ (2, node.vote_processor.tier (key2.pub));
+	ASSERT_EQ (3, node.vote_processor.tier (vxlnetwork::dev::genesis_key.pub));
+}
 }
+
+// Votes are spread over several workers, votes of each representative must still be processed in arrival order
+TEST (vote_processor, threads_keep_representative_order)
+{
+	vxlnetwork::system system;
+	vxlnetwork::node_config node_config (vxlnetwork::get_available_port (), system.logging);
+	node_config.vote_processor_threads = 4;
+	auto & node (*system.add_node (node_config));
+	auto channel (std::make_shared<vxlnetwork::transport::channel_loopback> (node));
+	std::vector<vxlnetwork::keypair> keys (8);
+	vxlnetwork::mutex mutex;
+	std::unordered_map<vxlnetwork::account, std::vector<uint64_t>> processed;
+	node.observers.vote.add ([&mutex, &processed] (std::shared_ptr<vxlnetwork::vote> const & vote_a, std::shared_ptr<vxlnetwork::transport::channel> const &, vxlnetwork::vote_code) {
+		vxlnetwork::lock_guard<vxlnetwork::mutex> guard (mutex);
+		processed[vote_a->account].push_back (vote_a->timestamp ());
+	});
+	std::size_t const votes_per_key (250);
+	for (uint64_t i = 0; i < votes_per_key; ++i)
+	{
+		for (auto const & key : keys)
+		{
+			auto vote = std::make_shared<vxlnetwork::vote> (key.pub, key.prv, vxlnetwork::vote::timestamp_min * (1 + i), 0, std::vector<vxlnetwork::block_hash>{ vxlnetwork::dev::genesis->hash () });
+			ASSERT_FALSE (node.vote_processor.vote (vote, channel));
+		}
+	}
+	node.vote_processor.flush ();
+	ASSERT_TRUE (node.vote_processor.empty ());
+	vxlnetwork::lock_guard<vxlnetwork::mutex> guard (mutex);
+	ASSERT_EQ (keys.size (), processed.size ());
+	for (auto const & [account, timestamps] : processed)
+	{
+		ASSERT_EQ (votes_per_key, timestamps.size ());
+		ASSERT_TRUE (std::is_sorted (timestamps.begin (), timestamps.end ()));
+	}
 }
 
 // Issue that tracks last changes on this test: https://github.com/vxlnetworkcurrency/vxlnetwork-node/issues/3485
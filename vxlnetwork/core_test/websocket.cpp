@@ -451,6 +451,68 @@ TEST (websocket, confirmation_options_sideband)
 	}
 }
 
+// Sessions with different confirmation options receive their own contents, each combination of options is encoded only once
+TEST (websocket, confirmation_options_shared_encoding)
+{
+	vxlnetwork::system system;
+	vxlnetwork::node_config config (vxlnetwork::get_available_port (), system.logging);
+	config.websocket_config.enabled = true;
+	config.websocket_config.port = vxlnetwork::get_available_port ();
+	auto node1 (system.add_node (config));
+
+	std::atomic<int> acks{ 0 };
+	auto subscribe = [&acks, &node1] (std::string const & options_a) {
+		fake_websocket_client client (node1->websocket_server->listening_port ());
+		client.send_message (R"json({"action": "subscribe", "topic": "confirmation", "ack": "true", "options": )json" + options_a + "}");
+		client.await_ack ();
+		++acks;
+		return client.get_response ();
+	};
+	// The first two sessions share a combination of options
+	auto future1 = std::async (std::launch::async, subscribe, R"json({"include_block": "true"})json");
+	auto future2 = std::async (std::launch::async, subscribe, R"json({"include_block": "true"})json");
+	auto future3 = std::async (std::launch::async, subscribe, R"json({"include_block": "true", "include_sideband_info": "true"})json");
+
+	ASSERT_TIMELY (10s, acks == 3);
+
+	vxlnetwork::keypair key;
+	vxlnetwork::block_hash previous (node1->latest (vxlnetwork::dev::genesis_key.pub));
+	vxlnetwork::state_block_builder builder;
+	auto send = builder
+				.account (vxlnetwork::dev::genesis_key.pub)
+				.previous (previous)
+				.representative (vxlnetwork::dev::genesis_key.pub)
+				.balance (vxlnetwork::dev::constants.genesis_amount - node1->config.online_weight_minimum.number () - 1)
+				.link (key.pub)
+				.sign (vxlnetwork::dev::genesis_key.prv, vxlnetwork::dev::genesis_key.pub)
+				.work (*system.work.generate (previous))
+				.build_shared ();
+	system.wallet (0)->insert_adhoc (vxlnetwork::dev::genesis_key.prv);
+	node1->process_active (send);
+
+	ASSERT_TIMELY (5s, future1.wait_for (0s) == std::future_status::ready && future2.wait_for (0s) == std::future_status::ready && future3.wait_for (0s) == std::future_status::ready);
+
+	auto parse = [] (boost::optional<std::string> const & response_a) {
+		boost::property_tree::ptree event;
+		std::stringstream stream;
+		stream << response_a.get ();
+		boost::property_tree::read_json (stream, event);
+		return event;
+	};
+	auto response1 = future1.get ();
+	auto response2 = future2.get ();
+	auto response3 = future3.get ();
+	ASSERT_TRUE (response1);
+	ASSERT_TRUE (response2);
+	ASSERT_TRUE (response3);
+	ASSERT_EQ (response1.get (), response2.get ());
+	ASSERT_EQ (0, parse (response1).get_child ("message").count ("sideband"));
+	ASSERT_EQ (1, parse (response3).get_child ("message").count ("sideband"));
+	ASSERT_EQ (2, node1->stats.count (vxlnetwork::stat::type::websocket, vxlnetwork::stat::detail::confirmation, vxlnetwork::stat::dir::out));
+	ASSERT_EQ (3, node1->stats.count (vxlnetwork::stat::type::websocket, vxlnetwork::stat::detail::ack, vxlnetwork::stat::dir::out));
+	ASSERT_LE (1, node1->stats.count (vxlnetwork::stat::type::websocket, vxlnetwork::stat::detail::fanout, vxlnetwork::stat::dir::out));
+}
+
 // Tests updating options of block confirmations
 TEST (websocket, confirmation_options_update)
 {
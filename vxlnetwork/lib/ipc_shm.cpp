@@ -0,0 +1,508 @@
+#include <vxlnetwork/lib/ipc_shm.hpp>
+#include <vxlnetwork/lib/utility.hpp>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <limits>
+#include <thread>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <signal.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+#if defined(__linux__)
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#endif
+
+static_assert (std::atomic<uint32_t>::is_always_lock_free && sizeof (std::atomic<uint32_t>) == sizeof (uint32_t), "Futex words must be plain 32-bit integers");
+static_assert (std::atomic<uint64_t>::is_always_lock_free, "Ring positions must be lock free to be shared between processes");
+
+namespace
+{
+class record_header final
+{
+public:
+	uint32_t size;
+	/** Set for the unused end of the ring which the consumer skips */
+	uint32_t padding;
+};
+static_assert (sizeof (record_header) == vxlnetwork::ipc::shm_ring::record_header_size, "Unexpected record header size");
+
+std::size_t align (std::size_t size_a, std::size_t alignment_a)
+{
+	return (size_a + alignment_a - 1) & ~(alignment_a - 1);
+}
+
+void futex_wait (std::atomic<uint32_t> & word_a, uint32_t expected_a, std::chrono::steady_clock::duration timeout_a)
+{
+#if defined(__linux__)
+	auto nanoseconds (std::chrono::duration_cast<std::chrono::nanoseconds> (timeout_a).count ());
+	timespec timeout_l{ static_cast<time_t> (nanoseconds / 1000000000), static_cast<long> (nanoseconds % 1000000000) };
+	// Not FUTEX_PRIVATE_FLAG, the word is shared with another process
+	syscall (SYS_futex, reinterpret_cast<uint32_t *> (&word_a), FUTEX_WAIT, expected_a, &timeout_l, nullptr, 0);
+#else
+	if (word_a.load () == expected_a)
+	{
+		std::this_thread::sleep_for (std::min<std::chrono::steady_clock::duration> (timeout_a, std::chrono::milliseconds (1)));
+	}
+#endif
+}
+
+void futex_wake (std::atomic<uint32_t> & word_a)
+{
+#if defined(__linux__)
+	syscall (SYS_futex, reinterpret_cast<uint32_t *> (&word_a), FUTEX_WAKE, 1, nullptr, nullptr, 0);
+#endif
+}
+
+/** Bumps \p signal_a and wakes the other side if it is asleep */
+void signal (std::atomic<uint32_t> & signal_a, std::atomic<uint32_t> & waiting_a)
+{
+	signal_a.fetch_add (1);
+	if (waiting_a.load ())
+	{
+		futex_wake (signal_a);
+	}
+}
+
+/** Waits until \p predicate_a holds. Returns true if it did not in time */
+bool wait (std::function<bool ()> const & predicate_a, std::atomic<uint32_t> & signal_a, std::atomic<uint32_t> & waiting_a, std::chrono::milliseconds timeout_a)
+{
+	auto result (!predicate_a ());
+	if (result && timeout_a.count () > 0)
+	{
+		auto const deadline (std::chrono::steady_clock::now () + std::min<std::chrono::milliseconds> (timeout_a, std::chrono::hours (24)));
+		for (auto now (std::chrono::steady_clock::now ()); result && now < deadline; now = std::chrono::steady_clock::now ())
+		{
+			auto const expected (signal_a.load ());
+			waiting_a.store (1);
+			// Checked again after announcing the wait, a signal in between changes the futex word and the wait returns immediately
+			result = !predicate_a ();
+			if (result)
+			{
+				futex_wait (signal_a, expected, deadline - now);
+				result = !predicate_a ();
+			}
+			waiting_a.store (0);
+		}
+	}
+	return result;
+}
+}
+
+vxlnetwork::ipc::shm_ring::shm_ring (vxlnetwork::ipc::shm_ring::header & header_a, uint8_t * data_a, std::size_t capacity_a) :
+	header_m (header_a),
+	data (data_a),
+	capacity (capacity_a),
+	reserved_head (header_a.head.load ())
+{
+	debug_assert (capacity > 0 && (capacity & (capacity - 1)) == 0);
+}
+
+void vxlnetwork::ipc::shm_ring::reset ()
+{
+	header_m.head = 0;
+	header_m.tail = 0;
+	reserved_head = 0;
+	signal (header_m.space_signal, header_m.producer_waiting);
+}
+
+std::size_t vxlnetwork::ipc::shm_ring::max_message_size () const
+{
+	return capacity / 2 - record_header_size;
+}
+
+std::size_t vxlnetwork::ipc::shm_ring::required (std::size_t size_a) const
+{
+	std::size_t result (0);
+	if (size_a <= max_message_size ())
+	{
+		auto const offset (header_m.head.load (std::memory_order_relaxed) & (capacity - 1));
+		auto const record (align (record_header_size + size_a, record_header_size));
+		result = record + (offset + record > capacity ? capacity - offset : 0);
+	}
+	return result;
+}
+
+bool vxlnetwork::ipc::shm_ring::wait_writable (std::size_t size_a, std::chrono::milliseconds timeout_a)
+{
+	auto const required_l (required (size_a));
+	return required_l == 0 || wait ([this, required_l] () { return capacity - (header_m.head.load (std::memory_order_relaxed) - header_m.tail.load (std::memory_order_acquire)) >= required_l; }, header_m.space_signal, header_m.producer_waiting, timeout_a);
+}
+
+uint8_t * vxlnetwork::ipc::shm_ring::reserve (std::size_t size_a, std::chrono::milliseconds timeout_a)
+{
+	uint8_t * result (nullptr);
+	if (!wait_writable (size_a, timeout_a))
+	{
+		auto head_l (header_m.head.load (std::memory_order_relaxed));
+		auto offset (head_l & (capacity - 1));
+		auto const record (align (record_header_size + size_a, record_header_size));
+		if (offset + record > capacity)
+		{
+			record_header skip{ static_cast<uint32_t> (capacity - offset), 1 };
+			std::memcpy (data + offset, &skip, sizeof (skip));
+			head_l += capacity - offset;
+			offset = 0;
+		}
+		record_header message{ static_cast<uint32_t> (size_a), 0 };
+		std::memcpy (data + offset, &message, sizeof (message));
+		reserved_head = head_l + record;
+		result = data + offset + record_header_size;
+	}
+	return result;
+}
+
+void vxlnetwork::ipc::shm_ring::commit ()
+{
+	header_m.head.store (reserved_head, std::memory_order_release);
+	signal (header_m.data_signal, header_m.consumer_waiting);
+}
+
+bool vxlnetwork::ipc::shm_ring::write (uint8_t const * data_a, std::size_t size_a, std::chrono::milliseconds timeout_a)
+{
+	auto destination (reserve (size_a, timeout_a));
+	if (destination != nullptr)
+	{
+		std::memcpy (destination, data_a, size_a);
+		commit ();
+	}
+	return destination == nullptr;
+}
+
+bool vxlnetwork::ipc::shm_ring::read (std::function<void (uint8_t const *, std::size_t)> const & handler_a, std::chrono::milliseconds timeout_a)
+{
+	auto tail_l (header_m.tail.load (std::memory_order_relaxed));
+	auto readable = [this, &tail_l] () { return header_m.head.load (std::memory_order_acquire) != tail_l; };
+	auto result (true);
+	while (result && !wait (readable, header_m.data_signal, header_m.consumer_waiting, timeout_a))
+	{
+		auto const offset (tail_l & (capacity - 1));
+		record_header record;
+		std::memcpy (&record, data + offset, sizeof (record));
+		if (record.padding)
+		{
+			tail_l += record.size;
+		}
+		else
+		{
+			handler_a (data + offset + record_header_size, record.size);
+			tail_l += align (record_header_size + record.size, record_header_size);
+			result = false;
+		}
+		header_m.tail.store (tail_l, std::memory_order_release);
+		signal (header_m.space_signal, header_m.producer_waiting);
+	}
+	return result;
+}
+
+constexpr std::size_t vxlnetwork::ipc::shm_ring::record_header_size;
+
+vxlnetwork::ipc::shm_channel::shm_channel (vxlnetwork::ipc::shm_channel::header & header_a, uint8_t * rings_a, std::size_t ring_size_a) :
+	status (header_a.status),
+	client_pid (header_a.client_pid),
+	requests (header_a.requests, rings_a, ring_size_a),
+	responses (header_a.responses, rings_a + ring_size_a, ring_size_a)
+{
+}
+
+bool vxlnetwork::ipc::shm_channel::client_died () const
+{
+	auto result (false);
+#ifndef _WIN32
+	auto pid (client_pid.load ());
+	result = status.load () == static_cast<uint32_t> (vxlnetwork::ipc::shm_channel_status::claimed) && pid != 0 && ::kill (pid, 0) != 0 && errno == ESRCH;
+#endif
+	return result;
+}
+
+vxlnetwork::ipc::shm_segment::~shm_segment ()
+{
+	close ();
+}
+
+std::size_t vxlnetwork::ipc::shm_segment::channel_stride (std::size_t ring_size_a)
+{
+	return align (sizeof (vxlnetwork::ipc::shm_channel::header), alignment) + 2 * ring_size_a;
+}
+
+void vxlnetwork::ipc::shm_segment::attach (uint8_t * base_a, std::size_t channels_a, std::size_t ring_size_a)
+{
+	channels.clear ();
+	channels.reserve (channels_a);
+	for (std::size_t i (0); i < channels_a; ++i)
+	{
+		auto channel_base (base_a + align (sizeof (header), alignment) + i * channel_stride (ring_size_a));
+		channels.emplace_back (*reinterpret_cast<vxlnetwork::ipc::shm_channel::header *> (channel_base), channel_base + align (sizeof (vxlnetwork::ipc::shm_channel::header), alignment), ring_size_a);
+	}
+}
+
+vxlnetwork::error vxlnetwork::ipc::shm_segment::create (std::string const & name_a, std::size_t channels_a, std::size_t ring_size_a)
+{
+	vxlnetwork::error error;
+#ifndef _WIN32
+	if (channels_a == 0 || ring_size_a < 4096 || (ring_size_a & (ring_size_a - 1)) != 0 || ring_size_a > std::numeric_limits<uint32_t>::max ())
+	{
+		error = "Shared memory IPC needs at least one channel and a ring size which is a power of two between 4 KiB and 2 GiB";
+	}
+	else
+	{
+		close ();
+		auto fd (::shm_open (name_a.c_str (), O_CREAT | O_EXCL | O_RDWR, S_IRUSR | S_IWUSR));
+		auto open_error (fd == -1 ? errno : 0);
+		if (open_error == EEXIST && stale (name_a))
+		{
+			// Left behind by a node which exited without removing it
+			::shm_unlink (name_a.c_str ());
+			fd = ::shm_open (name_a.c_str (), O_CREAT | O_EXCL | O_RDWR, S_IRUSR | S_IWUSR);
+			open_error = fd == -1 ? errno : 0;
+		}
+		auto const created (fd != -1);
+		auto size (align (sizeof (header), alignment) + channels_a * channel_stride (ring_size_a));
+		if (open_error == EEXIST)
+		{
+			error = "Segment already exists and is in use or was created by another version, remove it if no node is using it";
+		}
+		else if (!created)
+		{
+			error = std::error_code (open_error, std::generic_category ());
+		}
+		else if (::ftruncate (fd, static_cast<off_t> (size)) != 0)
+		{
+			error = std::error_code (errno, std::generic_category ());
+		}
+		else
+		{
+			auto mapping_l (::mmap (nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0));
+			if (mapping_l == MAP_FAILED)
+			{
+				error = std::error_code (errno, std::generic_category ());
+			}
+			else
+			{
+				name = name_a;
+				mapping = mapping_l;
+				mapping_size = size;
+				owner = true;
+				auto base (static_cast<uint8_t *> (mapping));
+				auto header_l (new (base) header ());
+				header_l->version = version_value;
+				header_l->channel_count = static_cast<uint32_t> (channels_a);
+				header_l->ring_size = ring_size_a;
+				header_l->creator_pid = static_cast<int32_t> (::getpid ());
+				for (std::size_t i (0); i < channels_a; ++i)
+				{
+					new (base + align (sizeof (header), alignment) + i * channel_stride (ring_size_a)) vxlnetwork::ipc::shm_channel::header ();
+				}
+				attach (base, channels_a, ring_size_a);
+				// Published last, clients ignore the segment until it is initialized
+				header_l->magic.store (magic_value, std::memory_order_release);
+			}
+		}
+		if (created)
+		{
+			::close (fd);
+			if (error)
+			{
+				::shm_unlink (name_a.c_str ());
+			}
+		}
+	}
+#else
+	error = "Shared memory IPC is not supported on this platform";
+#endif
+	return error;
+}
+
+bool vxlnetwork::ipc::shm_segment::stale (std::string const & name_a)
+{
+	auto result (false);
+#ifndef _WIN32
+	auto fd (::shm_open (name_a.c_str (), O_RDONLY, 0));
+	struct stat stat_l;
+	if (fd != -1 && ::fstat (fd, &stat_l) == 0 && static_cast<std::size_t> (stat_l.st_size) >= sizeof (header))
+	{
+		auto mapping_l (::mmap (nullptr, sizeof (header), PROT_READ, MAP_SHARED, fd, 0));
+		if (mapping_l != MAP_FAILED)
+		{
+			auto header_l (static_cast<header const *> (mapping_l));
+			// A segment still being initialized or with another layout is left alone
+			if (header_l->magic.load (std::memory_order_acquire) == magic_value && header_l->version == version_value)
+			{
+				auto pid (header_l->creator_pid);
+				result = pid != 0 && ::kill (pid, 0) != 0 && errno == ESRCH;
+			}
+			::munmap (mapping_l, sizeof (header));
+		}
+	}
+	if (fd != -1)
+	{
+		::close (fd);
+	}
+#endif
+	return result;
+}
+
+vxlnetwork::error vxlnetwork::ipc::shm_segment::open (std::string const & name_a)
+{
+	vxlnetwork::error error;
+#ifndef _WIN32
+	close ();
+	auto fd (::shm_open (name_a.c_str (), O_RDWR, 0));
+	struct stat stat_l;
+	if (fd == -1 || ::fstat (fd, &stat_l) != 0)
+	{
+		error = std::error_code (errno, std::generic_category ());
+	}
+	else if (static_cast<std::size_t> (stat_l.st_size) < sizeof (header))
+	{
+		error = "Shared memory segment is not initialized";
+	}
+	else
+	{
+		auto size (static_cast<std::size_t> (stat_l.st_size));
+		auto mapping_l (::mmap (nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0));
+		if (mapping_l == MAP_FAILED)
+		{
+			error = std::error_code (errno, std::generic_category ());
+		}
+		else
+		{
+			name = name_a;
+			mapping = mapping_l;
+			mapping_size = size;
+			auto base (static_cast<uint8_t *> (mapping));
+			auto header_l (reinterpret_cast<header *> (base));
+			if (header_l->magic.load (std::memory_order_acquire) != magic_value || header_l->version != version_value || align (sizeof (header), alignment) + header_l->channel_count * channel_stride (header_l->ring_size) != size)
+			{
+				error = "Shared memory segment is not initialized or has an incompatible layout";
+				close ();
+			}
+			else
+			{
+				attach (base, header_l->channel_count, header_l->ring_size);
+			}
+		}
+	}
+	if (fd != -1)
+	{
+		::close (fd);
+	}
+#else
+	error = "Shared memory IPC is not supported on this platform";
+#endif
+	return error;
+}
+
+void vxlnetwork::ipc::shm_segment::close ()
+{
+	channels.clear ();
+#ifndef _WIN32
+	if (mapping != nullptr)
+	{
+		::munmap (mapping, mapping_size);
+		if (owner)
+		{
+			::shm_unlink (name.c_str ());
+		}
+	}
+#endif
+	mapping = nullptr;
+	mapping_size = 0;
+	owner = false;
+}
+
+constexpr uint64_t vxlnetwork::ipc::shm_segment::magic_value;
+constexpr uint32_t vxlnetwork::ipc::shm_segment::version_value;
+constexpr std::size_t vxlnetwork::ipc::shm_segment::alignment;
+
+vxlnetwork::ipc::shm_client::~shm_client ()
+{
+	close ();
+}
+
+vxlnetwork::error vxlnetwork::ipc::shm_client::connect (std::string const & name_a)
+{
+	close ();
+	auto error (segment.open (name_a));
+	if (!error)
+	{
+		for (auto i (segment.channels.begin ()), n (segment.channels.end ()); i != n && channel == nullptr; ++i)
+		{
+			auto expected (static_cast<uint32_t> (vxlnetwork::ipc::shm_channel_status::free));
+			if (i->status.compare_exchange_strong (expected, static_cast<uint32_t> (vxlnetwork::ipc::shm_channel_status::claimed)))
+			{
+#ifndef _WIN32
+				i->client_pid = static_cast<int32_t> (::getpid ());
+#endif
+				channel = &*i;
+			}
+		}
+		if (channel == nullptr)
+		{
+			error = "No free shared memory IPC channel";
+		}
+	}
+	return error;
+}
+
+vxlnetwork::error vxlnetwork::ipc::shm_client::write (vxlnetwork::ipc::payload_encoding encoding_a, uint8_t const * data_a, std::size_t size_a, std::chrono::milliseconds timeout_a)
+{
+	vxlnetwork::error error;
+	if (channel == nullptr)
+	{
+		error = "Not connected";
+	}
+	else if (encoding_a != vxlnetwork::ipc::payload_encoding::flatbuffers && encoding_a != vxlnetwork::ipc::payload_encoding::flatbuffers_json)
+	{
+		error = "Shared memory IPC only supports flatbuffers encodings";
+	}
+	else
+	{
+		auto destination (channel->requests.reserve (4 + size_a, timeout_a));
+		if (destination == nullptr)
+		{
+			error = size_a + 4 > channel->requests.max_message_size () ? "Request is too large" : "Timed out waiting for space in the request ring";
+		}
+		else
+		{
+			destination[vxlnetwork::ipc::preamble_offset::lead] = 'N';
+			destination[vxlnetwork::ipc::preamble_offset::encoding] = static_cast<uint8_t> (encoding_a);
+			destination[vxlnetwork::ipc::preamble_offset::reserved_1] = 0;
+			destination[vxlnetwork::ipc::preamble_offset::reserved_2] = 0;
+			std::memcpy (destination + 4, data_a, size_a);
+			channel->requests.commit ();
+		}
+	}
+	return error;
+}
+
+vxlnetwork::error vxlnetwork::ipc::shm_client::read (std::function<void (uint8_t const *, std::size_t)> const & handler_a, std::chrono::milliseconds timeout_a)
+{
+	vxlnetwork::error error;
+	if (channel == nullptr)
+	{
+		error = "Not connected";
+	}
+	else if (channel->responses.read (handler_a, timeout_a))
+	{
+		error = "Timed out waiting for a message";
+	}
+	return error;
+}
+
+void vxlnetwork::ipc::shm_client::close ()
+{
+	if (channel != nullptr)
+	{
+		// The node resets the rings and frees the channel once it notices
+		channel->status = static_cast<uint32_t> (vxlnetwork::ipc::shm_channel_status::closed);
+		channel = nullptr;
+	}
+	segment.close ();
+}
@@ -0,0 +1,198 @@
+#pragma once
+
+#include <vxlnetwork/lib/errors.hpp>
+#include <vxlnetwork/lib/ipc.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace vxlnetwork
+{
+namespace ipc
+{
+	/**
+	 * Single producer, single consumer ring of messages in memory shared between processes.
+	 * A message is never split at the end of the ring, so the consumer reads it in place. Waiting for data or
+	 * space uses a futex on Linux and only enters the kernel when the other side sleeps. Other platforms poll.
+	 */
+	class shm_ring final
+	{
+	public:
+		/** Control block in shared memory. Positions count bytes since the ring was reset */
+		class header final
+		{
+		public:
+			std::atomic<uint64_t> head;
+			std::atomic<uint64_t> tail;
+			/** Futex words, bumped when data is published and when space is released */
+			std::atomic<uint32_t> data_signal;
+			std::atomic<uint32_t> space_signal;
+			/** Set while a side sleeps, so the other side only issues a wake syscall when needed */
+			std::atomic<uint32_t> consumer_waiting;
+			std::atomic<uint32_t> producer_waiting;
+		};
+
+		/** Attaches to a ring of \p capacity_a bytes, which must be a power of two */
+		shm_ring (vxlnetwork::ipc::shm_ring::header & header_a, uint8_t * data_a, std::size_t capacity_a);
+
+		/** Discards all messages. Only safe while neither side uses the ring */
+		void reset ();
+
+		/** The largest message the ring accepts, half of its capacity so a message always fits after skipping the end of the ring */
+		std::size_t max_message_size () const;
+
+		/**
+		 * Reserves space for a message of \p size_a bytes, waiting up to \p timeout_a for the consumer to release space.
+		 * The message becomes visible to the consumer with commit.
+		 * @return Where to write the message, nullptr if it is too large or there was no space in time
+		 */
+		uint8_t * reserve (std::size_t size_a, std::chrono::milliseconds timeout_a);
+		void commit ();
+		/** Copies a message into the ring. Returns true if it is too large or there was no space in time */
+		bool write (uint8_t const * data_a, std::size_t size_a, std::chrono::milliseconds timeout_a);
+		/** Waits until a message of \p size_a bytes fits. Returns true if there was no space in time */
+		bool wait_writable (std::size_t size_a, std::chrono::milliseconds timeout_a);
+
+		/**
+		 * Waits up to \p timeout_a for the next message and calls \p handler_a with the message in place.
+		 * The data is only valid during the call, the space is released once the handler returns.
+		 * @return true if there was no message in time
+		 */
+		bool read (std::function<void (uint8_t const *, std::size_t)> const & handler_a, std::chrono::milliseconds timeout_a);
+
+		static std::size_t constexpr record_header_size{ 8 };
+
+	private:
+		/** Space the message would take including the skipped end of the ring, zero if it cannot fit at all */
+		std::size_t required (std::size_t size_a) const;
+
+		vxlnetwork::ipc::shm_ring::header & header_m;
+		uint8_t * data;
+		std::size_t const capacity;
+		/** Head after the reserved message, published by commit. Only used by the producer */
+		uint64_t reserved_head{ 0 };
+	};
+
+	/** Status of a channel, stored in shared memory */
+	enum class shm_channel_status : uint32_t
+	{
+		free = 0,
+		claimed,
+		closed
+	};
+
+	/** A channel is used by one client at a time. Requests and responses each have their own ring */
+	class shm_channel final
+	{
+	public:
+		/** Control block in shared memory */
+		class header final
+		{
+		public:
+			std::atomic<uint32_t> status;
+			std::atomic<int32_t> client_pid;
+			vxlnetwork::ipc::shm_ring::header requests;
+			vxlnetwork::ipc::shm_ring::header responses;
+		};
+
+		shm_channel (vxlnetwork::ipc::shm_channel::header & header_a, uint8_t * rings_a, std::size_t ring_size_a);
+
+		/** True if the channel is claimed by a process which no longer exists */
+		bool client_died () const;
+
+		std::atomic<uint32_t> & status;
+		std::atomic<int32_t> & client_pid;
+		/** Client to node */
+		vxlnetwork::ipc::shm_ring requests;
+		/** Node to client, carrying both responses and broker events */
+		vxlnetwork::ipc::shm_ring responses;
+	};
+
+	/**
+	 * A named POSIX shared memory object holding a fixed number of channels.
+	 * The node creates it, clients open it and claim a free channel.
+	 */
+	class shm_segment final
+	{
+	public:
+		shm_segment () = default;
+		~shm_segment ();
+		shm_segment (shm_segment const &) = delete;
+		shm_segment & operator= (shm_segment const &) = delete;
+
+		/**
+		 * Creates the segment, it is only accessible to the current user. Fails if a segment with the same name belongs to a
+		 * running process, one left behind by a process which exited is replaced.
+		 */
+		vxlnetwork::error create (std::string const & name_a, std::size_t channels_a, std::size_t ring_size_a);
+		/** Opens a segment created by a node */
+		vxlnetwork::error open (std::string const & name_a);
+		/** Unmaps the segment, the creator also removes the name */
+		void close ();
+
+		std::vector<vxlnetwork::ipc::shm_channel> channels;
+
+	private:
+		class header final
+		{
+		public:
+			std::atomic<uint64_t> magic;
+			uint32_t version;
+			uint32_t channel_count;
+			uint64_t ring_size;
+			/** Process which created the segment */
+			int32_t creator_pid;
+		};
+		static uint64_t constexpr magic_value{ 0x4d48535f4c4e5856 };
+		static uint32_t constexpr version_value{ 2 };
+		static std::size_t constexpr alignment{ 64 };
+
+		static std::size_t channel_stride (std::size_t ring_size_a);
+		/** Whether the existing segment \p name_a was initialized by a process which is no longer running */
+		static bool stale (std::string const & name_a);
+		void attach (uint8_t * base_a, std::size_t channels_a, std::size_t ring_size_a);
+
+		std::string name;
+		void * mapping{ nullptr };
+		std::size_t mapping_size{ 0 };
+		/** The creator removes the name again */
+		bool owner{ false };
+	};
+
+	/**
+	 * Client side of the shared memory transport. Requests are framed with the IPC preamble followed by the payload,
+	 * without a length prefix, responses and events are just the payload. Only flatbuffers encodings are supported.
+	 * @note Not thread safe, a client is meant to be used from a single thread.
+	 */
+	class shm_client final
+	{
+	public:
+		shm_client () = default;
+		~shm_client ();
+
+		/** Opens the segment \p name_a and claims a free channel */
+		vxlnetwork::error connect (std::string const & name_a);
+
+		/** Sends a request, waiting up to \p timeout_a for space */
+		vxlnetwork::error write (vxlnetwork::ipc::payload_encoding encoding_a, uint8_t const * data_a, std::size_t size_a, std::chrono::milliseconds timeout_a);
+
+		/**
+		 * Waits up to \p timeout_a for the next response or event and passes it to \p handler_a in place.
+		 * The data is only valid during the call.
+		 */
+		vxlnetwork::error read (std::function<void (uint8_t const *, std::size_t)> const & handler_a, std::chrono::milliseconds timeout_a);
+
+		/** Releases the channel. The node discards the session, including its subscriptions */
+		void close ();
+
+	private:
+		vxlnetwork::ipc::shm_segment segment;
+		vxlnetwork::ipc::shm_channel * channel{ nullptr };
+	};
+}
+}
@@ -0,0 +1,231 @@
+#include <vxlnetwork/lib/json_writer.hpp>
+#include <vxlnetwork/lib/utility.hpp>
+
+vxlnetwork::json_writer::json_writer ()
+{
+	reset ();
+}
+
+void vxlnetwork::json_writer::reset ()
+{
+	output = "{";
+	scopes.clear ();
+	scopes.push_back ({ false, 0, 0 });
+}
+
+void vxlnetwork::json_writer::put (std::string const & key_a, std::string const & value_a)
+{
+	key (key_a);
+	write_string (value_a);
+}
+
+void vxlnetwork::json_writer::put (std::string const & key_a, char const * value_a)
+{
+	put (key_a, std::string (value_a));
+}
+
+void vxlnetwork::json_writer::put_child (std::string const & key_a, boost::property_tree::ptree const & tree_a)
+{
+	key (key_a);
+	write_tree (tree_a, scopes.size ());
+}
+
+void vxlnetwork::json_writer::begin_object (std::string const & key_a)
+{
+	key (key_a);
+	open (false);
+}
+
+void vxlnetwork::json_writer::begin_array (std::string const & key_a)
+{
+	key (key_a);
+	open (true);
+}
+
+void vxlnetwork::json_writer::push_back (std::string const & value_a)
+{
+	next (true);
+	write_string (value_a);
+}
+
+void vxlnetwork::json_writer::push_back (char const * value_a)
+{
+	push_back (std::string (value_a));
+}
+
+void vxlnetwork::json_writer::push_back_child (boost::property_tree::ptree const & tree_a)
+{
+	next (true);
+	write_tree (tree_a, scopes.size ());
+}
+
+void vxlnetwork::json_writer::begin_object ()
+{
+	next (true);
+	open (false);
+}
+
+void vxlnetwork::json_writer::begin_array ()
+{
+	next (true);
+	open (true);
+}
+
+void vxlnetwork::json_writer::end_object ()
+{
+	close (false);
+}
+
+void vxlnetwork::json_writer::end_array ()
+{
+	close (true);
+}
+
+bool vxlnetwork::json_writer::empty () const
+{
+	debug_assert (!scopes.empty ());
+	return scopes.front ().members == 0;
+}
+
+std::string vxlnetwork::json_writer::finish ()
+{
+	debug_assert (scopes.size () == 1 && "All objects and arrays must be closed before finishing the document");
+	output += '\n';
+	output += "}\n";
+	std::string result;
+	result.swap (output);
+	reset ();
+	return result;
+}
+
+std::string vxlnetwork::json_writer::write (boost::property_tree::ptree const & tree_a)
+{
+	vxlnetwork::json_writer writer;
+	for (auto const & [key, child] : tree_a)
+	{
+		writer.put_child (key, child);
+	}
+	return writer.finish ();
+}
+
+void vxlnetwork::json_writer::next (bool array_a)
+{
+	debug_assert (!scopes.empty ());
+	auto & current (scopes.back ());
+	debug_assert (current.array == array_a);
+	output += current.members == 0 ? "\n" : ",\n";
+	++current.members;
+	indent (scopes.size ());
+}
+
+void vxlnetwork::json_writer::key (std::string const & key_a)
+{
+	next (false);
+	write_string (key_a);
+	output += ": ";
+}
+
+void vxlnetwork::json_writer::open (bool array_a)
+{
+	scopes.push_back ({ array_a, output.size (), 0 });
+	output += array_a ? '[' : '{';
+}
+
+void vxlnetwork::json_writer::close (bool array_a)
+{
+	debug_assert (scopes.size () > 1 && scopes.back ().array == array_a);
+	auto const current (scopes.back ());
+	scopes.pop_back ();
+	if (current.members == 0)
+	{
+		// An empty ptree child is a value
+		output.resize (current.start);
+		output += "\"\"";
+	}
+	else
+	{
+		output += '\n';
+		indent (scopes.size ());
+		output += array_a ? ']' : '}';
+	}
+}
+
+void vxlnetwork::json_writer::write_string (std::string const & value_a)
+{
+	// Same escaping as boost::property_tree::json_parser::create_escapes, everything outside of ASCII is written as is
+	static char const * hexdigits = "0123456789ABCDEF";
+	output += '"';
+	for (auto i : value_a)
+	{
+		auto c (static_cast<unsigned char> (i));
+		if (c == 0x20 || c == 0x21 || (c >= 0x23 && c <= 0x2E) || (c >= 0x30 && c <= 0x5B) || c >= 0x5D)
+		{
+			output += i;
+		}
+		else
+		{
+			output += '\\';
+			switch (i)
+			{
+				case '\b':
+					output += 'b';
+					break;
+				case '\f':
+					output += 'f';
+					break;
+				case '\n':
+					output += 'n';
+					break;
+				case '\r':
+					output += 'r';
+					break;
+				case '\t':
+					output += 't';
+					break;
+				case '/':
+				case '"':
+				case '\\':
+					output += i;
+					break;
+				default:
+					output += "u00";
+					output += hexdigits[c / 16];
+					output += hexdigits[c % 16];
+					break;
+			}
+		}
+	}
+	output += '"';
+}
+
+void vxlnetwork::json_writer::write_tree (boost::property_tree::ptree const & tree_a, std::size_t indent_a)
+{
+	if (tree_a.empty ())
+	{
+		write_string (tree_a.data ());
+	}
+	else
+	{
+		auto array (tree_a.count (std::string ()) == tree_a.size ());
+		output += array ? '[' : '{';
+		for (auto i (tree_a.begin ()), n (tree_a.end ()); i != n; ++i)
+		{
+			output += i == tree_a.begin () ? "\n" : ",\n";
+			indent (indent_a + 1);
+			if (!array)
+			{
+				write_string (i->first);
+				output += ": ";
+			}
+			write_tree (i->second, indent_a + 1);
+		}
+		output += '\n';
+		indent (indent_a);
+		output += array ? ']' : '}';
+	}
+}
+
+void vxlnetwork::json_writer::indent (std::size_t indent_a)
+{
+	output.append (4 * indent_a, ' ');
+}
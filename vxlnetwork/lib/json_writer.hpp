@@ -0,0 +1,84 @@
+#pragma once
+
+#include <boost/property_tree/ptree.hpp>
+
+#include <string>
+#include <vector>
+
+namespace vxlnetwork
+{
+/**
+ * Writes a JSON document directly into a string, without building a property tree first.
+ * The output is identical to boost::property_tree::write_json for the equivalent tree: every value is written as a string
+ * using the same translation as ptree::put, and an object or array without members is written as "" like an empty ptree child.
+ * The root is always an object, members of the current scope are added with put and begin_object/begin_array,
+ * elements of an array scope with push_back and the begin_object/begin_array overloads without a key.
+ */
+class json_writer final
+{
+public:
+	json_writer ();
+
+	void put (std::string const & key_a, std::string const & value_a);
+	void put (std::string const & key_a, char const * value_a);
+	template <typename T>
+	void put (std::string const & key_a, T const & value_a)
+	{
+		put (key_a, translate (value_a));
+	}
+	void put_child (std::string const & key_a, boost::property_tree::ptree const & tree_a);
+	void begin_object (std::string const & key_a);
+	void begin_array (std::string const & key_a);
+
+	void push_back (std::string const & value_a);
+	void push_back (char const * value_a);
+	template <typename T>
+	void push_back (T const & value_a)
+	{
+		push_back (translate (value_a));
+	}
+	void push_back_child (boost::property_tree::ptree const & tree_a);
+	void begin_object ();
+	void begin_array ();
+
+	void end_object ();
+	void end_array ();
+
+	/** True if nothing has been added to the root object */
+	bool empty () const;
+	/** Closes the root object and returns the document, the writer starts a new empty document afterwards */
+	std::string finish ();
+
+	/** Same output as boost::property_tree::write_json (stream, tree_a) */
+	static std::string write (boost::property_tree::ptree const & tree_a);
+
+private:
+	class scope final
+	{
+	public:
+		bool array;
+		/** Position of the opening bracket, used to replace an empty scope with "" */
+		std::size_t start;
+		std::size_t members;
+	};
+
+	template <typename T>
+	static std::string translate (T const & value_a)
+	{
+		typename boost::property_tree::translator_between<std::string, T>::type translator;
+		return *translator.put_value (value_a);
+	}
+	void reset ();
+	/** Separates and indents a new member or element of the current scope */
+	void next (bool array_a);
+	void key (std::string const & key_a);
+	void open (bool array_a);
+	void close (bool array_a);
+	void write_string (std::string const & value_a);
+	void write_tree (boost::property_tree::ptree const & tree_a, std::size_t indent_a);
+	void indent (std::size_t indent_a);
+
+	std::string output;
+	std::vector<scope> scopes;
+};
+}
@@ -26,6 +26,9 @@ vxlnetwork::error vxlnetwork::lmdb_config::serialize_toml (vxlnetwork::tomlconfi
 	toml.put ("sync", sync_string, "Sync strategy for flushing commits to the ledger database. This does not affect the wallet database.\ntype:string,{always, nosync_safe, nosync_unsafe, nosync_unsafe_large_memory}");
 	toml.put ("max_databases", max_databases, "Maximum open lmdb databases. Increase default if more than 100 wallets is required.\nNote: external management is recommended when a large amounts of wallets are required (see https://docs.vxlnetwork.org/integration-guides/key-management/).\ntype:uin32");
 	toml.put ("map_size", map_size, "Maximum ledger database map size in bytes.\ntype:uint64");
+	toml.put ("compaction", compaction, "Compact the ledger database in the background while the node is running. Requires free disk space for a copy of the live data.\ntype:bool");
+	toml.put ("compaction_threshold", compaction_threshold, "Percentage of the ledger database file made of free pages which starts a compaction.\ntype:uint32,[1..100]");
+	toml.put ("compaction_rate_limit", compaction_rate_limit, "Maximum rate in MiB/s at which a compaction copies the ledger, 0 for unlimited.\ntype:uint32");
 	return toml.get_error ();
 }
 
@@ -34,6 +37,9 @@ vxlnetwork::error vxlnetwork::lmdb_config::deserialize_toml (vxlnetwork::tomlcon
 	auto default_max_databases = max_databases;
 	toml.get_optional<uint32_t> ("max_databases", max_databases);
 	toml.get_optional<size_t> ("map_size", map_size);
+	toml.get_optional<bool> ("compaction", compaction);
+	toml.get_optional<unsigned> ("compaction_threshold", compaction_threshold);
+	toml.get_optional<uint32_t> ("compaction_rate_limit", compaction_rate_limit);
 
 	if (!toml.get_error ())
 	{
@@ -61,5 +67,10 @@ vxlnetwork::error vxlnetwork::lmdb_config::deserialize_toml (vxlnetwork::tomlcon
 		}
 	}
 
+	if (compaction_threshold < 1 || compaction_threshold > 100)
+	{
+		toml.get_error ().set ("compaction_threshold must be a percentage between 1 and 100");
+	}
+
 	return toml.get_error ();
 }
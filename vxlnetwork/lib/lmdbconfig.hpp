@@ -46,5 +46,12 @@ public:
 	sync_strategy sync{ always };
 	uint32_t max_databases{ 128 };
 	size_t map_size{ 256ULL * 1024 * 1024 * 1024 };
+
+	/** Rewrite the ledger into a new file in the background while the node runs, reclaiming free pages */
+	bool compaction{ false };
+	/** Percentage of the ledger file which must be free pages before a compaction starts */
+	unsigned compaction_threshold{ 50 };
+	/** Maximum rate tables are copied at in MiB/s, 0 is unlimited */
+	uint32_t compaction_rate_limit{ 64 };
 };
 }
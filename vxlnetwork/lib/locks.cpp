@@ -250,6 +250,8 @@ char const * vxlnetwork::mutex_identifier (mutexes mutex)
 	{
 		case mutexes::active:
 			return "active";
+		case mutexes::active_shard:
+			return "active_shard";
 		case mutexes::block_arrival:
 			return "block_arrival";
 		case mutexes::block_processor:
@@ -20,6 +20,7 @@ bool any_filters_registered ();
 enum class mutexes
 {
 	active,
+	active_shard,
 	block_arrival,
 	block_processor,
 	block_uniquer,
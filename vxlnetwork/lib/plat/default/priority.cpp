@@ -3,3 +3,7 @@
 void vxlnetwork::work_thread_reprioritize ()
 {
 }
+
+void vxlnetwork::thread_pin_to_cpu (unsigned)
+{
+}
@@ -14,3 +14,12 @@ void vxlnetwork::work_thread_reprioritize ()
 		(void)result;
 	}
 }
+
+void vxlnetwork::thread_pin_to_cpu (unsigned cpu_a)
+{
+	cpu_set_t cpus;
+	CPU_ZERO (&cpus);
+	CPU_SET (cpu_a % CPU_SETSIZE, &cpus);
+	auto result (pthread_setaffinity_np (pthread_self (), sizeof (cpus), &cpus));
+	(void)result;
+}
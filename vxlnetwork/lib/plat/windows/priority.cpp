@@ -5,4 +5,9 @@ void work_thread_reprioritize ()
 {
 	SetThreadPriority (GetCurrentThread (), THREAD_MODE_BACKGROUND_BEGIN);
 }
+
+void thread_pin_to_cpu (unsigned cpu_a)
+{
+	SetThreadAffinityMask (GetCurrentThread (), DWORD_PTR (1) << (cpu_a % (sizeof (DWORD_PTR) * 8)));
+}
 }
@@ -1,6 +1,55 @@
 #include <vxlnetwork/lib/rep_weights.hpp>
 #include <vxlnetwork/secure/store.hpp>
 
+#include <algorithm>
+
+namespace
+{
+std::size_t slot_index (vxlnetwork::account const & account_a)
+{
+	// Accounts are public keys and already uniformly distributed
+	return static_cast<std::size_t> (account_a.qwords[0]);
+}
+}
+
+vxlnetwork::uint128_t vxlnetwork::rep_weights::snapshot::get (vxlnetwork::account const & account_a) const
+{
+	auto existing (std::lower_bound (entries.begin (), entries.end (), account_a, [] (entry const & entry_a, vxlnetwork::account const & account_a) { return entry_a.first < account_a; }));
+	if (existing != entries.end () && existing->first == account_a)
+	{
+		return existing->second;
+	}
+	return vxlnetwork::uint128_t{ 0 };
+}
+
+std::vector<vxlnetwork::rep_weights::snapshot::entry>::const_iterator vxlnetwork::rep_weights::snapshot::begin () const
+{
+	return entries.begin ();
+}
+
+std::vector<vxlnetwork::rep_weights::snapshot::entry>::const_iterator vxlnetwork::rep_weights::snapshot::end () const
+{
+	return entries.end ();
+}
+
+std::size_t vxlnetwork::rep_weights::snapshot::size () const
+{
+	return entries.size ();
+}
+
+vxlnetwork::rep_weights::table::table (std::size_t capacity_a) :
+	mask{ capacity_a - 1 },
+	slots{ std::make_unique<slot[]> (capacity_a) }
+{
+	debug_assert ((capacity_a & mask) == 0);
+}
+
+vxlnetwork::rep_weights::rep_weights ()
+{
+	tables.push_back (std::make_unique<table> (initial_capacity));
+	current.store (tables.back ().get ());
+}
+
 void vxlnetwork::rep_weights::representation_add (vxlnetwork::account const & source_rep_a, vxlnetwork::uint128_t const & amount_a)
 {
 	vxlnetwork::lock_guard<vxlnetwork::mutex> guard (mutex);
@@ -24,6 +73,15 @@ void vxlnetwork::rep_weights::representation_add_dual (vxlnetwork::account const
 	}
 }
 
+void vxlnetwork::rep_weights::representation_add_batch (std::vector<std::pair<vxlnetwork::account, vxlnetwork::uint128_t>> const & deltas_a)
+{
+	vxlnetwork::lock_guard<vxlnetwork::mutex> guard (mutex);
+	for (auto const & [representative, amount] : deltas_a)
+	{
+		put (representative, get (representative) + amount);
+	}
+}
+
 void vxlnetwork::rep_weights::representation_put (vxlnetwork::account const & account_a, vxlnetwork::uint128_union const & representation_a)
 {
 	vxlnetwork::lock_guard<vxlnetwork::mutex> guard (mutex);
@@ -32,65 +90,180 @@ void vxlnetwork::rep_weights::representation_put (vxlnetwork::account const & ac
 
 vxlnetwork::uint128_t vxlnetwork::rep_weights::representation_get (vxlnetwork::account const & account_a) const
 {
-	vxlnetwork::lock_guard<vxlnetwork::mutex> lk (mutex);
 	return get (account_a);
 }
 
+vxlnetwork::rep_weights::snapshot vxlnetwork::rep_weights::get_snapshot () const
+{
+	vxlnetwork::rep_weights::snapshot result;
+	{
+		vxlnetwork::lock_guard<vxlnetwork::mutex> guard (mutex);
+		result.entries.reserve (count);
+		for_each ([&result] (vxlnetwork::account const & account_a, vxlnetwork::uint128_t const & weight_a) {
+			result.entries.emplace_back (account_a, weight_a);
+		});
+	}
+	std::sort (result.entries.begin (), result.entries.end (), [] (auto const & first_a, auto const & second_a) { return first_a.first < second_a.first; });
+	return result;
+}
+
 /** Makes a copy */
 std::unordered_map<vxlnetwork::account, vxlnetwork::uint128_t> vxlnetwork::rep_weights::get_rep_amounts () const
 {
+	std::unordered_map<vxlnetwork::account, vxlnetwork::uint128_t> result;
 	vxlnetwork::lock_guard<vxlnetwork::mutex> guard (mutex);
-	return rep_amounts;
+	result.reserve (count);
+	for_each ([&result] (vxlnetwork::account const & account_a, vxlnetwork::uint128_t const & weight_a) {
+		result.emplace (account_a, weight_a);
+	});
+	return result;
 }
 
 void vxlnetwork::rep_weights::copy_from (vxlnetwork::rep_weights & other_a)
 {
 	vxlnetwork::lock_guard<vxlnetwork::mutex> guard_this (mutex);
 	vxlnetwork::lock_guard<vxlnetwork::mutex> guard_other (other_a.mutex);
-	for (auto const & entry : other_a.rep_amounts)
-	{
-		auto prev_amount (get (entry.first));
-		put (entry.first, prev_amount + entry.second);
-	}
+	other_a.for_each ([this] (vxlnetwork::account const & account_a, vxlnetwork::uint128_t const & weight_a) {
+		auto prev_amount (get (account_a));
+		put (account_a, prev_amount + weight_a);
+	});
+}
+
+std::size_t vxlnetwork::rep_weights::size () const
+{
+	vxlnetwork::lock_guard<vxlnetwork::mutex> guard (mutex);
+	return count;
+}
+
+uint64_t vxlnetwork::rep_weights::version () const
+{
+	return version_m.load ();
 }
 
 void vxlnetwork::rep_weights::put (vxlnetwork::account const & account_a, vxlnetwork::uint128_union const & representation_a)
 {
-	auto it = rep_amounts.find (account_a);
-	auto amount = representation_a.number ();
-	if (it != rep_amounts.end ())
+	++version_m;
+	auto const amount (representation_a.number ());
+	auto const high (static_cast<uint64_t> (amount >> 64));
+	auto const low (static_cast<uint64_t> (amount));
+	auto table_l (current.load (std::memory_order_relaxed));
+	for (auto i (slot_index (account_a));; ++i)
 	{
-		it->second = amount;
+		auto & slot_l (table_l->slots[i & table_l->mask]);
+		auto const sequence (slot_l.sequence.load (std::memory_order_relaxed));
+		if (sequence == 0)
+		{
+			// Keep the load factor at or below one half so probe sequences stay short and always end at an empty slot
+			if ((count + 1) * 2 > table_l->mask + 1)
+			{
+				grow ();
+				put (account_a, representation_a);
+				return;
+			}
+			slot_l.account = account_a;
+			slot_l.high.store (high, std::memory_order_relaxed);
+			slot_l.low.store (low, std::memory_order_relaxed);
+			// Publishes the account and weight together
+			slot_l.sequence.store (2, std::memory_order_release);
+			++count;
+			return;
+		}
+		if (slot_l.account == account_a)
+		{
+			slot_l.sequence.store (sequence + 1, std::memory_order_relaxed);
+			std::atomic_thread_fence (std::memory_order_release);
+			slot_l.high.store (high, std::memory_order_relaxed);
+			slot_l.low.store (low, std::memory_order_relaxed);
+			// Zero marks an empty slot, skip it on wrap around
+			slot_l.sequence.store (sequence + 2 != 0 ? sequence + 2 : 2, std::memory_order_release);
+			return;
+		}
 	}
-	else
+}
+
+vxlnetwork::uint128_t vxlnetwork::rep_weights::get (vxlnetwork::account const & account_a) const
+{
+	auto table_l (current.load (std::memory_order_acquire));
+	for (auto i (slot_index (account_a));; ++i)
 	{
-		rep_amounts.emplace (account_a, amount);
+		auto const & slot_l (table_l->slots[i & table_l->mask]);
+		auto sequence (slot_l.sequence.load (std::memory_order_acquire));
+		if (sequence == 0)
+		{
+			return vxlnetwork::uint128_t{ 0 };
+		}
+		if (slot_l.account == account_a)
+		{
+			while (true)
+			{
+				auto const high (slot_l.high.load (std::memory_order_relaxed));
+				auto const low (slot_l.low.load (std::memory_order_relaxed));
+				std::atomic_thread_fence (std::memory_order_acquire);
+				auto const sequence_after (slot_l.sequence.load (std::memory_order_relaxed));
+				if ((sequence & 1) == 0 && sequence == sequence_after)
+				{
+					return (vxlnetwork::uint128_t{ high } << 64) | low;
+				}
+				// The writer is updating this slot, the retry completes as soon as it is done
+				sequence = slot_l.sequence.load (std::memory_order_acquire);
+			}
+		}
 	}
 }
 
-vxlnetwork::uint128_t vxlnetwork::rep_weights::get (vxlnetwork::account const & account_a) const
+void vxlnetwork::rep_weights::grow ()
 {
-	auto it = rep_amounts.find (account_a);
-	if (it != rep_amounts.end ())
+	auto const & previous (*current.load (std::memory_order_relaxed));
+	tables.push_back (std::make_unique<table> ((previous.mask + 1) * 2));
+	auto & next (*tables.back ());
+	for (std::size_t i = 0; i <= previous.mask; ++i)
 	{
-		return it->second;
+		auto const & source (previous.slots[i]);
+		if (source.sequence.load (std::memory_order_relaxed) != 0)
+		{
+			auto index (slot_index (source.account));
+			while (next.slots[index & next.mask].sequence.load (std::memory_order_relaxed) != 0)
+			{
+				++index;
+			}
+			auto & destination (next.slots[index & next.mask]);
+			destination.account = source.account;
+			destination.high.store (source.high.load (std::memory_order_relaxed), std::memory_order_relaxed);
+			destination.low.store (source.low.load (std::memory_order_relaxed), std::memory_order_relaxed);
+			destination.sequence.store (2, std::memory_order_relaxed);
+		}
 	}
-	else
+	// Readers loading the new table see it fully populated
+	current.store (&next, std::memory_order_release);
+}
+
+/** Visits every representative and its weight. Must be called with the mutex held */
+template <typename Op>
+void vxlnetwork::rep_weights::for_each (Op const & op_a) const
+{
+	auto const & table_l (*current.load (std::memory_order_relaxed));
+	for (std::size_t i = 0; i <= table_l.mask; ++i)
 	{
-		return vxlnetwork::uint128_t{ 0 };
+		auto const & slot_l (table_l.slots[i]);
+		if (slot_l.sequence.load (std::memory_order_relaxed) != 0)
+		{
+			op_a (slot_l.account, (vxlnetwork::uint128_t{ slot_l.high.load (std::memory_order_relaxed) } << 64) | slot_l.low.load (std::memory_order_relaxed));
+		}
 	}
 }
 
 std::unique_ptr<vxlnetwork::container_info_component> vxlnetwork::collect_container_info (vxlnetwork::rep_weights const & rep_weights, std::string const & name)
 {
 	size_t rep_amounts_count;
-
+	size_t capacity;
 	{
 		vxlnetwork::lock_guard<vxlnetwork::mutex> guard (rep_weights.mutex);
-		rep_amounts_count = rep_weights.rep_amounts.size ();
+		rep_amounts_count = rep_weights.count;
+		capacity = rep_weights.current.load ()->mask + 1;
 	}
-	auto sizeof_element = sizeof (decltype (rep_weights.rep_amounts)::value_type);
+	auto sizeof_element = sizeof (vxlnetwork::rep_weights::slot);
 	auto composite = std::make_unique<vxlnetwork::container_info_composite> (name);
 	composite->add_component (std::make_unique<vxlnetwork::container_info_leaf> (container_info{ "rep_amounts", rep_amounts_count, sizeof_element }));
+	composite->add_component (std::make_unique<vxlnetwork::container_info_leaf> (container_info{ "capacity", capacity, sizeof_element }));
 	return composite;
 }
@@ -0,0 +1,98 @@
+#pragma once
+
+#include <vxlnetwork/lib/locks.hpp>
+#include <vxlnetwork/lib/numbers.hpp>
+#include <vxlnetwork/lib/utility.hpp>
+
+#include <atomic>
+#include <memory>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace vxlnetwork
+{
+class store;
+class transaction;
+
+/**
+ * Voting weight per representative, read on every vote, tally and quorum computation.
+ *
+ * Weights live in an open-addressing table of flat slots holding the account and its 16 byte weight. Readers never take
+ * a lock: every slot is guarded by its own sequence counter and a read only retries while the single writer is updating
+ * that very slot. Representatives are never removed, so a published key is immutable and probing needs no synchronization.
+ * When the table grows a larger copy is published and the previous one is retired but kept alive, readers still probing
+ * it observe the weights as they were before the growth. With geometric growth retired tables take less memory than the current one.
+ *
+ * Writers are serialized by a mutex, a batch of deltas is applied under a single acquisition and is never observed
+ * partially by snapshot ().
+ */
+class rep_weights
+{
+public:
+	/** Point-in-time copy of all weights, ordered by representative */
+	class snapshot final
+	{
+	public:
+		using entry = std::pair<vxlnetwork::account, vxlnetwork::uint128_t>;
+		vxlnetwork::uint128_t get (vxlnetwork::account const &) const;
+		std::vector<entry>::const_iterator begin () const;
+		std::vector<entry>::const_iterator end () const;
+		std::size_t size () const;
+
+	private:
+		std::vector<entry> entries;
+		friend class vxlnetwork::rep_weights;
+	};
+
+	rep_weights ();
+	void representation_add (vxlnetwork::account const & source_rep_a, vxlnetwork::uint128_t const & amount_a);
+	void representation_add_dual (vxlnetwork::account const & source_rep_1, vxlnetwork::uint128_t const & amount_1, vxlnetwork::account const & source_rep_2, vxlnetwork::uint128_t const & amount_2);
+	/** Adds every amount (wrapping, so subtractions are expressed as 0 - amount) to its representative as a single batch */
+	void representation_add_batch (std::vector<std::pair<vxlnetwork::account, vxlnetwork::uint128_t>> const & deltas_a);
+	vxlnetwork::uint128_t representation_get (vxlnetwork::account const & account_a) const;
+	void representation_put (vxlnetwork::account const & account_a, vxlnetwork::uint128_union const & representation_a);
+	/** Makes a consistent copy, batches of deltas are either fully included or not at all */
+	vxlnetwork::rep_weights::snapshot get_snapshot () const;
+	std::unordered_map<vxlnetwork::account, vxlnetwork::uint128_t> get_rep_amounts () const;
+	void copy_from (rep_weights & other_a);
+	std::size_t size () const;
+	/** Raised by every weight change, an unchanged version means a snapshot taken meanwhile is still current */
+	uint64_t version () const;
+
+private:
+	class slot final
+	{
+	public:
+		/** Zero while the slot is empty, odd while the weight is being written */
+		std::atomic<uint32_t> sequence{ 0 };
+		vxlnetwork::account account{ 0 };
+		std::atomic<uint64_t> high{ 0 };
+		std::atomic<uint64_t> low{ 0 };
+	};
+	class table final
+	{
+	public:
+		explicit table (std::size_t capacity_a);
+		std::size_t const mask;
+		std::unique_ptr<slot[]> const slots;
+	};
+
+	static std::size_t constexpr initial_capacity{ 64 };
+	mutable vxlnetwork::mutex mutex;
+	std::atomic<table *> current;
+	/** Every table allocated so far, retired tables stay alive for readers which loaded them before a growth */
+	std::vector<std::unique_ptr<table>> tables;
+	std::size_t count{ 0 };
+	std::atomic<uint64_t> version_m{ 0 };
+	void put (vxlnetwork::account const & account_a, vxlnetwork::uint128_union const & representation_a);
+	vxlnetwork::uint128_t get (vxlnetwork::account const & account_a) const;
+	void grow ();
+	template <typename Op>
+	void for_each (Op const &) const;
+
+	friend std::unique_ptr<container_info_component> collect_container_info (rep_weights const &, std::string const &);
+};
+
+std::unique_ptr<container_info_component> collect_container_info (rep_weights const &, std::string const &);
+}
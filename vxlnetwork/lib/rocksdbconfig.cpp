@@ -7,6 +7,7 @@ vxlnetwork::error vxlnetwork::rocksdb_config::serialize_toml (vxlnetwork::tomlco
 	toml.put ("enable", enable, "Whether to use the RocksDB backend for the ledger database.\ntype:bool");
 	toml.put ("memory_multiplier", memory_multiplier, "This will modify how much memory is used represented by 1 (low), 2 (medium), 3 (high). Default is 2.\ntype:uint8");
 	toml.put ("io_threads", io_threads, "Number of threads to use with the background compaction and flushing. Number of hardware threads is recommended.\ntype:uint32");
+	toml.put ("block_cache", block_cache, "Size in MiB of the block cache shared by all tables. Memtable memory is charged against this cache as well. 0 sizes the cache from memory_multiplier.\ntype:uint64");
 	return toml.get_error ();
 }
 
@@ -15,6 +16,7 @@ vxlnetwork::error vxlnetwork::rocksdb_config::deserialize_toml (vxlnetwork::toml
 	toml.get_optional<bool> ("enable", enable);
 	toml.get_optional<uint8_t> ("memory_multiplier", memory_multiplier);
 	toml.get_optional<unsigned> ("io_threads", io_threads);
+	toml.get_optional<uint64_t> ("block_cache", block_cache);
 
 	// Validate ranges
 	if (io_threads == 0)
@@ -25,5 +25,7 @@ public:
 	bool enable{ false };
 	uint8_t memory_multiplier{ 2 };
 	unsigned io_threads{ std::thread::hardware_concurrency () };
+	/** Size in MiB of the block cache shared by all tables, memtables are charged against it as well. 0 derives it from memory_multiplier */
+	uint64_t block_cache{ 0 };
 };
 }
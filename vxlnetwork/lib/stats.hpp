@@ -241,7 +241,15 @@ public:
 		requests,
 		filter,
 		telemetry,
-		vote_generator
+		vote_generator,
+		block_cache,
+		group_commit,
+		rocksdb,
+		lmdb_compaction,
+		unchecked,
+		traffic_drop,
+		websocket,
+		rpc
 	};
 
 	/** Optional detail type */
@@ -289,6 +297,7 @@ public:
 		initiate_legacy_age,
 		initiate_lazy,
 		initiate_wallet_lazy,
+		initiate_ascending,
 
 		// bootstrap specific
 		bulk_pull,
@@ -356,6 +365,8 @@ public:
 		tcp_connect_error,
 		tcp_read_error,
 		tcp_write_error,
+		tcp_write_coalesced,
+		tcp_write_calls_saved,
 
 		// ipc
 		invocations,
@@ -367,6 +378,8 @@ public:
 		blocks_confirmed,
 		blocks_confirmed_unbounded,
 		blocks_confirmed_bounded,
+		parallel_batch,
+		parallel_conflict,
 
 		// [request] aggregator
 		aggregator_accepted,
@@ -382,8 +395,15 @@ public:
 		requests_cannot_vote,
 		requests_unknown,
 
+		// traffic class
+		vote,
+		bootstrap,
+		telemetry,
+		generic,
+
 		// duplicate
 		duplicate_publish,
+		duplicate_confirm_ack,
 
 		// telemetry
 		invalid_signature,
@@ -398,7 +418,60 @@ public:
 		generator_broadcasts,
 		generator_replies,
 		generator_replies_discarded,
-		generator_spacing
+		generator_spacing,
+
+		// block cache
+		hit,
+		miss,
+		eviction,
+		invalidation,
+
+		// group commit
+		commit,
+		commit_size,
+		queue_wait_us,
+		commit_time_us,
+
+		// rocksdb, block cache counters use hit and miss
+		bloom_filter_useful,
+		bloom_filter_prefix_useful,
+		memtable_hit,
+		memtable_miss,
+		bytes_read,
+		bytes_written,
+		compaction_bytes_read,
+		compaction_bytes_written,
+		write_stall_us,
+
+		// lmdb compaction, copied and replayed data uses bytes_read and bytes_written
+		compaction_start,
+		compaction_switch,
+		compaction_abort,
+		entries_total,
+		entries_copied,
+		changes_replayed,
+		throttle_us,
+
+		// unchecked, in-memory evictions use eviction
+		put,
+		drop,
+		trigger,
+		satisfied,
+
+		// websocket, encodings are counted per topic (vote, bootstrap and telemetry use the traffic class details), send queue overflows use overflow
+		ack,
+		confirmation,
+		stopped_election,
+		work,
+		new_unconfirmed_block,
+		fanout,
+		fanout_us,
+
+		// rpc, executed actions are counted per cost class, queue full rejections use overflow and queue times use queue_wait_us
+		light,
+		heavy,
+		queue_timeout,
+		execution_us
 	};
 
 	/** Direction of the stat. If the direction is irrelevant, use in */
@@ -90,6 +90,30 @@ std::string vxlnetwork::thread_role::get_string (vxlnetwork::thread_role::name r
 		case vxlnetwork::thread_role::name::unchecked:
 			thread_role_name_string = "Unchecked";
 			break;
+		case vxlnetwork::thread_role::name::group_commit:
+			thread_role_name_string = "Group commit";
+			break;
+		case vxlnetwork::thread_role::name::ledger_export:
+			thread_role_name_string = "Ledger export";
+			break;
+		case vxlnetwork::thread_role::name::ledger_import:
+			thread_role_name_string = "Ledger import";
+			break;
+		case vxlnetwork::thread_role::name::db_compaction:
+			thread_role_name_string = "DB compaction";
+			break;
+		case vxlnetwork::thread_role::name::io_shard:
+			thread_role_name_string = "I/O shard";
+			break;
+		case vxlnetwork::thread_role::name::confirmation_height_worker:
+			thread_role_name_string = "Conf height wrk";
+			break;
+		case vxlnetwork::thread_role::name::ipc_shared_memory:
+			thread_role_name_string = "IPC shm";
+			break;
+		case vxlnetwork::thread_role::name::rpc_executor:
+			thread_role_name_string = "RPC executor";
+			break;
 		default:
 			debug_assert (false && "vxlnetwork::thread_role::get_string unhandled thread role");
 	}
@@ -42,6 +42,14 @@ namespace thread_role
 		db_parallel_traversal,
 		election_scheduler,
 		unchecked,
+		group_commit,
+		ledger_export,
+		ledger_import,
+		db_compaction,
+		io_shard,
+		confirmation_height_worker,
+		ipc_shared_memory,
+		rpc_executor,
 	};
 
 	/*
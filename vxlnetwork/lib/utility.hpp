@@ -103,6 +103,9 @@ private:
 // Lower priority of calling work generating thread
 void work_thread_reprioritize ();
 
+// Restrict the calling thread to a single CPU, does nothing on platforms without affinity support
+void thread_pin_to_cpu (unsigned);
+
 /*
  * Functions for managing filesystem permissions, platform specific
  */
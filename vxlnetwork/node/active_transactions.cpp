@@ -10,6 +10,7 @@
 #include <boost/format.hpp>
 #include <boost/variant/get.hpp>
 
+#include <algorithm>
 #include <numeric>
 
 using namespace std::chrono;
@@ -22,14 +23,20 @@ vxlnetwork::active_transactions::active_transactions (vxlnetwork::node & node_a,
 	scheduler{ node_a.scheduler }, // Move dependencies requiring this circular reference
 	confirmation_height_processor{ confirmation_height_processor_a },
 	node{ node_a },
-	generator{ node_a.config, node_a.ledger, node_a.wallets, node_a.vote_processor, node_a.history, node_a.network, node_a.stats, false },
-	final_generator{ node_a.config, node_a.ledger, node_a.wallets, node_a.vote_processor, node_a.history, node_a.network, node_a.stats, true },
+	generator{ node_a.config, node_a.ledger, node_a.group_commit, node_a.wallets, node_a.vote_processor, node_a.history, node_a.network, node_a.stats, false },
+	final_generator{ node_a.config, node_a.ledger, node_a.group_commit, node_a.wallets, node_a.vote_processor, node_a.history, node_a.network, node_a.stats, true },
 	election_time_to_live{ node_a.network_params.network.is_dev_network () ? 0s : 2s },
 	thread ([this] () {
 		vxlnetwork::thread_role::set (vxlnetwork::thread_role::name::request_loop);
 		request_loop ();
 	})
 {
+	shards.reserve (shard_count);
+	for (std::size_t i = 0; i < shard_count; ++i)
+	{
+		shards.push_back (std::make_unique<shard> ());
+	}
+
 	// Register a callback which will get called after a block is cemented
 	confirmation_height_processor.add_cemented_observer ([this] (std::shared_ptr<vxlnetwork::block> const & callback_block_a) {
 		this->block_cemented_callback (callback_block_a);
@@ -53,7 +60,7 @@ bool vxlnetwork::active_transactions::insert_election_from_frontiers_confirmatio
 {
 	bool inserted{ false };
 	vxlnetwork::unique_lock<vxlnetwork::mutex> lock (mutex);
-	if (roots.get<tag_root> ().find (block_a->qualified_root ()) == roots.get<tag_root> ().end ())
+	if (!active (block_a->qualified_root ()))
 	{
 		std::function<void (std::shared_ptr<vxlnetwork::block> const &)> election_confirmation_cb;
 		if (election_behavior_a == vxlnetwork::election_behavior::optimistic)
@@ -282,20 +289,18 @@ void vxlnetwork::active_transactions::block_already_cemented_callback (vxlnetwor
 
 int64_t vxlnetwork::active_transactions::vacancy () const
 {
-	vxlnetwork::lock_guard<vxlnetwork::mutex> lock{ mutex };
-	auto result = static_cast<int64_t> (node.config.active_elections_size) - static_cast<int64_t> (roots.size ());
+	auto result = static_cast<int64_t> (node.config.active_elections_size) - static_cast<int64_t> (roots_size.load ());
 	return result;
 }
 
 void vxlnetwork::active_transactions::request_confirm (vxlnetwork::unique_lock<vxlnetwork::mutex> & lock_a)
 {
 	debug_assert (lock_a.owns_lock ());
-
-	std::size_t const this_loop_target_l (roots.size ());
-	auto const elections_l{ list_active_impl (this_loop_target_l) };
-
 	lock_a.unlock ();
 
+	auto const elections_l{ list_active () };
+	std::size_t const this_loop_target_l (elections_l.size ());
+
 	vxlnetwork::confirmation_solicitor solicitor (node.network, node.config);
 	solicitor.prepare (node.rep_crawler.principal_representatives (std::numeric_limits<std::size_t>::max ()));
 	vxlnetwork::vote_generator_session generator_session (generator);
@@ -305,7 +310,7 @@ void vxlnetwork::active_transactions::request_confirm (vxlnetwork::unique_lock<v
 	vxlnetwork::timer<std::chrono::milliseconds> elapsed (vxlnetwork::timer_state::started);
 
 	/*
-	 * Loop through active elections in descending order of proof-of-work difficulty, requesting confirmation
+	 * Loop through active elections from the oldest, requesting confirmation
 	 *
 	 * Only up to a certain amount of elections are queued for confirmation request and block rebroadcasting. The remaining elections can still be confirmed if votes arrive
 	 * Elections extending the soft config.active_elections_size limit are flushed after a certain time-to-live cutoff
@@ -358,12 +363,24 @@ void vxlnetwork::active_transactions::cleanup_election (vxlnetwork::unique_lock<
 	auto blocks_l = election.blocks ();
 	for (auto const & [hash, block] : blocks_l)
 	{
-		auto erased (blocks.erase (hash));
-		(void)erased;
-		debug_assert (erased == 1);
+		{
+			auto & shard_l (block_shard (hash));
+			vxlnetwork::lock_guard<vxlnetwork::mutex> guard (shard_l.mutex);
+			[[maybe_unused]] auto erased (shard_l.blocks.erase (hash));
+			debug_assert (erased == 1);
+		}
 		erase_inactive_votes_cache (hash);
 	}
-	roots.get<tag_root> ().erase (roots.get<tag_root> ().find (election.qualified_root));
+	{
+		auto & shard_l (root_shard (election.qualified_root));
+		vxlnetwork::lock_guard<vxlnetwork::mutex> guard (shard_l.mutex);
+		auto existing (shard_l.roots.get<tag_root> ().find (election.qualified_root));
+		if (existing != shard_l.roots.get<tag_root> ().end ())
+		{
+			shard_l.roots.get<tag_root> ().erase (existing);
+			--roots_size;
+		}
+	}
 
 	lock_a.unlock ();
 	vacancy_update ();
@@ -391,22 +408,22 @@ void vxlnetwork::active_transactions::cleanup_election (vxlnetwork::unique_lock<
 
 std::vector<std::shared_ptr<vxlnetwork::election>> vxlnetwork::active_transactions::list_active (std::size_t max_a)
 {
-	vxlnetwork::lock_guard<vxlnetwork::mutex> guard (mutex);
-	return list_active_impl (max_a);
-}
-
-std::vector<std::shared_ptr<vxlnetwork::election>> vxlnetwork::active_transactions::list_active_impl (std::size_t max_a) const
-{
-	std::vector<std::shared_ptr<vxlnetwork::election>> result_l;
-	result_l.reserve (std::min (max_a, roots.size ()));
+	// Shards are visited one at a time, elections inserted or erased meanwhile may or may not be listed
+	std::vector<std::pair<uint64_t, std::shared_ptr<vxlnetwork::election>>> sorted_l;
+	sorted_l.reserve (roots_size);
+	for (auto const & shard_l : shards)
 	{
-		auto & sorted_roots_l (roots.get<tag_random_access> ());
-		std::size_t count_l{ 0 };
-		for (auto i = sorted_roots_l.begin (), n = sorted_roots_l.end (); i != n && count_l < max_a; ++i, ++count_l)
+		vxlnetwork::lock_guard<vxlnetwork::mutex> guard (shard_l->mutex);
+		for (auto const & info : shard_l->roots.get<tag_random_access> ())
 		{
-			result_l.push_back (i->election);
+			sorted_l.emplace_back (info.sequence, info.election);
 		}
 	}
+	auto const count_l (std::min (max_a, sorted_l.size ()));
+	std::partial_sort (sorted_l.begin (), sorted_l.begin () + count_l, sorted_l.end (), [] (auto const & lhs, auto const & rhs) { return lhs.first < rhs.first; });
+	std::vector<std::shared_ptr<vxlnetwork::election>> result_l;
+	result_l.reserve (count_l);
+	std::transform (sorted_l.begin (), sorted_l.begin () + count_l, std::back_inserter (result_l), [] (auto const & item_a) { return item_a.second; });
 	return result_l;
 }
 
@@ -451,7 +468,7 @@ void vxlnetwork::active_transactions::frontiers_confirmation (vxlnetwork::unique
 	// Spend some time prioritizing accounts with the most uncemented blocks to reduce voting traffic
 	auto request_interval = std::chrono::milliseconds (node.network_params.network.request_interval_ms);
 	// Spend longer searching ledger accounts when there is a low amount of elections going on
-	auto low_active = roots.size () < 1000;
+	auto low_active = size () < 1000;
 	auto time_to_spend_prioritizing_ledger_accounts = request_interval / (low_active ? 20 : 100);
 	auto time_to_spend_prioritizing_wallet_accounts = request_interval / 250;
 	auto time_to_spend_confirming_pessimistic_accounts = time_to_spend_prioritizing_ledger_accounts;
@@ -791,7 +808,7 @@ void vxlnetwork::active_transactions::stop ()
 	generator.stop ();
 	final_generator.stop ();
 	lock.lock ();
-	roots.clear ();
+	clear ();
 }
 
 vxlnetwork::election_insertion_result vxlnetwork::active_transactions::insert_impl (vxlnetwork::unique_lock<vxlnetwork::mutex> & lock_a, std::shared_ptr<vxlnetwork::block> const & block_a, boost::optional<vxlnetwork::uint128_t> const & previous_balance_a, vxlnetwork::election_behavior election_behavior_a, std::function<void (std::shared_ptr<vxlnetwork::block> const &)> const & confirmation_action_a)
@@ -802,8 +819,9 @@ vxlnetwork::election_insertion_result vxlnetwork::active_transactions::insert_im
 	if (!stopped)
 	{
 		auto root (block_a->qualified_root ());
-		auto existing (roots.get<tag_root> ().find (root));
-		if (existing == roots.get<tag_root> ().end ())
+		auto & root_shard_l (root_shard (root));
+		auto existing (election (root));
+		if (existing == nullptr)
 		{
 			if (recently_confirmed.get<tag_root> ().find (root) == recently_confirmed.get<tag_root> ().end ())
 			{
@@ -826,18 +844,28 @@ vxlnetwork::election_insertion_result vxlnetwork::active_transactions::insert_im
 					node.online_reps.observe (rep_a);
 				},
 				election_behavior_a);
-				roots.get<tag_root> ().emplace (vxlnetwork::active_transactions::conflict_info{ root, result.election, epoch, previous_balance });
-				blocks.emplace (hash, result.election);
+				{
+					vxlnetwork::lock_guard<vxlnetwork::mutex> guard (root_shard_l.mutex);
+					root_shard_l.roots.get<tag_root> ().emplace (vxlnetwork::active_transactions::conflict_info{ root, result.election, epoch, previous_balance, next_sequence++ });
+				}
+				++roots_size;
+				{
+					auto & block_shard_l (block_shard (hash));
+					vxlnetwork::lock_guard<vxlnetwork::mutex> guard (block_shard_l.mutex);
+					block_shard_l.blocks.emplace (hash, result.election);
+				}
 				auto const cache = find_inactive_votes_cache_impl (hash);
 				lock_a.unlock ();
 				result.election->insert_inactive_votes_cache (cache);
+				// Votes for this hash seen before the election must be accepted again when they are rebroadcast
+				node.network.vote_digests.erase (hash);
 				node.stats.inc (vxlnetwork::stat::type::election, vxlnetwork::stat::detail::election_start);
 				vacancy_update ();
 			}
 		}
 		else
 		{
-			result.election = existing->election;
+			result.election = existing;
 		}
 
 		if (lock_a.owns_lock ())
@@ -861,44 +889,47 @@ vxlnetwork::vote_code vxlnetwork::active_transactions::vote (std::shared_ptr<vxl
 	// If all hashes were recently confirmed then it is a replay
 	unsigned recently_confirmed_counter (0);
 	std::vector<std::pair<std::shared_ptr<vxlnetwork::election>, vxlnetwork::block_hash>> process;
+	// Lookup of a block hash or a full block, only takes a shard mutex
+	auto find_election = [this] (auto const & vote_block_a) {
+		if (vote_block_a.which ())
+		{
+			auto const & block_hash (boost::get<vxlnetwork::block_hash> (vote_block_a));
+			return std::make_pair (block_election (block_hash), block_hash);
+		}
+		auto const & block (boost::get<std::shared_ptr<vxlnetwork::block>> (vote_block_a));
+		return std::make_pair (election (block->qualified_root ()), block->hash ());
+	};
+	std::vector<std::pair<decltype (vote_a->blocks)::value_type, vxlnetwork::block_hash>> missing;
+	for (auto const & vote_block : vote_a->blocks)
+	{
+		auto [election_l, block_hash] = find_election (vote_block);
+		if (election_l != nullptr)
+		{
+			process.emplace_back (election_l, block_hash);
+		}
+		else
+		{
+			missing.emplace_back (vote_block, block_hash);
+		}
+	}
+	if (!missing.empty ())
 	{
 		vxlnetwork::unique_lock<vxlnetwork::mutex> lock (mutex);
-		for (auto vote_block : vote_a->blocks)
+		for (auto const & [vote_block, block_hash] : missing)
 		{
-			auto & recently_confirmed_by_hash (recently_confirmed.get<tag_hash> ());
-			if (vote_block.which ())
+			// An election can have started since the lookup, elections are only inserted with the active mutex held
+			auto election_l (find_election (vote_block).first);
+			if (election_l != nullptr)
 			{
-				auto const & block_hash (boost::get<vxlnetwork::block_hash> (vote_block));
-				auto existing (blocks.find (block_hash));
-				if (existing != blocks.end ())
-				{
-					process.emplace_back (existing->second, block_hash);
-				}
-				else if (recently_confirmed_by_hash.count (block_hash) == 0)
-				{
-					add_inactive_votes_cache (lock, block_hash, vote_a->account, vote_a->timestamp ());
-				}
-				else
-				{
-					++recently_confirmed_counter;
-				}
+				process.emplace_back (election_l, block_hash);
+			}
+			else if (recently_confirmed.get<tag_hash> ().count (block_hash) == 0)
+			{
+				add_inactive_votes_cache (lock, block_hash, vote_a->account, vote_a->timestamp ());
 			}
 			else
 			{
-				auto block (boost::get<std::shared_ptr<vxlnetwork::block>> (vote_block));
-				auto existing (roots.get<tag_root> ().find (block->qualified_root ()));
-				if (existing != roots.get<tag_root> ().end ())
-				{
-					process.emplace_back (existing->election, block->hash ());
-				}
-				else if (recently_confirmed_by_hash.count (block->hash ()) == 0)
-				{
-					add_inactive_votes_cache (lock, block->hash (), vote_a->account, vote_a->timestamp ());
-				}
-				else
-				{
-					++recently_confirmed_counter;
-				}
+				++recently_confirmed_counter;
 			}
 		}
 	}
@@ -934,37 +965,62 @@ vxlnetwork::vote_code vxlnetwork::active_transactions::vote (std::shared_ptr<vxl
 
 bool vxlnetwork::active_transactions::active (vxlnetwork::qualified_root const & root_a)
 {
-	vxlnetwork::lock_guard<vxlnetwork::mutex> lock (mutex);
-	return roots.get<tag_root> ().find (root_a) != roots.get<tag_root> ().end ();
+	return election (root_a) != nullptr;
 }
 
 bool vxlnetwork::active_transactions::active (vxlnetwork::block const & block_a)
 {
-	vxlnetwork::lock_guard<vxlnetwork::mutex> guard (mutex);
-	return roots.get<tag_root> ().find (block_a.qualified_root ()) != roots.get<tag_root> ().end () && blocks.find (block_a.hash ()) != blocks.end ();
+	return active (block_a.qualified_root ()) && active (block_a.hash ());
+}
+
+bool vxlnetwork::active_transactions::active (vxlnetwork::block_hash const & hash_a)
+{
+	return block_election (hash_a) != nullptr;
 }
 
 std::shared_ptr<vxlnetwork::election> vxlnetwork::active_transactions::election (vxlnetwork::qualified_root const & root_a) const
 {
 	std::shared_ptr<vxlnetwork::election> result;
-	vxlnetwork::lock_guard<vxlnetwork::mutex> lock (mutex);
-	auto existing = roots.get<tag_root> ().find (root_a);
-	if (existing != roots.get<tag_root> ().end ())
+	auto & shard_l (root_shard (root_a));
+	vxlnetwork::lock_guard<vxlnetwork::mutex> guard (shard_l.mutex);
+	auto existing = shard_l.roots.get<tag_root> ().find (root_a);
+	if (existing != shard_l.roots.get<tag_root> ().end ())
 	{
 		result = existing->election;
 	}
 	return result;
 }
 
+std::shared_ptr<vxlnetwork::election> vxlnetwork::active_transactions::block_election (vxlnetwork::block_hash const & hash_a) const
+{
+	std::shared_ptr<vxlnetwork::election> result;
+	auto & shard_l (block_shard (hash_a));
+	vxlnetwork::lock_guard<vxlnetwork::mutex> guard (shard_l.mutex);
+	auto existing = shard_l.blocks.find (hash_a);
+	if (existing != shard_l.blocks.end ())
+	{
+		result = existing->second;
+	}
+	return result;
+}
+
+vxlnetwork::active_transactions::shard & vxlnetwork::active_transactions::root_shard (vxlnetwork::qualified_root const & root_a) const
+{
+	// Roots are either block hashes or accounts, both are uniformly distributed
+	return *shards[root_a.root ().raw.qwords[0] % shards.size ()];
+}
+
+vxlnetwork::active_transactions::shard & vxlnetwork::active_transactions::block_shard (vxlnetwork::block_hash const & hash_a) const
+{
+	return *shards[hash_a.qwords[0] % shards.size ()];
+}
+
 std::shared_ptr<vxlnetwork::block> vxlnetwork::active_transactions::winner (vxlnetwork::block_hash const & hash_a) const
 {
 	std::shared_ptr<vxlnetwork::block> result;
-	vxlnetwork::unique_lock<vxlnetwork::mutex> lock (mutex);
-	auto existing = blocks.find (hash_a);
-	if (existing != blocks.end ())
+	auto election (block_election (hash_a));
+	if (election != nullptr)
 	{
-		auto election = existing->second;
-		lock.unlock ();
 		result = election->winner ();
 	}
 	return result;
@@ -1010,57 +1066,92 @@ void vxlnetwork::active_transactions::erase (vxlnetwork::block const & block_a)
 void vxlnetwork::active_transactions::erase (vxlnetwork::qualified_root const & root_a)
 {
 	vxlnetwork::unique_lock<vxlnetwork::mutex> lock (mutex);
-	auto root_it (roots.get<tag_root> ().find (root_a));
-	if (root_it != roots.get<tag_root> ().end ())
+	auto election_l (election (root_a));
+	if (election_l != nullptr)
 	{
-		cleanup_election (lock, *root_it->election);
+		cleanup_election (lock, *election_l);
 	}
 }
 
 void vxlnetwork::active_transactions::erase_hash (vxlnetwork::block_hash const & hash_a)
 {
-	vxlnetwork::unique_lock<vxlnetwork::mutex> lock (mutex);
-	[[maybe_unused]] auto erased (blocks.erase (hash_a));
+	vxlnetwork::lock_guard<vxlnetwork::mutex> lock (mutex);
+	auto & shard_l (block_shard (hash_a));
+	vxlnetwork::lock_guard<vxlnetwork::mutex> guard (shard_l.mutex);
+	[[maybe_unused]] auto erased (shard_l.blocks.erase (hash_a));
 	debug_assert (erased == 1);
 }
 
 void vxlnetwork::active_transactions::erase_oldest ()
 {
 	vxlnetwork::unique_lock<vxlnetwork::mutex> lock (mutex);
-	if (!roots.empty ())
+	// Elections are appended to their shard, so the oldest one is at the front of one of the shards
+	std::shared_ptr<vxlnetwork::election> oldest;
+	uint64_t oldest_sequence{ std::numeric_limits<uint64_t>::max () };
+	for (auto const & shard_l : shards)
+	{
+		vxlnetwork::lock_guard<vxlnetwork::mutex> guard (shard_l->mutex);
+		auto & sequenced (shard_l->roots.get<tag_random_access> ());
+		if (!sequenced.empty () && sequenced.front ().sequence < oldest_sequence)
+		{
+			oldest = sequenced.front ().election;
+			oldest_sequence = sequenced.front ().sequence;
+		}
+	}
+	if (oldest != nullptr)
 	{
 		node.stats.inc (vxlnetwork::stat::type::election, vxlnetwork::stat::detail::election_drop_overflow);
-		auto item = roots.get<tag_random_access> ().front ();
-		cleanup_election (lock, *item.election);
+		cleanup_election (lock, *oldest);
+	}
+}
+
+void vxlnetwork::active_transactions::clear ()
+{
+	for (auto const & shard_l : shards)
+	{
+		vxlnetwork::lock_guard<vxlnetwork::mutex> guard (shard_l->mutex);
+		roots_size -= shard_l->roots.size ();
+		shard_l->roots.clear ();
+		shard_l->blocks.clear ();
 	}
 }
 
 bool vxlnetwork::active_transactions::empty ()
 {
-	vxlnetwork::lock_guard<vxlnetwork::mutex> lock (mutex);
-	return roots.empty ();
+	return roots_size == 0;
 }
 
 std::size_t vxlnetwork::active_transactions::size ()
 {
-	vxlnetwork::lock_guard<vxlnetwork::mutex> lock (mutex);
-	return roots.size ();
+	return roots_size;
+}
+
+std::size_t vxlnetwork::active_transactions::blocks_size ()
+{
+	std::size_t result (0);
+	for (auto const & shard_l : shards)
+	{
+		vxlnetwork::lock_guard<vxlnetwork::mutex> guard (shard_l->mutex);
+		result += shard_l->blocks.size ();
+	}
+	return result;
 }
 
 bool vxlnetwork::active_transactions::publish (std::shared_ptr<vxlnetwork::block> const & block_a)
 {
-	vxlnetwork::unique_lock<vxlnetwork::mutex> lock (mutex);
-	auto existing (roots.get<tag_root> ().find (block_a->qualified_root ()));
+	auto election (this->election (block_a->qualified_root ()));
 	auto result (true);
-	if (existing != roots.get<tag_root> ().end ())
+	if (election != nullptr)
 	{
-		auto election (existing->election);
-		lock.unlock ();
 		result = election->publish (block_a);
 		if (!result)
 		{
-			lock.lock ();
-			blocks.emplace (block_a->hash (), election);
+			vxlnetwork::unique_lock<vxlnetwork::mutex> lock (mutex);
+			{
+				auto & shard_l (block_shard (block_a->hash ()));
+				vxlnetwork::lock_guard<vxlnetwork::mutex> guard (shard_l.mutex);
+				shard_l.blocks.emplace (block_a->hash (), election);
+			}
 			auto const cache = find_inactive_votes_cache_impl (block_a->hash ());
 			lock.unlock ();
 			election->insert_inactive_votes_cache (cache);
@@ -1074,18 +1165,16 @@ bool vxlnetwork::active_transactions::publish (std::shared_ptr<vxlnetwork::block
 boost::optional<vxlnetwork::election_status_type> vxlnetwork::active_transactions::confirm_block (vxlnetwork::transaction const & transaction_a, std::shared_ptr<vxlnetwork::block> const & block_a)
 {
 	auto hash (block_a->hash ());
-	vxlnetwork::unique_lock<vxlnetwork::mutex> lock (mutex);
-	auto existing (blocks.find (hash));
+	auto existing (block_election (hash));
 	boost::optional<vxlnetwork::election_status_type> status_type;
-	if (existing != blocks.end ())
+	if (existing != nullptr)
 	{
-		lock.unlock ();
-		vxlnetwork::unique_lock<vxlnetwork::mutex> election_lock (existing->second->mutex);
-		if (existing->second->status.winner && existing->second->status.winner->hash () == hash)
+		vxlnetwork::unique_lock<vxlnetwork::mutex> election_lock (existing->mutex);
+		if (existing->status.winner && existing->status.winner->hash () == hash)
 		{
-			if (!existing->second->confirmed ())
+			if (!existing->confirmed ())
 			{
-				existing->second->confirm_once (election_lock, vxlnetwork::election_status_type::active_confirmation_height);
+				existing->confirm_once (election_lock, vxlnetwork::election_status_type::active_confirmation_height);
 				status_type = vxlnetwork::election_status_type::active_confirmation_height;
 			}
 			else
@@ -1334,17 +1423,17 @@ std::unique_ptr<vxlnetwork::container_info_component> vxlnetwork::collect_contai
 	std::size_t recently_confirmed_count;
 	std::size_t recently_cemented_count;
 
+	roots_count = active_transactions.size ();
+	blocks_count = active_transactions.blocks_size ();
 	{
 		vxlnetwork::lock_guard<vxlnetwork::mutex> guard (active_transactions.mutex);
-		roots_count = active_transactions.roots.size ();
-		blocks_count = active_transactions.blocks.size ();
 		recently_confirmed_count = active_transactions.recently_confirmed.size ();
 		recently_cemented_count = active_transactions.recently_cemented.size ();
 	}
 
 	auto composite = std::make_unique<container_info_composite> (name);
-	composite->add_component (std::make_unique<container_info_leaf> (container_info{ "roots", roots_count, sizeof (decltype (active_transactions.roots)::value_type) }));
-	composite->add_component (std::make_unique<container_info_leaf> (container_info{ "blocks", blocks_count, sizeof (decltype (active_transactions.blocks)::value_type) }));
+	composite->add_component (std::make_unique<container_info_leaf> (container_info{ "roots", roots_count, sizeof (vxlnetwork::active_transactions::ordered_roots::value_type) }));
+	composite->add_component (std::make_unique<container_info_leaf> (container_info{ "blocks", blocks_count, sizeof (decltype (vxlnetwork::active_transactions::shard::blocks)::value_type) }));
 	composite->add_component (std::make_unique<container_info_leaf> (container_info{ "election_winner_details", active_transactions.election_winner_details_size (), sizeof (decltype (active_transactions.election_winner_details)::value_type) }));
 	composite->add_component (std::make_unique<container_info_leaf> (container_info{ "recently_confirmed", recently_confirmed_count, sizeof (decltype (active_transactions.recently_confirmed)::value_type) }));
 	composite->add_component (std::make_unique<container_info_leaf> (container_info{ "recently_cemented", recently_cemented_count, sizeof (decltype (active_transactions.recently_cemented)::value_type) }));
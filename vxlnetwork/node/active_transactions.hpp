@@ -90,6 +90,8 @@ class active_transactions final
 		std::shared_ptr<vxlnetwork::election> election;
 		vxlnetwork::epoch epoch;
 		vxlnetwork::uint128_t previous_balance;
+		/** Insertion order across all shards */
+		uint64_t sequence;
 	};
 
 	friend class vxlnetwork::election;
@@ -114,8 +116,6 @@ public:
 		mi::hashed_unique<mi::tag<tag_root>,
 			mi::member<conflict_info, vxlnetwork::qualified_root, &conflict_info::root>>>>;
 	// clang-format on
-	ordered_roots roots;
-	using roots_iterator = active_transactions::ordered_roots::index_iterator<tag_root>::type;
 
 	explicit active_transactions (vxlnetwork::node &, vxlnetwork::confirmation_height_processor &);
 	~active_transactions ();
@@ -124,15 +124,20 @@ public:
 	// Is the root of this block in the roots container
 	bool active (vxlnetwork::block const &);
 	bool active (vxlnetwork::qualified_root const &);
+	// Is this block hash in any active election
+	bool active (vxlnetwork::block_hash const &);
 	std::shared_ptr<vxlnetwork::election> election (vxlnetwork::qualified_root const &) const;
 	std::shared_ptr<vxlnetwork::block> winner (vxlnetwork::block_hash const &) const;
-	// Returns a list of elections sorted by difficulty
+	// Returns a list of elections, oldest first
 	std::vector<std::shared_ptr<vxlnetwork::election>> list_active (std::size_t = std::numeric_limits<std::size_t>::max ());
 	void erase (vxlnetwork::block const &);
 	void erase_hash (vxlnetwork::block_hash const &);
 	void erase_oldest ();
+	// Drops every election without cleaning up after it
+	void clear ();
 	bool empty ();
 	std::size_t size ();
+	std::size_t blocks_size ();
 	void stop ();
 	bool publish (std::shared_ptr<vxlnetwork::block> const &);
 	boost::optional<vxlnetwork::election_status_type> confirm_block (vxlnetwork::transaction const &, std::shared_ptr<vxlnetwork::block> const &);
@@ -142,7 +147,6 @@ public:
 	int64_t vacancy () const;
 	std::function<void ()> vacancy_update{ [] () {} };
 
-	std::unordered_map<vxlnetwork::block_hash, std::shared_ptr<vxlnetwork::election>> blocks;
 	std::deque<vxlnetwork::election_status> list_recently_cemented ();
 	std::deque<vxlnetwork::election_status> recently_cemented;
 
@@ -184,6 +188,28 @@ public:
 	// clang-format on
 
 private:
+	/**
+	 * Part of the active elections, guarded by its own mutex.
+	 * A root lives in the shard selected by its hash, a block hash in the shard selected by the block hash itself as votes
+	 * only carry hashes, so the blocks of an election can be spread over several shards. Inserting and erasing elections
+	 * also holds the active mutex, which is always locked before a shard mutex. At most one shard mutex is held at a time.
+	 */
+	class shard final
+	{
+	public:
+		vxlnetwork::mutex mutex{ mutex_identifier (mutexes::active_shard) };
+		ordered_roots roots;
+		std::unordered_map<vxlnetwork::block_hash, std::shared_ptr<vxlnetwork::election>> blocks;
+	};
+	shard & root_shard (vxlnetwork::qualified_root const &) const;
+	shard & block_shard (vxlnetwork::block_hash const &) const;
+	std::shared_ptr<vxlnetwork::election> block_election (vxlnetwork::block_hash const &) const;
+	static std::size_t constexpr shard_count{ 16 };
+	std::vector<std::unique_ptr<shard>> shards;
+	std::atomic<std::size_t> roots_size{ 0 };
+	// Guarded by the active mutex
+	uint64_t next_sequence{ 0 };
+
 	vxlnetwork::mutex election_winner_details_mutex{ mutex_identifier (mutexes::election_winner_details) };
 
 	std::unordered_map<vxlnetwork::block_hash, std::shared_ptr<vxlnetwork::election>> election_winner_details;
@@ -197,8 +223,6 @@ private:
 	void erase (vxlnetwork::qualified_root const &);
 	// Erase all blocks from active and, if not confirmed, clear digests from network filters
 	void cleanup_election (vxlnetwork::unique_lock<vxlnetwork::mutex> & lock_a, vxlnetwork::election const &);
-	// Returns a list of elections sorted by difficulty, mutex must be locked
-	std::vector<std::shared_ptr<vxlnetwork::election>> list_active_impl (std::size_t) const;
 
 	vxlnetwork::condition_variable condition;
 	bool started{ false };
@@ -1,5 +1,6 @@
 #include <vxlnetwork/lib/threading.hpp>
 #include <vxlnetwork/node/bootstrap/bootstrap.hpp>
+#include <vxlnetwork/node/bootstrap/bootstrap_ascending.hpp>
 #include <vxlnetwork/node/bootstrap/bootstrap_lazy.hpp>
 #include <vxlnetwork/node/bootstrap/bootstrap_legacy.hpp>
 #include <vxlnetwork/node/common.hpp>
@@ -127,6 +128,24 @@ void vxlnetwork::bootstrap_initiator::bootstrap_wallet (std::deque<vxlnetwork::a
 	condition.notify_all ();
 }
 
+void vxlnetwork::bootstrap_initiator::bootstrap_ascending (bool force, std::string id_a)
+{
+	if (force)
+	{
+		stop_attempts ();
+	}
+	vxlnetwork::unique_lock<vxlnetwork::mutex> lock (mutex);
+	if (!stopped && find_attempt (vxlnetwork::bootstrap_mode::ascending) == nullptr)
+	{
+		node.stats.inc (vxlnetwork::stat::type::bootstrap, vxlnetwork::stat::detail::initiate_ascending, vxlnetwork::stat::dir::out);
+		auto ascending_attempt (std::make_shared<vxlnetwork::bootstrap_attempt_ascending> (node.shared (), attempts.incremental++, id_a));
+		attempts_list.push_back (ascending_attempt);
+		attempts.add (ascending_attempt);
+		lock.unlock ();
+		condition.notify_all ();
+	}
+}
+
 void vxlnetwork::bootstrap_initiator::run_bootstrap ()
 {
 	vxlnetwork::unique_lock<vxlnetwork::mutex> lock (mutex);
@@ -245,6 +264,12 @@ std::shared_ptr<vxlnetwork::bootstrap_attempt> vxlnetwork::bootstrap_initiator::
 	return find_attempt (vxlnetwork::bootstrap_mode::wallet_lazy);
 }
 
+std::shared_ptr<vxlnetwork::bootstrap_attempt> vxlnetwork::bootstrap_initiator::current_ascending_attempt ()
+{
+	vxlnetwork::lock_guard<vxlnetwork::mutex> lock (mutex);
+	return find_attempt (vxlnetwork::bootstrap_mode::ascending);
+}
+
 void vxlnetwork::bootstrap_initiator::stop_attempts ()
 {
 	vxlnetwork::unique_lock<vxlnetwork::mutex> lock (mutex);
@@ -27,7 +27,8 @@ enum class bootstrap_mode
 {
 	legacy,
 	lazy,
-	wallet_lazy
+	wallet_lazy,
+	ascending
 };
 enum class sync_result
 {
@@ -82,7 +83,7 @@ public:
 
 /**
  * Client side portion to initiate bootstrap sessions. Prevents multiple legacy-type bootstrap sessions from being started at the same time. Does permit
- * lazy/wallet bootstrap sessions to overlap with legacy sessions.
+ * lazy/wallet/ascending bootstrap sessions to overlap with legacy sessions.
  */
 class bootstrap_initiator final
 {
@@ -93,6 +94,7 @@ public:
 	void bootstrap (bool force = false, std::string id_a = "", uint32_t const frontiers_age_a = std::numeric_limits<uint32_t>::max (), vxlnetwork::account const & start_account_a = vxlnetwork::account{});
 	bool bootstrap_lazy (vxlnetwork::hash_or_account const &, bool force = false, bool confirmed = true, std::string id_a = "");
 	void bootstrap_wallet (std::deque<vxlnetwork::account> &);
+	void bootstrap_ascending (bool force = false, std::string id_a = "");
 	void run_bootstrap ();
 	void lazy_requeue (vxlnetwork::block_hash const &, vxlnetwork::block_hash const &);
 	void notify_listeners (bool);
@@ -105,6 +107,7 @@ public:
 	std::shared_ptr<vxlnetwork::bootstrap_attempt> current_attempt ();
 	std::shared_ptr<vxlnetwork::bootstrap_attempt> current_lazy_attempt ();
 	std::shared_ptr<vxlnetwork::bootstrap_attempt> current_wallet_attempt ();
+	std::shared_ptr<vxlnetwork::bootstrap_attempt> current_ascending_attempt ();
 	vxlnetwork::pulls_cache cache;
 	vxlnetwork::bootstrap_attempts attempts;
 	void stop ();
@@ -148,5 +151,15 @@ public:
 	static constexpr uint64_t lazy_batch_pull_count_resize_blocks_limit = 4 * 1024 * 1024;
 	static constexpr double lazy_batch_pull_count_resize_ratio = 2.0;
 	static constexpr std::size_t lazy_blocks_restart_limit = 1024 * 1024;
+	static constexpr double ascending_peer_rate_initial = 4.0;
+	static constexpr double ascending_peer_rate_min = 0.5;
+	static constexpr double ascending_peer_rate_max = 64.0;
+	static constexpr std::size_t ascending_accounts_max = 64 * 1024;
+	static constexpr std::size_t ascending_refill_threshold = 1024;
+	static constexpr std::size_t ascending_ledger_batch = 4 * 1024;
+	static constexpr unsigned ascending_account_pulls_max = 4;
+	static constexpr double ascending_priority_ledger = 1.0;
+	static constexpr double ascending_priority_unchecked = 2.0;
+	static constexpr double ascending_priority_min = 1.0;
 };
 }
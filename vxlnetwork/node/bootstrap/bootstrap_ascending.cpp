@@ -0,0 +1,376 @@
+#include <vxlnetwork/node/bootstrap/bootstrap.hpp>
+#include <vxlnetwork/node/bootstrap/bootstrap_ascending.hpp>
+#include <vxlnetwork/node/common.hpp>
+#include <vxlnetwork/node/node.hpp>
+#include <vxlnetwork/node/transport/tcp.hpp>
+
+#include <boost/format.hpp>
+
+#include <algorithm>
+
+constexpr double vxlnetwork::bootstrap_limits::ascending_peer_rate_initial;
+constexpr double vxlnetwork::bootstrap_limits::ascending_peer_rate_min;
+constexpr double vxlnetwork::bootstrap_limits::ascending_peer_rate_max;
+constexpr std::size_t vxlnetwork::bootstrap_limits::ascending_accounts_max;
+constexpr std::size_t vxlnetwork::bootstrap_limits::ascending_refill_threshold;
+constexpr std::size_t vxlnetwork::bootstrap_limits::ascending_ledger_batch;
+constexpr unsigned vxlnetwork::bootstrap_limits::ascending_account_pulls_max;
+constexpr double vxlnetwork::bootstrap_limits::ascending_priority_ledger;
+constexpr double vxlnetwork::bootstrap_limits::ascending_priority_unchecked;
+constexpr double vxlnetwork::bootstrap_limits::ascending_priority_min;
+
+vxlnetwork::bootstrap_attempt_ascending::bootstrap_attempt_ascending (std::shared_ptr<vxlnetwork::node> const & node_a, uint64_t incremental_id_a, std::string const & id_a) :
+	vxlnetwork::bootstrap_attempt (node_a, vxlnetwork::bootstrap_mode::ascending, incremental_id_a, id_a)
+{
+	node->bootstrap_initiator.notify_listeners (true);
+}
+
+bool vxlnetwork::bootstrap_attempt_ascending::pull_target::operator== (vxlnetwork::bootstrap_attempt_ascending::pull_target const & other_a) const
+{
+	return start == other_a.start && is_hash == other_a.is_hash;
+}
+
+std::size_t vxlnetwork::bootstrap_attempt_ascending::pull_target_hash::operator() (vxlnetwork::bootstrap_attempt_ascending::pull_target const & target_a) const
+{
+	return std::hash<vxlnetwork::uint256_union> () (target_a.start.raw) ^ static_cast<std::size_t> (target_a.is_hash);
+}
+
+void vxlnetwork::bootstrap_attempt_ascending::prioritize (vxlnetwork::account const & account_a, double priority_a, vxlnetwork::block_hash const & resume_a)
+{
+	{
+		vxlnetwork::lock_guard<vxlnetwork::mutex> lock (mutex);
+		prioritize_locked (pull_target{ account_a, false }, priority_a, resume_a);
+	}
+	condition.notify_all ();
+}
+
+void vxlnetwork::bootstrap_attempt_ascending::prioritize_locked (vxlnetwork::bootstrap_attempt_ascending::pull_target const & target_a, double priority_a, vxlnetwork::block_hash const & resume_a)
+{
+	debug_assert (!mutex.try_lock ());
+	auto pulls (target_pulls.find (target_a));
+	if (target_a.start.is_zero () || (pulls != target_pulls.end () && pulls->second >= vxlnetwork::bootstrap_limits::ascending_account_pulls_max))
+	{
+		return;
+	}
+	auto & by_target (accounts.get<tag_target> ());
+	auto existing (by_target.find (target_a));
+	if (existing != by_target.end ())
+	{
+		by_target.modify (existing, [priority_a, &resume_a] (target_priority & entry_a) {
+			entry_a.priority += priority_a;
+			if (!resume_a.is_zero ())
+			{
+				entry_a.resume = resume_a;
+			}
+		});
+	}
+	else if (accounts.size () < vxlnetwork::bootstrap_limits::ascending_accounts_max)
+	{
+		accounts.insert (target_priority{ target_a, priority_a, resume_a });
+	}
+}
+
+std::size_t vxlnetwork::bootstrap_attempt_ascending::accounts_size ()
+{
+	vxlnetwork::lock_guard<vxlnetwork::mutex> lock (mutex);
+	return accounts.size ();
+}
+
+bool vxlnetwork::bootstrap_attempt_ascending::finished ()
+{
+	debug_assert (!mutex.try_lock ());
+	return stopped || (accounts.empty () && unchecked_scanned && ledger_exhausted && pulling == 0);
+}
+
+void vxlnetwork::bootstrap_attempt_ascending::refill (vxlnetwork::unique_lock<vxlnetwork::mutex> & lock_a)
+{
+	if (accounts.size () >= vxlnetwork::bootstrap_limits::ascending_refill_threshold)
+	{
+		return;
+	}
+	if (!unchecked_scanned)
+	{
+		// Blocks waiting for a dependency point at chains which are known to be behind
+		std::vector<pull_target> found;
+		lock_a.unlock ();
+		auto transaction (node->store.tx_begin_read ());
+		node->unchecked.for_each (
+		transaction, [&found] (vxlnetwork::unchecked_key const & key_a, vxlnetwork::unchecked_info const & info_a) {
+			pull_target dependency{ 0, false };
+			if (key_a.previous == info_a.block->previous ())
+			{
+				// A missing previous block belongs to the same account, which is pulled from the remote head down to the local frontier
+				dependency.start = !info_a.account.is_zero () ? info_a.account : info_a.block->account ();
+			}
+			if (dependency.start.is_zero ())
+			{
+				// The account of a missing source block is not known locally, pull the chain ending at the block itself
+				dependency = pull_target{ key_a.previous, true };
+			}
+			if (!dependency.start.is_zero ())
+			{
+				found.push_back (dependency);
+			}
+		},
+		[&found, &stopped = stopped] () { return !stopped && found.size () < vxlnetwork::bootstrap_limits::ascending_accounts_max; });
+		lock_a.lock ();
+		for (auto const & target : found)
+		{
+			prioritize_locked (target, vxlnetwork::bootstrap_limits::ascending_priority_unchecked, vxlnetwork::block_hash (0));
+		}
+		unchecked_scanned = true;
+	}
+	else if (!ledger_exhausted)
+	{
+		std::vector<vxlnetwork::account> found;
+		auto cursor (ledger_cursor);
+		lock_a.unlock ();
+		{
+			auto transaction (node->store.tx_begin_read ());
+			for (auto i (node->store.account.begin (transaction, cursor)), n (node->store.account.end ()); i != n && found.size () < vxlnetwork::bootstrap_limits::ascending_ledger_batch; ++i)
+			{
+				found.push_back (i->first);
+			}
+		}
+		lock_a.lock ();
+		for (auto const & account : found)
+		{
+			prioritize_locked (pull_target{ account, false }, vxlnetwork::bootstrap_limits::ascending_priority_ledger, vxlnetwork::block_hash (0));
+		}
+		if (found.size () < vxlnetwork::bootstrap_limits::ascending_ledger_batch || found.back ().number () == std::numeric_limits<vxlnetwork::uint256_t>::max ())
+		{
+			ledger_exhausted = true;
+		}
+		else
+		{
+			ledger_cursor = found.back ().number () + 1;
+		}
+	}
+}
+
+bool vxlnetwork::bootstrap_attempt_ascending::peer_ready (vxlnetwork::bootstrap_attempt_ascending::peer_state & peer_a, std::chrono::steady_clock::time_point const & now_a)
+{
+	auto elapsed (std::chrono::duration_cast<std::chrono::duration<double>> (now_a - peer_a.refilled).count ());
+	// Bucket holds at most one second worth of pulls
+	peer_a.tokens = std::min (std::max (1.0, peer_a.rate), peer_a.tokens + elapsed * peer_a.rate);
+	peer_a.refilled = now_a;
+	bool result (false);
+	if (peer_a.tokens >= 1.0)
+	{
+		peer_a.tokens -= 1.0;
+		result = true;
+	}
+	return result;
+}
+
+void vxlnetwork::bootstrap_attempt_ascending::request (vxlnetwork::unique_lock<vxlnetwork::mutex> & lock_a)
+{
+	lock_a.unlock ();
+	auto connection_l (node->bootstrap_initiator.connections->connection (shared_from_this ()));
+	lock_a.lock ();
+	if (connection_l == nullptr || stopped)
+	{
+		if (connection_l != nullptr)
+		{
+			lock_a.unlock ();
+			node->bootstrap_initiator.connections->pool_connection (connection_l);
+			lock_a.lock ();
+		}
+		return;
+	}
+	auto now (std::chrono::steady_clock::now ());
+	auto endpoint (connection_l->channel->get_tcp_endpoint ());
+	auto peer (peers.find (endpoint));
+	if (peer == peers.end ())
+	{
+		peer = peers.emplace (endpoint, peer_state{ vxlnetwork::bootstrap_limits::ascending_peer_rate_initial, 1.0, now }).first;
+	}
+	if (!accounts.empty () && peer_ready (peer->second, now))
+	{
+		auto & by_priority (accounts.get<tag_priority> ());
+		auto top (by_priority.begin ());
+		auto entry (*top);
+		by_priority.erase (top);
+		pulling_targets[entry.target.start.raw] = entry;
+		++target_pulls[entry.target];
+		++peer->second.in_flight;
+		++pulling;
+		lock_a.unlock ();
+		vxlnetwork::account_info info;
+		vxlnetwork::block_hash frontier (0);
+		if (!entry.target.is_hash && !node->store.account.get (node->store.tx_begin_read (), entry.target.start.as_account (), info))
+		{
+			frontier = info.head;
+		}
+		// Pull from the remote head down to the local frontier, only the missing segment of the chain is transferred
+		// A block hash pulls the chain ending at that block
+		vxlnetwork::pull_info pull (entry.target.start, entry.target.start.as_block_hash (), frontier, incremental_id, 0, node->network_params.bootstrap.lazy_retry_limit);
+		if (!entry.resume.is_zero ())
+		{
+			pull.head = entry.resume;
+		}
+		auto this_l (shared_from_this ());
+		// The bulk_pull_client destructor reports back to this attempt which can cause a deadlock if this is the last reference
+		// Dispatch request in an external thread in case it needs to be destroyed
+		node->background ([connection_l, this_l, pull] () {
+			auto client (std::make_shared<vxlnetwork::bulk_pull_client> (connection_l, this_l, pull));
+			client->request ();
+		});
+		lock_a.lock ();
+	}
+	else
+	{
+		// Peer is over its rate, hand the connection back behind the other idle ones so the next request uses a different peer
+		lock_a.unlock ();
+		node->bootstrap_initiator.connections->pool_connection (connection_l, false, true);
+		lock_a.lock ();
+		auto wait (std::chrono::milliseconds (static_cast<int64_t> (1000.0 / std::max (peer->second.rate, vxlnetwork::bootstrap_limits::ascending_peer_rate_min))));
+		condition.wait_for (lock_a, std::min (wait, std::chrono::milliseconds (100)));
+	}
+}
+
+bool vxlnetwork::bootstrap_attempt_ascending::process_block (std::shared_ptr<vxlnetwork::block> const & block_a, vxlnetwork::account const & known_account_a, uint64_t pull_blocks_processed, vxlnetwork::bulk_pull::count_t max_blocks, bool block_expected, unsigned retry_limit)
+{
+	auto stop_pull (vxlnetwork::bootstrap_attempt::process_block (block_a, known_account_a, pull_blocks_processed, max_blocks, block_expected, retry_limit));
+	if (block_expected)
+	{
+		// Destinations of sends are accounts the local ledger may not know about yet
+		vxlnetwork::account destination (block_a->destination ());
+		if (destination.is_zero () && block_a->type () == vxlnetwork::block_type::state)
+		{
+			auto const & link (block_a->link ());
+			if (!link.is_zero () && !node->ledger.is_epoch_link (link) && !node->ledger.block_or_pruned_exists (link.as_block_hash ()))
+			{
+				destination = link.as_account ();
+			}
+		}
+		if (!destination.is_zero ())
+		{
+			prioritize (destination, vxlnetwork::bootstrap_limits::ascending_priority_ledger);
+		}
+	}
+	return stop_pull;
+}
+
+void vxlnetwork::bootstrap_attempt_ascending::ascending_pull_finished (vxlnetwork::pull_info const & pull_a, vxlnetwork::tcp_endpoint const & endpoint_a, uint64_t blocks_a, bool success_a, bool network_error_a)
+{
+	{
+		vxlnetwork::lock_guard<vxlnetwork::mutex> lock (mutex);
+		auto peer (peers.find (endpoint_a));
+		if (peer != peers.end ())
+		{
+			auto & state (peer->second);
+			debug_assert (state.in_flight > 0);
+			--state.in_flight;
+			++state.pulls;
+			state.blocks += blocks_a;
+			if (blocks_a > 0 && success_a)
+			{
+				// Additive increase while the peer keeps delivering
+				state.rate = std::min (vxlnetwork::bootstrap_limits::ascending_peer_rate_max, state.rate + 1.0);
+			}
+			else if (network_error_a || blocks_a > 0)
+			{
+				// Multiplicative decrease when the pull broke off
+				++state.failures;
+				state.rate = std::max (vxlnetwork::bootstrap_limits::ascending_peer_rate_min, state.rate / 2.0);
+			}
+			else
+			{
+				++state.empty;
+			}
+		}
+		pull_target target{ pull_a.account_or_head, false };
+		double priority (vxlnetwork::bootstrap_limits::ascending_priority_ledger);
+		auto existing (pulling_targets.find (pull_a.account_or_head.raw));
+		if (existing != pulling_targets.end ())
+		{
+			target = existing->second.target;
+			priority = existing->second.priority;
+			pulling_targets.erase (existing);
+		}
+		if (success_a)
+		{
+			++pulls_completed;
+		}
+		else if (blocks_a > 0)
+		{
+			// Partial chain, continue from where the peer stopped before anything else
+			++pulls_failed;
+			prioritize_locked (target, priority * 2.0, pull_a.head);
+		}
+		else if (network_error_a)
+		{
+			// Nothing was learnt about the account, retry with another peer
+			++pulls_failed;
+			prioritize_locked (target, priority, vxlnetwork::block_hash (0));
+		}
+		else
+		{
+			// Remote has nothing above the local frontier
+			++pulls_empty;
+			if (priority / 2.0 >= vxlnetwork::bootstrap_limits::ascending_priority_min)
+			{
+				prioritize_locked (target, priority / 2.0, vxlnetwork::block_hash (0));
+			}
+		}
+	}
+	condition.notify_all ();
+}
+
+void vxlnetwork::bootstrap_attempt_ascending::run ()
+{
+	debug_assert (started);
+	node->bootstrap_initiator.connections->populate_connections (false);
+	vxlnetwork::unique_lock<vxlnetwork::mutex> lock (mutex);
+	while (!finished ())
+	{
+		refill (lock);
+		if (!accounts.empty ())
+		{
+			request (lock);
+		}
+		else if (!finished ())
+		{
+			// Wait for running pulls to feed accounts back
+			condition.wait_for (lock, std::chrono::seconds (1));
+		}
+	}
+	if (!stopped)
+	{
+		node->logger.try_log (boost::str (boost::format ("Completed ascending pulls, %1% accounts pulled, %2% failed, %3% already in sync") % pulls_completed % pulls_failed % pulls_empty));
+	}
+	lock.unlock ();
+	stop ();
+	condition.notify_all ();
+}
+
+void vxlnetwork::bootstrap_attempt_ascending::get_information (boost::property_tree::ptree & tree_a)
+{
+	vxlnetwork::lock_guard<vxlnetwork::mutex> lock (mutex);
+	auto elapsed (std::max (std::chrono::duration_cast<std::chrono::duration<double>> (std::chrono::steady_clock::now () - attempt_start).count (), vxlnetwork::bootstrap_limits::bootstrap_minimum_elapsed_seconds_blockrate));
+	auto pulls_total (pulls_completed + pulls_failed + pulls_empty);
+	tree_a.put ("accounts", std::to_string (accounts.size ()));
+	tree_a.put ("pulls_completed", std::to_string (pulls_completed));
+	tree_a.put ("pulls_failed", std::to_string (pulls_failed));
+	tree_a.put ("pulls_empty", std::to_string (pulls_empty));
+	tree_a.put ("pulls_per_sec", std::to_string (pulls_total / elapsed));
+	tree_a.put ("blocks_per_sec", std::to_string (total_blocks / elapsed));
+	tree_a.put ("ledger_exhausted", ledger_exhausted);
+	boost::property_tree::ptree peers_l;
+	for (auto const & [endpoint, state] : peers)
+	{
+		boost::property_tree::ptree entry;
+		entry.put ("endpoint", boost::str (boost::format ("%1%") % endpoint));
+		entry.put ("rate", std::to_string (state.rate));
+		entry.put ("in_flight", std::to_string (state.in_flight));
+		entry.put ("pulls", std::to_string (state.pulls));
+		entry.put ("failures", std::to_string (state.failures));
+		entry.put ("empty", std::to_string (state.empty));
+		entry.put ("blocks", std::to_string (state.blocks));
+		// Blocks delivered per pull made
+		entry.put ("efficiency", std::to_string (state.pulls != 0 ? static_cast<double> (state.blocks) / state.pulls : 0.0));
+		peers_l.push_back (std::make_pair ("", entry));
+	}
+	tree_a.add_child ("peers", peers_l);
+}
@@ -0,0 +1,111 @@
+#pragma once
+
+#include <vxlnetwork/node/bootstrap/bootstrap_attempt.hpp>
+
+#include <boost/multi_index/hashed_index.hpp>
+#include <boost/multi_index/member.hpp>
+#include <boost/multi_index/ordered_index.hpp>
+#include <boost/multi_index_container.hpp>
+#include <boost/property_tree/ptree_fwd.hpp>
+
+#include <atomic>
+#include <unordered_map>
+
+namespace mi = boost::multi_index;
+
+namespace vxlnetwork
+{
+class node;
+
+/**
+ * Ascending bootstrap session. Keeps a prioritized set of accounts taken from the dependencies of blocks in unchecked, from
+ * the local ledger and from send destinations seen while pulling, and pulls each chain from the remote head down to the local frontier.
+ * A missing source block has no known account and is pulled by its hash instead.
+ * Pulls for different accounts are spread over all bootstrap connections in parallel. Every peer has its own pull rate which grows
+ * while its pulls return blocks and halves when they fail, and the outcome of each pull raises or lowers the priority of the account.
+ */
+class bootstrap_attempt_ascending final : public bootstrap_attempt
+{
+public:
+	explicit bootstrap_attempt_ascending (std::shared_ptr<vxlnetwork::node> const & node_a, uint64_t incremental_id_a, std::string const & id_a = "");
+	void run () override;
+	bool process_block (std::shared_ptr<vxlnetwork::block> const &, vxlnetwork::account const &, uint64_t, vxlnetwork::bulk_pull::count_t, bool, unsigned) override;
+	void ascending_pull_finished (vxlnetwork::pull_info const &, vxlnetwork::tcp_endpoint const &, uint64_t, bool, bool) override;
+	void get_information (boost::property_tree::ptree &) override;
+	/** Adds \p priority_a to the priority of \p account_a, inserting the account if needed. A non-zero \p resume_a continues the next pull from that block */
+	void prioritize (vxlnetwork::account const & account_a, double priority_a, vxlnetwork::block_hash const & resume_a = vxlnetwork::block_hash (0));
+	std::size_t accounts_size ();
+
+	/** Start of a chain to pull, an account or the hash of a missing source block whose account is not known locally */
+	class pull_target final
+	{
+	public:
+		vxlnetwork::hash_or_account start;
+		bool is_hash;
+		bool operator== (vxlnetwork::bootstrap_attempt_ascending::pull_target const &) const;
+	};
+	class pull_target_hash final
+	{
+	public:
+		std::size_t operator() (vxlnetwork::bootstrap_attempt_ascending::pull_target const &) const;
+	};
+	class target_priority final
+	{
+	public:
+		vxlnetwork::bootstrap_attempt_ascending::pull_target target;
+		double priority;
+		vxlnetwork::block_hash resume;
+	};
+
+	class peer_state final
+	{
+	public:
+		/** Pulls per second this peer is currently allowed */
+		double rate;
+		double tokens;
+		std::chrono::steady_clock::time_point refilled;
+		unsigned in_flight{ 0 };
+		uint64_t pulls{ 0 };
+		uint64_t failures{ 0 };
+		/** Pulls that returned no blocks */
+		uint64_t empty{ 0 };
+		uint64_t blocks{ 0 };
+	};
+
+private:
+	bool finished ();
+	void prioritize_locked (vxlnetwork::bootstrap_attempt_ascending::pull_target const &, double, vxlnetwork::block_hash const &);
+	void refill (vxlnetwork::unique_lock<vxlnetwork::mutex> &);
+	void request (vxlnetwork::unique_lock<vxlnetwork::mutex> &);
+	/** Takes a token from the peer's bucket if one is available */
+	bool peer_ready (vxlnetwork::bootstrap_attempt_ascending::peer_state &, std::chrono::steady_clock::time_point const &);
+
+	class tag_target
+	{
+	};
+	class tag_priority
+	{
+	};
+	// clang-format off
+	boost::multi_index_container<target_priority,
+	mi::indexed_by<
+		mi::hashed_unique<mi::tag<tag_target>,
+			mi::member<target_priority, pull_target, &target_priority::target>, pull_target_hash>,
+		mi::ordered_non_unique<mi::tag<tag_priority>,
+			mi::member<target_priority, double, &target_priority::priority>, std::greater<double>>>>
+	accounts;
+	// clang-format on
+	/** Targets currently being pulled with their priority, by the start sent in the bulk_pull, used to requeue them once the pull finishes */
+	std::unordered_map<vxlnetwork::uint256_union, target_priority> pulling_targets;
+	/** Number of pulls made for each target, targets reaching bootstrap_limits::ascending_account_pulls_max are not queued again */
+	std::unordered_map<pull_target, unsigned, pull_target_hash> target_pulls;
+	std::unordered_map<vxlnetwork::tcp_endpoint, peer_state> peers;
+	/** Next account to read from the ledger */
+	vxlnetwork::account ledger_cursor{ 0 };
+	bool ledger_exhausted{ false };
+	bool unchecked_scanned{ false };
+	uint64_t pulls_completed{ 0 };
+	uint64_t pulls_failed{ 0 };
+	uint64_t pulls_empty{ 0 };
+};
+}
@@ -110,6 +110,10 @@ std::string vxlnetwork::bootstrap_attempt::mode_text ()
 	{
 		mode_text = "wallet_lazy";
 	}
+	else if (mode == vxlnetwork::bootstrap_mode::ascending)
+	{
+		mode_text = "ascending";
+	}
 	return mode_text;
 }
 
@@ -199,3 +203,8 @@ std::size_t vxlnetwork::bootstrap_attempt::wallet_size ()
 	debug_assert (mode == vxlnetwork::bootstrap_mode::wallet_lazy);
 	return 0;
 }
+
+void vxlnetwork::bootstrap_attempt::ascending_pull_finished (vxlnetwork::pull_info const &, vxlnetwork::tcp_endpoint const &, uint64_t, bool, bool)
+{
+	debug_assert (mode == vxlnetwork::bootstrap_mode::ascending);
+}
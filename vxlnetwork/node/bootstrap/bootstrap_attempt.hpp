@@ -41,6 +41,8 @@ public:
 	virtual void requeue_pending (vxlnetwork::account const &);
 	virtual void wallet_start (std::deque<vxlnetwork::account> &);
 	virtual std::size_t wallet_size ();
+	/** Reports the outcome of an ascending pull of \p blocks from \p endpoint, \p success when the chain reached the requested end */
+	virtual void ascending_pull_finished (vxlnetwork::pull_info const &, vxlnetwork::tcp_endpoint const &, uint64_t blocks, bool success, bool network_error);
 	virtual void get_information (boost::property_tree::ptree &) = 0;
 	vxlnetwork::mutex next_log_mutex;
 	std::chrono::steady_clock::time_point next_log{ std::chrono::steady_clock::now () };
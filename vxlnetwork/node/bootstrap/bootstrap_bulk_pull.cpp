@@ -31,9 +31,19 @@ vxlnetwork::bulk_pull_client::bulk_pull_client (std::shared_ptr<vxlnetwork::boot
 
 vxlnetwork::bulk_pull_client::~bulk_pull_client ()
 {
+	if (attempt->mode == vxlnetwork::bootstrap_mode::ascending)
+	{
+		// Ascending attempts schedule their own pulls, report the outcome instead of requeueing
+		auto success (expected == pull.end || expected.is_zero ());
+		if (!success)
+		{
+			pull.head = expected;
+		}
+		attempt->ascending_pull_finished (pull, connection->channel->get_tcp_endpoint (), pull_blocks - unexpected_count, success, network_error);
+	}
 	/* If received end block is not expected end block
 	Or if given start and end blocks are from different chains (i.e. forked node or malicious node) */
-	if (expected != pull.end && !expected.is_zero ())
+	else if (expected != pull.end && !expected.is_zero ())
 	{
 		pull.head = expected;
 		if (attempt->mode != vxlnetwork::bootstrap_mode::legacy)
@@ -184,8 +194,8 @@ void vxlnetwork::bulk_pull_client::received_type ()
 		}
 		case vxlnetwork::block_type::not_a_block:
 		{
-			// Avoid re-using slow peers, or peers that sent the wrong blocks.
-			if (!connection->pending_stop && (expected == pull.end || (pull.count != 0 && pull.count == pull_blocks)))
+			// Avoid re-using slow peers, or peers that sent the wrong blocks. An empty reply to an ascending pull means the account is in sync.
+			if (!connection->pending_stop && (expected == pull.end || (pull.count != 0 && pull.count == pull_blocks) || (attempt->mode == vxlnetwork::bootstrap_mode::ascending && pull_blocks == 0)))
 			{
 				connection->connections.pool_connection (connection);
 			}
@@ -221,7 +231,18 @@ void vxlnetwork::bulk_pull_client::received_block (boost::system::error_code con
 			bool block_expected (false);
 			// Unconfirmed head is used only for lazy destinations if legacy bootstrap is not available, see vxlnetwork::bootstrap_attempt::lazy_destinations_increment (...)
 			bool unconfirmed_account_head (connection->node->flags.disable_legacy_bootstrap && pull_blocks == 0 && pull.retry_limit <= connection->node->network_params.bootstrap.lazy_retry_limit && expected == pull.account_or_head && block->account () == pull.account_or_head);
-			if (hash == expected || unconfirmed_account_head)
+			// Ascending pulls start from the account without knowing the remote head, which must be an open or state block of that account, or a legacy block following one of its local blocks
+			bool ascending_account_head (false);
+			if (attempt->mode == vxlnetwork::bootstrap_mode::ascending && pull_blocks == 0 && pull.head == pull.head_original && !pull.account_or_head.is_zero ())
+			{
+				ascending_account_head = block->account () == pull.account_or_head;
+				if (!ascending_account_head && block->account ().is_zero () && !block->previous ().is_zero ())
+				{
+					auto transaction (connection->node->store.tx_begin_read ());
+					ascending_account_head = connection->node->store.block.exists (transaction, block->previous ()) && connection->node->ledger.account (transaction, block->previous ()) == pull.account_or_head;
+				}
+			}
+			if (hash == expected || unconfirmed_account_head || ascending_account_head)
 			{
 				expected = block->previous ();
 				block_expected = true;
@@ -232,7 +253,7 @@ void vxlnetwork::bulk_pull_client::received_block (boost::system::error_code con
 			}
 			if (pull_blocks == 0 && block_expected)
 			{
-				known_account = block->account ();
+				known_account = ascending_account_head ? pull.account_or_head.as_account () : block->account ();
 			}
 			if (connection->block_count++ == 0)
 			{
@@ -496,7 +517,7 @@ void vxlnetwork::bulk_pull_server::send_next ()
 		}
 		connection->socket->async_write (vxlnetwork::shared_const_buffer (std::move (send_buffer)), [this_l] (boost::system::error_code const & ec, std::size_t size_a) {
 			this_l->sent_action (ec, size_a);
-		});
+		}, vxlnetwork::traffic_class::bootstrap);
 	}
 	else
 	{
@@ -600,7 +621,7 @@ void vxlnetwork::bulk_pull_server::send_finished ()
 	}
 	connection->socket->async_write (send_buffer, [this_l] (boost::system::error_code const & ec, std::size_t size_a) {
 		this_l->no_block_sent (ec, size_a);
-	});
+	}, vxlnetwork::traffic_class::bootstrap);
 }
 
 void vxlnetwork::bulk_pull_server::no_block_sent (boost::system::error_code const & ec, std::size_t size_a)
@@ -702,7 +723,7 @@ void vxlnetwork::bulk_pull_account_server::send_frontier ()
 		auto this_l (shared_from_this ());
 		connection->socket->async_write (vxlnetwork::shared_const_buffer (std::move (send_buffer)), [this_l] (boost::system::error_code const & ec, std::size_t size_a) {
 			this_l->sent_action (ec, size_a);
-		});
+		}, vxlnetwork::traffic_class::bootstrap);
 	}
 }
 
@@ -758,7 +779,7 @@ void vxlnetwork::bulk_pull_account_server::send_next_block ()
 		auto this_l (shared_from_this ());
 		connection->socket->async_write (vxlnetwork::shared_const_buffer (std::move (send_buffer)), [this_l] (boost::system::error_code const & ec, std::size_t size_a) {
 			this_l->sent_action (ec, size_a);
-		});
+		}, vxlnetwork::traffic_class::bootstrap);
 	}
 	else
 	{
@@ -905,7 +926,7 @@ void vxlnetwork::bulk_pull_account_server::send_finished ()
 
 	connection->socket->async_write (vxlnetwork::shared_const_buffer (std::move (send_buffer)), [this_l] (boost::system::error_code const & ec, std::size_t size_a) {
 		this_l->complete (ec, size_a);
-	});
+	}, vxlnetwork::traffic_class::bootstrap);
 }
 
 void vxlnetwork::bulk_pull_account_server::complete (boost::system::error_code const & ec, std::size_t size_a)
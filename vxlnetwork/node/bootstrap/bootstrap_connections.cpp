@@ -1,4 +1,5 @@
 #include <vxlnetwork/node/bootstrap/bootstrap.hpp>
+#include <vxlnetwork/node/bootstrap/bootstrap_ascending.hpp>
 #include <vxlnetwork/node/bootstrap/bootstrap_attempt.hpp>
 #include <vxlnetwork/node/bootstrap/bootstrap_connections.hpp>
 #include <vxlnetwork/node/common.hpp>
@@ -206,11 +207,17 @@ void vxlnetwork::bootstrap_connections::populate_connections (bool repeat)
 	double rate_sum = 0.0;
 	std::size_t num_pulls = 0;
 	std::size_t attempts_count = node.bootstrap_initiator.attempts.size ();
+	// Ascending pulls are handed straight to idle connections, scale on the accounts still queued instead
+	std::size_t ascending_pulls = 0;
+	if (auto ascending_attempt = node.bootstrap_initiator.current_ascending_attempt ())
+	{
+		ascending_pulls = std::static_pointer_cast<vxlnetwork::bootstrap_attempt_ascending> (ascending_attempt)->accounts_size ();
+	}
 	std::priority_queue<std::shared_ptr<vxlnetwork::bootstrap_client>, std::vector<std::shared_ptr<vxlnetwork::bootstrap_client>>, block_rate_cmp> sorted_connections;
 	std::unordered_set<vxlnetwork::tcp_endpoint> endpoints;
 	{
 		vxlnetwork::unique_lock<vxlnetwork::mutex> lock (mutex);
-		num_pulls = pulls.size ();
+		num_pulls = pulls.size () + ascending_pulls;
 		std::deque<std::weak_ptr<vxlnetwork::bootstrap_client>> new_clients;
 		for (auto & c : clients)
 		{
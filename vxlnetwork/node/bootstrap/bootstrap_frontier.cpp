@@ -268,7 +268,7 @@ void vxlnetwork::frontier_req_server::send_next ()
 		next ();
 		connection->socket->async_write (vxlnetwork::shared_const_buffer (std::move (send_buffer)), [this_l] (boost::system::error_code const & ec, std::size_t size_a) {
 			this_l->sent_action (ec, size_a);
-		});
+		}, vxlnetwork::traffic_class::bootstrap);
 	}
 	else
 	{
@@ -292,7 +292,7 @@ void vxlnetwork::frontier_req_server::send_finished ()
 	}
 	connection->socket->async_write (vxlnetwork::shared_const_buffer (std::move (send_buffer)), [this_l] (boost::system::error_code const & ec, std::size_t size_a) {
 		this_l->no_block_sent (ec, size_a);
-	});
+	}, vxlnetwork::traffic_class::bootstrap);
 }
 
 void vxlnetwork::frontier_req_server::no_block_sent (boost::system::error_code const & ec, std::size_t size_a)
@@ -512,34 +512,49 @@ void vxlnetwork::bootstrap_server::receive_confirm_ack_action (boost::system::er
 {
 	if (!ec)
 	{
-		auto error (false);
-		vxlnetwork::bufferstream stream (receive_buffer->data (), size_a);
-		auto request (std::make_unique<vxlnetwork::confirm_ack> (error, stream, header_a));
-		if (!error)
+		vxlnetwork::uint128_t digest;
+		auto duplicate (node->network.vote_filter.apply (receive_buffer->data (), size_a, &digest));
+		// A representative's own reply to a rep crawler query must not be lost behind a relayed copy of the same vote
+		if (duplicate && node->rep_crawler.is_queried (vxlnetwork::transport::map_tcp_to_endpoint (remote_endpoint)))
 		{
-			if (is_realtime_connection ())
+			duplicate = false;
+		}
+		if (!duplicate)
+		{
+			auto error (false);
+			vxlnetwork::bufferstream stream (receive_buffer->data (), size_a);
+			auto request (std::make_unique<vxlnetwork::confirm_ack> (error, stream, header_a, digest));
+			if (!error)
 			{
-				bool process_vote (true);
-				if (header_a.block_type () != vxlnetwork::block_type::not_a_block)
+				if (is_realtime_connection ())
 				{
-					for (auto & vote_block : request->vote->blocks)
+					bool process_vote (true);
+					if (header_a.block_type () != vxlnetwork::block_type::not_a_block)
 					{
-						if (!vote_block.which ())
+						for (auto & vote_block : request->vote->blocks)
 						{
-							auto const & block (boost::get<std::shared_ptr<vxlnetwork::block>> (vote_block));
-							if (node->network_params.work.validate_entry (*block))
+							if (!vote_block.which ())
 							{
-								process_vote = false;
-								node->stats.inc_detail_only (vxlnetwork::stat::type::error, vxlnetwork::stat::detail::insufficient_work);
+								auto const & block (boost::get<std::shared_ptr<vxlnetwork::block>> (vote_block));
+								if (node->network_params.work.validate_entry (*block))
+								{
+									process_vote = false;
+									node->stats.inc_detail_only (vxlnetwork::stat::type::error, vxlnetwork::stat::detail::insufficient_work);
+								}
 							}
 						}
 					}
+					if (process_vote)
+					{
+						add_request (std::unique_ptr<vxlnetwork::message> (request.release ()));
+					}
 				}
-				if (process_vote)
-				{
-					add_request (std::unique_ptr<vxlnetwork::message> (request.release ()));
-				}
+				receive ();
 			}
+		}
+		else
+		{
+			node->stats.inc (vxlnetwork::stat::type::filter, vxlnetwork::stat::detail::duplicate_confirm_ack);
 			receive ();
 		}
 	}
@@ -727,7 +742,7 @@ public:
 						connection_l->finish_request ();
 					}
 				}
-			});
+			}, vxlnetwork::traffic_class::bootstrap);
 		}
 		else if (message_a.response)
 		{
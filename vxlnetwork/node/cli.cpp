@@ -4,6 +4,7 @@
 #include <vxlnetwork/node/cli.hpp>
 #include <vxlnetwork/node/common.hpp>
 #include <vxlnetwork/node/daemonconfig.hpp>
+#include <vxlnetwork/node/ledger_export.hpp>
 #include <vxlnetwork/node/node.hpp>
 
 #include <boost/format.hpp>
@@ -61,6 +62,8 @@ void vxlnetwork::add_node_options (boost::program_options::options_description &
 	("final_vote_clear", "Clear final votes")
 	("rebuild_database", "Rebuild LMDB database with vacuum for best compaction")
 	("migrate_database_lmdb_to_rocksdb", "Migrates LMDB database to RocksDB")
+	("ledger_export", "Writes the ledger to <file> in a backend independent format")
+	("ledger_import", "Loads the ledger from <file> written by --ledger_export in to an empty database in data_path")
 	("diagnostics", "Run internal diagnostics")
 	("generate_config", boost::program_options::value<std::string> (), "Write configuration to stdout, populated with defaults suitable for this system. Pass the configuration type node, rpc or tls. See also use_defaults.")
 	("key_create", "Generates a adhoc random keypair and prints it to stdout")
@@ -97,6 +100,7 @@ void vxlnetwork::add_node_flag_options (boost::program_options::options_descript
 		("disable_lazy_bootstrap", "Disables lazy bootstrap")
 		("disable_legacy_bootstrap", "Disables legacy bootstrap")
 		("disable_wallet_bootstrap", "Disables wallet lazy bootstrap")
+		("enable_ascending_bootstrap", "Replaces ongoing legacy bootstrap with parallel ascending bootstrap of local and unchecked accounts")
 		("disable_ongoing_bootstrap", "Disable ongoing bootstrap")
 		("disable_rep_crawler", "Disable rep crawler")
 		("disable_request_loop", "Disable request loop")
@@ -116,6 +120,7 @@ void vxlnetwork::add_node_flag_options (boost::program_options::options_descript
 		("block_processor_verification_size", boost::program_options::value<std::size_t>(), "Increase batch signature verification size in block processor, default 0 (limited by config signature_checker_threads), unlimited for fast_bootstrap")
 		("inactive_votes_cache_size", boost::program_options::value<std::size_t>(), "Increase cached votes without active elections size, default 16384")
 		("vote_processor_capacity", boost::program_options::value<std::size_t>(), "Vote processor queue size before dropping votes, default 144k")
+		("unchecked_memory_limit", boost::program_options::value<std::size_t>(), "Keep unchecked blocks in memory only, bounded to this many MiB with the oldest blocks evicted first, instead of the unchecked table. Default 0 (use the unchecked table)")
 		;
 	// clang-format on
 }
@@ -128,6 +133,7 @@ std::error_code vxlnetwork::update_flags (vxlnetwork::node_flags & flags_a, boos
 	flags_a.disable_lazy_bootstrap = (vm.count ("disable_lazy_bootstrap") > 0);
 	flags_a.disable_legacy_bootstrap = (vm.count ("disable_legacy_bootstrap") > 0);
 	flags_a.disable_wallet_bootstrap = (vm.count ("disable_wallet_bootstrap") > 0);
+	flags_a.enable_ascending_bootstrap = (vm.count ("enable_ascending_bootstrap") > 0);
 	flags_a.disable_ongoing_bootstrap = (vm.count ("disable_ongoing_bootstrap") > 0);
 	flags_a.disable_rep_crawler = (vm.count ("disable_rep_crawler") > 0);
 	flags_a.disable_request_loop = (vm.count ("disable_request_loop") > 0);
@@ -184,6 +190,11 @@ std::error_code vxlnetwork::update_flags (vxlnetwork::node_flags & flags_a, boos
 	{
 		flags_a.vote_processor_capacity = vote_processor_capacity_it->second.as<std::size_t> ();
 	}
+	auto unchecked_memory_limit_it = vm.find ("unchecked_memory_limit");
+	if (unchecked_memory_limit_it != vm.end ())
+	{
+		flags_a.unchecked_memory_limit = unchecked_memory_limit_it->second.as<std::size_t> () * 1024 * 1024;
+	}
 	// Config overriding
 	auto config (vm.find ("config"));
 	if (config != vm.end ())
@@ -498,6 +509,86 @@ std::error_code vxlnetwork::handle_node_options (boost::program_options::variabl
 			std::cerr << "There was an error migrating" << std::endl;
 		}
 	}
+	else if (vm.count ("ledger_export"))
+	{
+		if (vm.count ("file") == 1)
+		{
+			auto node_flags = vxlnetwork::inactive_node_flag_defaults ();
+			vxlnetwork::update_flags (node_flags, vm);
+			vxlnetwork::inactive_node node (data_path, node_flags);
+			if (!node.node->init_error ())
+			{
+				std::cout << "Exporting ledger, might take a while..." << std::endl;
+				vxlnetwork::ledger_export ledger_export (node.node->store, node.node->network_params.ledger);
+				if (!ledger_export.write (vm["file"].as<std::string> (), std::max (1u, std::thread::hardware_concurrency ())))
+				{
+					for (auto const & [table, count] : ledger_export.entries)
+					{
+						std::cout << boost::str (boost::format ("Table %1%: %2% entries\n") % static_cast<int> (table) % count);
+					}
+					std::cout << "Export completed" << std::endl;
+				}
+				else
+				{
+					std::cerr << "Export failed: " << ledger_export.error_message << std::endl;
+					ec = vxlnetwork::error_cli::generic;
+				}
+			}
+		}
+		else
+		{
+			std::cerr << "ledger_export requires one <file> option\n";
+			ec = vxlnetwork::error_cli::invalid_arguments;
+		}
+	}
+	else if (vm.count ("ledger_import"))
+	{
+		if (vm.count ("file") == 1)
+		{
+			vxlnetwork::network_params network_params{ vxlnetwork::network_constants::active_network };
+			vxlnetwork::daemon_config config{ data_path, network_params };
+			auto config_arg (vm.find ("config"));
+			std::vector<std::string> config_overrides;
+			if (config_arg != vm.end ())
+			{
+				config_overrides = vxlnetwork::config_overrides (config_arg->second.as<std::vector<vxlnetwork::config_key_value_pair>> ());
+			}
+			if (!vxlnetwork::read_node_config_toml (data_path, config, config_overrides))
+			{
+				// Opened directly, an inactive node would insert the genesis block in to the empty ledger
+				boost::filesystem::create_directories (data_path);
+				vxlnetwork::logger_mt logger;
+				auto make_store = [&] (boost::filesystem::path const & path_a) {
+					return vxlnetwork::make_store (logger, path_a, network_params.ledger, false, true, config.node.rocksdb_config, config.node.diagnostics_config.txn_tracking, config.node.block_processor_batch_max_time, config.node.lmdb_config);
+				};
+				std::cout << "Importing ledger, might take a while..." << std::endl;
+				std::unordered_map<vxlnetwork::tables, uint64_t> entries;
+				std::string error_message;
+				if (!vxlnetwork::ledger_export::import (data_path, vm["file"].as<std::string> (), std::max (1u, std::thread::hardware_concurrency ()), network_params.ledger, make_store, entries, error_message))
+				{
+					for (auto const & [table, count] : entries)
+					{
+						std::cout << boost::str (boost::format ("Table %1%: %2% entries\n") % static_cast<int> (table) % count);
+					}
+					std::cout << "Import completed" << std::endl;
+				}
+				else
+				{
+					std::cerr << "Import failed: " << error_message << std::endl;
+					ec = vxlnetwork::error_cli::generic;
+				}
+			}
+			else
+			{
+				ec = vxlnetwork::error_cli::reading_config;
+			}
+		}
+		else
+		{
+			std::cerr << "ledger_import requires one <file> option\n";
+			ec = vxlnetwork::error_cli::invalid_arguments;
+		}
+	}
 	else if (vm.count ("unchecked_clear"))
 	{
 		boost::filesystem::path data_path = vm.count ("data_path") ? boost::filesystem::path (vm["data_path"].as<std::string> ()) : vxlnetwork::working_path ();
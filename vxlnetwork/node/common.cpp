@@ -366,6 +366,10 @@ std::string vxlnetwork::message_parser::status_string ()
 		{
 			return "duplicate_publish_message";
 		}
+		case vxlnetwork::message_parser::parse_status::duplicate_confirm_ack_message:
+		{
+			return "duplicate_confirm_ack_message";
+		}
 	}
 
 	debug_assert (false);
@@ -373,8 +377,9 @@ std::string vxlnetwork::message_parser::status_string ()
 	return "[unknown parse_status]";
 }
 
-vxlnetwork::message_parser::message_parser (vxlnetwork::network_filter & publish_filter_a, vxlnetwork::block_uniquer & block_uniquer_a, vxlnetwork::vote_uniquer & vote_uniquer_a, vxlnetwork::message_visitor & visitor_a, vxlnetwork::work_pool & pool_a, vxlnetwork::network_constants const & network) :
+vxlnetwork::message_parser::message_parser (vxlnetwork::network_filter & publish_filter_a, vxlnetwork::network_filter & vote_filter_a, vxlnetwork::block_uniquer & block_uniquer_a, vxlnetwork::vote_uniquer & vote_uniquer_a, vxlnetwork::message_visitor & visitor_a, vxlnetwork::work_pool & pool_a, vxlnetwork::network_constants const & network) :
 	publish_filter (publish_filter_a),
+	vote_filter (vote_filter_a),
 	block_uniquer (block_uniquer_a),
 	vote_uniquer (vote_uniquer_a),
 	visitor (visitor_a),
@@ -428,7 +433,16 @@ void vxlnetwork::message_parser::deserialize_buffer (uint8_t const * buffer_a, s
 					}
 					case vxlnetwork::message_type::confirm_ack:
 					{
-						deserialize_confirm_ack (stream, header);
+						// Votes are relayed by many peers, check the wire bytes before constructing the vote
+						vxlnetwork::uint128_t digest;
+						if (!vote_filter.apply (buffer_a + header.size, size_a - header.size, &digest) || (vote_filter_exempt && vote_filter_exempt ()))
+						{
+							deserialize_confirm_ack (stream, header, digest);
+						}
+						else
+						{
+							status = parse_status::duplicate_confirm_ack_message;
+						}
 						break;
 					}
 					case vxlnetwork::message_type::node_id_handshake:
@@ -517,10 +531,10 @@ void vxlnetwork::message_parser::deserialize_confirm_req (vxlnetwork::stream & s
 	}
 }
 
-void vxlnetwork::message_parser::deserialize_confirm_ack (vxlnetwork::stream & stream_a, vxlnetwork::message_header const & header_a)
+void vxlnetwork::message_parser::deserialize_confirm_ack (vxlnetwork::stream & stream_a, vxlnetwork::message_header const & header_a, vxlnetwork::uint128_t const & digest_a)
 {
 	auto error (false);
-	vxlnetwork::confirm_ack incoming (error, stream_a, header_a, &vote_uniquer);
+	vxlnetwork::confirm_ack incoming (error, stream_a, header_a, digest_a, &vote_uniquer);
 	if (!error && at_end (stream_a))
 	{
 		for (auto & vote_block : incoming.vote->blocks)
@@ -838,9 +852,10 @@ std::size_t vxlnetwork::confirm_req::size (vxlnetwork::block_type type_a, std::s
 	return result;
 }
 
-vxlnetwork::confirm_ack::confirm_ack (bool & error_a, vxlnetwork::stream & stream_a, vxlnetwork::message_header const & header_a, vxlnetwork::vote_uniquer * uniquer_a) :
+vxlnetwork::confirm_ack::confirm_ack (bool & error_a, vxlnetwork::stream & stream_a, vxlnetwork::message_header const & header_a, vxlnetwork::uint128_t const & digest_a, vxlnetwork::vote_uniquer * uniquer_a) :
 	message (header_a),
-	vote (vxlnetwork::make_shared<vxlnetwork::vote> (error_a, stream_a, header.block_type ()))
+	vote (vxlnetwork::make_shared<vxlnetwork::vote> (error_a, stream_a, header.block_type ())),
+	digest (digest_a)
 {
 	if (!error_a && uniquer_a)
 	{
@@ -10,6 +10,7 @@
 #include <vxlnetwork/secure/network_filter.hpp>
 
 #include <bitset>
+#include <functional>
 
 namespace vxlnetwork
 {
@@ -272,23 +273,27 @@ public:
 		invalid_telemetry_req_message,
 		invalid_telemetry_ack_message,
 		outdated_version,
-		duplicate_publish_message
+		duplicate_publish_message,
+		duplicate_confirm_ack_message
 	};
-	message_parser (vxlnetwork::network_filter &, vxlnetwork::block_uniquer &, vxlnetwork::vote_uniquer &, vxlnetwork::message_visitor &, vxlnetwork::work_pool &, vxlnetwork::network_constants const & protocol);
+	message_parser (vxlnetwork::network_filter &, vxlnetwork::network_filter &, vxlnetwork::block_uniquer &, vxlnetwork::vote_uniquer &, vxlnetwork::message_visitor &, vxlnetwork::work_pool &, vxlnetwork::network_constants const & protocol);
 	void deserialize_buffer (uint8_t const *, std::size_t);
 	void deserialize_keepalive (vxlnetwork::stream &, vxlnetwork::message_header const &);
 	void deserialize_publish (vxlnetwork::stream &, vxlnetwork::message_header const &, vxlnetwork::uint128_t const & = 0);
 	void deserialize_confirm_req (vxlnetwork::stream &, vxlnetwork::message_header const &);
-	void deserialize_confirm_ack (vxlnetwork::stream &, vxlnetwork::message_header const &);
+	void deserialize_confirm_ack (vxlnetwork::stream &, vxlnetwork::message_header const &, vxlnetwork::uint128_t const & = 0);
 	void deserialize_node_id_handshake (vxlnetwork::stream &, vxlnetwork::message_header const &);
 	void deserialize_telemetry_req (vxlnetwork::stream &, vxlnetwork::message_header const &);
 	void deserialize_telemetry_ack (vxlnetwork::stream &, vxlnetwork::message_header const &);
 	bool at_end (vxlnetwork::stream &);
 	vxlnetwork::network_filter & publish_filter;
+	vxlnetwork::network_filter & vote_filter;
 	vxlnetwork::block_uniquer & block_uniquer;
 	vxlnetwork::vote_uniquer & vote_uniquer;
 	vxlnetwork::message_visitor & visitor;
 	vxlnetwork::work_pool & pool;
+	/** When set and returning true, duplicate confirm_acks are parsed instead of being dropped by the vote filter */
+	std::function<bool ()> vote_filter_exempt;
 	parse_status status;
 	vxlnetwork::network_constants const & network;
 	std::string status_string ();
@@ -341,12 +346,13 @@ public:
 class confirm_ack final : public message
 {
 public:
-	confirm_ack (bool &, vxlnetwork::stream &, vxlnetwork::message_header const &, vxlnetwork::vote_uniquer * = nullptr);
+	confirm_ack (bool &, vxlnetwork::stream &, vxlnetwork::message_header const &, vxlnetwork::uint128_t const & = 0, vxlnetwork::vote_uniquer * = nullptr);
 	confirm_ack (vxlnetwork::network_constants const & constants, std::shared_ptr<vxlnetwork::vote> const &);
 	void serialize (vxlnetwork::stream &) const override;
 	void visit (vxlnetwork::message_visitor &) const override;
 	bool operator== (vxlnetwork::confirm_ack const &) const;
 	std::shared_ptr<vxlnetwork::vote> vote;
+	vxlnetwork::uint128_t digest{ 0 };
 	static std::size_t size (vxlnetwork::block_type, std::size_t = 0);
 };
 
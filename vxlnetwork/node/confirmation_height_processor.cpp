@@ -1,5 +1,6 @@
 #include <vxlnetwork/lib/logger_mt.hpp>
 #include <vxlnetwork/lib/numbers.hpp>
+#include <vxlnetwork/lib/stats.hpp>
 #include <vxlnetwork/lib/threading.hpp>
 #include <vxlnetwork/lib/utility.hpp>
 #include <vxlnetwork/node/confirmation_height_processor.hpp>
@@ -9,15 +10,20 @@
 
 #include <boost/thread/latch.hpp>
 
+#include <future>
 #include <numeric>
 
-vxlnetwork::confirmation_height_processor::confirmation_height_processor (vxlnetwork::ledger & ledger_a, vxlnetwork::write_database_queue & write_database_queue_a, std::chrono::milliseconds batch_separate_pending_min_time_a, vxlnetwork::logging const & logging_a, vxlnetwork::logger_mt & logger_a, boost::latch & latch, confirmation_height_mode mode_a) :
+vxlnetwork::confirmation_height_processor::confirmation_height_processor (vxlnetwork::ledger & ledger_a, vxlnetwork::write_database_queue & write_database_queue_a, std::chrono::milliseconds batch_separate_pending_min_time_a, vxlnetwork::logging const & logging_a, vxlnetwork::logger_mt & logger_a, boost::latch & latch, confirmation_height_mode mode_a, unsigned threads_a) :
 	ledger (ledger_a),
 	write_database_queue (write_database_queue_a),
+	batch_separate_pending_min_time (batch_separate_pending_min_time_a),
+	logging (logging_a),
+	logger (logger_a),
 	// clang-format off
 unbounded_processor (ledger_a, write_database_queue_a, batch_separate_pending_min_time_a, logging_a, logger_a, stopped, batch_write_size, [this](auto & cemented_blocks) { this->notify_observers (cemented_blocks); }, [this](auto const & block_hash_a) { this->notify_observers (block_hash_a); }, [this]() { return this->awaiting_processing_size (); }),
 bounded_processor (ledger_a, write_database_queue_a, batch_separate_pending_min_time_a, logging_a, logger_a, stopped, batch_write_size, [this](auto & cemented_blocks) { this->notify_observers (cemented_blocks); }, [this](auto const & block_hash_a) { this->notify_observers (block_hash_a); }, [this]() { return this->awaiting_processing_size (); }),
 	// clang-format on
+	workers (threads_a > 1 ? std::make_unique<vxlnetwork::thread_pool> (threads_a, vxlnetwork::thread_role::name::confirmation_height_worker) : nullptr),
 	thread ([this, &latch, mode_a] () {
 		vxlnetwork::thread_role::set (vxlnetwork::thread_role::name::confirmation_height_processing);
 		// Do not start running the processing thread until other threads have finished their operations
@@ -43,6 +49,10 @@ void vxlnetwork::confirmation_height_processor::stop ()
 	{
 		thread.join ();
 	}
+	if (workers)
+	{
+		workers->stop ();
+	}
 }
 
 void vxlnetwork::confirmation_height_processor::run (confirmation_height_mode mode_a)
@@ -53,31 +63,41 @@ void vxlnetwork::confirmation_height_processor::run (confirmation_height_mode mo
 		if (!paused && !awaiting_processing.empty ())
 		{
 			lk.unlock ();
-			if (bounded_processor.pending_empty () && unbounded_processor.pending_empty ())
+			auto pending_empty = bounded_processor.pending_empty () && unbounded_processor.pending_empty ();
+			if (pending_empty)
 			{
 				lk.lock ();
 				original_hashes_pending.clear ();
 				lk.unlock ();
 			}
 
-			set_next_hash ();
-
 			auto const num_blocks_to_use_unbounded = confirmation_height::unbounded_cutoff;
 			auto blocks_within_automatic_unbounded_selection = (ledger.cache.block_count < num_blocks_to_use_unbounded || ledger.cache.block_count - num_blocks_to_use_unbounded < ledger.cache.cemented_count);
 
-			// Don't want to mix up pending writes across different processors
-			auto valid_unbounded = (mode_a == confirmation_height_mode::automatic && blocks_within_automatic_unbounded_selection && bounded_processor.pending_empty ());
-			auto force_unbounded = (!unbounded_processor.pending_empty () || mode_a == confirmation_height_mode::unbounded);
-			if (force_unbounded || valid_unbounded)
+			// Parallel walks use unbounded walkers and start from a clean slate, so only batch several blocks when the unbounded processor would be picked anyway
+			auto parallel = workers != nullptr && pending_empty && awaiting_processing_size () > 1 && (mode_a == confirmation_height_mode::unbounded || (mode_a == confirmation_height_mode::automatic && blocks_within_automatic_unbounded_selection));
+			if (parallel)
 			{
-				debug_assert (bounded_processor.pending_empty ());
-				unbounded_processor.process (original_block);
+				process_parallel ();
 			}
 			else
 			{
-				debug_assert (mode_a == confirmation_height_mode::bounded || mode_a == confirmation_height_mode::automatic);
-				debug_assert (unbounded_processor.pending_empty ());
-				bounded_processor.process (original_block);
+				set_next_hash ();
+
+				// Don't want to mix up pending writes across different processors
+				auto valid_unbounded = (mode_a == confirmation_height_mode::automatic && blocks_within_automatic_unbounded_selection && bounded_processor.pending_empty ());
+				auto force_unbounded = (!unbounded_processor.pending_empty () || mode_a == confirmation_height_mode::unbounded);
+				if (force_unbounded || valid_unbounded)
+				{
+					debug_assert (bounded_processor.pending_empty ());
+					unbounded_processor.process (original_block);
+				}
+				else
+				{
+					debug_assert (mode_a == confirmation_height_mode::bounded || mode_a == confirmation_height_mode::automatic);
+					debug_assert (unbounded_processor.pending_empty ());
+					bounded_processor.process (original_block);
+				}
 			}
 
 			lk.lock ();
@@ -169,6 +189,134 @@ void vxlnetwork::confirmation_height_processor::set_next_hash ()
 	awaiting_processing.get<tag_sequence> ().pop_front ();
 }
 
+void vxlnetwork::confirmation_height_processor::process_parallel ()
+{
+	debug_assert (workers != nullptr);
+	debug_assert (unbounded_processor.pending_empty ());
+	std::vector<std::shared_ptr<vxlnetwork::block>> batch;
+	{
+		vxlnetwork::lock_guard<vxlnetwork::mutex> guard (mutex);
+		auto & sequence (awaiting_processing.get<tag_sequence> ());
+		while (!sequence.empty () && batch.size () < parallel_batch_max)
+		{
+			batch.push_back (sequence.front ().block);
+			original_hashes_pending.insert (batch.back ()->hash ());
+			sequence.pop_front ();
+		}
+		debug_assert (!batch.empty ());
+		original_block = batch.front ();
+	}
+	ledger.stats.inc (vxlnetwork::stat::type::confirmation_height, vxlnetwork::stat::detail::parallel_batch);
+
+	// Blocks of the same account always go to the same walker, other accounts go to the walker with the fewest blocks so far
+	auto const num_groups (std::min<std::size_t> (workers->get_num_threads (), batch.size ()));
+	std::vector<std::vector<std::shared_ptr<vxlnetwork::block>>> groups (num_groups);
+	std::unordered_map<vxlnetwork::account, std::size_t> account_groups;
+	for (auto const & block : batch)
+	{
+		vxlnetwork::account account (block->account ());
+		if (account.is_zero ())
+		{
+			account = block->sideband ().account;
+		}
+		auto existing (account_groups.find (account));
+		if (existing == account_groups.end ())
+		{
+			auto smallest (std::min_element (groups.begin (), groups.end (), [] (auto const & lhs, auto const & rhs) { return lhs.size () < rhs.size (); }));
+			existing = account_groups.emplace (account, std::distance (groups.begin (), smallest)).first;
+		}
+		groups[existing->second].push_back (block);
+	}
+
+	// Walkers never write, blocks found already cemented are only reported once it is known whether the group is merged
+	std::vector<std::vector<vxlnetwork::block_hash>> already_cemented (num_groups);
+	{
+		vxlnetwork::lock_guard<vxlnetwork::mutex> guard (mutex);
+		debug_assert (parallel_walkers.empty ());
+		for (auto & hashes : already_cemented)
+		{
+			// clang-format off
+			parallel_walkers.push_back (std::make_unique<confirmation_height_unbounded> (ledger, write_database_queue, batch_separate_pending_min_time, logging, logger, stopped, batch_write_size, [] (auto const &) { debug_assert (false); }, [&hashes] (auto const & block_hash_a) { hashes.push_back (block_hash_a); }, [] () { return uint64_t{ 0 }; }));
+			// clang-format on
+			parallel_walkers.back ()->defer_writes = true;
+		}
+	}
+
+	std::vector<std::future<void>> done;
+	for (std::size_t i = 0; i < num_groups; ++i)
+	{
+		auto promise (std::make_shared<std::promise<void>> ());
+		done.push_back (promise->get_future ());
+		workers->push_task ([this, &walker = *parallel_walkers[i], &group = groups[i], promise] () {
+			for (auto const & block : group)
+			{
+				if (stopped)
+				{
+					break;
+				}
+				walker.process (block);
+			}
+			promise->set_value ();
+		});
+	}
+	for (auto & future : done)
+	{
+		future.wait ();
+	}
+
+	// Merge in group order, a group writing the confirmation height of an account which is written by an earlier group is processed again serially
+	std::vector<std::shared_ptr<vxlnetwork::block>> conflicted;
+	if (!stopped)
+	{
+		std::unordered_set<vxlnetwork::account> merged_accounts;
+		for (std::size_t i = 0; i < num_groups; ++i)
+		{
+			auto & walker (*parallel_walkers[i]);
+			auto accounts (walker.pending_accounts ());
+			auto disjoint = std::none_of (accounts.begin (), accounts.end (), [&merged_accounts] (auto const & account_a) { return merged_accounts.count (account_a) > 0; });
+			if (disjoint)
+			{
+				merged_accounts.insert (accounts.begin (), accounts.end ());
+				for (auto const & hash : already_cemented[i])
+				{
+					notify_observers (hash);
+				}
+				unbounded_processor.merge_pending (walker);
+			}
+			else
+			{
+				ledger.stats.inc (vxlnetwork::stat::type::confirmation_height, vxlnetwork::stat::detail::parallel_conflict);
+				conflicted.insert (conflicted.end (), groups[i].begin (), groups[i].end ());
+			}
+		}
+
+		// All confirmation heights of the merged groups are written in a single batch
+		if (!unbounded_processor.pending_empty ())
+		{
+			auto scoped_write_guard = write_database_queue.wait (vxlnetwork::writer::confirmation_height);
+			unbounded_processor.cement_blocks (scoped_write_guard);
+		}
+		unbounded_processor.clear_process_vars ();
+	}
+	{
+		vxlnetwork::lock_guard<vxlnetwork::mutex> guard (mutex);
+		parallel_walkers.clear ();
+	}
+
+	for (auto const & block : conflicted)
+	{
+		if (stopped)
+		{
+			break;
+		}
+		{
+			vxlnetwork::lock_guard<vxlnetwork::mutex> guard (mutex);
+			original_block = block;
+		}
+		unbounded_processor.process (block);
+	}
+}
+
 // Not thread-safe, only call before this processor has begun cementing
 void vxlnetwork::confirmation_height_processor::add_cemented_observer (std::function<void (std::shared_ptr<vxlnetwork::block> const &)> const & callback_a)
 {
@@ -214,6 +362,8 @@ std::unique_ptr<vxlnetwork::container_info_component> vxlnetwork::collect_contai
 	return composite;
 }
 
+constexpr std::size_t vxlnetwork::confirmation_height_processor::parallel_batch_max;
+
 std::size_t vxlnetwork::confirmation_height_processor::awaiting_processing_size () const
 {
 	vxlnetwork::lock_guard<vxlnetwork::mutex> guard (mutex);
@@ -228,7 +378,13 @@ bool vxlnetwork::confirmation_height_processor::is_processing_added_block (vxlne
 
 bool vxlnetwork::confirmation_height_processor::is_processing_block (vxlnetwork::block_hash const & hash_a) const
 {
-	return is_processing_added_block (hash_a) || unbounded_processor.has_iterated_over_block (hash_a);
+	auto result = is_processing_added_block (hash_a) || unbounded_processor.has_iterated_over_block (hash_a);
+	if (!result)
+	{
+		vxlnetwork::lock_guard<vxlnetwork::mutex> guard (mutex);
+		result = std::any_of (parallel_walkers.begin (), parallel_walkers.end (), [&hash_a] (auto const & walker_a) { return walker_a->has_iterated_over_block (hash_a); });
+	}
+	return result;
 }
 
 vxlnetwork::block_hash vxlnetwork::confirmation_height_processor::current () const
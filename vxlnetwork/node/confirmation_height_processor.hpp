@@ -27,12 +27,13 @@ namespace vxlnetwork
 {
 class ledger;
 class logger_mt;
+class thread_pool;
 class write_database_queue;
 
 class confirmation_height_processor final
 {
 public:
-	confirmation_height_processor (vxlnetwork::ledger &, vxlnetwork::write_database_queue &, std::chrono::milliseconds, vxlnetwork::logging const &, vxlnetwork::logger_mt &, boost::latch & initialized_latch, confirmation_height_mode = confirmation_height_mode::automatic);
+	confirmation_height_processor (vxlnetwork::ledger &, vxlnetwork::write_database_queue &, std::chrono::milliseconds, vxlnetwork::logging const &, vxlnetwork::logger_mt &, boost::latch & initialized_latch, confirmation_height_mode = confirmation_height_mode::automatic, unsigned threads = 0);
 	~confirmation_height_processor ();
 	void pause ();
 	void unpause ();
@@ -91,12 +92,26 @@ private:
 	vxlnetwork::write_database_queue & write_database_queue;
 	/** The maximum amount of blocks to write at once. This is dynamically modified by the bounded processor based on previous write performance **/
 	uint64_t batch_write_size{ 16384 };
+	std::chrono::milliseconds batch_separate_pending_min_time;
+	vxlnetwork::logging const & logging;
+	vxlnetwork::logger_mt & logger;
 
 	confirmation_height_unbounded unbounded_processor;
 	confirmation_height_bounded bounded_processor;
+	/** Unbounded walkers of the parallel batch currently being processed, each one walks the chains of a different set of accounts */
+	std::vector<std::unique_ptr<confirmation_height_unbounded>> parallel_walkers;
+	/** Only set when more than one confirmation height thread is configured */
+	std::unique_ptr<vxlnetwork::thread_pool> workers;
 	std::thread thread;
 
 	void set_next_hash ();
+	/**
+	 * Pops up to parallel_batch_max blocks, groups them by account and walks every group with its own unbounded walker on the worker pool.
+	 * Walks only read the ledger and no confirmation height is written until all of them finish, so they share the same view of it.
+	 * Groups whose pending writes touch an account another group writes are not merged and their blocks are processed serially afterwards.
+	 */
+	void process_parallel ();
+	static std::size_t constexpr parallel_batch_max{ 4096 };
 	void notify_observers (std::vector<std::shared_ptr<vxlnetwork::block>> const &);
 	void notify_observers (vxlnetwork::block_hash const &);
 
@@ -108,6 +123,7 @@ private:
 	friend class confirmation_height_many_accounts_many_confirmations_Test;
 	friend class confirmation_height_long_chains_Test;
 	friend class confirmation_height_many_accounts_single_confirmation_Test;
+	friend class confirmation_height_parallel_walk_Test;
 	friend class request_aggregator_cannot_vote_Test;
 	friend class active_transactions_pessimistic_elections_Test;
 };
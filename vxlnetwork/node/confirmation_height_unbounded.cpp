@@ -169,7 +169,7 @@ void vxlnetwork::confirmation_height_unbounded::process (std::shared_ptr<vxlnetw
 		});
 		auto force_write = total_pending_write_block_count > batch_write_size;
 
-		if ((max_write_size_reached || should_output || force_write) && !pending_writes.empty ())
+		if (!defer_writes && (max_write_size_reached || should_output || force_write) && !pending_writes.empty ())
 		{
 			if (write_database_queue.process (vxlnetwork::writer::confirmation_height))
 			{
@@ -478,6 +478,28 @@ bool vxlnetwork::confirmation_height_unbounded::has_iterated_over_block (vxlnetw
 	return block_cache.count (hash_a) == 1;
 }
 
+void vxlnetwork::confirmation_height_unbounded::merge_pending (confirmation_height_unbounded & other_a)
+{
+	debug_assert (&other_a != this);
+	std::move (other_a.pending_writes.begin (), other_a.pending_writes.end (), std::back_inserter (pending_writes));
+	pending_writes_size = pending_writes.size ();
+	other_a.pending_writes.clear ();
+	other_a.pending_writes_size = 0;
+	vxlnetwork::lock_guard<vxlnetwork::mutex> guard (block_cache_mutex);
+	vxlnetwork::lock_guard<vxlnetwork::mutex> other_guard (other_a.block_cache_mutex);
+	block_cache.insert (other_a.block_cache.begin (), other_a.block_cache.end ());
+}
+
+std::unordered_set<vxlnetwork::account> vxlnetwork::confirmation_height_unbounded::pending_accounts () const
+{
+	std::unordered_set<vxlnetwork::account> result;
+	for (auto const & pending : pending_writes)
+	{
+		result.insert (pending.account);
+	}
+	return result;
+}
+
 uint64_t vxlnetwork::confirmation_height_unbounded::block_cache_size () const
 {
 	vxlnetwork::lock_guard<vxlnetwork::mutex> guard (block_cache_mutex);
@@ -7,6 +7,7 @@
 
 #include <chrono>
 #include <unordered_map>
+#include <unordered_set>
 
 namespace vxlnetwork
 {
@@ -26,6 +27,13 @@ public:
 	void process (std::shared_ptr<vxlnetwork::block> original_block);
 	void cement_blocks (vxlnetwork::write_guard &);
 	bool has_iterated_over_block (vxlnetwork::block_hash const &) const;
+	/** Moves the pending writes of \p other_a, and the blocks needed for their callbacks, behind the pending writes of this processor */
+	void merge_pending (confirmation_height_unbounded & other_a);
+	/** Accounts which have a confirmation height pending to be written */
+	std::unordered_set<vxlnetwork::account> pending_accounts () const;
+
+	/** Never write while iterating, pending writes are kept until cement_blocks or merge_pending. Used by the parallel walkers of confirmation_height_processor */
+	bool defer_writes{ false };
 
 private:
 	class confirmed_iterated_pair
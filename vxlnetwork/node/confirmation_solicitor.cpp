@@ -31,7 +31,7 @@ bool vxlnetwork::confirmation_solicitor::broadcast (vxlnetwork::election const &
 	if (rebroadcasted++ < max_block_broadcasts)
 	{
 		auto const & hash (election_a.status.winner->hash ());
-		vxlnetwork::publish winner{ config.network_params.network, election_a.status.winner };
+		vxlnetwork::transport::shared_message winner{ vxlnetwork::publish{ config.network_params.network, election_a.status.winner } };
 		unsigned count = 0;
 		// Directed broadcasting to principal representatives
 		for (auto i (representatives_broadcasts.begin ()), n (representatives_broadcasts.end ()); i != n && count < max_election_broadcasts; ++i)
@@ -28,7 +28,9 @@ vxlnetwork::election::election (vxlnetwork::node & node_a, std::shared_ptr<vxlne
 	root (block_a->root ()),
 	qualified_root (block_a->qualified_root ())
 {
-	last_votes.emplace (vxlnetwork::account::null (), vxlnetwork::vote_info{ std::chrono::steady_clock::now (), 0, block_a->hash () });
+	weights_epoch = node.online_reps.weights_epoch ();
+	weights = node.online_reps.weights ();
+	vote_set (vxlnetwork::account::null (), vxlnetwork::vote_info{ std::chrono::steady_clock::now (), 0, block_a->hash () });
 	last_blocks.emplace (block_a->hash (), block_a);
 	if (node.config.enable_voting && node.wallets.reps ().voting > 0)
 	{
@@ -232,40 +234,104 @@ vxlnetwork::tally_t vxlnetwork::election::tally () const
 
 vxlnetwork::tally_t vxlnetwork::election::tally_impl () const
 {
-	std::unordered_map<vxlnetwork::block_hash, vxlnetwork::uint128_t> block_weights;
-	std::unordered_map<vxlnetwork::block_hash, vxlnetwork::uint128_t> final_weights_l;
-	for (auto const & [account, info] : last_votes)
-	{
-		auto rep_weight (node.ledger.weight (account));
-		block_weights[info.hash] += rep_weight;
-		if (info.timestamp == std::numeric_limits<uint64_t>::max ())
-		{
-			final_weights_l[info.hash] += rep_weight;
-		}
-	}
-	last_tally = block_weights;
+	refresh_weights ();
 	vxlnetwork::tally_t result;
-	for (auto const & [hash, amount] : block_weights)
+	for (auto const & [hash, tally_l] : last_tally)
 	{
 		auto block (last_blocks.find (hash));
 		if (block != last_blocks.end ())
 		{
-			result.emplace (amount, block->second);
+			result.emplace (tally_l.weight, block->second);
 		}
 	}
-	// Calculate final votes sum for winner
-	if (!final_weights_l.empty () && !result.empty ())
+	// Final votes sum for winner
+	if (!result.empty ())
 	{
-		auto winner_hash (result.begin ()->second->hash ());
-		auto find_final (final_weights_l.find (winner_hash));
-		if (find_final != final_weights_l.end ())
+		auto find_final (last_tally.find (result.begin ()->second->hash ()));
+		if (find_final->second.final_votes > 0)
 		{
-			final_weight = find_final->second;
+			final_weight = find_final->second.final_weight;
 		}
 	}
 	return result;
 }
 
+void vxlnetwork::election::vote_set (vxlnetwork::account const & rep_a, vxlnetwork::vote_info const & info_a)
+{
+	refresh_weights ();
+	auto weight_l (rep_weight (rep_a));
+	auto existing (last_votes.find (rep_a));
+	if (existing != last_votes.end ())
+	{
+		tally_sub (existing->second, weight_l);
+		existing->second = info_a;
+	}
+	else
+	{
+		last_votes.emplace (rep_a, info_a);
+	}
+	tally_add (info_a, weight_l);
+}
+
+auto vxlnetwork::election::vote_erase (votes_t::iterator vote_a) -> votes_t::iterator
+{
+	refresh_weights ();
+	tally_sub (vote_a->second, rep_weight (vote_a->first));
+	return last_votes.erase (vote_a);
+}
+
+void vxlnetwork::election::tally_add (vxlnetwork::vote_info const & info_a, vxlnetwork::uint128_t const & weight_a) const
+{
+	auto & tally_l (last_tally[info_a.hash]);
+	tally_l.weight += weight_a;
+	++tally_l.votes;
+	if (info_a.timestamp == std::numeric_limits<uint64_t>::max ())
+	{
+		tally_l.final_weight += weight_a;
+		++tally_l.final_votes;
+	}
+}
+
+void vxlnetwork::election::tally_sub (vxlnetwork::vote_info const & info_a, vxlnetwork::uint128_t const & weight_a) const
+{
+	auto existing (last_tally.find (info_a.hash));
+	if (existing != last_tally.end ())
+	{
+		auto & tally_l (existing->second);
+		tally_l.weight -= weight_a;
+		if (info_a.timestamp == std::numeric_limits<uint64_t>::max ())
+		{
+			tally_l.final_weight -= weight_a;
+			--tally_l.final_votes;
+		}
+		// Blocks stay in the tally as long as any vote points at them, even without weight
+		if (--tally_l.votes == 0)
+		{
+			last_tally.erase (existing);
+		}
+	}
+}
+
+vxlnetwork::uint128_t vxlnetwork::election::rep_weight (vxlnetwork::account const & rep_a) const
+{
+	return weights->get (rep_a);
+}
+
+void vxlnetwork::election::refresh_weights () const
+{
+	auto const epoch_l (node.online_reps.weights_epoch ());
+	if (epoch_l != weights_epoch)
+	{
+		weights_epoch = epoch_l;
+		weights = node.online_reps.weights ();
+		last_tally.clear ();
+		for (auto const & [rep, info] : last_votes)
+		{
+			tally_add (info, rep_weight (rep));
+		}
+	}
+}
+
 void vxlnetwork::election::confirm_if_quorum (vxlnetwork::unique_lock<vxlnetwork::mutex> & lock_a)
 {
 	debug_assert (lock_a.owns_lock ());
@@ -384,7 +450,7 @@ vxlnetwork::election_vote_result vxlnetwork::election::vote (vxlnetwork::account
 		if (should_process)
 		{
 			node.stats.inc (vxlnetwork::stat::type::election, vxlnetwork::stat::detail::vote_new);
-			last_votes[rep] = { std::chrono::steady_clock::now (), timestamp_a, block_hash_a };
+			vote_set (rep, { std::chrono::steady_clock::now (), timestamp_a, block_hash_a });
 			live_vote_action (rep);
 			if (!confirmed ())
 			{
@@ -442,9 +508,9 @@ std::size_t vxlnetwork::election::insert_inactive_votes_cache (vxlnetwork::inact
 	vxlnetwork::unique_lock<vxlnetwork::mutex> lock (mutex);
 	for (auto const & [rep, timestamp] : cache_a.voters)
 	{
-		auto inserted (last_votes.emplace (rep, vxlnetwork::vote_info{ std::chrono::steady_clock::time_point::min (), timestamp, cache_a.hash }));
-		if (inserted.second)
+		if (last_votes.find (rep) == last_votes.end ())
 		{
+			vote_set (rep, vxlnetwork::vote_info{ std::chrono::steady_clock::time_point::min (), timestamp, cache_a.hash });
 			node.stats.inc (vxlnetwork::stat::type::election, vxlnetwork::stat::detail::vote_cached);
 		}
 	}
@@ -517,7 +583,11 @@ void vxlnetwork::election::remove_votes (vxlnetwork::block_hash const & hash_a)
 		auto list_generated_votes (node.history.votes (root, hash_a));
 		for (auto const & vote : list_generated_votes)
 		{
-			last_votes.erase (vote->account);
+			auto existing (last_votes.find (vote->account));
+			if (existing != last_votes.end ())
+			{
+				vote_erase (existing);
+			}
 		}
 		// Clear votes cache
 		node.history.erase (root);
@@ -535,7 +605,7 @@ void vxlnetwork::election::remove_block (vxlnetwork::block_hash const & hash_a)
 			{
 				if (i->second.hash == hash_a)
 				{
-					i = last_votes.erase (i);
+					i = vote_erase (i);
 				}
 				else
 				{
@@ -556,7 +626,7 @@ bool vxlnetwork::election::replace_by_weight (vxlnetwork::unique_lock<vxlnetwork
 	// Sort existing blocks tally
 	std::vector<std::pair<vxlnetwork::block_hash, vxlnetwork::uint128_t>> sorted;
 	sorted.reserve (last_tally.size ());
-	std::copy (last_tally.begin (), last_tally.end (), std::back_inserter (sorted));
+	std::transform (last_tally.begin (), last_tally.end (), std::back_inserter (sorted), [] (auto const & entry) { return std::make_pair (entry.first, entry.second.weight); });
 	lock_a.unlock ();
 	// Sort in ascending order
 	std::sort (sorted.begin (), sorted.end (), [] (auto const & left, auto const & right) { return left.second < right.second; });
@@ -128,12 +128,38 @@ private:
 	void remove_block (vxlnetwork::block_hash const &);
 	bool replace_by_weight (vxlnetwork::unique_lock<vxlnetwork::mutex> & lock_a, vxlnetwork::block_hash const &);
 
+private: // Tally
+	using votes_t = std::unordered_map<vxlnetwork::account, vxlnetwork::vote_info>;
+	/** Sets the vote of \p rep_a, applying the difference to the tally */
+	void vote_set (vxlnetwork::account const & rep_a, vxlnetwork::vote_info const & info_a);
+	/** Removes a vote and its weight from the tally, returns the following vote */
+	votes_t::iterator vote_erase (votes_t::iterator vote_a);
+	void tally_add (vxlnetwork::vote_info const & info_a, vxlnetwork::uint128_t const & weight_a) const;
+	void tally_sub (vxlnetwork::vote_info const & info_a, vxlnetwork::uint128_t const & weight_a) const;
+	/** Weight of \p rep_a in the online_reps snapshot the election tallies with */
+	vxlnetwork::uint128_t rep_weight (vxlnetwork::account const & rep_a) const;
+	/** Takes the online_reps snapshot again and rebuilds the tally when online_reps has sampled since it was taken */
+	void refresh_weights () const;
+
+	class block_tally final
+	{
+	public:
+		vxlnetwork::uint128_t weight{ 0 };
+		vxlnetwork::uint128_t final_weight{ 0 };
+		std::size_t votes{ 0 };
+		std::size_t final_votes{ 0 };
+	};
+
 private:
 	std::unordered_map<vxlnetwork::block_hash, std::shared_ptr<vxlnetwork::block>> last_blocks;
-	std::unordered_map<vxlnetwork::account, vxlnetwork::vote_info> last_votes;
+	votes_t last_votes;
 	std::atomic<bool> is_quorum{ false };
 	mutable vxlnetwork::uint128_t final_weight{ 0 };
-	mutable std::unordered_map<vxlnetwork::block_hash, vxlnetwork::uint128_t> last_tally;
+	/** Weight of the votes for every block voted on, kept up to date as votes change */
+	mutable std::unordered_map<vxlnetwork::block_hash, block_tally> last_tally;
+	/** Weights of every representative, frozen from online_reps when the election starts and at every weights epoch */
+	mutable std::shared_ptr<vxlnetwork::rep_weights::snapshot const> weights;
+	mutable uint64_t weights_epoch{ 0 };
 
 	vxlnetwork::election_behavior const behavior{ vxlnetwork::election_behavior::normal };
 	std::chrono::steady_clock::time_point const election_start = { std::chrono::steady_clock::now () };
@@ -156,5 +182,6 @@ public: // Only used in tests
 	friend class confirmation_solicitor_bypass_max_requests_cap_Test;
 	friend class votes_add_existing_Test;
 	friend class votes_add_old_Test;
+	friend class election_tally_benchmark_Test;
 };
 }
@@ -0,0 +1,227 @@
+#include <vxlnetwork/lib/stats.hpp>
+#include <vxlnetwork/lib/threading.hpp>
+#include <vxlnetwork/node/group_commit.hpp>
+#include <vxlnetwork/secure/store.hpp>
+
+#include <algorithm>
+
+vxlnetwork::group_commit::config::config ()
+{
+	budgets.fill (std::chrono::milliseconds (0));
+	// Background writers are not latency sensitive and can wait for others to join the group
+	set_budget (vxlnetwork::writer::online_weight, std::chrono::milliseconds (100));
+	set_budget (vxlnetwork::writer::peers, std::chrono::milliseconds (100));
+}
+
+void vxlnetwork::group_commit::config::set_budget (vxlnetwork::writer writer_a, std::chrono::milliseconds budget_a)
+{
+	debug_assert (writer_a != vxlnetwork::writer::count);
+	budgets[static_cast<std::size_t> (writer_a)] = budget_a;
+}
+
+std::chrono::milliseconds vxlnetwork::group_commit::config::budget (vxlnetwork::writer writer_a) const
+{
+	debug_assert (writer_a != vxlnetwork::writer::count);
+	return budgets[static_cast<std::size_t> (writer_a)];
+}
+
+vxlnetwork::group_commit::group_commit (vxlnetwork::store & store_a, vxlnetwork::stat & stats_a, config const & config_a) :
+	store{ store_a },
+	stats{ stats_a },
+	config_m{ config_a },
+	thread{ [this] () {
+		vxlnetwork::thread_role::set (vxlnetwork::thread_role::name::group_commit);
+		run ();
+	} }
+{
+	stats.define_histogram (vxlnetwork::stat::type::group_commit, vxlnetwork::stat::detail::commit_size, vxlnetwork::stat::dir::in, { 1, 2, 4, 8, 16, 32, 64, 128, 256, 512 });
+	stats.define_histogram (vxlnetwork::stat::type::group_commit, vxlnetwork::stat::detail::queue_wait_us, vxlnetwork::stat::dir::in, { 0, 100, 1000, 10000, 100000, 1000000 });
+	stats.define_histogram (vxlnetwork::stat::type::group_commit, vxlnetwork::stat::detail::commit_time_us, vxlnetwork::stat::dir::in, { 0, 100, 1000, 10000, 100000, 1000000 });
+}
+
+vxlnetwork::group_commit::~group_commit ()
+{
+	stop ();
+}
+
+std::future<void> vxlnetwork::group_commit::submit (vxlnetwork::writer writer_a, std::vector<vxlnetwork::tables> const & tables_a, action const & action_a)
+{
+	debug_assert (writer_a != vxlnetwork::writer::count);
+	entry entry_l;
+	entry_l.tables = tables_a;
+	entry_l.action = action_a;
+	entry_l.submitted = std::chrono::steady_clock::now ();
+	entry_l.deadline = entry_l.submitted + config_m.budget (writer_a);
+	auto result (entry_l.promise.get_future ());
+	vxlnetwork::unique_lock<vxlnetwork::mutex> lock{ mutex };
+	if (!stopped)
+	{
+		queues[static_cast<std::size_t> (writer_a)].push_back (std::move (entry_l));
+		++queued;
+		lock.unlock ();
+		condition.notify_all (); // Notify run ()
+	}
+	else
+	{
+		lock.unlock ();
+		std::vector<entry> batch;
+		batch.push_back (std::move (entry_l));
+		commit_batch (batch);
+	}
+	return result;
+}
+
+void vxlnetwork::group_commit::flush ()
+{
+	vxlnetwork::unique_lock<vxlnetwork::mutex> lock{ mutex };
+	condition.wait (lock, [this] () {
+		return stopped || (queued == 0 && !committing);
+	});
+}
+
+void vxlnetwork::group_commit::stop ()
+{
+	vxlnetwork::unique_lock<vxlnetwork::mutex> lock{ mutex };
+	if (!stopped)
+	{
+		stopped = true;
+		lock.unlock ();
+		condition.notify_all (); // Notify flush (), run ()
+	}
+	else
+	{
+		lock.unlock ();
+	}
+	if (thread.joinable ())
+	{
+		thread.join ();
+	}
+}
+
+std::size_t vxlnetwork::group_commit::size () const
+{
+	vxlnetwork::lock_guard<vxlnetwork::mutex> lock{ mutex };
+	return queued;
+}
+
+void vxlnetwork::group_commit::run ()
+{
+	vxlnetwork::unique_lock<vxlnetwork::mutex> lock{ mutex };
+	while (!stopped || queued > 0)
+	{
+		if (queued == 0)
+		{
+			condition.wait (lock, [this] () { return stopped || queued > 0; });
+		}
+		else if (!stopped && queued < config_m.max_batch && std::chrono::steady_clock::now () < next_deadline ())
+		{
+			// Give other writers the chance to join the group until the most urgent budget runs out
+			condition.wait_until (lock, next_deadline ());
+		}
+		else
+		{
+			auto batch (take_batch ());
+			committing = true;
+			lock.unlock ();
+			commit_batch (batch);
+			lock.lock ();
+			committing = false;
+			condition.notify_all (); // Notify flush ()
+		}
+	}
+}
+
+std::vector<vxlnetwork::group_commit::entry> vxlnetwork::group_commit::take_batch ()
+{
+	std::vector<entry> result;
+	result.reserve (std::min (queued, config_m.max_batch));
+	auto const count (queues.size ());
+	auto empty_in_a_row (0u);
+	for (auto i (next_writer); result.size () < config_m.max_batch && empty_in_a_row < count; i = (i + 1) % count)
+	{
+		auto & queue (queues[i]);
+		if (!queue.empty ())
+		{
+			result.push_back (std::move (queue.front ()));
+			queue.pop_front ();
+			empty_in_a_row = 0;
+		}
+		else
+		{
+			++empty_in_a_row;
+		}
+	}
+	queued -= result.size ();
+	next_writer = (next_writer + 1) % count;
+	return result;
+}
+
+std::chrono::steady_clock::time_point vxlnetwork::group_commit::next_deadline () const
+{
+	auto result (std::chrono::steady_clock::time_point::max ());
+	for (auto const & queue : queues)
+	{
+		if (!queue.empty ())
+		{
+			result = std::min (result, queue.front ().deadline);
+		}
+	}
+	return result;
+}
+
+void vxlnetwork::group_commit::commit_batch (std::vector<entry> & batch_a)
+{
+	debug_assert (!batch_a.empty ());
+	std::vector<vxlnetwork::tables> tables;
+	for (auto const & entry_l : batch_a)
+	{
+		tables.insert (tables.end (), entry_l.tables.begin (), entry_l.tables.end ());
+	}
+	std::sort (tables.begin (), tables.end ());
+	tables.erase (std::unique (tables.begin (), tables.end ()), tables.end ());
+	try
+	{
+		vxlnetwork::lock_guard<vxlnetwork::mutex> commit_lock{ commit_mutex };
+		auto transaction (store.tx_begin_write (tables));
+		auto const started (std::chrono::steady_clock::now ());
+		for (auto & entry_l : batch_a)
+		{
+			auto const waited (std::chrono::duration_cast<std::chrono::microseconds> (started - entry_l.submitted).count ());
+			stats.add (vxlnetwork::stat::type::group_commit, vxlnetwork::stat::detail::queue_wait_us, vxlnetwork::stat::dir::in, waited);
+			stats.update_histogram (vxlnetwork::stat::type::group_commit, vxlnetwork::stat::detail::queue_wait_us, vxlnetwork::stat::dir::in, waited);
+			entry_l.action (transaction);
+		}
+		auto const commit_start (std::chrono::steady_clock::now ());
+		transaction.commit ();
+		auto const commit_time (std::chrono::duration_cast<std::chrono::microseconds> (std::chrono::steady_clock::now () - commit_start).count ());
+		stats.add (vxlnetwork::stat::type::group_commit, vxlnetwork::stat::detail::commit_time_us, vxlnetwork::stat::dir::in, commit_time);
+		stats.update_histogram (vxlnetwork::stat::type::group_commit, vxlnetwork::stat::detail::commit_time_us, vxlnetwork::stat::dir::in, commit_time);
+	}
+	catch (...)
+	{
+		// The whole group fails together, waiting submitters are woken up with the exception and the writer thread keeps going
+		for (auto & entry_l : batch_a)
+		{
+			entry_l.promise.set_exception (std::current_exception ());
+		}
+		return;
+	}
+	++commits;
+	actions += batch_a.size ();
+	stats.inc (vxlnetwork::stat::type::group_commit, vxlnetwork::stat::detail::commit);
+	stats.add (vxlnetwork::stat::type::group_commit, vxlnetwork::stat::detail::commit_size, vxlnetwork::stat::dir::in, batch_a.size ());
+	stats.update_histogram (vxlnetwork::stat::type::group_commit, vxlnetwork::stat::detail::commit_size, vxlnetwork::stat::dir::in, batch_a.size ());
+	for (auto & entry_l : batch_a)
+	{
+		entry_l.promise.set_value ();
+	}
+}
+
+std::unique_ptr<vxlnetwork::container_info_component> vxlnetwork::collect_container_info (group_commit & group_commit, std::string const & name)
+{
+	auto composite = std::make_unique<vxlnetwork::container_info_composite> (name);
+	composite->add_component (std::make_unique<vxlnetwork::container_info_leaf> (container_info{ "queued", group_commit.size (), sizeof (vxlnetwork::group_commit::entry) }));
+	composite->add_component (std::make_unique<vxlnetwork::container_info_leaf> (container_info{ "commits", group_commit.commits, 0 }));
+	composite->add_component (std::make_unique<vxlnetwork::container_info_leaf> (container_info{ "actions", group_commit.actions, 0 }));
+	return composite;
+}
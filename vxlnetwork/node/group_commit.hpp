@@ -0,0 +1,109 @@
+#pragma once
+
+#include <vxlnetwork/lib/locks.hpp>
+#include <vxlnetwork/lib/utility.hpp>
+#include <vxlnetwork/node/write_database_queue.hpp>
+#include <vxlnetwork/secure/store.hpp>
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <deque>
+#include <functional>
+#include <future>
+#include <thread>
+#include <vector>
+
+namespace vxlnetwork
+{
+class stat;
+
+/**
+ * Coalesces small, independent database writes from several writers into a single write transaction so that
+ * one commit (and its fsync) is paid for a whole group of actions instead of once per action.
+ *
+ * Every writer has a latency budget: an action is committed at the latest once its budget has elapsed since it
+ * was submitted, or earlier when the batch is full or another action with an elapsed budget triggers the commit.
+ * With a zero budget an action commits as soon as the writer thread is idle, batching then only happens naturally
+ * while a previous group is being committed. Writers are drained round-robin when a batch is assembled so a busy
+ * writer cannot starve the others.
+ *
+ * Groups do not take the write_database_queue guard. Like the standalone transactions they replace, they only wait for
+ * the database's own writer lock, so a blocking caller is never queued behind the exclusive writers waiting on the queue.
+ * @note This class is thread-safe.
+ */
+class group_commit final
+{
+public:
+	using action = std::function<void (vxlnetwork::write_transaction const &)>;
+
+	class config final
+	{
+	public:
+		config ();
+		/** Maximum number of actions committed by a single write transaction */
+		std::size_t max_batch{ 256 };
+		/** Latency budget per writer, indexed by the vxlnetwork::writer value */
+		std::array<std::chrono::milliseconds, static_cast<std::size_t> (vxlnetwork::writer::count)> budgets;
+		void set_budget (vxlnetwork::writer, std::chrono::milliseconds);
+		std::chrono::milliseconds budget (vxlnetwork::writer) const;
+	};
+
+	group_commit (vxlnetwork::store &, vxlnetwork::stat &, config const & = config{});
+	~group_commit ();
+
+	/**
+	 * Queues \p action_a to be run inside a write transaction opened over \p tables_a (in addition to the tables of the other actions in the group).
+	 * The returned future becomes ready once the transaction containing the action has been committed. If an action of the
+	 * group or the commit throws, the exception is stored in the future of every action of the group.
+	 * After stop () the action is run and committed on the calling thread.
+	 */
+	std::future<void> submit (vxlnetwork::writer writer_a, std::vector<vxlnetwork::tables> const & tables_a, action const & action_a);
+	/** Blocks until all actions submitted so far have been committed */
+	void flush ();
+	/** Commits pending actions and stops the writer thread */
+	void stop ();
+	std::size_t size () const;
+
+	std::atomic<uint64_t> commits{ 0 };
+	std::atomic<uint64_t> actions{ 0 };
+
+private:
+	class entry final
+	{
+	public:
+		std::vector<vxlnetwork::tables> tables;
+		vxlnetwork::group_commit::action action;
+		std::chrono::steady_clock::time_point submitted;
+		std::chrono::steady_clock::time_point deadline;
+		std::promise<void> promise;
+	};
+
+	void run ();
+	/** Takes up to max_batch entries, one per writer at a time. Must be called with the mutex held */
+	std::vector<entry> take_batch ();
+	/** Earliest deadline over the head of every writer queue. Must be called with the mutex held */
+	std::chrono::steady_clock::time_point next_deadline () const;
+	/** Commits the batch in one transaction and fulfills the promise of every entry. Does not throw */
+	void commit_batch (std::vector<entry> &);
+
+	vxlnetwork::store & store;
+	vxlnetwork::stat & stats;
+	config const config_m;
+	std::array<std::deque<entry>, static_cast<std::size_t> (vxlnetwork::writer::count)> queues;
+	std::size_t queued{ 0 };
+	/** Writer queue the next batch starts from, rotated after every batch */
+	std::size_t next_writer{ 0 };
+	bool committing{ false };
+	bool stopped{ false };
+	mutable vxlnetwork::mutex mutex;
+	/** Serializes commits, only relevant after stop () when callers commit on their own threads */
+	vxlnetwork::mutex commit_mutex;
+	vxlnetwork::condition_variable condition;
+	std::thread thread;
+
+	friend std::unique_ptr<container_info_component> collect_container_info (group_commit &, std::string const &);
+};
+
+std::unique_ptr<container_info_component> collect_container_info (group_commit & group_commit, std::string const & name);
+}
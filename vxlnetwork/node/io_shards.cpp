@@ -0,0 +1,158 @@
+#include <vxlnetwork/lib/threading.hpp>
+#include <vxlnetwork/lib/utility.hpp>
+#include <vxlnetwork/node/io_shards.hpp>
+
+#include <iostream>
+
+std::size_t constexpr vxlnetwork::io_shards::none;
+
+vxlnetwork::io_shards::shard::shard () :
+	io_guard (boost::asio::make_work_guard (io_ctx))
+{
+}
+
+vxlnetwork::io_shards::io_shards (boost::asio::io_context & shared_a, unsigned shard_count_a) :
+	shared (shared_a),
+	sockets (std::make_unique<std::atomic<std::size_t>[]> (shard_count_a))
+{
+	auto const cpus (std::thread::hardware_concurrency ());
+	boost::thread::attributes attrs;
+	vxlnetwork::thread_attributes::set (attrs);
+	for (auto i (0u); i < shard_count_a; ++i)
+	{
+		sockets[i] = 0;
+		shards.push_back (std::make_unique<shard> ());
+		auto & shard_l (*shards.back ());
+		// Counting down from the last CPU keeps at least one CPU free of shard threads
+		auto const cpu (shard_count_a < cpus ? std::make_optional (cpus - 1 - i) : std::nullopt);
+		shard_l.thread = boost::thread (attrs, [this, &shard_l, cpu] () {
+			run (shard_l, cpu);
+		});
+	}
+}
+
+vxlnetwork::io_shards::~io_shards ()
+{
+	stop ();
+}
+
+void vxlnetwork::io_shards::run (vxlnetwork::io_shards::shard & shard_a, std::optional<unsigned> cpu_a)
+{
+	vxlnetwork::thread_role::set (vxlnetwork::thread_role::name::io_shard);
+	if (cpu_a)
+	{
+		vxlnetwork::thread_pin_to_cpu (*cpu_a);
+	}
+	try
+	{
+		while (shard_a.io_ctx.run_one () > 0)
+		{
+			++shard_a.handlers;
+		}
+	}
+	catch (std::exception const & ex)
+	{
+		std::cerr << ex.what () << std::endl;
+#ifndef NDEBUG
+		throw;
+#endif
+	}
+	catch (...)
+	{
+#ifndef NDEBUG
+		throw;
+#endif
+	}
+}
+
+void vxlnetwork::io_shards::stop ()
+{
+	for (auto & shard_l : shards)
+	{
+		shard_l->io_guard.reset ();
+		shard_l->io_ctx.stop ();
+	}
+	for (auto & shard_l : shards)
+	{
+		// A shard thread stopping the node must not wait for itself
+		if (shard_l->thread.joinable () && shard_l->thread.get_id () != boost::this_thread::get_id ())
+		{
+			shard_l->thread.join ();
+		}
+	}
+}
+
+std::size_t vxlnetwork::io_shards::pick () const
+{
+	if (shards.empty ())
+	{
+		return none;
+	}
+	std::size_t result (0);
+	for (std::size_t i (1); i < shards.size (); ++i)
+	{
+		if (sockets[i] < sockets[result])
+		{
+			result = i;
+		}
+	}
+	return result;
+}
+
+void vxlnetwork::io_shards::acquire (std::size_t shard_a)
+{
+	if (shard_a != none)
+	{
+		debug_assert (shard_a < shards.size ());
+		++sockets[shard_a];
+	}
+}
+
+std::size_t vxlnetwork::io_shards::assign ()
+{
+	auto result (pick ());
+	acquire (result);
+	return result;
+}
+
+void vxlnetwork::io_shards::release (std::size_t shard_a)
+{
+	if (shard_a != none)
+	{
+		debug_assert (shard_a < shards.size ());
+		--sockets[shard_a];
+	}
+}
+
+boost::asio::io_context & vxlnetwork::io_shards::context (std::size_t shard_a)
+{
+	if (shard_a == none)
+	{
+		return shared;
+	}
+	debug_assert (shard_a < shards.size ());
+	return shards[shard_a]->io_ctx;
+}
+
+std::size_t vxlnetwork::io_shards::size () const
+{
+	return shards.size ();
+}
+
+std::size_t vxlnetwork::io_shards::socket_count (std::size_t shard_a) const
+{
+	return shard_a < shards.size () ? sockets[shard_a].load () : 0;
+}
+
+std::unique_ptr<vxlnetwork::container_info_component> vxlnetwork::collect_container_info (io_shards & io_shards, std::string const & name)
+{
+	auto composite = std::make_unique<container_info_composite> (name);
+	for (std::size_t i (0); i < io_shards.shards.size (); ++i)
+	{
+		auto shard_composite = std::make_unique<container_info_composite> ("shard_" + std::to_string (i));
+		shard_composite->add_component (std::make_unique<container_info_leaf> (container_info{ "sockets", io_shards.socket_count (i), 0 }));
+		shard_composite->add_component (std::make_unique<container_info_leaf> (container_info{ "handlers", static_cast<std::size_t> (io_shards.shards[i]->handlers), 0 }));
+		composite->add_component (std::move (shard_composite));
+	}
+	return composite;
+}
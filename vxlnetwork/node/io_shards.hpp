@@ -0,0 +1,77 @@
+#pragma once
+
+#include <vxlnetwork/boost/asio/executor_work_guard.hpp>
+#include <vxlnetwork/boost/asio/io_context.hpp>
+
+#include <boost/thread/thread.hpp>
+
+#include <atomic>
+#include <limits>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace vxlnetwork
+{
+class container_info_component;
+
+/**
+ * Optional set of io_contexts, each run by a single thread.
+ * Every client and accepted peer socket is assigned to one shard for its whole lifetime so its handlers never migrate
+ * between threads. Listening sockets stay on the shared io_context. Work crossing shards, like processing a received
+ * message, is handed off through the node's existing processing queues. With no shards configured all sockets run on
+ * the shared io_context.
+ *
+ * Shard threads are pinned to the highest numbered CPUs, away from the low CPUs the scheduler fills first with the
+ * shared io_threads and other node threads. Nothing is pinned when there are not more CPUs than shards.
+ */
+class io_shards final
+{
+public:
+	io_shards (boost::asio::io_context & shared_a, unsigned shard_count_a);
+	~io_shards ();
+	/** Stops all shard threads, pending handlers are discarded */
+	void stop ();
+	/** Returns the shard with the fewest sockets without counting a socket for it */
+	std::size_t pick () const;
+	/** Counts a socket for \p shard_a, its context must be used for all of the socket's handlers */
+	void acquire (std::size_t shard_a);
+	/** Picks and acquires the shard with the fewest sockets */
+	std::size_t assign ();
+	/** Called once the socket which acquired \p shard_a is destroyed */
+	void release (std::size_t shard_a);
+	/** The shard's io_context, or the shared one for \p none or when no shards are configured */
+	boost::asio::io_context & context (std::size_t shard_a);
+	std::size_t size () const;
+	/** Number of live sockets assigned to \p shard_a */
+	std::size_t socket_count (std::size_t shard_a) const;
+
+	/** Not a shard, used by sockets running on the shared io_context */
+	static std::size_t constexpr none = std::numeric_limits<std::size_t>::max ();
+
+private:
+	class shard final
+	{
+	public:
+		shard ();
+		boost::asio::io_context io_ctx;
+		boost::asio::executor_work_guard<boost::asio::io_context::executor_type> io_guard;
+		boost::thread thread;
+		/** Completion handlers run by this shard */
+		std::atomic<uint64_t> handlers{ 0 };
+	};
+
+	/** Pins the thread to \p cpu_a unless it is std::nullopt */
+	void run (vxlnetwork::io_shards::shard &, std::optional<unsigned> cpu_a);
+
+	boost::asio::io_context & shared;
+	/** Sockets per shard, kept outside of the shards so sockets destroyed along with a shard's pending handlers can still release */
+	std::unique_ptr<std::atomic<std::size_t>[]> sockets;
+	std::vector<std::unique_ptr<shard>> shards;
+
+	friend std::unique_ptr<container_info_component> collect_container_info (io_shards & io_shards, std::string const & name);
+};
+
+std::unique_ptr<container_info_component> collect_container_info (io_shards & io_shards, std::string const & name);
+}
@@ -26,6 +26,14 @@ vxlnetwork::error vxlnetwork::ipc::ipc_config::serialize_toml (vxlnetwork::tomlc
 	domain_l.put ("io_timeout", transport_domain.io_timeout, "Timeout for requests.\ntype:seconds");
 	toml.put_child ("local", domain_l);
 
+	vxlnetwork::tomlconfig shared_memory_l;
+	shared_memory_l.put ("enable", transport_shared_memory.enabled, "Enable or disable IPC via shared memory. Only flatbuffers encodings are supported, clients read responses and events in place.\ntype:bool");
+	shared_memory_l.put ("name", transport_shared_memory.name, "Name of the shared memory object.\ntype:string");
+	shared_memory_l.put ("channels", transport_shared_memory.channels, "Number of clients which can be connected at the same time.\ntype:uint64");
+	shared_memory_l.put ("ring_size", transport_shared_memory.ring_size, "Size in bytes of each client's request and response buffers. Must be a power of two, messages are limited to half of it.\ntype:uint64");
+	shared_memory_l.put ("io_timeout", transport_shared_memory.io_timeout, "Timeout for writing responses when the client does not read them.\ntype:seconds");
+	toml.put_child ("shared_memory", shared_memory_l);
+
 	vxlnetwork::tomlconfig flatbuffers_l;
 	flatbuffers_l.put ("skip_unexpected_fields_in_json", flatbuffers.skip_unexpected_fields_in_json, "Allow client to send unknown fields in json messages. These will be ignored.\ntype:bool");
 	flatbuffers_l.put ("verify_buffers", flatbuffers.verify_buffers, "Verify that the buffer is valid before parsing. This is recommended when receiving data from untrusted sources.\ntype:bool");
@@ -56,6 +64,16 @@ vxlnetwork::error vxlnetwork::ipc::ipc_config::deserialize_toml (vxlnetwork::tom
 		domain_l->get<std::size_t> ("io_timeout", transport_domain.io_timeout);
 	}
 
+	auto shared_memory_l (toml.get_optional_child ("shared_memory"));
+	if (shared_memory_l)
+	{
+		shared_memory_l->get<bool> ("enable", transport_shared_memory.enabled);
+		shared_memory_l->get<std::string> ("name", transport_shared_memory.name);
+		shared_memory_l->get<std::size_t> ("channels", transport_shared_memory.channels);
+		shared_memory_l->get<std::size_t> ("ring_size", transport_shared_memory.ring_size);
+		shared_memory_l->get<std::size_t> ("io_timeout", transport_shared_memory.io_timeout);
+	}
+
 	auto flatbuffers_l (toml.get_optional_child ("flatbuffers"));
 	if (flatbuffers_l)
 	{
@@ -56,6 +56,18 @@ namespace ipc
 		uint16_t port;
 	};
 
+	/** Shared memory specific transport config */
+	class ipc_config_shared_memory : public ipc_config_transport
+	{
+	public:
+		/** Name of the POSIX shared memory object */
+		std::string name{ "/vxlnetwork" };
+		/** Number of clients which can be connected at the same time */
+		std::size_t channels{ 4 };
+		/** Size of each channel's request and response ring, a power of two. Messages are limited to half of it */
+		std::size_t ring_size{ 4 * 1024 * 1024 };
+	};
+
 	/** IPC configuration */
 	class ipc_config
 	{
@@ -68,6 +80,7 @@ namespace ipc
 		vxlnetwork::error serialize_toml (vxlnetwork::tomlconfig & toml) const;
 		ipc_config_domain_socket transport_domain;
 		ipc_config_tcp_socket transport_tcp;
+		ipc_config_shared_memory transport_shared_memory;
 		ipc_config_flatbuffers flatbuffers;
 	};
 }
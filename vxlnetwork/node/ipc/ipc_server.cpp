@@ -4,6 +4,7 @@
 #include <vxlnetwork/boost/asio/strand.hpp>
 #include <vxlnetwork/lib/config.hpp>
 #include <vxlnetwork/lib/ipc.hpp>
+#include <vxlnetwork/lib/ipc_shm.hpp>
 #include <vxlnetwork/lib/locks.hpp>
 #include <vxlnetwork/lib/threading.hpp>
 #include <vxlnetwork/lib/timer.hpp>
@@ -294,7 +295,7 @@ public:
 			});
 		}));
 		// For unsafe actions to be allowed, the unsafe encoding must be used AND the transport config must allow it
-		handler->process_request (allow_unsafe && config_transport.allow_unsafe);
+		handler->queue_request (allow_unsafe && config_transport.allow_unsafe);
 	}
 
 	/** Async request reader */
@@ -573,6 +574,288 @@ std::optional<std::uint16_t> socket_transport<ACCEPTOR_TYPE, SOCKET_TYPE, ENDPOI
 	return std::nullopt;
 }
 
+/**
+ * A session on a shared memory channel. Requests are handled in place on the channel thread, responses and
+ * broker events are copied into the response ring once, from where the client reads them in place.
+ */
+class shm_session final : public std::enable_shared_from_this<shm_session>
+{
+public:
+	shm_session (vxlnetwork::ipc::ipc_server & server_a, vxlnetwork::ipc::shm_channel & channel_a, vxlnetwork::ipc::ipc_config_transport & config_transport_a) :
+		server (server_a), node (server_a.node), session_id (server_a.id_dispenser.fetch_add (1)), channel (channel_a), config_transport (config_transport_a)
+	{
+		if (node.config.logging.log_ipc ())
+		{
+			node.logger.always_log ("IPC: created shared memory session with id: ", session_id);
+		}
+	}
+
+	std::shared_ptr<vxlnetwork::ipc::subscriber> get_subscriber ()
+	{
+		class subscriber_impl final : public vxlnetwork::ipc::subscriber
+		{
+		public:
+			subscriber_impl (std::shared_ptr<shm_session> const & session_a) :
+				session_m (session_a)
+			{
+			}
+
+			void async_send_message (uint8_t const * data_a, std::size_t length_a, std::function<void (vxlnetwork::error const &)> broadcast_completion_handler_a) override
+			{
+				if (auto session_l = session_m.lock ())
+				{
+					auto error_l (session_l->send_event (data_a, length_a));
+					if (broadcast_completion_handler_a)
+					{
+						broadcast_completion_handler_a (error_l);
+					}
+				}
+			}
+
+			uint64_t get_id () const override
+			{
+				uint64_t id{ 0 };
+				if (auto session_l = session_m.lock ())
+				{
+					id = session_l->session_id;
+				}
+				return id;
+			}
+
+			std::string get_service_name () const override
+			{
+				std::string name;
+				if (auto session_l = session_m.lock ())
+				{
+					name = session_l->service_name;
+				}
+				return name;
+			}
+
+			void set_service_name (std::string const & service_name_a) override
+			{
+				if (auto session_l = session_m.lock ())
+				{
+					session_l->service_name = service_name_a;
+				}
+			}
+
+			vxlnetwork::ipc::payload_encoding get_active_encoding () const override
+			{
+				vxlnetwork::ipc::payload_encoding encoding{ vxlnetwork::ipc::payload_encoding::flatbuffers };
+				if (auto session_l = session_m.lock ())
+				{
+					encoding = session_l->active_encoding;
+				}
+				return encoding;
+			}
+
+		private:
+			std::weak_ptr<shm_session> session_m;
+		};
+
+		if (!subscriber)
+		{
+			subscriber = std::make_shared<subscriber_impl> (shared_from_this ());
+		}
+		return subscriber;
+	}
+
+	/** Handles a request in place. The data is only valid during the call, which is why flatbuffers requests are handled synchronously */
+	void handle_request (uint8_t const * data_a, std::size_t size_a)
+	{
+		if (size_a < 4 || data_a[vxlnetwork::ipc::preamble_offset::lead] != 'N' || data_a[vxlnetwork::ipc::preamble_offset::reserved_1] != 0 || data_a[vxlnetwork::ipc::preamble_offset::reserved_2] != 0)
+		{
+			if (node.config.logging.log_ipc ())
+			{
+				node.logger.always_log ("IPC: Invalid preamble");
+			}
+		}
+		else
+		{
+			auto encoding (data_a[vxlnetwork::ipc::preamble_offset::encoding]);
+			active_encoding = static_cast<vxlnetwork::ipc::payload_encoding> (encoding);
+			if (encoding == static_cast<uint8_t> (vxlnetwork::ipc::payload_encoding::flatbuffers) || encoding == static_cast<uint8_t> (vxlnetwork::ipc::payload_encoding::flatbuffers_json))
+			{
+				session_timer.restart ();
+
+				// Lazily create one Flatbuffers handler instance per session
+				if (!flatbuffers_handler)
+				{
+					flatbuffers_handler = std::make_shared<vxlnetwork::ipc::flatbuffers_handler> (node, server, get_subscriber (), node.config.ipc_config);
+				}
+
+				if (encoding == static_cast<uint8_t> (vxlnetwork::ipc::payload_encoding::flatbuffers_json))
+				{
+					flatbuffers_handler->process_json (data_a + 4, size_a - 4, [this] (std::shared_ptr<std::string> const & body) {
+						write_response (reinterpret_cast<uint8_t const *> (body->data ()), body->size ());
+					});
+				}
+				else
+				{
+					flatbuffers_handler->process (data_a + 4, size_a - 4, [this] (std::shared_ptr<flatbuffers::FlatBufferBuilder> const & fbb) {
+						write_response (fbb->GetBufferPointer (), fbb->GetSize ());
+					});
+				}
+			}
+			else if (node.config.logging.log_ipc ())
+			{
+				node.logger.always_log ("IPC: Unsupported payload encoding for shared memory");
+			}
+		}
+	}
+
+	/** Stops writing to the channel, after this the rings can be reset for the next client */
+	void close ()
+	{
+		vxlnetwork::lock_guard<vxlnetwork::mutex> guard (mutex);
+		closed = true;
+	}
+
+private:
+	/** Writes a response, waiting up to the io timeout for the client to make space */
+	void write_response (uint8_t const * data_a, std::size_t size_a)
+	{
+		if (node.config.logging.log_ipc ())
+		{
+			node.logger.always_log (boost::str (boost::format ("IPC/Flatbuffer request completed in: %1% %2%") % session_timer.stop ().count () % session_timer.unit ()));
+		}
+
+		auto const deadline (std::chrono::steady_clock::now () + std::chrono::seconds (config_transport.io_timeout));
+		auto done (false);
+		while (!done)
+		{
+			{
+				// Broker events are written concurrently, space is waited for without holding the lock so they are never held up
+				vxlnetwork::lock_guard<vxlnetwork::mutex> guard (mutex);
+				done = closed || !channel.responses.write (data_a, size_a, std::chrono::milliseconds (0));
+			}
+			auto remaining (std::chrono::duration_cast<std::chrono::milliseconds> (deadline - std::chrono::steady_clock::now ()));
+			if (!done && channel.responses.wait_writable (size_a, std::max (remaining, std::chrono::milliseconds (0))))
+			{
+				node.logger.always_log (boost::str (boost::format ("IPC: Dropped shared memory response of %1% bytes, the client does not read responses or the message exceeds %2% bytes") % size_a % channel.responses.max_message_size ()));
+				done = true;
+			}
+		}
+	}
+
+	/** Events are dropped instead of waiting if the client does not keep up, so the broker is never held up */
+	vxlnetwork::error send_event (uint8_t const * data_a, std::size_t length_a)
+	{
+		vxlnetwork::error error_l;
+		vxlnetwork::lock_guard<vxlnetwork::mutex> guard (mutex);
+		if (closed)
+		{
+			error_l = "Session closed";
+		}
+		else if (channel.responses.write (data_a, length_a, std::chrono::milliseconds (0)))
+		{
+			node.stats.inc (vxlnetwork::stat::type::ipc, vxlnetwork::stat::detail::overflow, vxlnetwork::stat::dir::out);
+			error_l = "Shared memory response ring is full";
+		}
+		return error_l;
+	}
+
+	vxlnetwork::ipc::ipc_server & server;
+	vxlnetwork::node & node;
+	uint64_t const session_id;
+	vxlnetwork::ipc::shm_channel & channel;
+	vxlnetwork::ipc::ipc_config_transport & config_transport;
+
+	/** Serializes writes to the response ring, and protects closed */
+	vxlnetwork::mutex mutex;
+	bool closed{ false };
+
+	/** Service name associated with this session. This is set through the ServiceRegister API */
+	vxlnetwork::locked<std::string> service_name;
+	std::atomic<vxlnetwork::ipc::payload_encoding> active_encoding{ vxlnetwork::ipc::payload_encoding::flatbuffers };
+	/** Timer for measuring the duration of ipc calls, only used by the channel thread */
+	vxlnetwork::timer<std::chrono::microseconds> session_timer;
+	/** Handler for Flatbuffers requests. This is created lazily on the first request. */
+	std::shared_ptr<vxlnetwork::ipc::flatbuffers_handler> flatbuffers_handler;
+	std::shared_ptr<vxlnetwork::ipc::subscriber> subscriber;
+};
+
+/** Shared memory transport, serving every channel of the segment from a dedicated thread */
+class shm_transport final : public vxlnetwork::ipc::transport
+{
+public:
+	shm_transport (vxlnetwork::ipc::ipc_server & server_a, vxlnetwork::ipc::ipc_config_shared_memory & config_a) :
+		server (server_a), config (config_a)
+	{
+		auto error (segment.create (config.name, config.channels, config.ring_size));
+		if (error)
+		{
+			throw std::runtime_error ("Could not create shared memory segment " + config.name + ": " + error.get_message ());
+		}
+		for (std::size_t i (0); i < segment.channels.size (); ++i)
+		{
+			threads.emplace_back ([this, i] () {
+				vxlnetwork::thread_role::set (vxlnetwork::thread_role::name::ipc_shared_memory);
+				run (segment.channels[i]);
+			});
+		}
+	}
+
+	~shm_transport ()
+	{
+		stop ();
+	}
+
+	void stop () override
+	{
+		stopped = true;
+		for (auto & thread : threads)
+		{
+			if (thread.joinable ())
+			{
+				thread.join ();
+			}
+		}
+	}
+
+private:
+	void run (vxlnetwork::ipc::shm_channel & channel_a)
+	{
+		std::shared_ptr<shm_session> session;
+		while (!stopped)
+		{
+			// Waits in slices to notice shutdown and disconnected clients
+			auto timeout (channel_a.requests.read ([&session, &channel_a, this] (uint8_t const * data_a, std::size_t size_a) {
+				if (!session)
+				{
+					session = std::make_shared<shm_session> (server, channel_a, config);
+				}
+				server.node.stats.inc (vxlnetwork::stat::type::ipc, vxlnetwork::stat::detail::invocations);
+				session->handle_request (data_a, size_a);
+			},
+			std::chrono::milliseconds (250)));
+			if (timeout && (channel_a.status == static_cast<uint32_t> (vxlnetwork::ipc::shm_channel_status::closed) || channel_a.client_died ()))
+			{
+				if (session)
+				{
+					// Dropping the session expires its broker subscriptions
+					session->close ();
+					session = nullptr;
+				}
+				channel_a.requests.reset ();
+				channel_a.responses.reset ();
+				channel_a.client_pid = 0;
+				channel_a.status = static_cast<uint32_t> (vxlnetwork::ipc::shm_channel_status::free);
+			}
+		}
+		if (session)
+		{
+			session->close ();
+		}
+	}
+
+	vxlnetwork::ipc::ipc_server & server;
+	vxlnetwork::ipc::ipc_config_shared_memory & config;
+	vxlnetwork::ipc::shm_segment segment;
+	std::vector<std::thread> threads;
+	std::atomic<bool> stopped{ false };
+};
 }
 
 /**
@@ -630,6 +913,11 @@ vxlnetwork::ipc::ipc_server::ipc_server (vxlnetwork::node & node_a, vxlnetwork::
 			transports.push_back (std::make_shared<tcp_socket_transport> (*this, boost::asio::ip::tcp::endpoint (boost::asio::ip::tcp::v6 (), node_a.config.ipc_config.transport_tcp.port), node_a.config.ipc_config.transport_tcp, threads));
 		}
 
+		if (node_a.config.ipc_config.transport_shared_memory.enabled)
+		{
+			transports.push_back (std::make_shared<shm_transport> (*this, node_a.config.ipc_config.transport_shared_memory));
+		}
+
 		node.logger.always_log ("IPC: server started");
 
 		if (!transports.empty ())
@@ -14,6 +14,7 @@
 
 #include <algorithm>
 #include <chrono>
+#include <unordered_set>
 
 namespace
 {
@@ -54,6 +55,30 @@ std::function<void ()> vxlnetwork::json_handler::create_worker_task (std::functi
 
 void vxlnetwork::json_handler::process_request (bool unsafe_a)
 {
+	if (!parse_request ())
+	{
+		execute_action (unsafe_a);
+	}
+}
+
+void vxlnetwork::json_handler::queue_request (bool unsafe_a)
+{
+	if (!parse_request ())
+	{
+		auto this_l (shared_from_this ());
+		node.rpc_executor.execute (
+		action, [this_l, unsafe_a] () {
+			this_l->execute_action (unsafe_a);
+		},
+		[this_l] (std::string const & error_a) {
+			json_error_response (this_l->response, error_a);
+		});
+	}
+}
+
+bool vxlnetwork::json_handler::parse_request ()
+{
+	auto error (true);
 	try
 	{
 		std::stringstream istream (body);
@@ -64,6 +89,23 @@ void vxlnetwork::json_handler::process_request (bool unsafe_a)
 			node_rpc_config.request_callback (request);
 		}
 		action = request.get<std::string> ("action");
+		error = false;
+	}
+	catch (std::runtime_error const &)
+	{
+		json_error_response (response, "Unable to parse JSON");
+	}
+	catch (...)
+	{
+		json_error_response (response, "Internal server error in RPC");
+	}
+	return error;
+}
+
+void vxlnetwork::json_handler::execute_action (bool unsafe_a)
+{
+	try
+	{
 		auto no_arg_func_iter = ipc_json_handler_no_arg_funcs.find (action);
 		if (no_arg_func_iter != ipc_json_handler_no_arg_funcs.cend ())
 		{
@@ -94,7 +136,6 @@ void vxlnetwork::json_handler::process_request (bool unsafe_a)
 			}
 			else if (action == "history")
 			{
-				response_l.put ("deprecated", "1");
 				request.put ("head", request.get<std::string> ("hash"));
 				account_history ();
 			}
@@ -156,7 +197,7 @@ void vxlnetwork::json_handler::process_request (bool unsafe_a)
 
 void vxlnetwork::json_handler::response_errors ()
 {
-	if (!ec && response_l.empty ())
+	if (!ec && response_l.empty () && response_writer.empty ())
 	{
 		// Return an error code if no response data was given
 		ec = vxlnetwork::error_rpc::empty_response;
@@ -169,11 +210,14 @@ void vxlnetwork::json_handler::response_errors ()
 		boost::property_tree::write_json (ostream, response_error);
 		response (ostream.str ());
 	}
+	else if (!response_writer.empty ())
+	{
+		debug_assert (response_l.empty ());
+		response (response_writer.finish ());
+	}
 	else
 	{
-		std::stringstream ostream;
-		boost::property_tree::write_json (ostream, response_l);
-		response (ostream.str ());
+		response (vxlnetwork::json_writer::write (response_l));
 	}
 }
 
@@ -338,6 +382,24 @@ vxlnetwork::block_hash vxlnetwork::json_handler::hash_impl (std::string search_t
 	return result;
 }
 
+bool vxlnetwork::json_handler::hashes_impl (std::vector<std::string> & hashes_text_a, std::vector<vxlnetwork::block_hash> & hashes_a)
+{
+	bool result (false);
+	for (auto & hashes : request.get_child ("hashes"))
+	{
+		std::string hash_text = hashes.second.data ();
+		vxlnetwork::block_hash hash;
+		if (hash.decode_hex (hash_text))
+		{
+			result = true;
+			break;
+		}
+		hashes_text_a.push_back (hash_text);
+		hashes_a.push_back (hash);
+	}
+	return result;
+}
+
 vxlnetwork::amount vxlnetwork::json_handler::threshold_optional_impl ()
 {
 	vxlnetwork::amount result (0);
@@ -891,17 +953,28 @@ void vxlnetwork::json_handler::account_weight ()
 void vxlnetwork::json_handler::accounts_balances ()
 {
 	boost::property_tree::ptree balances;
-	for (auto & accounts : request.get_child ("accounts"))
+	std::vector<vxlnetwork::account> accounts;
+	for (auto & accounts_text : request.get_child ("accounts"))
 	{
-		auto account (account_impl (accounts.second.data ()));
+		auto account (account_impl (accounts_text.second.data ()));
 		if (!ec)
+		{
+			accounts.push_back (account);
+		}
+	}
+	if (!ec)
+	{
+		auto transaction (node.store.tx_begin_read ());
+		auto const infos (node.store.account.batch_get (transaction, accounts));
+		for (std::size_t i = 0; i < accounts.size (); ++i)
 		{
 			boost::property_tree::ptree entry;
-			auto balance (node.balance_pending (account, false));
-			entry.put ("balance", balance.first.convert_to<std::string> ());
-			entry.put ("pending", balance.second.convert_to<std::string> ());
-			entry.put ("receivable", balance.second.convert_to<std::string> ());
-			balances.push_back (std::make_pair (account.to_account (), entry));
+			vxlnetwork::uint128_t const balance (infos[i] ? infos[i]->balance.number () : 0);
+			auto const receivable (node.ledger.account_receivable (transaction, accounts[i], false));
+			entry.put ("balance", balance.convert_to<std::string> ());
+			entry.put ("pending", receivable.convert_to<std::string> ());
+			entry.put ("receivable", receivable.convert_to<std::string> ());
+			balances.push_back (std::make_pair (accounts[i].to_account (), entry));
 		}
 	}
 	response_l.add_child ("balances", balances);
@@ -956,16 +1029,24 @@ void vxlnetwork::json_handler::accounts_create ()
 void vxlnetwork::json_handler::accounts_frontiers ()
 {
 	boost::property_tree::ptree frontiers;
-	auto transaction (node.store.tx_begin_read ());
-	for (auto & accounts : request.get_child ("accounts"))
+	std::vector<vxlnetwork::account> accounts;
+	for (auto & accounts_text : request.get_child ("accounts"))
 	{
-		auto account (account_impl (accounts.second.data ()));
+		auto account (account_impl (accounts_text.second.data ()));
 		if (!ec)
 		{
-			auto latest (node.ledger.latest (transaction, account));
-			if (!latest.is_zero ())
+			accounts.push_back (account);
+		}
+	}
+	if (!ec)
+	{
+		auto transaction (node.store.tx_begin_read ());
+		auto const infos (node.store.account.batch_get (transaction, accounts));
+		for (std::size_t i = 0; i < accounts.size (); ++i)
+		{
+			if (infos[i] && !infos[i]->head.is_zero ())
 			{
-				frontiers.put (account.to_account (), latest.to_string ());
+				frontiers.put (accounts[i].to_account (), infos[i]->head.to_string ());
 			}
 		}
 	}
@@ -1195,41 +1276,38 @@ void vxlnetwork::json_handler::blocks ()
 {
 	bool const json_block_l = request.get<bool> ("json_block", false);
 	boost::property_tree::ptree blocks;
+	std::vector<std::string> hashes_text;
+	std::vector<vxlnetwork::block_hash> hashes;
+	auto const bad_hash (hashes_impl (hashes_text, hashes));
 	auto transaction (node.store.tx_begin_read ());
-	for (boost::property_tree::ptree::value_type & hashes : request.get_child ("hashes"))
+	auto const blocks_l (node.store.block.batch_get (transaction, hashes));
+	for (std::size_t i = 0; i < hashes.size () && !ec; ++i)
 	{
-		if (!ec)
+		auto const & hash_text (hashes_text[i]);
+		auto const & block (blocks_l[i]);
+		if (block != nullptr)
 		{
-			std::string hash_text = hashes.second.data ();
-			vxlnetwork::block_hash hash;
-			if (!hash.decode_hex (hash_text))
+			if (json_block_l)
 			{
-				auto block (node.store.block.get (transaction, hash));
-				if (block != nullptr)
-				{
-					if (json_block_l)
-					{
-						boost::property_tree::ptree block_node_l;
-						block->serialize_json (block_node_l);
-						blocks.add_child (hash_text, block_node_l);
-					}
-					else
-					{
-						std::string contents;
-						block->serialize_json (contents);
-						blocks.put (hash_text, contents);
-					}
-				}
-				else
-				{
-					ec = vxlnetwork::error_blocks::not_found;
-				}
+				boost::property_tree::ptree block_node_l;
+				block->serialize_json (block_node_l);
+				blocks.add_child (hash_text, block_node_l);
 			}
 			else
 			{
-				ec = vxlnetwork::error_blocks::bad_hash_number;
+				std::string contents;
+				block->serialize_json (contents);
+				blocks.put (hash_text, contents);
 			}
 		}
+		else
+		{
+			ec = vxlnetwork::error_blocks::not_found;
+		}
+	}
+	if (!ec && bad_hash)
+	{
+		ec = vxlnetwork::error_blocks::bad_hash_number;
 	}
 	response_l.add_child ("blocks", blocks);
 	response_errors ();
@@ -1246,127 +1324,125 @@ void vxlnetwork::json_handler::blocks_info ()
 
 	boost::property_tree::ptree blocks;
 	boost::property_tree::ptree blocks_not_found;
+	std::vector<std::string> hashes_text;
+	std::vector<vxlnetwork::block_hash> hashes;
+	auto const bad_hash (hashes_impl (hashes_text, hashes));
 	auto transaction (node.store.tx_begin_read ());
-	for (boost::property_tree::ptree::value_type & hashes : request.get_child ("hashes"))
+	auto const blocks_l (node.store.block.batch_get (transaction, hashes));
+	for (std::size_t i = 0; i < hashes.size () && !ec; ++i)
 	{
-		if (!ec)
+		auto const & hash_text (hashes_text[i]);
+		auto const & hash (hashes[i]);
+		auto const & block (blocks_l[i]);
+		if (block != nullptr)
 		{
-			std::string hash_text = hashes.second.data ();
-			vxlnetwork::block_hash hash;
-			if (!hash.decode_hex (hash_text))
+			boost::property_tree::ptree entry;
+			vxlnetwork::account account (block->account ().is_zero () ? block->sideband ().account : block->account ());
+			entry.put ("block_account", account.to_account ());
+			bool error_or_pruned (false);
+			auto amount (node.ledger.amount_safe (transaction, hash, error_or_pruned));
+			if (!error_or_pruned)
 			{
-				auto block (node.store.block.get (transaction, hash));
-				if (block != nullptr)
+				entry.put ("amount", amount.convert_to<std::string> ());
+			}
+			auto balance (node.ledger.balance (transaction, hash));
+			entry.put ("balance", balance.convert_to<std::string> ());
+			entry.put ("height", std::to_string (block->sideband ().height));
+			entry.put ("local_timestamp", std::to_string (block->sideband ().timestamp));
+			entry.put ("successor", block->sideband ().successor.to_string ());
+			auto confirmed (node.ledger.block_confirmed (transaction, hash));
+			entry.put ("confirmed", confirmed);
+
+			if (json_block_l)
+			{
+				boost::property_tree::ptree block_node_l;
+				block->serialize_json (block_node_l);
+				entry.add_child ("contents", block_node_l);
+			}
+			else
+			{
+				std::string contents;
+				block->serialize_json (contents);
+				entry.put ("contents", contents);
+			}
+			if (block->type () == vxlnetwork::block_type::state)
+			{
+				auto subtype (vxlnetwork::state_subtype (block->sideband ().details));
+				entry.put ("subtype", subtype);
+			}
+			if (receivable || receive_hash)
+			{
+				auto destination (node.ledger.block_destination (transaction, *block));
+				if (destination.is_zero ())
 				{
-					boost::property_tree::ptree entry;
-					vxlnetwork::account account (block->account ().is_zero () ? block->sideband ().account : block->account ());
-					entry.put ("block_account", account.to_account ());
-					bool error_or_pruned (false);
-					auto amount (node.ledger.amount_safe (transaction, hash, error_or_pruned));
-					if (!error_or_pruned)
+					if (receivable)
 					{
-						entry.put ("amount", amount.convert_to<std::string> ());
+						entry.put ("pending", "0");
+						entry.put ("receivable", "0");
 					}
-					auto balance (node.ledger.balance (transaction, hash));
-					entry.put ("balance", balance.convert_to<std::string> ());
-					entry.put ("height", std::to_string (block->sideband ().height));
-					entry.put ("local_timestamp", std::to_string (block->sideband ().timestamp));
-					entry.put ("successor", block->sideband ().successor.to_string ());
-					auto confirmed (node.ledger.block_confirmed (transaction, hash));
-					entry.put ("confirmed", confirmed);
-
-					if (json_block_l)
+					if (receive_hash)
 					{
-						boost::property_tree::ptree block_node_l;
-						block->serialize_json (block_node_l);
-						entry.add_child ("contents", block_node_l);
+						entry.put ("receive_hash", vxlnetwork::block_hash (0).to_string ());
 					}
-					else
+				}
+				else if (node.store.pending.exists (transaction, vxlnetwork::pending_key (destination, hash)))
+				{
+					if (receivable)
 					{
-						std::string contents;
-						block->serialize_json (contents);
-						entry.put ("contents", contents);
+						entry.put ("pending", "1");
+						entry.put ("receivable", "1");
 					}
-					if (block->type () == vxlnetwork::block_type::state)
+					if (receive_hash)
 					{
-						auto subtype (vxlnetwork::state_subtype (block->sideband ().details));
-						entry.put ("subtype", subtype);
+						entry.put ("receive_hash", vxlnetwork::block_hash (0).to_string ());
 					}
-					if (receivable || receive_hash)
+				}
+				else
+				{
+					if (receivable)
 					{
-						auto destination (node.ledger.block_destination (transaction, *block));
-						if (destination.is_zero ())
-						{
-							if (receivable)
-							{
-								entry.put ("pending", "0");
-								entry.put ("receivable", "0");
-							}
-							if (receive_hash)
-							{
-								entry.put ("receive_hash", vxlnetwork::block_hash (0).to_string ());
-							}
-						}
-						else if (node.store.pending.exists (transaction, vxlnetwork::pending_key (destination, hash)))
-						{
-							if (receivable)
-							{
-								entry.put ("pending", "1");
-								entry.put ("receivable", "1");
-							}
-							if (receive_hash)
-							{
-								entry.put ("receive_hash", vxlnetwork::block_hash (0).to_string ());
-							}
-						}
-						else
-						{
-							if (receivable)
-							{
-								entry.put ("pending", "0");
-								entry.put ("receivable", "0");
-							}
-							if (receive_hash)
-							{
-								std::shared_ptr<vxlnetwork::block> receive_block = node.ledger.find_receive_block_by_send_hash (transaction, destination, hash);
-								std::string receive_hash = receive_block ? receive_block->hash ().to_string () : vxlnetwork::block_hash (0).to_string ();
-								entry.put ("receive_hash", receive_hash);
-							}
-						}
+						entry.put ("pending", "0");
+						entry.put ("receivable", "0");
 					}
-					if (source)
+					if (receive_hash)
 					{
-						vxlnetwork::block_hash source_hash (node.ledger.block_source (transaction, *block));
-						auto block_a (node.store.block.get (transaction, source_hash));
-						if (block_a != nullptr)
-						{
-							auto source_account (node.ledger.account (transaction, source_hash));
-							entry.put ("source_account", source_account.to_account ());
-						}
-						else
-						{
-							entry.put ("source_account", "0");
-						}
+						std::shared_ptr<vxlnetwork::block> receive_block = node.ledger.find_receive_block_by_send_hash (transaction, destination, hash);
+						std::string receive_hash = receive_block ? receive_block->hash ().to_string () : vxlnetwork::block_hash (0).to_string ();
+						entry.put ("receive_hash", receive_hash);
 					}
-					blocks.push_back (std::make_pair (hash_text, entry));
 				}
-				else if (include_not_found)
+			}
+			if (source)
+			{
+				vxlnetwork::block_hash source_hash (node.ledger.block_source (transaction, *block));
+				auto block_a (node.store.block.get (transaction, source_hash));
+				if (block_a != nullptr)
 				{
-					boost::property_tree::ptree entry;
-					entry.put ("", hash_text);
-					blocks_not_found.push_back (std::make_pair ("", entry));
+					auto source_account (node.ledger.account (transaction, source_hash));
+					entry.put ("source_account", source_account.to_account ());
 				}
 				else
 				{
-					ec = vxlnetwork::error_blocks::not_found;
+					entry.put ("source_account", "0");
 				}
 			}
-			else
-			{
-				ec = vxlnetwork::error_blocks::bad_hash_number;
-			}
+			blocks.push_back (std::make_pair (hash_text, entry));
+		}
+		else if (include_not_found)
+		{
+			boost::property_tree::ptree entry;
+			entry.put ("", hash_text);
+			blocks_not_found.push_back (std::make_pair ("", entry));
+		}
+		else
+		{
+			ec = vxlnetwork::error_blocks::not_found;
 		}
 	}
+	if (!ec && bad_hash)
+	{
+		ec = vxlnetwork::error_blocks::bad_hash_number;
+	}
 	if (!ec)
 	{
 		response_l.add_child ("blocks", blocks);
@@ -2169,8 +2245,9 @@ void vxlnetwork::json_handler::delegators ()
 	if (!ec)
 	{
 		auto transaction (node.store.tx_begin_read ());
-		boost::property_tree::ptree delegators;
-		for (auto i (node.store.account.begin (transaction, start_account.number () + 1)), n (node.store.account.end ()); i != n && delegators.size () < count; ++i)
+		uint64_t delegators_count (0);
+		response_writer.begin_object ("delegators");
+		for (auto i (node.store.account.begin (transaction, start_account.number () + 1)), n (node.store.account.end ()); i != n && delegators_count < count; ++i)
 		{
 			vxlnetwork::account_info const & info (i->second);
 			if (info.representative == representative)
@@ -2180,11 +2257,12 @@ void vxlnetwork::json_handler::delegators ()
 					std::string balance;
 					vxlnetwork::uint128_union (info.balance).encode_dec (balance);
 					vxlnetwork::account const & delegator (i->first);
-					delegators.put (delegator.to_account (), balance);
+					response_writer.put (delegator.to_account (), balance);
+					++delegators_count;
 				}
 			}
 		}
-		response_l.add_child ("delegators", delegators);
+		response_writer.end_object ();
 	}
 	response_errors ();
 }
@@ -2592,9 +2670,13 @@ void vxlnetwork::json_handler::account_history ()
 	}
 	if (!ec)
 	{
-		boost::property_tree::ptree history;
 		bool output_raw (request.get_optional<bool> ("raw") == true);
-		response_l.put ("account", account.to_account ());
+		if (action == "history")
+		{
+			response_writer.put ("deprecated", "1");
+		}
+		response_writer.put ("account", account.to_account ());
+		response_writer.begin_array ("history");
 		auto block (node.store.block.get (transaction, hash));
 		while (block != nullptr && count > 0)
 		{
@@ -2618,17 +2700,17 @@ void vxlnetwork::json_handler::account_history ()
 						entry.put ("work", vxlnetwork::to_string_hex (block->block_work ()));
 						entry.put ("signature", block->block_signature ().to_string ());
 					}
-					history.push_back (std::make_pair ("", entry));
+					response_writer.push_back_child (entry);
 					--count;
 				}
 			}
 			hash = reverse ? node.store.block.successor (transaction, hash) : block->previous ();
 			block = node.store.block.get (transaction, hash);
 		}
-		response_l.add_child ("history", history);
+		response_writer.end_array ();
 		if (!hash.is_zero ())
 		{
-			response_l.put (reverse ? "next" : "previous", hash.to_string ());
+			response_writer.put (reverse ? "next" : "previous", hash.to_string ());
 		}
 	}
 	response_errors ();
@@ -2707,45 +2789,51 @@ void vxlnetwork::json_handler::ledger ()
 		bool const weight = request.get<bool> ("weight", false);
 		bool const pending = request.get<bool> ("pending", false);
 		bool const receivable = request.get<bool> ("receivable", pending);
-		boost::property_tree::ptree accounts;
+		uint64_t accounts_count (0);
+		response_writer.begin_object ("accounts");
 		auto transaction (node.store.tx_begin_read ());
 		if (!ec && !sorting) // Simple
 		{
-			for (auto i (node.store.account.begin (transaction, start)), n (node.store.account.end ()); i != n && accounts.size () < count; ++i)
+			for (auto i (node.store.account.begin (transaction, start)), n (node.store.account.end ()); i != n && accounts_count < count; ++i)
 			{
 				vxlnetwork::account_info const & info (i->second);
 				if (info.modified >= modified_since && (receivable || info.balance.number () >= threshold.number ()))
 				{
 					vxlnetwork::account const & account (i->first);
-					boost::property_tree::ptree response_a;
+					vxlnetwork::uint128_t account_receivable{ 0 };
 					if (receivable)
 					{
-						auto account_receivable = node.ledger.account_receivable (transaction, account);
+						account_receivable = node.ledger.account_receivable (transaction, account);
 						if (info.balance.number () + account_receivable < threshold.number ())
 						{
 							continue;
 						}
-						response_a.put ("pending", account_receivable.convert_to<std::string> ());
-						response_a.put ("receivable", account_receivable.convert_to<std::string> ());
 					}
-					response_a.put ("frontier", info.head.to_string ());
-					response_a.put ("open_block", info.open_block.to_string ());
-					response_a.put ("representative_block", node.ledger.representative (transaction, info.head).to_string ());
+					response_writer.begin_object (account.to_account ());
+					if (receivable)
+					{
+						response_writer.put ("pending", account_receivable.convert_to<std::string> ());
+						response_writer.put ("receivable", account_receivable.convert_to<std::string> ());
+					}
+					response_writer.put ("frontier", info.head.to_string ());
+					response_writer.put ("open_block", info.open_block.to_string ());
+					response_writer.put ("representative_block", node.ledger.representative (transaction, info.head).to_string ());
 					std::string balance;
 					vxlnetwork::uint128_union (info.balance).encode_dec (balance);
-					response_a.put ("balance", balance);
-					response_a.put ("modified_timestamp", std::to_string (info.modified));
-					response_a.put ("block_count", std::to_string (info.block_count));
+					response_writer.put ("balance", balance);
+					response_writer.put ("modified_timestamp", std::to_string (info.modified));
+					response_writer.put ("block_count", std::to_string (info.block_count));
 					if (representative)
 					{
-						response_a.put ("representative", info.representative.to_account ());
+						response_writer.put ("representative", info.representative.to_account ());
 					}
 					if (weight)
 					{
 						auto account_weight (node.ledger.weight (account));
-						response_a.put ("weight", account_weight.convert_to<std::string> ());
+						response_writer.put ("weight", account_weight.convert_to<std::string> ());
 					}
-					accounts.push_back (std::make_pair (account.to_account (), response_a));
+					response_writer.end_object ();
+					++accounts_count;
 				}
 			}
 		}
@@ -2764,45 +2852,50 @@ void vxlnetwork::json_handler::ledger ()
 			std::sort (ledger_l.begin (), ledger_l.end ());
 			std::reverse (ledger_l.begin (), ledger_l.end ());
 			vxlnetwork::account_info info;
-			for (auto i (ledger_l.begin ()), n (ledger_l.end ()); i != n && accounts.size () < count; ++i)
+			for (auto i (ledger_l.begin ()), n (ledger_l.end ()); i != n && accounts_count < count; ++i)
 			{
 				node.store.account.get (transaction, i->second, info);
 				if (receivable || info.balance.number () >= threshold.number ())
 				{
 					vxlnetwork::account const & account (i->second);
-					boost::property_tree::ptree response_a;
+					vxlnetwork::uint128_t account_receivable{ 0 };
 					if (receivable)
 					{
-						auto account_receivable = node.ledger.account_receivable (transaction, account);
+						account_receivable = node.ledger.account_receivable (transaction, account);
 						if (info.balance.number () + account_receivable < threshold.number ())
 						{
 							continue;
 						}
-						response_a.put ("pending", account_receivable.convert_to<std::string> ());
-						response_a.put ("receivable", account_receivable.convert_to<std::string> ());
 					}
-					response_a.put ("frontier", info.head.to_string ());
-					response_a.put ("open_block", info.open_block.to_string ());
-					response_a.put ("representative_block", node.ledger.representative (transaction, info.head).to_string ());
+					response_writer.begin_object (account.to_account ());
+					if (receivable)
+					{
+						response_writer.put ("pending", account_receivable.convert_to<std::string> ());
+						response_writer.put ("receivable", account_receivable.convert_to<std::string> ());
+					}
+					response_writer.put ("frontier", info.head.to_string ());
+					response_writer.put ("open_block", info.open_block.to_string ());
+					response_writer.put ("representative_block", node.ledger.representative (transaction, info.head).to_string ());
 					std::string balance;
 					(i->first).encode_dec (balance);
-					response_a.put ("balance", balance);
-					response_a.put ("modified_timestamp", std::to_string (info.modified));
-					response_a.put ("block_count", std::to_string (info.block_count));
+					response_writer.put ("balance", balance);
+					response_writer.put ("modified_timestamp", std::to_string (info.modified));
+					response_writer.put ("block_count", std::to_string (info.block_count));
 					if (representative)
 					{
-						response_a.put ("representative", info.representative.to_account ());
+						response_writer.put ("representative", info.representative.to_account ());
 					}
 					if (weight)
 					{
 						auto account_weight (node.ledger.weight (account));
-						response_a.put ("weight", account_weight.convert_to<std::string> ());
+						response_writer.put ("weight", account_weight.convert_to<std::string> ());
 					}
-					accounts.push_back (std::make_pair (account.to_account (), response_a));
+					response_writer.end_object ();
+					++accounts_count;
 				}
 			}
 		}
-		response_l.add_child ("accounts", accounts);
+		response_writer.end_object ();
 	}
 	response_errors ();
 }
@@ -3891,6 +3984,23 @@ void vxlnetwork::json_handler::stats ()
 	{
 		node.store.serialize_memory_stats (response_l);
 	}
+	else if (type == "rpc")
+	{
+		boost::property_tree::ptree actions_l;
+		for (auto const & [action_l, totals] : node.rpc_executor.actions ())
+		{
+			boost::property_tree::ptree entry;
+			entry.put ("cost", vxlnetwork::to_string (vxlnetwork::rpc_executor::classify (action_l)));
+			entry.put ("executed", totals.executed);
+			entry.put ("rejected", totals.rejected);
+			entry.put ("queue_us", totals.queue_us);
+			entry.put ("execution_us", totals.execution_us);
+			entry.put ("max_execution_us", totals.max_execution_us);
+			actions_l.add_child (action_l, entry);
+		}
+		response_l.add_child ("actions", actions_l);
+		response_l.put ("queued", node.rpc_executor.size ());
+	}
 	else
 	{
 		ec = vxlnetwork::error_rpc::invalid_missing_type;
@@ -4097,25 +4207,31 @@ void vxlnetwork::json_handler::unchecked ()
 	auto count (count_optional_impl ());
 	if (!ec)
 	{
-		boost::property_tree::ptree unchecked;
+		// A block waiting on several dependencies is listed once per dependency with json_block and once otherwise
+		std::unordered_set<vxlnetwork::block_hash> listed;
+		uint64_t unchecked_count (0);
 		auto transaction (node.store.tx_begin_read ());
-		for (auto [i, n] = node.unchecked.full_range (transaction); i != n && unchecked.size () < count; ++i)
-		{
-			vxlnetwork::unchecked_info const & info (i->second);
+		response_writer.begin_object ("blocks");
+		node.unchecked.for_each (
+		transaction, [this, &listed, &unchecked_count, &json_block_l] (vxlnetwork::unchecked_key const & key, vxlnetwork::unchecked_info const & info) {
+			auto const hash (info.block->hash ());
 			if (json_block_l)
 			{
 				boost::property_tree::ptree block_node_l;
 				info.block->serialize_json (block_node_l);
-				unchecked.add_child (info.block->hash ().to_string (), block_node_l);
+				response_writer.put_child (hash.to_string (), block_node_l);
+				++unchecked_count;
 			}
-			else
+			else if (listed.insert (hash).second)
 			{
 				std::string contents;
 				info.block->serialize_json (contents);
-				unchecked.put (info.block->hash ().to_string (), contents);
+				response_writer.put (hash.to_string (), contents);
+				++unchecked_count;
 			}
-		}
-		response_l.add_child ("blocks", unchecked);
+		},
+		[&unchecked_count, count] () { return unchecked_count < count; });
+		response_writer.end_object ();
 	}
 	response_errors ();
 }
@@ -4137,12 +4253,11 @@ void vxlnetwork::json_handler::unchecked_get ()
 	if (!ec)
 	{
 		auto transaction (node.store.tx_begin_read ());
-		for (auto [i, n] = node.unchecked.full_range (transaction); i != n; ++i)
-		{
-			vxlnetwork::unchecked_key const & key (i->first);
+		bool done{ false };
+		node.unchecked.for_each (
+		transaction, [this, &hash, &json_block_l, &done] (vxlnetwork::unchecked_key const & key, vxlnetwork::unchecked_info const & info) {
 			if (key.hash == hash)
 			{
-				vxlnetwork::unchecked_info const & info (i->second);
 				response_l.put ("modified_timestamp", std::to_string (info.modified ()));
 
 				if (json_block_l)
@@ -4157,9 +4272,10 @@ void vxlnetwork::json_handler::unchecked_get ()
 					info.block->serialize_json (contents);
 					response_l.put ("contents", contents);
 				}
-				break;
+				done = true;
 			}
-		}
+		},
+		[&done] () { return !done; });
 		if (response_l.empty ())
 		{
 			ec = vxlnetwork::error_blocks::not_found;
@@ -4185,11 +4301,10 @@ void vxlnetwork::json_handler::unchecked_keys ()
 	{
 		boost::property_tree::ptree unchecked;
 		auto transaction (node.store.tx_begin_read ());
-		for (auto [i, n] = node.unchecked.equal_range (transaction, key); i != n && unchecked.size () < count; ++i)
-		{
+		node.unchecked.for_each (
+		transaction, key, [&unchecked, &json_block_l] (vxlnetwork::unchecked_key const & key_a, vxlnetwork::unchecked_info const & info) {
 			boost::property_tree::ptree entry;
-			vxlnetwork::unchecked_info const & info (i->second);
-			entry.put ("key", i->first.key ().to_string ());
+			entry.put ("key", key_a.key ().to_string ());
 			entry.put ("hash", info.block->hash ().to_string ());
 			entry.put ("modified_timestamp", std::to_string (info.modified ()));
 			if (json_block_l)
@@ -4205,7 +4320,8 @@ void vxlnetwork::json_handler::unchecked_keys ()
 				entry.put ("contents", contents);
 			}
 			unchecked.push_back (std::make_pair ("", entry));
-		}
+		},
+		[&unchecked, count] () { return unchecked.size () < count; });
 		response_l.add_child ("unchecked", unchecked);
 	}
 	response_errors ();
@@ -4687,9 +4803,9 @@ void vxlnetwork::json_handler::wallet_ledger ()
 	auto wallet (wallet_impl ());
 	if (!ec)
 	{
-		boost::property_tree::ptree accounts;
 		auto transaction (node.wallets.tx_begin_read ());
 		auto block_transaction (node.store.tx_begin_read ());
+		response_writer.begin_object ("accounts");
 		for (auto i (wallet->store.begin (transaction)), n (wallet->store.end ()); i != n; ++i)
 		{
 			vxlnetwork::account const & account (i->first);
@@ -4698,35 +4814,35 @@ void vxlnetwork::json_handler::wallet_ledger ()
 			{
 				if (info.modified >= modified_since)
 				{
-					boost::property_tree::ptree entry;
-					entry.put ("frontier", info.head.to_string ());
-					entry.put ("open_block", info.open_block.to_string ());
-					entry.put ("representative_block", node.ledger.representative (block_transaction, info.head).to_string ());
+					response_writer.begin_object (account.to_account ());
+					response_writer.put ("frontier", info.head.to_string ());
+					response_writer.put ("open_block", info.open_block.to_string ());
+					response_writer.put ("representative_block", node.ledger.representative (block_transaction, info.head).to_string ());
 					std::string balance;
 					vxlnetwork::uint128_union (info.balance).encode_dec (balance);
-					entry.put ("balance", balance);
-					entry.put ("modified_timestamp", std::to_string (info.modified));
-					entry.put ("block_count", std::to_string (info.block_count));
+					response_writer.put ("balance", balance);
+					response_writer.put ("modified_timestamp", std::to_string (info.modified));
+					response_writer.put ("block_count", std::to_string (info.block_count));
 					if (representative)
 					{
-						entry.put ("representative", info.representative.to_account ());
+						response_writer.put ("representative", info.representative.to_account ());
 					}
 					if (weight)
 					{
 						auto account_weight (node.ledger.weight (account));
-						entry.put ("weight", account_weight.convert_to<std::string> ());
+						response_writer.put ("weight", account_weight.convert_to<std::string> ());
 					}
 					if (receivable)
 					{
 						auto account_receivable (node.ledger.account_receivable (block_transaction, account));
-						entry.put ("pending", account_receivable.convert_to<std::string> ());
-						entry.put ("receivable", account_receivable.convert_to<std::string> ());
+						response_writer.put ("pending", account_receivable.convert_to<std::string> ());
+						response_writer.put ("receivable", account_receivable.convert_to<std::string> ());
 					}
-					accounts.push_back (std::make_pair (account.to_account (), entry));
+					response_writer.end_object ();
 				}
 			}
 		}
-		response_l.add_child ("accounts", accounts);
+		response_writer.end_object ();
 	}
 	response_errors ();
 }
@@ -5211,7 +5327,7 @@ void vxlnetwork::inprocess_rpc_handler::process_request (std::string const &, st
 		this->stop_callback ();
 		this->stop ();
 	}));
-	handler->process_request ();
+	handler->queue_request ();
 }
 
 void vxlnetwork::inprocess_rpc_handler::process_request_v2 (rpc_handler_request_params const & params_a, std::string const & body_a, std::function<void (std::shared_ptr<std::string> const &)> response_a)
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <vxlnetwork/lib/json_writer.hpp>
 #include <vxlnetwork/lib/numbers.hpp>
 #include <vxlnetwork/node/ipc/flatbuffers_handler.hpp>
 #include <vxlnetwork/node/wallet.hpp>
@@ -24,7 +25,10 @@ class json_handler : public std::enable_shared_from_this<vxlnetwork::json_handle
 public:
 	json_handler (
 	vxlnetwork::node &, vxlnetwork::node_rpc_config const &, std::string const &, std::function<void (std::string const &)> const &, std::function<void ()> stop_callback = [] () {});
+	/** Parses and executes the request on the calling thread */
 	void process_request (bool unsafe = false);
+	/** Parses the request on the calling thread and executes it on the node's RPC executor, which may reject it when busy */
+	void queue_request (bool unsafe = false);
 	void account_balance ();
 	void account_block_count ();
 	void account_count ();
@@ -152,6 +156,8 @@ public:
 	std::error_code ec;
 	std::string action;
 	boost::property_tree::ptree response_l;
+	/** Used instead of response_l by handlers with large responses, which are written out directly as they are produced */
+	vxlnetwork::json_writer response_writer;
 	std::shared_ptr<vxlnetwork::wallet> wallet_impl ();
 	bool wallet_locked_impl (vxlnetwork::transaction const &, std::shared_ptr<vxlnetwork::wallet> const &);
 	bool wallet_account_impl (vxlnetwork::transaction const &, std::shared_ptr<vxlnetwork::wallet> const &, vxlnetwork::account const &);
@@ -160,6 +166,8 @@ public:
 	vxlnetwork::amount amount_impl ();
 	std::shared_ptr<vxlnetwork::block> block_impl (bool = true);
 	vxlnetwork::block_hash hash_impl (std::string = "hash");
+	/** Decodes the "hashes" array up to the first invalid entry, returns true if an invalid entry was found */
+	bool hashes_impl (std::vector<std::string> &, std::vector<vxlnetwork::block_hash> &);
 	vxlnetwork::amount threshold_optional_impl ();
 	uint64_t work_optional_impl ();
 	uint64_t count_impl ();
@@ -173,6 +181,11 @@ public:
 	std::function<void ()> stop_callback;
 	vxlnetwork::node_rpc_config const & node_rpc_config;
 	std::function<void ()> create_worker_task (std::function<void (std::shared_ptr<vxlnetwork::json_handler> const &)> const &);
+
+private:
+	/** Reads the request and its action, responds with an error and returns true if the body is invalid */
+	bool parse_request ();
+	void execute_action (bool unsafe);
 };
 
 class inprocess_rpc_handler final : public vxlnetwork::rpc_handler_interface
@@ -0,0 +1,571 @@
+#include <vxlnetwork/crypto/blake2/blake2.h>
+#include <vxlnetwork/lib/blocks.hpp>
+#include <vxlnetwork/lib/threading.hpp>
+#include <vxlnetwork/node/ledger_export.hpp>
+#include <vxlnetwork/secure/common.hpp>
+
+#include <boost/endian/conversion.hpp>
+#include <boost/filesystem/operations.hpp>
+#include <boost/format.hpp>
+
+#include <fstream>
+#include <future>
+#include <map>
+
+std::array<vxlnetwork::tables, 6> const vxlnetwork::ledger_export::tables{ vxlnetwork::tables::accounts, vxlnetwork::tables::blocks, vxlnetwork::tables::pending, vxlnetwork::tables::confirmation_height, vxlnetwork::tables::frontiers, vxlnetwork::tables::pruned };
+std::array<uint8_t, 8> const vxlnetwork::ledger_export::magic{ 'V', 'X', 'L', 'L', 'E', 'D', 'G', 'R' };
+uint8_t constexpr vxlnetwork::ledger_export::format_version;
+std::size_t constexpr vxlnetwork::ledger_export::chunk_size;
+
+namespace
+{
+/** Takes the place of a table code and starts the end record */
+uint8_t constexpr end_marker{ 0xff };
+std::size_t constexpr header_size{ 8 + 1 + 4 + 32 };
+/** Table code, sequence, entry count and payload size */
+std::size_t constexpr chunk_header_size{ 1 + 4 + 4 + 4 };
+/** Key size and value size preceding every entry in a chunk payload */
+std::size_t constexpr entry_header_size{ 2 + 4 };
+
+template <typename T>
+void put (std::vector<uint8_t> & buffer_a, T value_a)
+{
+	boost::endian::native_to_big_inplace (value_a);
+	auto bytes (reinterpret_cast<uint8_t const *> (&value_a));
+	buffer_a.insert (buffer_a.end (), bytes, bytes + sizeof (value_a));
+}
+
+template <typename T>
+T get (uint8_t const * bytes_a)
+{
+	T result;
+	std::copy (bytes_a, bytes_a + sizeof (result), reinterpret_cast<uint8_t *> (&result));
+	return boost::endian::big_to_native (result);
+}
+
+uint64_t checksum (uint8_t const * begin_a, std::size_t size_a)
+{
+	uint64_t result;
+	blake2b_state state;
+	blake2b_init (&state, sizeof (result));
+	blake2b_update (&state, begin_a, size_a);
+	blake2b_final (&state, &result, sizeof (result));
+	return result;
+}
+
+class chunk final
+{
+public:
+	chunk (uint8_t table_a, uint32_t sequence_a) :
+		table{ table_a },
+		sequence{ sequence_a }
+	{
+	}
+	void append (vxlnetwork::raw_entry const & entry_a)
+	{
+		put (payload, static_cast<uint16_t> (entry_a.key_size));
+		put (payload, static_cast<uint32_t> (entry_a.value_size));
+		payload.insert (payload.end (), entry_a.key, entry_a.key + entry_a.key_size);
+		payload.insert (payload.end (), entry_a.value, entry_a.value + entry_a.value_size);
+		++count;
+	}
+	std::vector<uint8_t> header () const
+	{
+		std::vector<uint8_t> result;
+		result.reserve (chunk_header_size);
+		result.push_back (table);
+		put (result, sequence);
+		put (result, count);
+		put (result, static_cast<uint32_t> (payload.size ()));
+		return result;
+	}
+	/** Checksum over the header and payload */
+	uint64_t hash () const
+	{
+		auto const header_l (header ());
+		uint64_t result;
+		blake2b_state state;
+		blake2b_init (&state, sizeof (result));
+		blake2b_update (&state, header_l.data (), header_l.size ());
+		blake2b_update (&state, payload.data (), payload.size ());
+		blake2b_final (&state, &result, sizeof (result));
+		return result;
+	}
+	std::vector<uint8_t> serialize () const
+	{
+		auto result (header ());
+		result.reserve (chunk_header_size + payload.size () + sizeof (uint64_t));
+		result.insert (result.end (), payload.begin (), payload.end ());
+		put (result, hash ());
+		return result;
+	}
+	/** Fills \p entries_a with entries pointing into the payload. Returns true if the payload is malformed */
+	bool decode (std::vector<vxlnetwork::raw_entry> & entries_a) const
+	{
+		entries_a.reserve (count);
+		auto position (payload.data ());
+		auto const end (payload.data () + payload.size ());
+		auto error (false);
+		while (!error && position != end)
+		{
+			error = static_cast<std::size_t> (end - position) < entry_header_size;
+			if (!error)
+			{
+				vxlnetwork::raw_entry entry;
+				entry.key_size = get<uint16_t> (position);
+				entry.value_size = get<uint32_t> (position + 2);
+				position += entry_header_size;
+				error = static_cast<std::size_t> (end - position) < entry.key_size + entry.value_size;
+				if (!error)
+				{
+					entry.key = position;
+					entry.value = position + entry.key_size;
+					position += entry.key_size + entry.value_size;
+					entries_a.push_back (entry);
+				}
+			}
+		}
+		return error || entries_a.size () != count;
+	}
+	uint8_t const table;
+	uint32_t const sequence;
+	uint32_t count{ 0 };
+	std::vector<uint8_t> payload;
+	/** Checksum read from the file, compared with the checksum over header and payload */
+	uint64_t expected_checksum{ 0 };
+};
+}
+
+vxlnetwork::ledger_export::ledger_export (vxlnetwork::store & store_a, vxlnetwork::ledger_constants & constants_a) :
+	store{ store_a },
+	constants{ constants_a }
+{
+}
+
+bool vxlnetwork::ledger_export::write (boost::filesystem::path const & path_a, unsigned threads_a)
+{
+	std::ofstream stream (path_a.string (), std::ios::binary | std::ios::trunc);
+	if (!stream.is_open ())
+	{
+		error_message = "Unable to open " + path_a.string ();
+		return true;
+	}
+	vxlnetwork::mutex mutex;
+	auto write_bytes = [&stream] (std::vector<uint8_t> const & bytes_a) {
+		stream.write (reinterpret_cast<char const *> (bytes_a.data ()), bytes_a.size ());
+	};
+	{
+		std::vector<uint8_t> header (magic.begin (), magic.end ());
+		header.push_back (format_version);
+		auto transaction (store.tx_begin_read ());
+		put (header, static_cast<uint32_t> (store.version.get (transaction)));
+		auto const genesis (constants.genesis->hash ());
+		header.insert (header.end (), genesis.bytes.begin (), genesis.bytes.end ());
+		debug_assert (header.size () == header_size);
+		write_bytes (header);
+	}
+	std::vector<uint32_t> chunks (tables.size (), 0);
+	std::vector<uint64_t> counts (tables.size (), 0);
+	{
+		// Every table is read through its own transaction and chunks are appended as soon as they are complete
+		vxlnetwork::thread_pool pool (std::max (1u, std::min<unsigned> (threads_a, tables.size ())), vxlnetwork::thread_role::name::ledger_export);
+		std::vector<std::future<void>> done;
+		for (uint8_t code = 0; code < tables.size (); ++code)
+		{
+			auto promise (std::make_shared<std::promise<void>> ());
+			done.push_back (promise->get_future ());
+			pool.push_task ([this, code, promise, &mutex, &write_bytes, &chunks, &counts] () {
+				auto flush = [&mutex, &write_bytes] (chunk const & chunk_a) {
+					auto bytes (chunk_a.serialize ());
+					vxlnetwork::lock_guard<vxlnetwork::mutex> guard (mutex);
+					write_bytes (bytes);
+				};
+				auto current (std::make_unique<chunk> (code, 0));
+				auto transaction (store.tx_begin_read ());
+				store.raw_for_each (transaction, tables[code], [&current, &flush, &counts, code] (vxlnetwork::raw_entry const & entry_a) {
+					current->append (entry_a);
+					++counts[code];
+					if (current->payload.size () >= chunk_size)
+					{
+						flush (*current);
+						current = std::make_unique<chunk> (code, current->sequence + 1);
+					}
+				});
+				if (current->count > 0)
+				{
+					flush (*current);
+					chunks[code] = current->sequence + 1;
+				}
+				else
+				{
+					chunks[code] = current->sequence;
+				}
+				promise->set_value ();
+			});
+		}
+		for (auto & i : done)
+		{
+			i.wait ();
+		}
+	}
+	std::vector<uint8_t> end_record;
+	end_record.push_back (end_marker);
+	end_record.push_back (static_cast<uint8_t> (tables.size ()));
+	for (uint8_t code = 0; code < tables.size (); ++code)
+	{
+		end_record.push_back (code);
+		put (end_record, chunks[code]);
+		put (end_record, counts[code]);
+		entries[tables[code]] = counts[code];
+	}
+	put (end_record, checksum (end_record.data (), end_record.size ()));
+	write_bytes (end_record);
+	stream.flush ();
+	auto error (!stream.good ());
+	if (error)
+	{
+		error_message = "Unable to write " + path_a.string ();
+	}
+	return error;
+}
+
+bool vxlnetwork::ledger_export::read (boost::filesystem::path const & path_a, unsigned threads_a)
+{
+	std::ifstream stream (path_a.string (), std::ios::binary);
+	if (!stream.is_open ())
+	{
+		error_message = "Unable to open " + path_a.string ();
+		return true;
+	}
+	// Returns true if fewer than \p size_a bytes could be read
+	auto read_bytes = [&stream] (std::vector<uint8_t> & buffer_a, std::size_t size_a) {
+		buffer_a.resize (size_a);
+		stream.read (reinterpret_cast<char *> (buffer_a.data ()), size_a);
+		return static_cast<std::size_t> (stream.gcount ()) != size_a;
+	};
+	std::vector<uint8_t> header;
+	if (read_bytes (header, header_size) || !std::equal (magic.begin (), magic.end (), header.begin ()))
+	{
+		error_message = "Not a ledger export file";
+		return true;
+	}
+	if (header[magic.size ()] != format_version)
+	{
+		error_message = boost::str (boost::format ("Unsupported format version %1%") % static_cast<unsigned> (header[magic.size ()]));
+		return true;
+	}
+	vxlnetwork::block_hash genesis;
+	std::copy (header.begin () + magic.size () + 5, header.end (), genesis.bytes.begin ());
+	if (genesis != constants.genesis->hash ())
+	{
+		error_message = "Ledger export belongs to a different network";
+		return true;
+	}
+	{
+		auto transaction (store.tx_begin_read ());
+		auto const version (get<uint32_t> (header.data () + magic.size () + 1));
+		if (version != static_cast<uint32_t> (store.version.get (transaction)))
+		{
+			error_message = boost::str (boost::format ("Ledger export has store version %1%, the store has version %2%") % version % store.version.get (transaction));
+			return true;
+		}
+	}
+	if (!empty ())
+	{
+		error_message = "The ledger must be empty to import";
+		return true;
+	}
+
+	class table_state final
+	{
+	public:
+		/** Decoded chunks waiting for their predecessors to be loaded */
+		std::map<uint32_t, std::pair<std::shared_ptr<chunk>, std::vector<vxlnetwork::raw_entry>>> ready;
+		/** Sequence of the next chunk read from the file */
+		uint32_t read{ 0 };
+		/** Sequence of the next chunk loaded into the store */
+		uint32_t loaded{ 0 };
+		uint64_t entries{ 0 };
+		bool loading{ false };
+	};
+	std::vector<table_state> states (tables.size ());
+	vxlnetwork::mutex mutex;
+	vxlnetwork::condition_variable condition;
+	std::size_t in_flight{ 0 };
+	std::atomic<bool> failed{ false };
+	auto fail = [&mutex, &failed, this] (std::string const & message_a) {
+		vxlnetwork::lock_guard<vxlnetwork::mutex> guard (mutex);
+		if (!failed.exchange (true))
+		{
+			error_message = message_a;
+		}
+	};
+	auto const threads (std::max (1u, threads_a));
+	// Bounds memory use to a few chunks per thread
+	auto const in_flight_max (threads * 4);
+	std::vector<uint8_t> end_record;
+	{
+		vxlnetwork::thread_pool pool (threads, vxlnetwork::thread_role::name::ledger_import);
+		auto decode_and_load = [this, &states, &mutex, &condition, &in_flight, &failed, &fail] (std::shared_ptr<chunk> const & chunk_a) {
+			std::vector<vxlnetwork::raw_entry> decoded;
+			if (chunk_a->hash () != chunk_a->expected_checksum)
+			{
+				fail (boost::str (boost::format ("Checksum mismatch in chunk %1% of table %2%") % chunk_a->sequence % static_cast<unsigned> (chunk_a->table)));
+			}
+			else if (chunk_a->decode (decoded))
+			{
+				fail (boost::str (boost::format ("Malformed chunk %1% of table %2%") % chunk_a->sequence % static_cast<unsigned> (chunk_a->table)));
+			}
+			vxlnetwork::unique_lock<vxlnetwork::mutex> lock (mutex);
+			auto & state (states[chunk_a->table]);
+			state.ready.emplace (chunk_a->sequence, std::make_pair (chunk_a, std::move (decoded)));
+			// A single task per table loads chunks in sequence order, others leave their chunk behind for it
+			if (!state.loading)
+			{
+				state.loading = true;
+				while (!state.ready.empty () && state.ready.begin ()->first == state.loaded)
+				{
+					auto next (std::move (state.ready.begin ()->second));
+					state.ready.erase (state.ready.begin ());
+					lock.unlock ();
+					if (!failed && store.raw_bulk_load (tables[next.first->table], next.second))
+					{
+						fail (boost::str (boost::format ("Unable to load chunk %1% of table %2%") % next.first->sequence % static_cast<unsigned> (next.first->table)));
+					}
+					next.first.reset ();
+					lock.lock ();
+					++state.loaded;
+					state.entries += next.second.size ();
+					--in_flight;
+					condition.notify_all ();
+				}
+				state.loading = false;
+			}
+		};
+		std::vector<uint8_t> buffer;
+		while (!failed && end_record.empty ())
+		{
+			if (read_bytes (buffer, 1))
+			{
+				fail ("Ledger export is truncated");
+			}
+			else if (buffer[0] == end_marker)
+			{
+				end_record = buffer;
+			}
+			else if (buffer[0] >= tables.size ())
+			{
+				fail (boost::str (boost::format ("Unknown table %1%") % static_cast<unsigned> (buffer[0])));
+			}
+			else if (auto const code (buffer[0]); read_bytes (buffer, chunk_header_size - 1))
+			{
+				fail ("Ledger export is truncated");
+			}
+			else
+			{
+				auto const sequence (get<uint32_t> (buffer.data ()));
+				auto const count (get<uint32_t> (buffer.data () + 4));
+				auto const size (get<uint32_t> (buffer.data () + 8));
+				auto & state (states[code]);
+				// The last entry may overshoot chunk_size by one maximum sized entry, anything larger is corrupt
+				if (sequence != state.read || size > 2 * chunk_size)
+				{
+					fail (boost::str (boost::format ("Unexpected chunk %1% of table %2%") % sequence % static_cast<unsigned> (code)));
+				}
+				else
+				{
+					++state.read;
+					auto chunk_l (std::make_shared<chunk> (code, sequence));
+					chunk_l->count = count;
+					std::vector<uint8_t> checksum_bytes;
+					if (read_bytes (chunk_l->payload, size) || read_bytes (checksum_bytes, sizeof (uint64_t)))
+					{
+						fail ("Ledger export is truncated");
+					}
+					else
+					{
+						chunk_l->expected_checksum = get<uint64_t> (checksum_bytes.data ());
+						{
+							vxlnetwork::unique_lock<vxlnetwork::mutex> lock (mutex);
+							condition.wait (lock, [&in_flight, in_flight_max] () { return in_flight < in_flight_max; });
+							++in_flight;
+						}
+						pool.push_task ([chunk_l, &decode_and_load] () {
+							decode_and_load (chunk_l);
+						});
+					}
+				}
+			}
+		}
+		vxlnetwork::unique_lock<vxlnetwork::mutex> lock (mutex);
+		condition.wait (lock, [&in_flight] () { return in_flight == 0; });
+	}
+	if (!failed)
+	{
+		std::vector<uint8_t> body;
+		auto const body_size (1 + tables.size () * (1 + 4 + 8));
+		if (read_bytes (body, body_size + sizeof (uint64_t)) || body[0] != tables.size ())
+		{
+			fail ("Ledger export has a malformed end record");
+		}
+		else
+		{
+			end_record.insert (end_record.end (), body.begin (), body.begin () + body_size);
+			if (checksum (end_record.data (), end_record.size ()) != get<uint64_t> (body.data () + body_size))
+			{
+				fail ("Checksum mismatch in the end record");
+			}
+			for (uint8_t code = 0; code < tables.size () && !failed; ++code)
+			{
+				auto const position (body.data () + 1 + code * (1 + 4 + 8));
+				auto const & state (states[code]);
+				if (position[0] != code || get<uint32_t> (position + 1) != state.loaded || get<uint64_t> (position + 5) != state.entries)
+				{
+					fail (boost::str (boost::format ("Ledger export is missing entries of table %1%") % static_cast<unsigned> (code)));
+				}
+			}
+		}
+	}
+	for (uint8_t code = 0; code < tables.size (); ++code)
+	{
+		entries[tables[code]] = states[code].entries;
+	}
+	return failed;
+}
+
+bool vxlnetwork::ledger_export::empty ()
+{
+	auto transaction (store.tx_begin_read ());
+	auto result (store.account.begin (transaction) == store.account.end ());
+	result = result && store.block.begin (transaction) == store.block.end ();
+	result = result && store.pending.begin (transaction) == store.pending.end ();
+	result = result && store.confirmation_height.begin (transaction) == store.confirmation_height.end ();
+	result = result && store.frontier.begin (transaction) == store.frontier.end ();
+	result = result && store.pruned.begin (transaction) == store.pruned.end ();
+	return result;
+}
+
+bool vxlnetwork::ledger_export::import (boost::filesystem::path const & data_path_a, boost::filesystem::path const & path_a, unsigned threads_a, vxlnetwork::ledger_constants & constants_a, std::function<std::unique_ptr<vxlnetwork::store> (boost::filesystem::path const &)> const & make_store_a, std::unordered_map<vxlnetwork::tables, uint64_t> & entries_a, std::string & error_message_a)
+{
+	auto error (false);
+	{
+		// Checked up front so a populated ledger is not replaced, the store is closed again before its files are swapped
+		auto existing (make_store_a (data_path_a));
+		if (existing->init_error ())
+		{
+			error_message_a = "Unable to open the database in " + data_path_a.string ();
+			error = true;
+		}
+		else if (!vxlnetwork::ledger_export (*existing, constants_a).empty ())
+		{
+			error_message_a = "The ledger must be empty to import";
+			error = true;
+		}
+	}
+	auto const temporary (data_path_a / "ledger_import");
+	auto const backup (data_path_a / "ledger_import_backup");
+	if (!error && boost::filesystem::exists (backup))
+	{
+		// The files of an interrupted swap must be restored by hand, they could be the only copy of the previous database
+		error_message_a = "A previous import was interrupted, restore or remove the database files in " + backup.string ();
+		error = true;
+	}
+	if (!error)
+	{
+		boost::system::error_code ec;
+		// Left behind by an interrupted import
+		boost::filesystem::remove_all (temporary, ec);
+		boost::filesystem::create_directories (temporary, ec);
+		{
+			auto store (make_store_a (temporary));
+			if (!store->init_error ())
+			{
+				vxlnetwork::ledger_export importer (*store, constants_a);
+				error = importer.read (path_a, threads_a);
+				entries_a = importer.entries;
+				error_message_a = importer.error_message;
+			}
+			else
+			{
+				error_message_a = "Unable to create a database in " + temporary.string ();
+				error = true;
+			}
+		}
+		if (!error)
+		{
+			error = swap (data_path_a, temporary, backup, error_message_a);
+		}
+		else
+		{
+			boost::filesystem::remove_all (temporary, ec);
+		}
+	}
+	return error;
+}
+
+bool vxlnetwork::ledger_export::swap (boost::filesystem::path const & data_path_a, boost::filesystem::path const & temporary_a, boost::filesystem::path const & backup_a, std::string & error_message_a)
+{
+	auto error (false);
+	boost::system::error_code ec;
+	std::vector<boost::filesystem::path> names;
+	for (boost::filesystem::directory_iterator i (temporary_a), n; i != n; ++i)
+	{
+		names.push_back (i->path ().filename ());
+	}
+	boost::filesystem::create_directories (backup_a, ec);
+	error = static_cast<bool> (ec);
+	std::vector<boost::filesystem::path> moved_aside;
+	std::vector<boost::filesystem::path> moved_in;
+	for (auto i (names.begin ()), n (names.end ()); i != n && !error; ++i)
+	{
+		auto const target (data_path_a / *i);
+		if (boost::filesystem::exists (target))
+		{
+			boost::filesystem::rename (target, backup_a / *i, ec);
+			error = static_cast<bool> (ec);
+			if (!error)
+			{
+				moved_aside.push_back (*i);
+			}
+		}
+		if (!error)
+		{
+			boost::filesystem::rename (temporary_a / *i, target, ec);
+			error = static_cast<bool> (ec);
+			if (!error)
+			{
+				moved_in.push_back (*i);
+			}
+		}
+	}
+	if (!error)
+	{
+		boost::filesystem::remove_all (backup_a, ec);
+		boost::filesystem::remove_all (temporary_a, ec);
+	}
+	else
+	{
+		error_message_a = "Unable to move the imported database in to " + data_path_a.string () + ": " + ec.message ();
+		// Imported files go back to the temporary directory before the previous files are restored in their place
+		auto restored (true);
+		for (auto const & name : moved_in)
+		{
+			boost::filesystem::rename (data_path_a / name, temporary_a / name, ec);
+			restored = restored && !ec;
+		}
+		for (auto const & name : moved_aside)
+		{
+			boost::filesystem::rename (backup_a / name, data_path_a / name, ec);
+			restored = restored && !ec;
+		}
+		if (restored)
+		{
+			boost::filesystem::remove (backup_a, ec);
+		}
+		else
+		{
+			error_message_a += ", the previous database files are left in " + backup_a.string () + " and the imported ones in " + temporary_a.string ();
+		}
+	}
+	return error;
+}
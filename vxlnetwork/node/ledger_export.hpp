@@ -0,0 +1,68 @@
+#pragma once
+
+#include <vxlnetwork/secure/store.hpp>
+
+#include <boost/filesystem/path.hpp>
+
+#include <array>
+#include <functional>
+#include <memory>
+#include <string>
+#include <unordered_map>
+
+namespace vxlnetwork
+{
+class ledger_constants;
+
+/**
+ * Backend independent ledger file used to provision nodes without bootstrapping or copying a database.
+ *
+ * The file starts with a header (magic, format version, store version and genesis hash) followed by chunks of raw table
+ * entries in their serialized store format. A chunk holds entries of a single table in key order, about chunk_size bytes,
+ * and carries its table, its sequence number within the table and a checksum over the whole chunk. Chunks of different
+ * tables are interleaved as they are exported in parallel. An end record with the chunk and entry count of every table
+ * closes the file, a truncated file is therefore detected.
+ *
+ * Importing verifies and decodes chunks in parallel and loads every table in key order through store::raw_bulk_load, which
+ * appends to LMDB pages and ingests sorted table files into RocksDB. Tables are loaded concurrently with each other.
+ * All integers are big endian.
+ */
+class ledger_export final
+{
+public:
+	ledger_export (vxlnetwork::store &, vxlnetwork::ledger_constants &);
+	/** Writes the ledger tables to \p path_a. The store must not be written to meanwhile. Returns true on error */
+	bool write (boost::filesystem::path const & path_a, unsigned threads_a);
+	/** Loads the file at \p path_a into the store, whose ledger tables must be empty. Returns true on error */
+	bool read (boost::filesystem::path const & path_a, unsigned threads_a);
+	/** Returns true if the ledger tables of the store hold no entries */
+	bool empty ();
+	/**
+	 * Loads the file at \p path_a into the database in \p data_path_a, whose ledger tables must be empty. The file is read
+	 * into a store opened by \p make_store_a in a temporary directory whose database files replace those in \p data_path_a
+	 * only once the import succeeded, a failed import leaves \p data_path_a unchanged. Returns true on error
+	 */
+	static bool import (boost::filesystem::path const & data_path_a, boost::filesystem::path const & path_a, unsigned threads_a, vxlnetwork::ledger_constants &, std::function<std::unique_ptr<vxlnetwork::store> (boost::filesystem::path const &)> const & make_store_a, std::unordered_map<vxlnetwork::tables, uint64_t> & entries_a, std::string & error_message_a);
+
+	/** Entries written or read per table */
+	std::unordered_map<vxlnetwork::tables, uint64_t> entries;
+	/** Describes the failure when write () or read () returned an error */
+	std::string error_message;
+
+	/** Tables contained in the file, the position in this list is the table code used in the file */
+	static std::array<vxlnetwork::tables, 6> const tables;
+	static std::array<uint8_t, 8> const magic;
+	static uint8_t constexpr format_version{ 1 };
+	/** Payload size after which a chunk is completed */
+	static std::size_t constexpr chunk_size{ 4 * 1024 * 1024 };
+
+private:
+	/**
+	 * Moves the database files in \p temporary_a in to \p data_path_a, setting the files they replace aside in \p backup_a.
+	 * Every file moved is moved back when one of them fails. Returns true on error
+	 */
+	static bool swap (boost::filesystem::path const & data_path_a, boost::filesystem::path const & temporary_a, boost::filesystem::path const & backup_a, std::string & error_message_a);
+	vxlnetwork::store & store;
+	vxlnetwork::ledger_constants & constants;
+};
+}
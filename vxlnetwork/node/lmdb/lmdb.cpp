@@ -11,6 +11,7 @@
 #include <boost/format.hpp>
 #include <boost/polymorphic_cast.hpp>
 
+#include <numeric>
 #include <queue>
 
 namespace vxlnetwork
@@ -71,7 +72,8 @@ vxlnetwork::mdb_store::mdb_store (vxlnetwork::logger_mt & logger_a, boost::files
 	logger (logger_a),
 	env (error, path_a, vxlnetwork::mdb_env::options::make ().set_config (lmdb_config_a).set_use_no_mem_init (true)),
 	mdb_txn_tracker (logger_a, txn_tracking_config_a, block_processor_batch_max_time_a),
-	txn_tracking_enabled (txn_tracking_config_a.enable)
+	txn_tracking_enabled (txn_tracking_config_a.enable),
+	compaction (*this, path_a, lmdb_config_a, logger_a)
 {
 	if (!error)
 	{
@@ -84,7 +86,7 @@ vxlnetwork::mdb_store::mdb_store (vxlnetwork::logger_mt & logger_a, boost::files
 			if (err == MDB_SUCCESS)
 			{
 				is_fully_upgraded = (version.get (transaction) == version_number);
-				mdb_dbi_close (env, meta_handle);
+				mdb_dbi_close (mdb_txn_env (env.tx (transaction)), meta_handle);
 			}
 		}
 
@@ -117,6 +119,9 @@ vxlnetwork::mdb_store::mdb_store (vxlnetwork::logger_mt & logger_a, boost::files
 				auto vacuum_success = vacuum_after_upgrade (path_a, lmdb_config_a);
 				logger.always_log (vacuum_success ? "Vacuum succeeded." : "Failed to vacuum. (Optional) Ensure enough disk space is available for a copy of the database and try to vacuum after shutting down the node");
 			}
+
+			// Upgrades write blocks directly and vacuuming reopens the environment, resetting transaction ids
+			block_cache.clear ();
 		}
 		else
 		{
@@ -135,9 +140,7 @@ bool vxlnetwork::mdb_store::vacuum_after_upgrade (boost::filesystem::path const
 	if (vacuum_success)
 	{
 		// Need to close the database to release the file handle
-		mdb_env_sync (env.environment, true);
-		mdb_env_close (env.environment);
-		env.environment = nullptr;
+		env.close ();
 
 		// Replace the ledger file with the vacuumed one
 		boost::filesystem::rename (vacuum_path, path_a);
@@ -169,7 +172,8 @@ void vxlnetwork::mdb_store::serialize_mdb_tracker (boost::property_tree::ptree &
 void vxlnetwork::mdb_store::serialize_memory_stats (boost::property_tree::ptree & json)
 {
 	MDB_stat stats;
-	auto status (mdb_env_stat (env.environment, &stats));
+	auto environment (env.current ());
+	auto status (mdb_env_stat (environment.get (), &stats));
 	release_assert (status == 0);
 	json.put ("branch_pages", stats.ms_branch_pages);
 	json.put ("depth", stats.ms_depth);
@@ -179,6 +183,21 @@ void vxlnetwork::mdb_store::serialize_memory_stats (boost::property_tree::ptree
 	json.put ("page_size", stats.ms_psize);
 }
 
+void vxlnetwork::mdb_store::export_stats (vxlnetwork::stat & stats_a)
+{
+	compaction.export_stats (stats_a);
+}
+
+void vxlnetwork::mdb_store::compact_if_needed ()
+{
+	compaction.start_if_needed ();
+}
+
+void vxlnetwork::mdb_store::stop_compaction ()
+{
+	compaction.stop ();
+}
+
 vxlnetwork::write_transaction vxlnetwork::mdb_store::tx_begin_write (std::vector<vxlnetwork::tables> const &, std::vector<vxlnetwork::tables> const &)
 {
 	return env.tx_begin_write (create_txn_callbacks ());
@@ -795,7 +814,8 @@ void vxlnetwork::mdb_store::create_backup_file (vxlnetwork::mdb_env & env_a, boo
 	auto start_message (boost::str (boost::format ("Performing %1% backup before database upgrade...") % filepath_a.filename ()));
 	logger_a.always_log (start_message);
 	std::cout << start_message << std::endl;
-	auto error (mdb_env_copy (env_a, backup_filepath.string ().c_str ()));
+	auto environment (env_a.current ());
+	auto error (mdb_env_copy (environment.get (), backup_filepath.string ().c_str ()));
 	if (error)
 	{
 		auto error_message (boost::str (boost::format ("%1% backup failed") % filepath_a.filename ()));
@@ -827,19 +847,58 @@ int vxlnetwork::mdb_store::get (vxlnetwork::transaction const & transaction_a, t
 	return mdb_get (env.tx (transaction_a), table_to_dbi (table_a), key_a, value_a);
 }
 
+void vxlnetwork::mdb_store::batch_get (vxlnetwork::transaction const & transaction_a, tables table_a, std::vector<vxlnetwork::mdb_val> const & keys_a, std::vector<vxlnetwork::mdb_val> & values_a, std::vector<int> & statuses_a) const
+{
+	values_a.assign (keys_a.size (), vxlnetwork::mdb_val{});
+	statuses_a.assign (keys_a.size (), MDB_NOTFOUND);
+	// Visit the keys in database order with a single cursor, LMDB searches the page the cursor is on before descending from the root
+	std::vector<std::size_t> order (keys_a.size ());
+	std::iota (order.begin (), order.end (), 0);
+	std::sort (order.begin (), order.end (), [&keys_a] (std::size_t lhs, std::size_t rhs) {
+		auto const & lhs_l (keys_a[lhs]);
+		auto const & rhs_l (keys_a[rhs]);
+		auto result (std::memcmp (lhs_l.data (), rhs_l.data (), std::min (lhs_l.size (), rhs_l.size ())));
+		return result < 0 || (result == 0 && lhs_l.size () < rhs_l.size ());
+	});
+	MDB_cursor * cursor;
+	auto status (mdb_cursor_open (env.tx (transaction_a), table_to_dbi (table_a), &cursor));
+	release_assert (status == MDB_SUCCESS);
+	for (auto index : order)
+	{
+		MDB_val key (keys_a[index]);
+		statuses_a[index] = mdb_cursor_get (cursor, &key, values_a[index], MDB_SET_KEY);
+	}
+	mdb_cursor_close (cursor);
+}
+
 int vxlnetwork::mdb_store::put (vxlnetwork::write_transaction const & transaction_a, tables table_a, vxlnetwork::mdb_val const & key_a, vxlnetwork::mdb_val const & value_a) const
 {
-	return (mdb_put (env.tx (transaction_a), table_to_dbi (table_a), key_a, value_a, 0));
+	auto status (mdb_put (env.tx (transaction_a), table_to_dbi (table_a), key_a, value_a, 0));
+	if (compaction.logging && status == MDB_SUCCESS)
+	{
+		compaction.log_put (table_a, key_a, value_a);
+	}
+	return status;
 }
 
 int vxlnetwork::mdb_store::del (vxlnetwork::write_transaction const & transaction_a, tables table_a, vxlnetwork::mdb_val const & key_a) const
 {
-	return (mdb_del (env.tx (transaction_a), table_to_dbi (table_a), key_a, nullptr));
+	auto status (mdb_del (env.tx (transaction_a), table_to_dbi (table_a), key_a, nullptr));
+	if (compaction.logging && status == MDB_SUCCESS)
+	{
+		compaction.log_del (table_a, key_a);
+	}
+	return status;
 }
 
 int vxlnetwork::mdb_store::drop (vxlnetwork::write_transaction const & transaction_a, tables table_a)
 {
-	return clear (transaction_a, table_to_dbi (table_a));
+	auto status (clear (transaction_a, table_to_dbi (table_a)));
+	if (compaction.logging && status == MDB_SUCCESS)
+	{
+		compaction.log_drop (table_a);
+	}
+	return status;
 }
 
 int vxlnetwork::mdb_store::clear (vxlnetwork::write_transaction const & transaction_a, MDB_dbi handle_a)
@@ -912,9 +971,49 @@ std::string vxlnetwork::mdb_store::error_string (int status) const
 	return mdb_strerror (status);
 }
 
+uint64_t vxlnetwork::mdb_store::snapshot_version (vxlnetwork::transaction const & transaction_a) const
+{
+	// Read transactions see the last committed transaction id
+	return env.txn_id (transaction_a);
+}
+
+uint64_t vxlnetwork::mdb_store::committed_version () const
+{
+	return env.last_txn_id ();
+}
+
 bool vxlnetwork::mdb_store::copy_db (boost::filesystem::path const & destination_file)
 {
-	return !mdb_env_copy2 (env.environment, destination_file.string ().c_str (), MDB_CP_COMPACT);
+	auto environment (env.current ());
+	return !mdb_env_copy2 (environment.get (), destination_file.string ().c_str (), MDB_CP_COMPACT);
+}
+
+void vxlnetwork::mdb_store::raw_for_each (vxlnetwork::transaction const & transaction_a, tables table_a, std::function<void (vxlnetwork::raw_entry const &)> const & action_a) const
+{
+	MDB_cursor * cursor;
+	auto status (mdb_cursor_open (env.tx (transaction_a), table_to_dbi (table_a), &cursor));
+	release_assert_success (*this, status);
+	MDB_val key;
+	MDB_val value;
+	for (status = mdb_cursor_get (cursor, &key, &value, MDB_FIRST); status == MDB_SUCCESS; status = mdb_cursor_get (cursor, &key, &value, MDB_NEXT))
+	{
+		action_a ({ static_cast<uint8_t const *> (key.mv_data), key.mv_size, static_cast<uint8_t const *> (value.mv_data), value.mv_size });
+	}
+	mdb_cursor_close (cursor);
+}
+
+bool vxlnetwork::mdb_store::raw_bulk_load (tables table_a, std::vector<vxlnetwork::raw_entry> const & entries_a)
+{
+	auto error (false);
+	auto transaction (tx_begin_write ({ table_a }));
+	for (auto i (entries_a.begin ()), n (entries_a.end ()); i != n && !error; ++i)
+	{
+		MDB_val key{ i->key_size, const_cast<uint8_t *> (i->key) };
+		MDB_val value{ i->value_size, const_cast<uint8_t *> (i->value) };
+		// Appending skips the page search and fills pages completely, it fails if the key doesn't sort after the last one
+		error = mdb_put (env.tx (transaction), table_to_dbi (table_a), &key, &value, MDB_APPEND) != MDB_SUCCESS;
+	}
+	return error;
 }
 
 void vxlnetwork::mdb_store::rebuild_db (vxlnetwork::write_transaction const & transaction_a)
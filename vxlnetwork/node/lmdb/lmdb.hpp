@@ -4,6 +4,7 @@
 #include <vxlnetwork/lib/lmdbconfig.hpp>
 #include <vxlnetwork/lib/logger_mt.hpp>
 #include <vxlnetwork/lib/numbers.hpp>
+#include <vxlnetwork/node/lmdb/lmdb_compaction.hpp>
 #include <vxlnetwork/node/lmdb/lmdb_env.hpp>
 #include <vxlnetwork/node/lmdb/lmdb_iterator.hpp>
 #include <vxlnetwork/node/lmdb/lmdb_txn.hpp>
@@ -66,6 +67,7 @@ private:
 	vxlnetwork::version_store_partial<MDB_val, mdb_store> version_store_partial;
 
 	friend class vxlnetwork::unchecked_mdb_store;
+	friend class vxlnetwork::mdb_compaction;
 
 public:
 	mdb_store (vxlnetwork::logger_mt &, boost::filesystem::path const &, vxlnetwork::ledger_constants & constants, vxlnetwork::txn_tracking_config const & txn_tracking_config_a = vxlnetwork::txn_tracking_config{}, std::chrono::milliseconds block_processor_batch_max_time_a = std::chrono::milliseconds (5000), vxlnetwork::lmdb_config const & lmdb_config_a = vxlnetwork::lmdb_config{}, bool backup_before_upgrade = false);
@@ -79,6 +81,9 @@ public:
 	static void create_backup_file (vxlnetwork::mdb_env &, boost::filesystem::path const &, vxlnetwork::logger_mt &);
 
 	void serialize_memory_stats (boost::property_tree::ptree &) override;
+	void export_stats (vxlnetwork::stat &) override;
+	void compact_if_needed () override;
+	void stop_compaction () override;
 
 	unsigned max_block_write_batch_num () const override;
 
@@ -230,11 +235,14 @@ public:
 	bool exists (vxlnetwork::transaction const & transaction_a, tables table_a, vxlnetwork::mdb_val const & key_a) const;
 
 	int get (vxlnetwork::transaction const & transaction_a, tables table_a, vxlnetwork::mdb_val const & key_a, vxlnetwork::mdb_val & value_a) const;
+	void batch_get (vxlnetwork::transaction const & transaction_a, tables table_a, std::vector<vxlnetwork::mdb_val> const & keys_a, std::vector<vxlnetwork::mdb_val> & values_a, std::vector<int> & statuses_a) const;
 	int put (vxlnetwork::write_transaction const & transaction_a, tables table_a, vxlnetwork::mdb_val const & key_a, vxlnetwork::mdb_val const & value_a) const;
 	int del (vxlnetwork::write_transaction const & transaction_a, tables table_a, vxlnetwork::mdb_val const & key_a) const;
 
 	bool copy_db (boost::filesystem::path const & destination_file) override;
 	void rebuild_db (vxlnetwork::write_transaction const & transaction_a) override;
+	void raw_for_each (vxlnetwork::transaction const & transaction_a, tables table_a, std::function<void (vxlnetwork::raw_entry const &)> const & action_a) const override;
+	bool raw_bulk_load (tables table_a, std::vector<vxlnetwork::raw_entry> const & entries_a) override;
 
 	template <typename Key, typename Value>
 	vxlnetwork::store_iterator<Key, Value> make_iterator (vxlnetwork::transaction const & transaction_a, tables table_a, bool const direction_asc) const
@@ -248,6 +256,13 @@ public:
 		return vxlnetwork::store_iterator<Key, Value> (std::make_unique<vxlnetwork::mdb_iterator<Key, Value>> (transaction_a, table_to_dbi (table_a), key));
 	}
 
+	/** LMDB has no prefix filters, the iterator continues past the prefix */
+	template <typename Key, typename Value>
+	vxlnetwork::store_iterator<Key, Value> make_prefix_iterator (vxlnetwork::transaction const & transaction_a, tables table_a, vxlnetwork::mdb_val const & key) const
+	{
+		return make_iterator<Key, Value> (transaction_a, table_a, key);
+	}
+
 	bool init_error () const override;
 
 	uint64_t count (vxlnetwork::transaction const &, MDB_dbi) const;
@@ -283,6 +298,8 @@ private:
 	bool not_found (int status) const override;
 	bool success (int status) const override;
 	int status_code_not_found () const override;
+	uint64_t snapshot_version (vxlnetwork::transaction const & transaction_a) const override;
+	uint64_t committed_version () const override;
 
 	MDB_dbi table_to_dbi (tables table_a) const;
 
@@ -294,6 +311,12 @@ private:
 
 	bool vacuum_after_upgrade (boost::filesystem::path const & path_a, vxlnetwork::lmdb_config const & lmdb_config_a);
 
+public:
+	/** Destroyed first, a running compaction finishes before the environment closes */
+	mutable vxlnetwork::mdb_compaction compaction;
+
+private:
+
 	class upgrade_counters
 	{
 	public:
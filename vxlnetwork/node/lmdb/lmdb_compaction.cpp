@@ -0,0 +1,461 @@
+#include <vxlnetwork/lib/logger_mt.hpp>
+#include <vxlnetwork/lib/stats.hpp>
+#include <vxlnetwork/lib/threading.hpp>
+#include <vxlnetwork/node/lmdb/lmdb.hpp>
+#include <vxlnetwork/node/lmdb/lmdb_compaction.hpp>
+
+#include <boost/filesystem/operations.hpp>
+#include <boost/format.hpp>
+
+#include <algorithm>
+
+namespace
+{
+/** Tables of a fully upgraded ledger, by the name of their LMDB database */
+std::array<std::pair<vxlnetwork::tables, char const *>, 11> const table_names{ {
+{ vxlnetwork::tables::frontiers, "frontiers" },
+{ vxlnetwork::tables::unchecked, "unchecked" },
+{ vxlnetwork::tables::online_weight, "online_weight" },
+{ vxlnetwork::tables::meta, "meta" },
+{ vxlnetwork::tables::peers, "peers" },
+{ vxlnetwork::tables::pruned, "pruned" },
+{ vxlnetwork::tables::confirmation_height, "confirmation_height" },
+{ vxlnetwork::tables::accounts, "accounts" },
+{ vxlnetwork::tables::pending, "pending" },
+{ vxlnetwork::tables::final_votes, "final_votes" },
+{ vxlnetwork::tables::blocks, "blocks" } } };
+
+std::vector<uint8_t> to_bytes (MDB_val const & value_a)
+{
+	auto data (static_cast<uint8_t const *> (value_a.mv_data));
+	return std::vector<uint8_t> (data, data + value_a.mv_size);
+}
+
+/** Commits \p transaction_a, or aborts it if an operation failed. Returns true on error */
+bool end_transaction (MDB_txn * transaction_a, bool error_a)
+{
+	if (error_a)
+	{
+		mdb_txn_abort (transaction_a);
+	}
+	else
+	{
+		error_a = mdb_txn_commit (transaction_a) != MDB_SUCCESS;
+	}
+	return error_a;
+}
+
+boost::filesystem::path lock_file (boost::filesystem::path const & path_a)
+{
+	return path_a.string () + "-lock";
+}
+}
+
+vxlnetwork::mdb_compaction::mdb_compaction (vxlnetwork::mdb_store & store_a, boost::filesystem::path const & path_a, vxlnetwork::lmdb_config const & config_a, vxlnetwork::logger_mt & logger_a) :
+	store (store_a),
+	path (path_a),
+	target_path (path_a.parent_path () / "compacting.ldb"),
+	config (config_a),
+	logger (logger_a),
+	enabled (config_a.compaction)
+{
+}
+
+vxlnetwork::mdb_compaction::~mdb_compaction ()
+{
+	stop ();
+}
+
+bool vxlnetwork::mdb_compaction::start_if_needed ()
+{
+	auto result (false);
+#ifndef _WIN32
+	// Windows can't rename a file over one which is open, the vacuum command needs to be used instead
+	if (enabled && !active && free_ratio () * 100 >= config.compaction_threshold)
+	{
+		vxlnetwork::lock_guard<vxlnetwork::mutex> guard (mutex);
+		if (!stopped && !active)
+		{
+			if (thread.joinable ())
+			{
+				thread.join ();
+			}
+			active = true;
+			thread = std::thread ([this] () {
+				vxlnetwork::thread_role::set (vxlnetwork::thread_role::name::db_compaction);
+				run ();
+				active = false;
+			});
+			result = true;
+		}
+	}
+#endif
+	return result;
+}
+
+void vxlnetwork::mdb_compaction::stop ()
+{
+	{
+		vxlnetwork::lock_guard<vxlnetwork::mutex> guard (mutex);
+		stopped = true;
+	}
+	condition.notify_all ();
+	if (thread.joinable ())
+	{
+		thread.join ();
+	}
+}
+
+bool vxlnetwork::mdb_compaction::running () const
+{
+	return active;
+}
+
+double vxlnetwork::mdb_compaction::free_ratio () const
+{
+	MDB_envinfo info;
+	auto environment (store.env.current ());
+	auto status (mdb_env_info (environment.get (), &info));
+	release_assert (status == MDB_SUCCESS);
+	auto transaction (store.tx_begin_read ());
+	// Both meta pages, then the pages of the free list, the main database holding the table names and every table
+	uint64_t used (2);
+	std::vector<MDB_dbi> databases{ 0, 1 };
+	for (auto const & [table, name] : table_names)
+	{
+		databases.push_back (store.table_to_dbi (table));
+	}
+	for (auto dbi : databases)
+	{
+		MDB_stat stats;
+		status = mdb_stat (store.env.tx (transaction), dbi, &stats);
+		release_assert (status == MDB_SUCCESS);
+		used += stats.ms_branch_pages + stats.ms_leaf_pages + stats.ms_overflow_pages;
+	}
+	uint64_t const total (info.me_last_pgno + 1);
+	return total > used ? static_cast<double> (total - used) / total : 0.0;
+}
+
+bool vxlnetwork::mdb_compaction::run ()
+{
+	logger.always_log (boost::str (boost::format ("Compacting ledger database, %1%%% of the file is free") % static_cast<unsigned> (free_ratio () * 100)));
+	++started;
+	boost::system::error_code ec;
+	boost::filesystem::remove (target_path, ec);
+	boost::filesystem::remove (lock_file (target_path), ec);
+
+	auto error (false);
+	vxlnetwork::mdb_env target (error, target_path, vxlnetwork::mdb_env::options::make ().set_config (config).set_use_no_mem_init (true));
+	auto target_environment (target.current ());
+	if (!error)
+	{
+		// The copy is flushed once before switching rather than on every chunk
+		error = mdb_env_set_flags (target_environment.get (), MDB_NOSYNC, 1) != MDB_SUCCESS;
+	}
+	// Open the tables in the order of their handles, the store keeps using its handles with the new environment
+	std::vector<vxlnetwork::tables> tables;
+	for (auto const & [table, name] : table_names)
+	{
+		tables.push_back (table);
+	}
+	std::sort (tables.begin (), tables.end (), [this] (vxlnetwork::tables lhs, vxlnetwork::tables rhs) {
+		return store.table_to_dbi (lhs) < store.table_to_dbi (rhs);
+	});
+	if (!error)
+	{
+		MDB_txn * transaction;
+		error = mdb_txn_begin (target_environment.get (), nullptr, 0, &transaction) != MDB_SUCCESS;
+		if (!error)
+		{
+			for (auto i (tables.begin ()), n (tables.end ()); i != n && !error; ++i)
+			{
+				auto name (std::find_if (table_names.begin (), table_names.end (), [table = *i] (auto const & entry_a) { return entry_a.first == table; })->second);
+				MDB_dbi dbi;
+				error = mdb_dbi_open (transaction, name, MDB_CREATE, &dbi) != MDB_SUCCESS || dbi != store.table_to_dbi (*i);
+			}
+			error = end_transaction (transaction, error);
+			if (error)
+			{
+				// Handles of tables removed by an upgrade leave gaps which a new environment doesn't reproduce
+				logger.always_log ("Compaction failed to recreate the table layout and is disabled, restart the node after a database upgrade before compacting");
+				enabled = false;
+			}
+		}
+	}
+	if (!error)
+	{
+		{
+			// Every write transaction from here on is logged
+			auto write_lock (store.env.lock_writes ());
+			vxlnetwork::lock_guard<vxlnetwork::mutex> guard (log_mutex);
+			log.clear ();
+			logging = true;
+		}
+		uint64_t entries_l (0);
+		{
+			auto transaction (store.tx_begin_read ());
+			for (auto table : tables)
+			{
+				entries_l += store.count (transaction, store.table_to_dbi (table));
+			}
+		}
+		entries_total += entries_l;
+		copy_start = std::chrono::steady_clock::now ();
+		copy_bytes = 0;
+		uint64_t copied (0);
+		for (auto i (tables.begin ()), n (tables.end ()); i != n && !error; ++i)
+		{
+			error = copy (target, *i, copied);
+			if (!error)
+			{
+				logger.always_log (boost::str (boost::format ("Compaction copied %1% of %2% entries") % copied % entries_l));
+			}
+		}
+		if (!error)
+		{
+			error = switch_over (target);
+		}
+		if (error)
+		{
+			abort ();
+		}
+	}
+	if (error)
+	{
+		++aborted;
+		target.close ();
+		boost::filesystem::remove (target_path, ec);
+		boost::filesystem::remove (lock_file (target_path), ec);
+		logger.always_log ("Compaction of the ledger database stopped, the database is unchanged");
+	}
+	else
+	{
+		logger.always_log (boost::str (boost::format ("Compaction of the ledger database completed, %1% bytes copied in %2% seconds") % copy_bytes % std::chrono::duration_cast<std::chrono::seconds> (std::chrono::steady_clock::now () - copy_start).count ()));
+	}
+	return error;
+}
+
+bool vxlnetwork::mdb_compaction::copy (vxlnetwork::mdb_env & target_a, vxlnetwork::tables table_a, uint64_t & copied_a)
+{
+	auto const dbi (store.table_to_dbi (table_a));
+	auto target_environment (target_a.current ());
+	std::vector<uint8_t> last_key;
+	auto error (false);
+	auto done (false);
+	while (!error && !done)
+	{
+		uint64_t bytes (0);
+		uint64_t entries (0);
+		{
+			auto transaction (store.tx_begin_read ());
+			MDB_txn * target_transaction;
+			error = mdb_txn_begin (target_environment.get (), nullptr, 0, &target_transaction) != MDB_SUCCESS;
+			if (!error)
+			{
+				MDB_cursor * cursor;
+				auto status (mdb_cursor_open (store.env.tx (transaction), dbi, &cursor));
+				release_assert (status == MDB_SUCCESS);
+				MDB_val key{ last_key.size (), last_key.data () };
+				MDB_val value;
+				status = mdb_cursor_get (cursor, &key, &value, last_key.empty () ? MDB_FIRST : MDB_SET_RANGE);
+				if (status == MDB_SUCCESS && !last_key.empty () && to_bytes (key) == last_key)
+				{
+					status = mdb_cursor_get (cursor, &key, &value, MDB_NEXT);
+				}
+				while (status == MDB_SUCCESS && entries < chunk_entries && !error)
+				{
+					// Appending fills pages completely, it fails if the change log already inserted a key after this one
+					auto put_status (mdb_put (target_transaction, dbi, &key, &value, MDB_APPEND));
+					if (put_status == MDB_KEYEXIST)
+					{
+						put_status = mdb_put (target_transaction, dbi, &key, &value, 0);
+					}
+					error = put_status != MDB_SUCCESS;
+					last_key = to_bytes (key);
+					bytes += key.mv_size + value.mv_size;
+					++entries;
+					status = mdb_cursor_get (cursor, &key, &value, MDB_NEXT);
+				}
+				release_assert (status == MDB_SUCCESS || status == MDB_NOTFOUND);
+				done = status == MDB_NOTFOUND;
+				mdb_cursor_close (cursor);
+				error = end_transaction (target_transaction, error);
+			}
+		}
+		copied_a += entries;
+		entries_copied += entries;
+		bytes_read += bytes;
+		bytes_written += bytes;
+		if (!error)
+		{
+			error = replay (target_a);
+		}
+		throttle (bytes);
+		vxlnetwork::lock_guard<vxlnetwork::mutex> guard (mutex);
+		error = error || stopped;
+	}
+	return error;
+}
+
+bool vxlnetwork::mdb_compaction::replay (vxlnetwork::mdb_env & target_a)
+{
+	std::deque<change> changes;
+	{
+		// No write transaction is open, so every logged change is committed and the next chunk reads a snapshot containing them
+		auto write_lock (store.env.lock_writes ());
+		vxlnetwork::lock_guard<vxlnetwork::mutex> guard (log_mutex);
+		changes.swap (log);
+	}
+	return apply (target_a, changes);
+}
+
+bool vxlnetwork::mdb_compaction::apply (vxlnetwork::mdb_env & target_a, std::deque<change> const & changes_a)
+{
+	auto error (false);
+	if (!changes_a.empty ())
+	{
+		uint64_t bytes (0);
+		auto target_environment (target_a.current ());
+		MDB_txn * transaction;
+		error = mdb_txn_begin (target_environment.get (), nullptr, 0, &transaction) != MDB_SUCCESS;
+		if (!error)
+		{
+			for (auto i (changes_a.begin ()), n (changes_a.end ()); i != n && !error; ++i)
+			{
+				auto const dbi (store.table_to_dbi (i->table));
+				MDB_val key{ i->key.size (), const_cast<uint8_t *> (i->key.data ()) };
+				auto status (MDB_SUCCESS);
+				switch (i->type)
+				{
+					case change::operation::put:
+					{
+						MDB_val value{ i->value.size (), const_cast<uint8_t *> (i->value.data ()) };
+						status = mdb_put (transaction, dbi, &key, &value, 0);
+						bytes += key.mv_size + value.mv_size;
+						break;
+					}
+					case change::operation::del:
+						status = mdb_del (transaction, dbi, &key, nullptr);
+						// Keys after the copy position haven't been copied yet
+						status = status == MDB_NOTFOUND ? MDB_SUCCESS : status;
+						break;
+					case change::operation::drop:
+						status = mdb_drop (transaction, dbi, 0);
+						break;
+				}
+				error = status != MDB_SUCCESS;
+			}
+			error = end_transaction (transaction, error);
+		}
+		changes_replayed += changes_a.size ();
+		bytes_written += bytes;
+	}
+	return error;
+}
+
+void vxlnetwork::mdb_compaction::throttle (uint64_t bytes_a)
+{
+	copy_bytes += bytes_a;
+	if (config.compaction_rate_limit != 0)
+	{
+		auto const allowed (std::chrono::microseconds (copy_bytes * 1000000 / (config.compaction_rate_limit * 1024ULL * 1024)));
+		auto const due (copy_start + allowed);
+		auto const now (std::chrono::steady_clock::now ());
+		if (due > now)
+		{
+			vxlnetwork::unique_lock<vxlnetwork::mutex> lock (mutex);
+			condition.wait_until (lock, due, [this] () { return stopped; });
+			throttle_us += std::chrono::duration_cast<std::chrono::microseconds> (std::chrono::steady_clock::now () - now).count ();
+		}
+	}
+}
+
+bool vxlnetwork::mdb_compaction::switch_over (vxlnetwork::mdb_env & target_a)
+{
+	// Writers wait from here until the store runs on the new file
+	auto write_lock (store.env.lock_writes ());
+	std::deque<change> changes;
+	{
+		vxlnetwork::lock_guard<vxlnetwork::mutex> guard (log_mutex);
+		changes.swap (log);
+		logging = false;
+	}
+	auto error (apply (target_a, changes));
+	if (!error)
+	{
+		// Flush the copy and restore the configured sync strategy
+		auto target_environment (target_a.current ());
+		error = mdb_env_sync (target_environment.get (), 1) != MDB_SUCCESS;
+		if (!error && (config.sync == vxlnetwork::lmdb_config::sync_strategy::always || config.sync == vxlnetwork::lmdb_config::sync_strategy::nosync_safe))
+		{
+			error = mdb_env_set_flags (target_environment.get (), MDB_NOSYNC, 0) != MDB_SUCCESS;
+		}
+	}
+	if (!error)
+	{
+		// The old file holds the same data until writers resume, a crash after the rename leaves a complete ledger either way
+		boost::system::error_code ec;
+		boost::filesystem::rename (target_path, path, ec);
+		error = static_cast<bool> (ec);
+	}
+	if (!error)
+	{
+		// Other processes opening the ledger have to share the lock file of the new environment
+		boost::system::error_code ec;
+		boost::filesystem::rename (lock_file (target_path), lock_file (path), ec);
+		store.env.replace (write_lock, target_a);
+		++switched;
+	}
+	return error;
+}
+
+void vxlnetwork::mdb_compaction::abort ()
+{
+	// Writers check logging inside their transaction, so it's only cleared while none is open
+	auto write_lock (store.env.lock_writes ());
+	vxlnetwork::lock_guard<vxlnetwork::mutex> guard (log_mutex);
+	logging = false;
+	log.clear ();
+}
+
+void vxlnetwork::mdb_compaction::log_put (vxlnetwork::tables table_a, MDB_val const & key_a, MDB_val const & value_a)
+{
+	change change_l{ table_a, change::operation::put, to_bytes (key_a), to_bytes (value_a) };
+	vxlnetwork::lock_guard<vxlnetwork::mutex> guard (log_mutex);
+	log.push_back (std::move (change_l));
+}
+
+void vxlnetwork::mdb_compaction::log_del (vxlnetwork::tables table_a, MDB_val const & key_a)
+{
+	change change_l{ table_a, change::operation::del, to_bytes (key_a), {} };
+	vxlnetwork::lock_guard<vxlnetwork::mutex> guard (log_mutex);
+	log.push_back (std::move (change_l));
+}
+
+void vxlnetwork::mdb_compaction::log_drop (vxlnetwork::tables table_a)
+{
+	vxlnetwork::lock_guard<vxlnetwork::mutex> guard (log_mutex);
+	log.push_back (change{ table_a, change::operation::drop, {}, {} });
+}
+
+void vxlnetwork::mdb_compaction::export_stats (vxlnetwork::stat & stats_a)
+{
+	static std::array<std::pair<std::atomic<uint64_t> vxlnetwork::mdb_compaction::*, vxlnetwork::stat::detail>, 9> const counters{ {
+	{ &vxlnetwork::mdb_compaction::started, vxlnetwork::stat::detail::compaction_start },
+	{ &vxlnetwork::mdb_compaction::switched, vxlnetwork::stat::detail::compaction_switch },
+	{ &vxlnetwork::mdb_compaction::aborted, vxlnetwork::stat::detail::compaction_abort },
+	{ &vxlnetwork::mdb_compaction::entries_total, vxlnetwork::stat::detail::entries_total },
+	{ &vxlnetwork::mdb_compaction::entries_copied, vxlnetwork::stat::detail::entries_copied },
+	{ &vxlnetwork::mdb_compaction::changes_replayed, vxlnetwork::stat::detail::changes_replayed },
+	{ &vxlnetwork::mdb_compaction::bytes_read, vxlnetwork::stat::detail::bytes_read },
+	{ &vxlnetwork::mdb_compaction::bytes_written, vxlnetwork::stat::detail::bytes_written },
+	{ &vxlnetwork::mdb_compaction::throttle_us, vxlnetwork::stat::detail::throttle_us } } };
+	for (auto const & [counter, detail] : counters)
+	{
+		auto const count ((this->*counter).exchange (0));
+		if (count != 0)
+		{
+			stats_a.add (vxlnetwork::stat::type::lmdb_compaction, detail, vxlnetwork::stat::dir::in, count);
+		}
+	}
+}
@@ -0,0 +1,121 @@
+#pragma once
+
+#include <vxlnetwork/lib/lmdbconfig.hpp>
+#include <vxlnetwork/lib/locks.hpp>
+#include <vxlnetwork/secure/store.hpp>
+
+#include <boost/filesystem/path.hpp>
+
+#include <atomic>
+#include <deque>
+#include <thread>
+#include <vector>
+
+#include <lmdb/libraries/liblmdb/lmdb.h>
+
+namespace vxlnetwork
+{
+class logger_mt;
+class mdb_env;
+class mdb_store;
+class stat;
+
+/**
+ * Rewrites the ledger into a new data file while the node keeps running, reclaiming the free pages LMDB never returns
+ * to the file system.
+ *
+ * Tables are copied in key order a chunk at a time, each chunk under its own read transaction. Writes made to the store
+ * meanwhile are recorded in a change log, which is replayed into the new file after every chunk. The log is taken while
+ * no write transaction is open so it only holds committed changes. The final replay and the switch happen while writes
+ * are held off through mdb_env::lock_writes: the new file is renamed over the old one and replaces the environment of the
+ * store. Readers still on the old environment keep it open until they finish.
+ */
+class mdb_compaction final
+{
+public:
+	mdb_compaction (vxlnetwork::mdb_store &, boost::filesystem::path const &, vxlnetwork::lmdb_config const &, vxlnetwork::logger_mt &);
+	~mdb_compaction ();
+
+	/** Starts compacting on a background thread if it is enabled and enough of the file is free, returns true if started */
+	bool start_if_needed ();
+	/** Copies the store into a new file and switches to it on the calling thread, returns true on error */
+	bool run ();
+	void stop ();
+	bool running () const;
+	/** Fraction of the data file made of free pages */
+	double free_ratio () const;
+
+	/** Records a write to the store, only called while logging is set */
+	void log_put (vxlnetwork::tables table_a, MDB_val const & key_a, MDB_val const & value_a);
+	void log_del (vxlnetwork::tables table_a, MDB_val const & key_a);
+	void log_drop (vxlnetwork::tables table_a);
+
+	/** Adds the counters accumulated since the previous call to \p stats_a */
+	void export_stats (vxlnetwork::stat & stats_a);
+
+	/** Set from the start of the copy until the switch, while the store records its writes */
+	std::atomic<bool> logging{ false };
+
+	/** Entries copied under a single read transaction */
+	static std::size_t constexpr chunk_entries{ 16 * 1024 };
+
+private:
+	class change final
+	{
+	public:
+		enum class operation : uint8_t
+		{
+			put,
+			del,
+			drop
+		};
+
+		vxlnetwork::tables table;
+		operation type;
+		std::vector<uint8_t> key;
+		std::vector<uint8_t> value;
+	};
+
+	/** Copies \p table_a into \p target_a and adds the number of entries to \p copied_a, returns true on error */
+	bool copy (vxlnetwork::mdb_env & target_a, vxlnetwork::tables table_a, uint64_t & copied_a);
+	/** Takes the logged changes while writes are held off and applies them to \p target_a, returns true on error */
+	bool replay (vxlnetwork::mdb_env & target_a);
+	bool apply (vxlnetwork::mdb_env & target_a, std::deque<change> const & changes_a);
+	/** Waits until \p bytes_a fit into the rate limit since the copy started */
+	void throttle (uint64_t bytes_a);
+	/** Switches the store over to \p target_a, returns true on error */
+	bool switch_over (vxlnetwork::mdb_env & target_a);
+	/** Stops logging and discards the log */
+	void abort ();
+
+	vxlnetwork::mdb_store & store;
+	boost::filesystem::path path;
+	boost::filesystem::path target_path;
+	vxlnetwork::lmdb_config config;
+	vxlnetwork::logger_mt & logger;
+	/** Cleared if the table layout can't be recreated */
+	std::atomic<bool> enabled;
+
+	vxlnetwork::mutex log_mutex;
+	std::deque<change> log;
+
+	vxlnetwork::mutex mutex;
+	vxlnetwork::condition_variable condition;
+	std::thread thread;
+	std::atomic<bool> active{ false };
+	bool stopped{ false };
+
+	std::chrono::steady_clock::time_point copy_start;
+	uint64_t copy_bytes{ 0 };
+
+	std::atomic<uint64_t> started{ 0 };
+	std::atomic<uint64_t> switched{ 0 };
+	std::atomic<uint64_t> aborted{ 0 };
+	std::atomic<uint64_t> entries_total{ 0 };
+	std::atomic<uint64_t> entries_copied{ 0 };
+	std::atomic<uint64_t> changes_replayed{ 0 };
+	std::atomic<uint64_t> bytes_read{ 0 };
+	std::atomic<uint64_t> bytes_written{ 0 };
+	std::atomic<uint64_t> throttle_us{ 0 };
+};
+}
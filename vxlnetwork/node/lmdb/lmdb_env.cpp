@@ -2,6 +2,17 @@
 
 #include <boost/filesystem/operations.hpp>
 
+namespace
+{
+void close_environment (MDB_env * environment_a)
+{
+	// Make sure the commits are flushed. This is a no-op unless MDB_NOSYNC is used.
+	mdb_env_sync (environment_a, true);
+	delete static_cast<uint64_t *> (mdb_env_get_userctx (environment_a));
+	mdb_env_close (environment_a);
+}
+}
+
 vxlnetwork::mdb_env::mdb_env (bool & error_a, boost::filesystem::path const & path_a, vxlnetwork::mdb_env::options options_a)
 {
 	init (error_a, path_a, options_a);
@@ -16,9 +27,14 @@ void vxlnetwork::mdb_env::init (bool & error_a, boost::filesystem::path const &
 		vxlnetwork::set_secure_perm_directory (path_a.parent_path (), error_chmod);
 		if (!error_mkdir)
 		{
-			auto status1 (mdb_env_create (&environment));
+			MDB_env * environment_l;
+			auto status1 (mdb_env_create (&environment_l));
+			release_assert (status1 == 0);
+			environment.reset (environment_l, close_environment);
+			// Offset added to transaction ids, raised when this environment replaces another one
+			status1 = mdb_env_set_userctx (environment_l, new uint64_t{ 0 });
 			release_assert (status1 == 0);
-			auto status2 (mdb_env_set_maxdbs (environment, options_a.config.max_databases));
+			auto status2 (mdb_env_set_maxdbs (environment_l, options_a.config.max_databases));
 			release_assert (status2 == 0);
 			auto map_size = options_a.config.map_size;
 			auto max_valgrind_map_size = 16 * 1024 * 1024;
@@ -27,7 +43,7 @@ void vxlnetwork::mdb_env::init (bool & error_a, boost::filesystem::path const &
 				// In order to run LMDB under Valgrind, the maximum map size must be smaller than half your available RAM
 				map_size = max_valgrind_map_size;
 			}
-			auto status3 (mdb_env_set_mapsize (environment, map_size));
+			auto status3 (mdb_env_set_mapsize (environment_l, map_size));
 			release_assert (status3 == 0);
 			// It seems if there's ever more threads than mdb_env_set_maxreaders has read slots available, we get failures on transaction creation unless MDB_NOTLS is specified
 			// This can happen if something like 256 io_threads are specified in the node config
@@ -51,7 +67,7 @@ void vxlnetwork::mdb_env::init (bool & error_a, boost::filesystem::path const &
 			{
 				environment_flags |= MDB_NOMEMINIT;
 			}
-			auto status4 (mdb_env_open (environment, path_a.string ().c_str (), environment_flags, 00600));
+			auto status4 (mdb_env_open (environment_l, path_a.string ().c_str (), environment_flags, 00600));
 			if (status4 != 0)
 			{
 				std::cerr << "Could not open lmdb environment: " << status4;
@@ -68,29 +84,19 @@ void vxlnetwork::mdb_env::init (bool & error_a, boost::filesystem::path const &
 		else
 		{
 			error_a = true;
-			environment = nullptr;
+			environment.reset ();
 		}
 	}
 	else
 	{
 		error_a = true;
-		environment = nullptr;
+		environment.reset ();
 	}
 }
 
 vxlnetwork::mdb_env::~mdb_env ()
 {
-	if (environment != nullptr)
-	{
-		// Make sure the commits are flushed. This is a no-op unless MDB_NOSYNC is used.
-		mdb_env_sync (environment, true);
-		mdb_env_close (environment);
-	}
-}
-
-vxlnetwork::mdb_env::operator MDB_env * () const
-{
-	return environment;
+	close ();
 }
 
 vxlnetwork::read_transaction vxlnetwork::mdb_env::tx_begin_read (mdb_txn_callbacks mdb_txn_callbacks) const
@@ -107,3 +113,49 @@ MDB_txn * vxlnetwork::mdb_env::tx (vxlnetwork::transaction const & transaction_a
 {
 	return static_cast<MDB_txn *> (transaction_a.get_handle ());
 }
+
+void vxlnetwork::mdb_env::close ()
+{
+	std::atomic_store (&environment, std::shared_ptr<MDB_env>{});
+}
+
+std::shared_ptr<MDB_env> vxlnetwork::mdb_env::current () const
+{
+	return std::atomic_load (&environment);
+}
+
+uint64_t vxlnetwork::mdb_env::txn_id (vxlnetwork::transaction const & transaction_a) const
+{
+	auto handle (tx (transaction_a));
+	return mdb_txn_id (handle) + *static_cast<uint64_t const *> (mdb_env_get_userctx (mdb_txn_env (handle)));
+}
+
+uint64_t vxlnetwork::mdb_env::last_txn_id () const
+{
+	auto environment_l (current ());
+	MDB_envinfo info;
+	auto status (mdb_env_info (environment_l.get (), &info));
+	release_assert (status == MDB_SUCCESS);
+	return info.me_last_txnid + *static_cast<uint64_t const *> (mdb_env_get_userctx (environment_l.get ()));
+}
+
+vxlnetwork::unique_lock<vxlnetwork::mutex> vxlnetwork::mdb_env::lock_writes () const
+{
+	return vxlnetwork::unique_lock<vxlnetwork::mutex> (write_mutex);
+}
+
+void vxlnetwork::mdb_env::replace (vxlnetwork::unique_lock<vxlnetwork::mutex> const & write_lock_a, vxlnetwork::mdb_env & replacement_a)
+{
+	debug_assert (write_lock_a.owns_lock () && write_lock_a.mutex () == &write_mutex);
+	auto previous (current ());
+	auto replacement (replacement_a.current ());
+	release_assert (previous != nullptr && replacement != nullptr);
+	MDB_envinfo info;
+	auto status (mdb_env_info (previous.get (), &info));
+	release_assert (status == MDB_SUCCESS);
+	// Start above every id the previous environment handed out, snapshot versions are compared across the replacement
+	auto previous_offset (*static_cast<uint64_t const *> (mdb_env_get_userctx (previous.get ())));
+	*static_cast<uint64_t *> (mdb_env_get_userctx (replacement.get ())) = previous_offset + info.me_last_txnid + 1;
+	replacement_a.close ();
+	std::atomic_store (&environment, std::move (replacement));
+}
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <vxlnetwork/lib/lmdbconfig.hpp>
+#include <vxlnetwork/lib/locks.hpp>
 #include <vxlnetwork/node/lmdb/lmdb_txn.hpp>
 #include <vxlnetwork/secure/store.hpp>
 
@@ -57,10 +58,29 @@ public:
 	mdb_env (bool &, boost::filesystem::path const &, vxlnetwork::mdb_env::options options_a = vxlnetwork::mdb_env::options::make ());
 	void init (bool &, boost::filesystem::path const &, vxlnetwork::mdb_env::options options_a = vxlnetwork::mdb_env::options::make ());
 	~mdb_env ();
-	operator MDB_env * () const;
 	vxlnetwork::read_transaction tx_begin_read (mdb_txn_callbacks txn_callbacks = mdb_txn_callbacks{}) const;
 	vxlnetwork::write_transaction tx_begin_write (mdb_txn_callbacks txn_callbacks = mdb_txn_callbacks{}) const;
 	MDB_txn * tx (vxlnetwork::transaction const & transaction_a) const;
-	MDB_env * environment;
+	/** Flushes and closes the environment, init can open it again */
+	void close ();
+	/** Environment new transactions begin on, hold the returned pointer for as long as the handle is used */
+	std::shared_ptr<MDB_env> current () const;
+	/** Transaction id which keeps increasing across replacements of the environment */
+	uint64_t txn_id (vxlnetwork::transaction const & transaction_a) const;
+	/** Id of the last committed transaction, on the same scale as txn_id */
+	uint64_t last_txn_id () const;
+	/** Held by write transactions from begin until commit, holding it guarantees no write transaction is open */
+	vxlnetwork::unique_lock<vxlnetwork::mutex> lock_writes () const;
+	/**
+	 * Moves the environment of \p replacement_a in, new transactions begin on it while read transactions keep
+	 * the previous environment open until they finish or renew. The caller holds \p write_lock_a from lock_writes.
+	 */
+	void replace (vxlnetwork::unique_lock<vxlnetwork::mutex> const & write_lock_a, vxlnetwork::mdb_env & replacement_a);
+
+private:
+	std::shared_ptr<MDB_env> environment;
+	mutable vxlnetwork::mutex write_mutex;
+
+	friend class vxlnetwork::write_mdb_txn;
 };
 }
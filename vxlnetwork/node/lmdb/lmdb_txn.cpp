@@ -50,9 +50,11 @@ private:
 }
 
 vxlnetwork::read_mdb_txn::read_mdb_txn (vxlnetwork::mdb_env const & environment_a, vxlnetwork::mdb_txn_callbacks txn_callbacks_a) :
+	env (environment_a),
+	environment (environment_a.current ()),
 	txn_callbacks (txn_callbacks_a)
 {
-	auto status (mdb_txn_begin (environment_a, nullptr, MDB_RDONLY, &handle));
+	auto status (mdb_txn_begin (environment.get (), nullptr, MDB_RDONLY, &handle));
 	release_assert (status == 0);
 	txn_callbacks.txn_start (this);
 }
@@ -73,7 +75,19 @@ void vxlnetwork::read_mdb_txn::reset ()
 
 void vxlnetwork::read_mdb_txn::renew ()
 {
-	auto status (mdb_txn_renew (handle));
+	auto current (env.current ());
+	auto status (0);
+	if (current == environment)
+	{
+		status = mdb_txn_renew (handle);
+	}
+	else
+	{
+		// Renewing would keep reading the environment that was replaced while this transaction was reset
+		mdb_txn_abort (handle);
+		environment = std::move (current);
+		status = mdb_txn_begin (environment.get (), nullptr, MDB_RDONLY, &handle);
+	}
 	release_assert (status == 0);
 	txn_callbacks.txn_start (this);
 }
@@ -85,6 +99,7 @@ void * vxlnetwork::read_mdb_txn::get_handle () const
 
 vxlnetwork::write_mdb_txn::write_mdb_txn (vxlnetwork::mdb_env const & environment_a, vxlnetwork::mdb_txn_callbacks txn_callbacks_a) :
 	env (environment_a),
+	write_lock (environment_a.write_mutex, std::defer_lock),
 	txn_callbacks (txn_callbacks_a)
 {
 	renew ();
@@ -103,12 +118,15 @@ void vxlnetwork::write_mdb_txn::commit ()
 		release_assert (status == MDB_SUCCESS, mdb_strerror (status));
 		txn_callbacks.txn_end (this);
 		active = false;
+		write_lock.unlock ();
 	}
 }
 
 void vxlnetwork::write_mdb_txn::renew ()
 {
-	auto status (mdb_txn_begin (env, nullptr, 0, &handle));
+	write_lock.lock ();
+	environment = env.current ();
+	auto status (mdb_txn_begin (environment.get (), nullptr, 0, &handle));
 	release_assert (status == MDB_SUCCESS, mdb_strerror (status));
 	txn_callbacks.txn_start (this);
 	active = true;
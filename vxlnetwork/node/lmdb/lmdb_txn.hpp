@@ -1,6 +1,7 @@
 #pragma once
 
 #include <vxlnetwork/lib/diagnosticsconfig.hpp>
+#include <vxlnetwork/lib/locks.hpp>
 #include <vxlnetwork/lib/timer.hpp>
 #include <vxlnetwork/secure/store.hpp>
 
@@ -33,6 +34,9 @@ public:
 	void renew () override;
 	void * get_handle () const override;
 	MDB_txn * handle;
+	vxlnetwork::mdb_env const & env;
+	/** Keeps the environment open if it is replaced while this transaction reads from it */
+	std::shared_ptr<MDB_env> environment;
 	mdb_txn_callbacks txn_callbacks;
 };
 
@@ -47,6 +51,9 @@ public:
 	bool contains (vxlnetwork::tables table_a) const override;
 	MDB_txn * handle;
 	vxlnetwork::mdb_env const & env;
+	/** Keeps the environment from being replaced while the transaction is open */
+	vxlnetwork::unique_lock<vxlnetwork::mutex> write_lock;
+	std::shared_ptr<MDB_env> environment;
 	mdb_txn_callbacks txn_callbacks;
 	bool active{ true };
 };
@@ -11,6 +11,8 @@
 
 #include <numeric>
 
+std::chrono::seconds constexpr vxlnetwork::network::vote_filter_expiry;
+
 vxlnetwork::network::network (vxlnetwork::node & node_a, uint16_t port_a) :
 	id (vxlnetwork::network_constants::active_network),
 	syn_cookies (node_a.network_params.network.max_peers_per_ip),
@@ -29,7 +31,9 @@ vxlnetwork::network::network (vxlnetwork::node & node_a, uint16_t port_a) :
 	limiter (node_a.config.bandwidth_limit_burst_ratio, node_a.config.bandwidth_limit),
 	tcp_message_manager (node_a.config.tcp_incoming_connections_max),
 	node (node_a),
-	publish_filter (256 * 1024),
+	publish_filter (node_a.config.network_filter_size, node_a.config.network_filter_ways),
+	vote_filter (node_a.config.network_filter_size, node_a.config.network_filter_ways),
+	vote_digests (vote_filter, node_a.config.network_filter_size, vote_filter_expiry),
 	udp_channels (node_a, port_a, inbound),
 	tcp_channels (node_a, inbound),
 	port (port_a),
@@ -186,6 +190,11 @@ void vxlnetwork::network::send_node_id_handshake (std::shared_ptr<vxlnetwork::tr
 }
 
 void vxlnetwork::network::flood_message (vxlnetwork::message & message_a, vxlnetwork::buffer_drop_policy const drop_policy_a, float const scale_a)
+{
+	flood_message (vxlnetwork::transport::shared_message{ message_a }, drop_policy_a, scale_a);
+}
+
+void vxlnetwork::network::flood_message (vxlnetwork::transport::shared_message const & message_a, vxlnetwork::buffer_drop_policy const drop_policy_a, float const scale_a)
 {
 	for (auto & i : list (fanout (scale_a)))
 	{
@@ -215,7 +224,7 @@ void vxlnetwork::network::flood_block (std::shared_ptr<vxlnetwork::block> const
 
 void vxlnetwork::network::flood_block_initial (std::shared_ptr<vxlnetwork::block> const & block_a)
 {
-	vxlnetwork::publish message (node.network_params.network, block_a);
+	vxlnetwork::transport::shared_message message{ vxlnetwork::publish{ node.network_params.network, block_a } };
 	for (auto const & i : node.rep_crawler.principal_representatives ())
 	{
 		i.channel->send (message, nullptr, vxlnetwork::buffer_drop_policy::no_limiter_drop);
@@ -228,7 +237,7 @@ void vxlnetwork::network::flood_block_initial (std::shared_ptr<vxlnetwork::block
 
 void vxlnetwork::network::flood_vote (std::shared_ptr<vxlnetwork::vote> const & vote_a, float scale)
 {
-	vxlnetwork::confirm_ack message{ node.network_params.network, vote_a };
+	vxlnetwork::transport::shared_message message{ vxlnetwork::confirm_ack{ node.network_params.network, vote_a } };
 	for (auto & i : list (fanout (scale)))
 	{
 		i->send (message, nullptr);
@@ -237,7 +246,7 @@ void vxlnetwork::network::flood_vote (std::shared_ptr<vxlnetwork::vote> const &
 
 void vxlnetwork::network::flood_vote_pr (std::shared_ptr<vxlnetwork::vote> const & vote_a)
 {
-	vxlnetwork::confirm_ack message{ node.network_params.network, vote_a };
+	vxlnetwork::transport::shared_message message{ vxlnetwork::confirm_ack{ node.network_params.network, vote_a } };
 	for (auto const & i : node.rep_crawler.principal_representatives ())
 	{
 		i.channel->send (message, nullptr, vxlnetwork::buffer_drop_policy::no_limiter_drop);
@@ -502,7 +511,15 @@ public:
 					}
 				}
 			}
-			node.vote_processor.vote (message_a.vote, channel);
+			if (node.vote_processor.vote (message_a.vote, channel))
+			{
+				// Dropped by the vote processor, allow a copy from another peer to be processed
+				node.network.vote_filter.clear (message_a.digest);
+			}
+			else if (!message_a.digest.is_zero ())
+			{
+				node.network.vote_digests.add (message_a.digest, *message_a.vote);
+			}
 		}
 	}
 	void bulk_pull (vxlnetwork::bulk_pull const &) override
@@ -764,6 +781,7 @@ void vxlnetwork::network::cleanup (std::chrono::steady_clock::time_point const &
 void vxlnetwork::network::ongoing_cleanup ()
 {
 	cleanup (std::chrono::steady_clock::now () - node.network_params.network.cleanup_cutoff ());
+	vote_digests.purge (std::chrono::steady_clock::now () - vote_filter_expiry);
 	std::weak_ptr<vxlnetwork::node> node_w (node.shared ());
 	node.workers.add_timed_task (std::chrono::steady_clock::now () + node.network_params.network.cleanup_period, [node_w] () {
 		if (auto node_l = node_w.lock ())
@@ -1062,6 +1080,72 @@ std::unique_ptr<vxlnetwork::container_info_component> vxlnetwork::collect_contai
 	composite->add_component (network.udp_channels.collect_container_info ("udp_channels"));
 	composite->add_component (network.syn_cookies.collect_container_info ("syn_cookies"));
 	composite->add_component (collect_container_info (network.excluded_peers, "excluded_peers"));
+	composite->add_component (network.publish_filter.collect_container_info ("publish_filter"));
+	composite->add_component (network.vote_filter.collect_container_info ("vote_filter"));
+	composite->add_component (network.vote_digests.collect_container_info ("vote_digests"));
+	return composite;
+}
+
+vxlnetwork::vote_digests::vote_digests (vxlnetwork::network_filter & filter_a, std::size_t max_size_a, std::chrono::steady_clock::duration expiry_a) :
+	filter (filter_a),
+	max_size (max_size_a),
+	expiry (expiry_a)
+{
+}
+
+void vxlnetwork::vote_digests::add (vxlnetwork::uint128_t const & digest_a, vxlnetwork::vote const & vote_a)
+{
+	auto const now (std::chrono::steady_clock::now ());
+	vxlnetwork::lock_guard<vxlnetwork::mutex> lock (mutex);
+	purge_impl (now - expiry);
+	for (auto const & hash : vote_a)
+	{
+		entries.get<tag_sequence> ().push_back ({ digest_a, hash, now });
+	}
+	while (entries.size () > max_size)
+	{
+		filter.clear (entries.get<tag_sequence> ().front ().digest);
+		entries.get<tag_sequence> ().pop_front ();
+	}
+}
+
+void vxlnetwork::vote_digests::erase (vxlnetwork::block_hash const & hash_a)
+{
+	vxlnetwork::lock_guard<vxlnetwork::mutex> lock (mutex);
+	auto [begin, end] = entries.get<tag_hash> ().equal_range (hash_a);
+	for (auto i (begin); i != end; ++i)
+	{
+		filter.clear (i->digest);
+	}
+	entries.get<tag_hash> ().erase (begin, end);
+}
+
+void vxlnetwork::vote_digests::purge (std::chrono::steady_clock::time_point const & cutoff_a)
+{
+	vxlnetwork::lock_guard<vxlnetwork::mutex> lock (mutex);
+	purge_impl (cutoff_a);
+}
+
+void vxlnetwork::vote_digests::purge_impl (std::chrono::steady_clock::time_point const & cutoff_a)
+{
+	auto & sequence (entries.get<tag_sequence> ());
+	while (!sequence.empty () && sequence.front ().added < cutoff_a)
+	{
+		filter.clear (sequence.front ().digest);
+		sequence.pop_front ();
+	}
+}
+
+std::size_t vxlnetwork::vote_digests::size () const
+{
+	vxlnetwork::lock_guard<vxlnetwork::mutex> lock (mutex);
+	return entries.size ();
+}
+
+std::unique_ptr<vxlnetwork::container_info_component> vxlnetwork::vote_digests::collect_container_info (std::string const & name)
+{
+	auto composite = std::make_unique<container_info_composite> (name);
+	composite->add_component (std::make_unique<container_info_leaf> (container_info{ "entries", size (), sizeof (decltype (entries)::value_type) }));
 	return composite;
 }
 
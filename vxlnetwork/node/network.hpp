@@ -6,6 +6,10 @@
 #include <vxlnetwork/node/transport/udp.hpp>
 #include <vxlnetwork/secure/network_filter.hpp>
 
+#include <boost/multi_index/hashed_index.hpp>
+#include <boost/multi_index/member.hpp>
+#include <boost/multi_index/sequenced_index.hpp>
+#include <boost/multi_index_container.hpp>
 #include <boost/thread/thread.hpp>
 
 #include <memory>
@@ -115,6 +119,52 @@ private:
 	std::unordered_map<boost::asio::ip::address, unsigned> cookies_per_ip;
 	std::size_t max_cookies_per_ip;
 };
+/**
+ * Digests of the confirm_acks let through network::vote_filter, with the hashes they vote for. The filter alone only
+ * forgets a digest when its bucket evicts it, dropping identical confirm_acks sent again on purpose such as a rebroadcast
+ * vote or a final vote replayed for a new election. A digest is cleared from the filter once it expires, when an election
+ * for one of its hashes starts or when newer digests push it out.
+ */
+class vote_digests final
+{
+public:
+	vote_digests (vxlnetwork::network_filter &, std::size_t max_size_a, std::chrono::steady_clock::duration expiry_a);
+	/** Records \p digest_a of a confirm_ack carrying \p vote_a, clearing expired digests */
+	void add (vxlnetwork::uint128_t const & digest_a, vxlnetwork::vote const & vote_a);
+	/** Clears the digests of every confirm_ack voting for \p hash_a */
+	void erase (vxlnetwork::block_hash const & hash_a);
+	/** Clears the digests recorded before \p cutoff_a */
+	void purge (std::chrono::steady_clock::time_point const & cutoff_a);
+	std::size_t size () const;
+	std::unique_ptr<container_info_component> collect_container_info (std::string const &);
+
+private:
+	class entry final
+	{
+	public:
+		vxlnetwork::uint128_t digest;
+		vxlnetwork::block_hash hash;
+		std::chrono::steady_clock::time_point added;
+	};
+	class tag_sequence
+	{
+	};
+	class tag_hash
+	{
+	};
+	/** Must be called with the mutex held */
+	void purge_impl (std::chrono::steady_clock::time_point const & cutoff_a);
+	vxlnetwork::network_filter & filter;
+	std::size_t const max_size;
+	std::chrono::steady_clock::duration const expiry;
+	mutable vxlnetwork::mutex mutex;
+	boost::multi_index_container<entry,
+	boost::multi_index::indexed_by<
+	boost::multi_index::sequenced<boost::multi_index::tag<tag_sequence>>,
+	boost::multi_index::hashed_non_unique<boost::multi_index::tag<tag_hash>,
+	boost::multi_index::member<entry, vxlnetwork::block_hash, &entry::hash>>>>
+	entries;
+};
 class network final
 {
 public:
@@ -124,6 +174,8 @@ public:
 	void start ();
 	void stop ();
 	void flood_message (vxlnetwork::message &, vxlnetwork::buffer_drop_policy const = vxlnetwork::buffer_drop_policy::limiter, float const = 1.0f);
+	/** Sends the same serialized buffer to every selected channel */
+	void flood_message (vxlnetwork::transport::shared_message const &, vxlnetwork::buffer_drop_policy const = vxlnetwork::buffer_drop_policy::limiter, float const = 1.0f);
 	void flood_keepalive (float const scale_a = 1.0f);
 	void flood_keepalive_self (float const scale_a = 0.5f);
 	void flood_vote (std::shared_ptr<vxlnetwork::vote> const &, float scale);
@@ -185,6 +237,9 @@ public:
 	vxlnetwork::tcp_message_manager tcp_message_manager;
 	vxlnetwork::node & node;
 	vxlnetwork::network_filter publish_filter;
+	/** Drops confirm_ack messages already received from another peer before the vote is deserialized */
+	vxlnetwork::network_filter vote_filter;
+	vxlnetwork::vote_digests vote_digests;
 	vxlnetwork::transport::udp_channels udp_channels;
 	vxlnetwork::transport::tcp_channels tcp_channels;
 	std::atomic<uint16_t> port{ 0 };
@@ -193,6 +248,8 @@ public:
 	std::function<void (std::shared_ptr<vxlnetwork::transport::channel>)> channel_observer;
 	std::atomic<bool> stopped{ false };
 	static unsigned const broadcast_interval_ms = 10;
+	/** Time after which an identical confirm_ack is processed again */
+	static std::chrono::seconds constexpr vote_filter_expiry{ 30 };
 	static std::size_t const buffer_size = 512;
 	static std::size_t const confirm_req_hashes_max = 7;
 	static std::size_t const confirm_ack_hashes_max = 12;
@@ -86,6 +86,7 @@ vxlnetwork::node::node (boost::asio::io_context & io_ctx_a, boost::filesystem::p
 	config (config_a),
 	network_params{ config.network_params },
 	stats (config.stat_config),
+	io_shards (io_ctx_a, config.io_shards),
 	workers (std::max (3u, config.io_threads / 4), vxlnetwork::thread_role::name::worker),
 	flags (flags_a),
 	work (work_a),
@@ -93,11 +94,12 @@ vxlnetwork::node::node (boost::asio::io_context & io_ctx_a, boost::filesystem::p
 	logger (config_a.logging.min_time_between_log_output),
 	store_impl (vxlnetwork::make_store (logger, application_path_a, network_params.ledger, flags.read_only, true, config_a.rocksdb_config, config_a.diagnostics_config.txn_tracking, config_a.block_processor_batch_max_time, config_a.lmdb_config, config_a.backup_before_upgrade)),
 	store (*store_impl),
-	unchecked{ store, flags.disable_block_processor_unchecked_deletion },
+	unchecked{ store, flags.disable_block_processor_unchecked_deletion, flags.unchecked_memory_limit },
 	wallets_store_impl (std::make_unique<vxlnetwork::mdb_wallets_store> (application_path_a / "wallets.ldb", config_a.lmdb_config)),
 	wallets_store (*wallets_store_impl),
 	gap_cache (*this),
 	ledger (store, stats, network_params.ledger, flags_a.generate_cache),
+	group_commit (store, stats),
 	checker (config.signature_checker_threads),
 	// empty `config.peering_port` means the user made no port choice at all;
 	// otherwise, any value is considered, with `0` having the special meaning of 'let the OS pick a port instead'
@@ -119,17 +121,21 @@ vxlnetwork::node::node (boost::asio::io_context & io_ctx_a, boost::filesystem::p
 	vote_processor (checker, active, observers, stats, config, flags, logger, online_reps, rep_crawler, ledger, network_params),
 	warmed_up (0),
 	block_processor (*this, write_database_queue),
-	online_reps (ledger, config),
+	online_reps (ledger, group_commit, config),
 	history{ config.network_params.voting },
 	vote_uniquer (block_uniquer),
-	confirmation_height_processor (ledger, write_database_queue, config.conf_height_processor_batch_min_time, config.logging, logger, node_initialized_latch, flags.confirmation_height_processor_mode),
+	confirmation_height_processor (ledger, write_database_queue, config.conf_height_processor_batch_min_time, config.logging, logger, node_initialized_latch, flags.confirmation_height_processor_mode, config.conf_height_processor_threads),
 	active (*this, confirmation_height_processor),
 	scheduler{ *this },
 	aggregator (config, stats, active.generator, active.final_generator, history, ledger, wallets, active),
+	rpc_executor (config.rpc_execution, stats),
 	wallets (wallets_store.init_error (), *this),
 	startup_time (std::chrono::steady_clock::now ()),
 	node_seq (seq)
 {
+	store.block_cache.set_max_size (config.block_cache_max_size);
+	store.block_cache.set_stats (stats);
+	unchecked.set_stats (stats);
 	unchecked.satisfied = [this] (vxlnetwork::unchecked_info const & info) {
 		this->block_processor.add (info);
 	};
@@ -142,7 +148,7 @@ vxlnetwork::node::node (boost::asio::io_context & io_ctx_a, boost::filesystem::p
 		if (config.websocket_config.enabled)
 		{
 			auto endpoint_l (vxlnetwork::tcp_endpoint (boost::asio::ip::make_address_v6 (config.websocket_config.address), config.websocket_config.port));
-			websocket_server = std::make_shared<vxlnetwork::websocket::listener> (config.websocket_config.tls_config, logger, wallets, io_ctx, endpoint_l);
+			websocket_server = std::make_shared<vxlnetwork::websocket::listener> (config.websocket_config.tls_config, logger, wallets, stats, io_ctx, endpoint_l, config.websocket_config.max_queued_bytes);
 			this->websocket_server->run ();
 		}
 
@@ -331,6 +337,15 @@ vxlnetwork::node::node (boost::asio::io_context & io_ctx_a, boost::filesystem::p
 		logger.always_log ("Node starting, version: ", VXLNETWORK_VERSION_STRING);
 		logger.always_log ("Build information: ", BUILD_INFO);
 		logger.always_log ("Database backend: ", store.vendor_get ());
+		{
+			std::chrono::milliseconds total{ 0 };
+			for (auto const & [phase, duration] : ledger.initialize_timings)
+			{
+				logger.always_log (boost::str (boost::format ("Ledger cache %1% built in %2% ms") % phase % duration.count ()));
+				total += duration;
+			}
+			logger.always_log (boost::str (boost::format ("Ledger cache built in %1% ms: %2% accounts, %3% blocks, %4% cemented, %5% representatives") % total.count () % ledger.cache.account_count.load () % ledger.cache.block_count.load () % ledger.cache.cemented_count.load () % ledger.cache.rep_weights.size ()));
+		}
 
 		auto const network_label = network_params.network.get_current_network_as_string ();
 		logger.always_log ("Active network: ", network_label);
@@ -537,6 +552,9 @@ std::unique_ptr<vxlnetwork::container_info_component> vxlnetwork::collect_contai
 	composite->add_component (collect_container_info (node.work, "work"));
 	composite->add_component (collect_container_info (node.gap_cache, "gap_cache"));
 	composite->add_component (collect_container_info (node.ledger, "ledger"));
+	composite->add_component (collect_container_info (node.store.block_cache, "block_cache"));
+	composite->add_component (collect_container_info (node.unchecked, "unchecked"));
+	composite->add_component (collect_container_info (node.group_commit, "group_commit"));
 	composite->add_component (collect_container_info (node.active, "active"));
 	composite->add_component (collect_container_info (node.bootstrap_initiator, "bootstrap_initiator"));
 	composite->add_component (collect_container_info (node.bootstrap, "bootstrap"));
@@ -546,9 +564,11 @@ std::unique_ptr<vxlnetwork::container_info_component> vxlnetwork::collect_contai
 		composite->add_component (collect_container_info (*node.telemetry, "telemetry"));
 	}
 	composite->add_component (collect_container_info (node.workers, "workers"));
+	composite->add_component (collect_container_info (node.io_shards, "io_shards"));
 	composite->add_component (collect_container_info (node.observers, "observers"));
 	composite->add_component (collect_container_info (node.wallets, "wallets"));
 	composite->add_component (collect_container_info (node.vote_processor, "vote_processor"));
+	composite->add_component (collect_container_info (node.rpc_executor, "rpc_executor"));
 	composite->add_component (collect_container_info (node.rep_crawler, "rep_crawler"));
 	composite->add_component (collect_container_info (node.block_processor, "block_processor"));
 	composite->add_component (collect_container_info (node.block_arrival, "block_arrival"));
@@ -628,6 +648,8 @@ void vxlnetwork::node::start ()
 	}
 	ongoing_rep_calculation ();
 	ongoing_peer_store ();
+	ongoing_database_stats ();
+	ongoing_database_compaction ();
 	ongoing_online_weight_calculation_queue ();
 	bool tcp_enabled (false);
 	if (config.tcp_incoming_connections_max > 0 && !(flags.disable_bootstrap_listener && flags.disable_tcp_realtime))
@@ -699,13 +721,17 @@ void vxlnetwork::node::stop ()
 		port_mapping.stop ();
 		checker.stop ();
 		wallets.stop ();
+		group_commit.stop ();
 		stats.stop ();
 		auto epoch_upgrade = epoch_upgrading.lock ();
 		if (epoch_upgrade->valid ())
 		{
 			epoch_upgrade->wait ();
 		}
+		rpc_executor.stop ();
 		workers.stop ();
+		store.stop_compaction ();
+		io_shards.stop ();
 		// work pool is not stopped on purpose due to testing setup
 	}
 }
@@ -858,7 +884,14 @@ void vxlnetwork::node::ongoing_bootstrap ()
 		}
 	}
 	// Bootstrap and schedule for next attempt
-	bootstrap_initiator.bootstrap (false, boost::str (boost::format ("auto_bootstrap_%1%") % previous_bootstrap_count), frontiers_age);
+	if (flags.enable_ascending_bootstrap)
+	{
+		bootstrap_initiator.bootstrap_ascending (false, boost::str (boost::format ("auto_ascending_%1%") % stats.count (vxlnetwork::stat::type::bootstrap, vxlnetwork::stat::detail::initiate_ascending, vxlnetwork::stat::dir::out)));
+	}
+	else
+	{
+		bootstrap_initiator.bootstrap (false, boost::str (boost::format ("auto_bootstrap_%1%") % previous_bootstrap_count), frontiers_age);
+	}
 	std::weak_ptr<vxlnetwork::node> node_w (shared_from_this ());
 	workers.add_timed_task (std::chrono::steady_clock::now () + next_wakeup, [node_w] () {
 		if (auto node_l = node_w.lock ())
@@ -881,6 +914,30 @@ void vxlnetwork::node::ongoing_peer_store ()
 	});
 }
 
+void vxlnetwork::node::ongoing_database_stats ()
+{
+	store.export_stats (stats);
+	std::weak_ptr<vxlnetwork::node> node_w (shared_from_this ());
+	workers.add_timed_task (std::chrono::steady_clock::now () + std::chrono::seconds (10), [node_w] () {
+		if (auto node_l = node_w.lock ())
+		{
+			node_l->ongoing_database_stats ();
+		}
+	});
+}
+
+void vxlnetwork::node::ongoing_database_compaction ()
+{
+	store.compact_if_needed ();
+	std::weak_ptr<vxlnetwork::node> node_w (shared_from_this ());
+	workers.add_timed_task (std::chrono::steady_clock::now () + std::chrono::minutes (5), [node_w] () {
+		if (auto node_l = node_w.lock ())
+		{
+			node_l->ongoing_database_compaction ();
+		}
+	});
+}
+
 void vxlnetwork::node::backup_wallet ()
 {
 	auto transaction (wallets.tx_begin_read ());
@@ -946,16 +1003,15 @@ void vxlnetwork::node::unchecked_cleanup ()
 		auto const now (vxlnetwork::seconds_since_epoch ());
 		auto const transaction (store.tx_begin_read ());
 		// Max 1M records to clean, max 2 minutes reading to prevent slow i/o systems issues
-		for (auto [i, n] = unchecked.full_range (transaction); i != n && cleaning_list.size () < 1024 * 1024 && vxlnetwork::seconds_since_epoch () - now < 120; ++i)
-		{
-			vxlnetwork::unchecked_key const & key (i->first);
-			vxlnetwork::unchecked_info const & info (i->second);
+		unchecked.for_each (
+		transaction, [this, &digests, &cleaning_list, &now] (vxlnetwork::unchecked_key const & key, vxlnetwork::unchecked_info const & info) {
 			if ((now - info.modified ()) > static_cast<uint64_t> (config.unchecked_cutoff_time.count ()))
 			{
 				digests.push_back (network.publish_filter.hash (info.block));
 				cleaning_list.push_back (key);
 			}
-		}
+		},
+		[&cleaning_list, &now] () { return cleaning_list.size () < 1024 * 1024 && vxlnetwork::seconds_since_epoch () - now < 120; });
 	}
 	if (!cleaning_list.empty ())
 	{
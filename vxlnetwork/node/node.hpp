@@ -13,6 +13,8 @@
 #include <vxlnetwork/node/election.hpp>
 #include <vxlnetwork/node/election_scheduler.hpp>
 #include <vxlnetwork/node/gap_cache.hpp>
+#include <vxlnetwork/node/group_commit.hpp>
+#include <vxlnetwork/node/io_shards.hpp>
 #include <vxlnetwork/node/network.hpp>
 #include <vxlnetwork/node/node_observers.hpp>
 #include <vxlnetwork/node/nodeconfig.hpp>
@@ -20,6 +22,7 @@
 #include <vxlnetwork/node/portmapping.hpp>
 #include <vxlnetwork/node/repcrawler.hpp>
 #include <vxlnetwork/node/request_aggregator.hpp>
+#include <vxlnetwork/node/rpc_executor.hpp>
 #include <vxlnetwork/node/signatures.hpp>
 #include <vxlnetwork/node/telemetry.hpp>
 #include <vxlnetwork/node/unchecked_map.hpp>
@@ -119,6 +122,8 @@ public:
 	void ongoing_rep_calculation ();
 	void ongoing_bootstrap ();
 	void ongoing_peer_store ();
+	void ongoing_database_stats ();
+	void ongoing_database_compaction ();
 	void ongoing_unchecked_cleanup ();
 	void ongoing_backlog_population ();
 	void backup_wallet ();
@@ -159,6 +164,7 @@ public:
 	vxlnetwork::node_config config;
 	vxlnetwork::network_params & network_params;
 	vxlnetwork::stat stats;
+	vxlnetwork::io_shards io_shards;
 	vxlnetwork::thread_pool workers;
 	std::shared_ptr<vxlnetwork::websocket::listener> websocket_server;
 	vxlnetwork::node_flags flags;
@@ -172,6 +178,7 @@ public:
 	vxlnetwork::wallets_store & wallets_store;
 	vxlnetwork::gap_cache gap_cache;
 	vxlnetwork::ledger ledger;
+	vxlnetwork::group_commit group_commit;
 	vxlnetwork::signature_checker checker;
 	vxlnetwork::network network;
 	std::shared_ptr<vxlnetwork::telemetry> telemetry;
@@ -194,6 +201,8 @@ public:
 	vxlnetwork::active_transactions active;
 	vxlnetwork::election_scheduler scheduler;
 	vxlnetwork::request_aggregator aggregator;
+	/** Runs RPC actions received through IPC and the in-process RPC server */
+	vxlnetwork::rpc_executor rpc_executor;
 	vxlnetwork::wallets wallets;
 	std::chrono::steady_clock::time_point const startup_time;
 	std::chrono::seconds unchecked_cutoff = std::chrono::seconds (7 * 24 * 60 * 60); // Week
@@ -88,9 +88,11 @@ vxlnetwork::error vxlnetwork::node_config::serialize_toml (vxlnetwork::tomlconfi
 	toml.put ("election_hint_weight_percent", election_hint_weight_percent, "Percentage of online weight to hint at starting an election. Defaults to 10.\ntype:uint32,[5,50]");
 	toml.put ("password_fanout", password_fanout, "Password fanout factor.\ntype:uint64");
 	toml.put ("io_threads", io_threads, "Number of threads dedicated to I/O operations. Defaults to the number of CPU threads, and at least 4.\ntype:uint64");
+	toml.put ("io_shards", io_shards, "Number of additional I/O threads, each running its own event loop, that peer connections are spread over. Every connection stays on one of them for its lifetime. They are pinned to the highest numbered CPUs when there are more CPUs than shards. 0 runs connections on the shared io_threads.\ntype:uint64");
 	toml.put ("network_threads", network_threads, "Number of threads dedicated to processing network messages. Defaults to the number of CPU threads, and at least 4.\ntype:uint64");
 	toml.put ("work_threads", work_threads, "Number of threads dedicated to CPU generated work. Defaults to all available CPU threads.\ntype:uint64");
 	toml.put ("signature_checker_threads", signature_checker_threads, "Number of additional threads dedicated to signature verification. Defaults to number of CPU threads / 2.\ntype:uint64");
+	toml.put ("vote_processor_threads", vote_processor_threads, "Number of threads verifying and applying incoming votes. Votes from one representative are always processed in order by the same thread. Defaults to 1.\ntype:uint64");
 	toml.put ("enable_voting", enable_voting, "Enable or disable voting. Enabling this option requires additional system resources, namely increased CPU, bandwidth and disk usage.\ntype:bool");
 	toml.put ("bootstrap_connections", bootstrap_connections, "Number of outbound bootstrap connections. Must be a power of 2. Defaults to 4.\nWarning: a larger amount of connections may use substantially more system memory.\ntype:uint64");
 	toml.put ("bootstrap_connections_max", bootstrap_connections_max, "Maximum number of inbound bootstrap connections. Defaults to 64.\nWarning: a larger amount of connections may use additional system memory.\ntype:uint64");
@@ -107,12 +109,18 @@ vxlnetwork::error vxlnetwork::node_config::serialize_toml (vxlnetwork::tomlconfi
 	toml.put ("external_address", external_address, "The external address of this node (NAT). If not set, the node will request this information via UPnP.\ntype:string,ip");
 	toml.put ("external_port", external_port, "The external port number of this node (NAT). Only used if external_address is set.\ntype:uint16");
 	toml.put ("tcp_incoming_connections_max", tcp_incoming_connections_max, "Maximum number of incoming TCP connections.\ntype:uint64");
+	toml.put ("tcp_write_coalesce_max_bytes", tcp_write_coalesce_max_bytes, "Maximum number of bytes of queued messages sent to a peer in a single write.\ntype:uint64");
+	toml.put ("tcp_write_coalesce_delay", tcp_write_coalesce_delay.count (), "Time an idle connection waits for more messages before writing, allowing them to be sent together. 0 writes immediately.\ntype:milliseconds");
 	toml.put ("use_memory_pools", use_memory_pools, "If true, allocate memory from memory pools. Enabling this may improve performance. Memory is never released to the OS.\ntype:bool");
 	toml.put ("confirmation_history_size", confirmation_history_size, "Maximum confirmation history size. If tracking the rate of block confirmations, the websocket feature is recommended instead.\ntype:uint64");
 	toml.put ("active_elections_size", active_elections_size, "Number of active elections. Elections beyond this limit have limited survival time.\nWarning: modifying this value may result in a lower confirmation rate.\ntype:uint64,[250..]");
 	toml.put ("bandwidth_limit", bandwidth_limit, "Outbound traffic limit in bytes/sec after which messages will be dropped.\nNote: changing to unlimited bandwidth (0) is not recommended for limited connections.\ntype:uint64");
 	toml.put ("bandwidth_limit_burst_ratio", bandwidth_limit_burst_ratio, "Burst ratio for outbound traffic shaping.\ntype:double");
+	toml.put ("network_filter_size", network_filter_size, "Number of message digests held by each of the publish and vote duplicate filters. A larger filter recognizes more duplicates at the cost of 16 bytes per digest.\ntype:uint64,[1..]");
+	toml.put ("network_filter_ways", network_filter_ways, "Number of digests sharing a bucket in the duplicate filters. A full bucket evicts one of its digests, fewer ways evict sooner and let more duplicates through.\ntype:uint64,[1..4]");
+	toml.put ("block_cache_max_size", block_cache_max_size, "Approximate memory in bytes used to cache recently read blocks in front of the ledger database. 0 disables the cache.\ntype:uint64");
 	toml.put ("conf_height_processor_batch_min_time", conf_height_processor_batch_min_time.count (), "Minimum write batching time when there are blocks pending confirmation height.\ntype:milliseconds");
+	toml.put ("conf_height_processor_threads", conf_height_processor_threads, "Number of threads walking the chains of independent accounts pending confirmation height in parallel. 0 or 1 walks them serially.\ntype:uint64");
 	toml.put ("backup_before_upgrade", backup_before_upgrade, "Backup the ledger database before performing upgrades.\nWarning: uses more disk storage and increases startup time when upgrading.\ntype:bool");
 	toml.put ("max_work_generate_multiplier", max_work_generate_multiplier, "Maximum allowed difficulty multiplier for work generation.\ntype:double,[1..]");
 	toml.put ("frontiers_confirmation", serialize_frontiers_confirmation (frontiers_confirmation), "Mode controlling frontier confirmation rate.\ntype:string,{auto,always,disabled}");
@@ -183,6 +191,14 @@ vxlnetwork::error vxlnetwork::node_config::serialize_toml (vxlnetwork::tomlconfi
 	lmdb_config.serialize_toml (lmdb_l);
 	toml.put_child ("lmdb", lmdb_l);
 
+	vxlnetwork::tomlconfig traffic_l;
+	traffic.serialize_toml (traffic_l);
+	toml.put_child ("traffic", traffic_l);
+
+	vxlnetwork::tomlconfig rpc_execution_l;
+	rpc_execution.serialize_toml (rpc_execution_l);
+	toml.put_child ("rpc_execution", rpc_execution_l);
+
 	return toml.get_error ();
 }
 
@@ -327,6 +343,7 @@ vxlnetwork::error vxlnetwork::node_config::deserialize_toml (vxlnetwork::tomlcon
 		toml.get<unsigned> ("election_hint_weight_percent", election_hint_weight_percent);
 		toml.get<unsigned> ("password_fanout", password_fanout);
 		toml.get<unsigned> ("io_threads", io_threads);
+		toml.get<unsigned> ("io_shards", io_shards);
 		toml.get<unsigned> ("work_threads", work_threads);
 		toml.get<unsigned> ("network_threads", network_threads);
 		toml.get<unsigned> ("bootstrap_connections", bootstrap_connections);
@@ -336,6 +353,7 @@ vxlnetwork::error vxlnetwork::node_config::deserialize_toml (vxlnetwork::tomlcon
 		toml.get<bool> ("enable_voting", enable_voting);
 		toml.get<bool> ("allow_local_peers", allow_local_peers);
 		toml.get<unsigned> (signature_checker_threads_key, signature_checker_threads);
+		toml.get<unsigned> ("vote_processor_threads", vote_processor_threads);
 
 		if (toml.has_key ("lmdb"))
 		{
@@ -343,11 +361,28 @@ vxlnetwork::error vxlnetwork::node_config::deserialize_toml (vxlnetwork::tomlcon
 			lmdb_config.deserialize_toml (lmdb_config_l);
 		}
 
+		if (toml.has_key ("traffic"))
+		{
+			auto traffic_l (toml.get_required_child ("traffic"));
+			traffic.deserialize_toml (traffic_l);
+		}
+
+		if (toml.has_key ("rpc_execution"))
+		{
+			auto rpc_execution_l (toml.get_required_child ("rpc_execution"));
+			rpc_execution.deserialize_toml (rpc_execution_l);
+		}
+
 		boost::asio::ip::address_v6 external_address_l;
 		toml.get<boost::asio::ip::address_v6> ("external_address", external_address_l);
 		external_address = external_address_l.to_string ();
 		toml.get<uint16_t> ("external_port", external_port);
 		toml.get<unsigned> ("tcp_incoming_connections_max", tcp_incoming_connections_max);
+		toml.get<std::size_t> ("tcp_write_coalesce_max_bytes", tcp_write_coalesce_max_bytes);
+
+		auto tcp_write_coalesce_delay_l = tcp_write_coalesce_delay.count ();
+		toml.get ("tcp_write_coalesce_delay", tcp_write_coalesce_delay_l);
+		tcp_write_coalesce_delay = std::chrono::milliseconds (tcp_write_coalesce_delay_l);
 
 		auto pow_sleep_interval_l (pow_sleep_interval.count ());
 		toml.get (pow_sleep_interval_key, pow_sleep_interval_l);
@@ -357,11 +392,15 @@ vxlnetwork::error vxlnetwork::node_config::deserialize_toml (vxlnetwork::tomlcon
 		toml.get<std::size_t> ("active_elections_size", active_elections_size);
 		toml.get<std::size_t> ("bandwidth_limit", bandwidth_limit);
 		toml.get<double> ("bandwidth_limit_burst_ratio", bandwidth_limit_burst_ratio);
+		toml.get<std::size_t> ("network_filter_size", network_filter_size);
+		toml.get<std::size_t> ("network_filter_ways", network_filter_ways);
+		toml.get<std::size_t> ("block_cache_max_size", block_cache_max_size);
 		toml.get<bool> ("backup_before_upgrade", backup_before_upgrade);
 
 		auto conf_height_processor_batch_min_time_l (conf_height_processor_batch_min_time.count ());
 		toml.get ("conf_height_processor_batch_min_time", conf_height_processor_batch_min_time_l);
 		conf_height_processor_batch_min_time = std::chrono::milliseconds (conf_height_processor_batch_min_time_l);
+		toml.get<unsigned> ("conf_height_processor_threads", conf_height_processor_threads);
 
 		toml.get<double> ("max_work_generate_multiplier", max_work_generate_multiplier);
 
@@ -413,6 +452,10 @@ vxlnetwork::error vxlnetwork::node_config::deserialize_toml (vxlnetwork::tomlcon
 		{
 			toml.get_error ().set ("io_threads must be non-zero");
 		}
+		if (vote_processor_threads == 0)
+		{
+			toml.get_error ().set ("vote_processor_threads must be non-zero");
+		}
 		if (active_elections_size <= 250 && !network_params.network.is_dev_network ())
 		{
 			toml.get_error ().set ("active_elections_size must be greater than 250");
@@ -421,6 +464,14 @@ vxlnetwork::error vxlnetwork::node_config::deserialize_toml (vxlnetwork::tomlcon
 		{
 			toml.get_error ().set ("bandwidth_limit unbounded = 0, default = 10485760, max = 18446744073709551615");
 		}
+		if (network_filter_size == 0)
+		{
+			toml.get_error ().set ("network_filter_size must be non-zero");
+		}
+		if (network_filter_ways < 1 || network_filter_ways > vxlnetwork::network_filter::bucket_ways)
+		{
+			toml.get_error ().set (boost::str (boost::format ("network_filter_ways must be a number between 1 and %1%") % vxlnetwork::network_filter::bucket_ways));
+		}
 		if (vote_generator_threshold < 1 || vote_generator_threshold > 11)
 		{
 			toml.get_error ().set ("vote_generator_threshold must be a number between 1 and 11");
@@ -9,8 +9,12 @@
 #include <vxlnetwork/lib/stats.hpp>
 #include <vxlnetwork/node/ipc/ipc_config.hpp>
 #include <vxlnetwork/node/logging.hpp>
+#include <vxlnetwork/node/rpc_executor_config.hpp>
+#include <vxlnetwork/node/trafficconfig.hpp>
 #include <vxlnetwork/node/websocketconfig.hpp>
+#include <vxlnetwork/secure/block_cache.hpp>
 #include <vxlnetwork/secure/common.hpp>
+#include <vxlnetwork/secure/network_filter.hpp>
 
 #include <chrono>
 #include <optional>
@@ -57,10 +61,14 @@ public:
 	unsigned election_hint_weight_percent{ 10 };
 	unsigned password_fanout{ 1024 };
 	unsigned io_threads{ std::max<unsigned> (4, std::thread::hardware_concurrency ()) };
+	/** Number of single threaded io_contexts peer sockets are spread over, 0 keeps sockets on the shared io_context */
+	unsigned io_shards{ 0 };
 	unsigned network_threads{ std::max<unsigned> (4, std::thread::hardware_concurrency ()) };
 	unsigned work_threads{ std::max<unsigned> (4, std::thread::hardware_concurrency ()) };
 	/* Use half available threads on the system for signature checking. The calling thread does checks as well, so these are extra worker threads */
 	unsigned signature_checker_threads{ std::thread::hardware_concurrency () / 2 };
+	/** Number of threads verifying and applying votes, votes from one representative are always handled by the same thread */
+	unsigned vote_processor_threads{ 1 };
 	bool enable_voting{ false };
 	unsigned bootstrap_connections{ 4 };
 	unsigned bootstrap_connections_max{ 64 };
@@ -85,6 +93,14 @@ public:
 	std::size_t active_elections_size{ 5000 };
 	/** Default maximum incoming TCP connections, including realtime network & bootstrap */
 	unsigned tcp_incoming_connections_max{ 2048 };
+	/** Upper bound in bytes of queued messages gathered into a single TCP write */
+	std::size_t tcp_write_coalesce_max_bytes{ 64 * 1024 };
+	/** Time an idle socket waits for more messages before writing, 0 writes immediately */
+	std::chrono::milliseconds tcp_write_coalesce_delay{ 0 };
+	/** Scheduling weight, drop policy and queue limit of each outbound traffic class */
+	vxlnetwork::traffic_config traffic;
+	/** Threads, queue limit and queue deadline of each RPC cost class */
+	vxlnetwork::rpc_executor_config rpc_execution;
 	bool use_memory_pools{ true };
 	static std::chrono::seconds constexpr keepalive_period = std::chrono::seconds (60);
 	static std::chrono::seconds constexpr keepalive_cutoff = keepalive_period * 5;
@@ -93,7 +109,15 @@ public:
 	std::size_t bandwidth_limit{ 10 * 1024 * 1024 };
 	/** By default, allow bursts of 15MB/s (not sustainable) */
 	double bandwidth_limit_burst_ratio{ 3. };
+	/** Number of digests held by each of the publish and vote duplicate filters */
+	std::size_t network_filter_size{ 256 * 1024 };
+	/** Digests sharing a bucket in the duplicate filters, fewer ways evict sooner and let more duplicates through */
+	std::size_t network_filter_ways{ vxlnetwork::network_filter::bucket_ways };
+	/** Memory budget in bytes for deserialized blocks cached in front of the ledger store, 0 disables the cache */
+	std::size_t block_cache_max_size{ vxlnetwork::block_cache::default_max_size };
 	std::chrono::milliseconds conf_height_processor_batch_min_time{ 50 };
+	/** Number of threads walking independent account chains of a confirmation height batch in parallel, 0 or 1 walks them serially */
+	unsigned conf_height_processor_threads{ 0 };
 	bool backup_before_upgrade{ false };
 	double max_work_generate_multiplier{ 64. };
 	uint32_t max_queued_requests{ 512 };
@@ -120,6 +144,7 @@ public:
 	bool disable_lazy_bootstrap{ false };
 	bool disable_legacy_bootstrap{ false };
 	bool disable_wallet_bootstrap{ false };
+	bool enable_ascending_bootstrap{ false };
 	bool disable_bootstrap_listener{ false };
 	bool disable_bootstrap_bulk_pull_server{ false };
 	bool disable_bootstrap_bulk_push_client{ false };
@@ -152,6 +177,8 @@ public:
 	std::size_t block_processor_verification_size{ 0 };
 	std::size_t inactive_votes_cache_size{ 16 * 1024 };
 	std::size_t vote_processor_capacity{ 144 * 1024 };
+	/** Bytes, unchecked blocks are kept in memory instead of the store when non-zero */
+	std::size_t unchecked_memory_limit{ 0 };
 	std::size_t bootstrap_interval{ 0 }; // For testing only
 };
 }
@@ -1,11 +1,14 @@
+#include <vxlnetwork/node/group_commit.hpp>
 #include <vxlnetwork/node/nodeconfig.hpp>
 #include <vxlnetwork/node/online_reps.hpp>
 #include <vxlnetwork/secure/ledger.hpp>
 #include <vxlnetwork/secure/store.hpp>
 
-vxlnetwork::online_reps::online_reps (vxlnetwork::ledger & ledger_a, vxlnetwork::node_config const & config_a) :
+vxlnetwork::online_reps::online_reps (vxlnetwork::ledger & ledger_a, vxlnetwork::group_commit & group_commit_a, vxlnetwork::node_config const & config_a) :
 	ledger{ ledger_a },
-	config{ config_a }
+	group_commit{ group_commit_a },
+	config{ config_a },
+	weights_refresh_interval{ config_a.network_params.network.is_dev_network () ? 0 : 1000 }
 {
 	if (!ledger.store.init_error ())
 	{
@@ -38,20 +41,21 @@ void vxlnetwork::online_reps::sample ()
 	vxlnetwork::uint128_t online_l = online_m;
 	lock.unlock ();
 	vxlnetwork::uint128_t trend_l;
-	{
-		auto transaction (ledger.store.tx_begin_write ({ tables::online_weight }));
+	group_commit.submit (vxlnetwork::writer::online_weight, { tables::online_weight }, [this, &online_l, &trend_l] (vxlnetwork::write_transaction const & transaction_a) {
 		// Discard oldest entries
-		while (ledger.store.online_weight.count (transaction) >= config.network_params.node.max_weight_samples)
+		while (ledger.store.online_weight.count (transaction_a) >= config.network_params.node.max_weight_samples)
 		{
-			auto oldest (ledger.store.online_weight.begin (transaction));
+			auto oldest (ledger.store.online_weight.begin (transaction_a));
 			debug_assert (oldest != ledger.store.online_weight.end ());
-			ledger.store.online_weight.del (transaction, oldest->first);
+			ledger.store.online_weight.del (transaction_a, oldest->first);
 		}
-		ledger.store.online_weight.put (transaction, std::chrono::system_clock::now ().time_since_epoch ().count (), online_l);
-		trend_l = calculate_trend (transaction);
-	}
+		ledger.store.online_weight.put (transaction_a, std::chrono::system_clock::now ().time_since_epoch ().count (), online_l);
+		trend_l = calculate_trend (transaction_a);
+	})
+	.wait ();
 	lock.lock ();
 	trended_m = trend_l;
+	++weights_epoch_m;
 }
 
 vxlnetwork::uint128_t vxlnetwork::online_reps::calculate_online () const
@@ -64,7 +68,7 @@ vxlnetwork::uint128_t vxlnetwork::online_reps::calculate_online () const
 	return current;
 }
 
-vxlnetwork::uint128_t vxlnetwork::online_reps::calculate_trend (vxlnetwork::transaction & transaction_a) const
+vxlnetwork::uint128_t vxlnetwork::online_reps::calculate_trend (vxlnetwork::transaction const & transaction_a) const
 {
 	std::vector<vxlnetwork::uint128_t> items;
 	items.reserve (config.network_params.node.max_weight_samples + 1);
@@ -114,6 +118,26 @@ void vxlnetwork::online_reps::clear ()
 	vxlnetwork::lock_guard<vxlnetwork::mutex> lock (mutex);
 	reps.clear ();
 	online_m = 0;
+	++weights_epoch_m;
+}
+
+uint64_t vxlnetwork::online_reps::weights_epoch () const
+{
+	return weights_epoch_m;
+}
+
+std::shared_ptr<vxlnetwork::rep_weights::snapshot const> vxlnetwork::online_reps::weights ()
+{
+	vxlnetwork::lock_guard<vxlnetwork::mutex> lock (weights_mutex);
+	auto const version (ledger.cache.rep_weights.version ());
+	auto const now (std::chrono::steady_clock::now ());
+	if (weights_m == nullptr || (version != weights_version && now - weights_time >= weights_refresh_interval))
+	{
+		weights_m = std::make_shared<vxlnetwork::rep_weights::snapshot const> (ledger.cache.rep_weights.get_snapshot ());
+		weights_version = version;
+		weights_time = now;
+	}
+	return weights_m;
 }
 
 std::unique_ptr<vxlnetwork::container_info_component> vxlnetwork::collect_container_info (online_reps & online_reps, std::string const & name)
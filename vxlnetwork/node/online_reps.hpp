@@ -1,6 +1,7 @@
 #pragma once
 
 #include <vxlnetwork/lib/numbers.hpp>
+#include <vxlnetwork/lib/rep_weights.hpp>
 #include <vxlnetwork/lib/utility.hpp>
 #include <vxlnetwork/secure/common.hpp>
 
@@ -9,12 +10,14 @@
 #include <boost/multi_index/ordered_index.hpp>
 #include <boost/multi_index_container.hpp>
 
+#include <atomic>
 #include <memory>
 #include <unordered_set>
 #include <vector>
 
 namespace vxlnetwork
 {
+class group_commit;
 class ledger;
 class node_config;
 class transaction;
@@ -23,7 +26,7 @@ class transaction;
 class online_reps final
 {
 public:
-	online_reps (vxlnetwork::ledger & ledger_a, vxlnetwork::node_config const & config_a);
+	online_reps (vxlnetwork::ledger & ledger_a, vxlnetwork::group_commit & group_commit_a, vxlnetwork::node_config const & config_a);
 	/** Add voting account \p rep_account to the set of online representatives */
 	void observe (vxlnetwork::account const & rep_account);
 	/** Called periodically to sample online weight */
@@ -37,6 +40,13 @@ public:
 	/** List of online representatives, both the currently sampling ones and the ones observed in the previous sampling period */
 	std::vector<vxlnetwork::account> list ();
 	void clear ();
+	/** Raised every time the online weight is sampled, elections take the weights () snapshot again when it changes */
+	uint64_t weights_epoch () const;
+	/**
+	 * Representative weights elections tally with. The snapshot is shared and taken again from the ledger once weights
+	 * have changed, at most every weights_refresh_interval
+	 */
+	std::shared_ptr<vxlnetwork::rep_weights::snapshot const> weights ();
 	static unsigned constexpr online_weight_quorum = 34; //
 
 private:
@@ -52,10 +62,11 @@ private:
 	class tag_account
 	{
 	};
-	vxlnetwork::uint128_t calculate_trend (vxlnetwork::transaction &) const;
+	vxlnetwork::uint128_t calculate_trend (vxlnetwork::transaction const &) const;
 	vxlnetwork::uint128_t calculate_online () const;
 	mutable vxlnetwork::mutex mutex;
 	vxlnetwork::ledger & ledger;
+	vxlnetwork::group_commit & group_commit;
 	vxlnetwork::node_config const & config;
 	boost::multi_index_container<rep_info,
 	boost::multi_index::indexed_by<
@@ -67,6 +78,13 @@ private:
 	vxlnetwork::uint128_t trended_m;
 	vxlnetwork::uint128_t online_m;
 	vxlnetwork::uint128_t minimum;
+	std::atomic<uint64_t> weights_epoch_m{ 0 };
+	/** Guards the weights snapshot apart from the online representatives, so taking one does not block observe () */
+	vxlnetwork::mutex weights_mutex;
+	std::shared_ptr<vxlnetwork::rep_weights::snapshot const> weights_m;
+	uint64_t weights_version{ 0 };
+	std::chrono::steady_clock::time_point weights_time;
+	std::chrono::milliseconds const weights_refresh_interval;
 
 	friend class election_quorum_minimum_update_weight_before_quorum_checks_Test;
 	friend std::unique_ptr<container_info_component> collect_container_info (online_reps & online_reps, std::string const & name);
@@ -158,6 +158,11 @@ void vxlnetwork::rep_crawler::query (std::vector<std::shared_ptr<vxlnetwork::tra
 {
 	auto transaction (node.store.tx_begin_read ());
 	auto hash_root (node.ledger.hash_root_random (transaction));
+	auto const deadline (std::chrono::steady_clock::now () + std::chrono::seconds (5));
+	for (auto const & channel : channels_a)
+	{
+		queried[std::hash<vxlnetwork::endpoint> () (channel->get_endpoint ()) % queried.size ()] = deadline.time_since_epoch ().count ();
+	}
 	{
 		vxlnetwork::lock_guard<vxlnetwork::mutex> lock (active_mutex);
 		// Don't send same block multiple times in tests
@@ -183,7 +188,7 @@ void vxlnetwork::rep_crawler::query (std::vector<std::shared_ptr<vxlnetwork::tra
 
 	// A representative must respond with a vote within the deadline
 	std::weak_ptr<vxlnetwork::node> node_w (node.shared ());
-	node.workers.add_timed_task (std::chrono::steady_clock::now () + std::chrono::seconds (5), [node_w, hash = hash_root.first] () {
+	node.workers.add_timed_task (deadline, [node_w, hash = hash_root.first] () {
 		if (auto node_l = node_w.lock ())
 		{
 			auto target_finished_processed (node_l->vote_processor.total_processed + node_l->vote_processor.size ());
@@ -229,6 +234,11 @@ bool vxlnetwork::rep_crawler::is_pr (vxlnetwork::transport::channel const & chan
 	return result;
 }
 
+bool vxlnetwork::rep_crawler::is_queried (vxlnetwork::endpoint const & endpoint_a) const
+{
+	return queried[std::hash<vxlnetwork::endpoint> () (endpoint_a) % queried.size ()] >= std::chrono::steady_clock::now ().time_since_epoch ().count ();
+}
+
 bool vxlnetwork::rep_crawler::response (std::shared_ptr<vxlnetwork::transport::channel> const & channel_a, std::shared_ptr<vxlnetwork::vote> const & vote_a)
 {
 	bool error = true;
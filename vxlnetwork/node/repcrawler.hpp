@@ -11,8 +11,11 @@
 #include <boost/multi_index_container.hpp>
 #include <boost/optional.hpp>
 
+#include <array>
+#include <atomic>
 #include <chrono>
 #include <memory>
+#include <unordered_map>
 #include <unordered_set>
 
 namespace mi = boost::multi_index;
@@ -95,6 +98,9 @@ public:
 	/** Query if a peer manages a principle representative */
 	bool is_pr (vxlnetwork::transport::channel const &) const;
 
+	/** Whether a query sent to \p endpoint_a is still awaiting its response, lock free as it is asked for every duplicate vote */
+	bool is_queried (vxlnetwork::endpoint const & endpoint_a) const;
+
 	/**
 	 * Called when a non-replay vote on a block previously sent by query() is received. This indicates
 	 * with high probability that the endpoint is a representative node.
@@ -126,6 +132,12 @@ private:
 	/** We have solicted votes for these random blocks */
 	std::unordered_set<vxlnetwork::block_hash> active;
 
+	/**
+	 * Deadlines of the responses to our queries, indexed by a hash of the queried endpoint. Endpoints sharing a slot
+	 * only let through a duplicate vote, which costs a deserialization.
+	 */
+	std::array<std::atomic<std::chrono::steady_clock::rep>, 256> queried{};
+
 	// Validate responses to see if they're reps
 	void validate ();
 
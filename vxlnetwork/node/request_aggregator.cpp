@@ -173,6 +173,7 @@ std::pair<std::vector<std::shared_ptr<vxlnetwork::block>>, std::vector<std::shar
 	std::vector<std::shared_ptr<vxlnetwork::block>> to_generate;
 	std::vector<std::shared_ptr<vxlnetwork::block>> to_generate_final;
 	std::vector<std::shared_ptr<vxlnetwork::vote>> cached_votes;
+	std::vector<std::pair<vxlnetwork::block_hash, vxlnetwork::root>> uncached;
 	for (auto const & [hash, root] : requests_a)
 	{
 		// 1. Votes in cache
@@ -184,109 +185,119 @@ std::pair<std::vector<std::shared_ptr<vxlnetwork::block>>, std::vector<std::shar
 		}
 		else
 		{
-			bool generate_vote (true);
-			bool generate_final_vote (false);
-			std::shared_ptr<vxlnetwork::block> block;
+			uncached.push_back (std::make_pair (hash, root));
+		}
+	}
+	// Most remaining requests are answered from the ledger by hash, look them all up in one batch
+	std::vector<vxlnetwork::block_hash> hashes;
+	hashes.reserve (uncached.size ());
+	std::transform (uncached.begin (), uncached.end (), std::back_inserter (hashes), [] (auto const & request) { return request.first; });
+	auto const ledger_blocks (ledger.store.block.batch_get (transaction, hashes));
+	for (std::size_t i = 0; i < uncached.size (); ++i)
+	{
+		auto const & [hash, root] = uncached[i];
+		bool generate_vote (true);
+		bool generate_final_vote (false);
+		std::shared_ptr<vxlnetwork::block> block;
 
-			//2. Final votes
-			auto final_vote_hashes (ledger.store.final_vote.get (transaction, root));
-			if (!final_vote_hashes.empty ())
+		//2. Final votes
+		auto final_vote_hashes (ledger.store.final_vote.get (transaction, root));
+		if (!final_vote_hashes.empty ())
+		{
+			generate_final_vote = true;
+			block = ledger.store.block.get (transaction, final_vote_hashes[0]);
+			// Allow same root vote
+			if (block != nullptr && final_vote_hashes.size () > 1)
 			{
-				generate_final_vote = true;
-				block = ledger.store.block.get (transaction, final_vote_hashes[0]);
-				// Allow same root vote
-				if (block != nullptr && final_vote_hashes.size () > 1)
-				{
-					to_generate_final.push_back (block);
-					block = ledger.store.block.get (transaction, final_vote_hashes[1]);
-					debug_assert (final_vote_hashes.size () == 2);
-				}
+				to_generate_final.push_back (block);
+				block = ledger.store.block.get (transaction, final_vote_hashes[1]);
+				debug_assert (final_vote_hashes.size () == 2);
 			}
+		}
 
-			// 3. Election winner by hash
-			if (block == nullptr)
+		// 3. Election winner by hash
+		if (block == nullptr)
+		{
+			block = active.winner (hash);
+		}
+
+		// 4. Ledger by hash
+		if (block == nullptr)
+		{
+			block = ledger_blocks[i];
+			// Confirmation status. Generate final votes for confirmed
+			if (block != nullptr)
 			{
-				block = active.winner (hash);
+				vxlnetwork::confirmation_height_info confirmation_height_info;
+				ledger.store.confirmation_height.get (transaction, block->account ().is_zero () ? block->sideband ().account : block->account (), confirmation_height_info);
+				generate_final_vote = (confirmation_height_info.height >= block->sideband ().height);
 			}
+		}
+
+		// 5. Ledger by root
+		if (block == nullptr && !root.is_zero ())
+		{
+			// Search for block root
+			auto successor (ledger.store.block.successor (transaction, root.as_block_hash ()));
 
-			// 4. Ledger by hash
-			if (block == nullptr)
+			// Search for account root
+			if (successor.is_zero ())
 			{
-				block = ledger.store.block.get (transaction, hash);
-				// Confirmation status. Generate final votes for confirmed
-				if (block != nullptr)
+				vxlnetwork::account_info info;
+				auto error (ledger.store.account.get (transaction, root.as_account (), info));
+				if (!error)
 				{
-					vxlnetwork::confirmation_height_info confirmation_height_info;
-					ledger.store.confirmation_height.get (transaction, block->account ().is_zero () ? block->sideband ().account : block->account (), confirmation_height_info);
-					generate_final_vote = (confirmation_height_info.height >= block->sideband ().height);
+					successor = info.open_block;
 				}
 			}
-
-			// 5. Ledger by root
-			if (block == nullptr && !root.is_zero ())
+			if (!successor.is_zero ())
 			{
-				// Search for block root
-				auto successor (ledger.store.block.successor (transaction, root.as_block_hash ()));
-
-				// Search for account root
-				if (successor.is_zero ())
+				auto successor_block = ledger.store.block.get (transaction, successor);
+				debug_assert (successor_block != nullptr);
+				block = std::move (successor_block);
+				// 5. Votes in cache for successor
+				auto find_successor_votes (local_votes.votes (root, successor));
+				if (!find_successor_votes.empty ())
 				{
-					vxlnetwork::account_info info;
-					auto error (ledger.store.account.get (transaction, root.as_account (), info));
-					if (!error)
-					{
-						successor = info.open_block;
-					}
+					cached_votes.insert (cached_votes.end (), find_successor_votes.begin (), find_successor_votes.end ());
+					generate_vote = false;
 				}
-				if (!successor.is_zero ())
+				// Confirmation status. Generate final votes for confirmed successor
+				if (block != nullptr && generate_vote)
 				{
-					auto successor_block = ledger.store.block.get (transaction, successor);
-					debug_assert (successor_block != nullptr);
-					block = std::move (successor_block);
-					// 5. Votes in cache for successor
-					auto find_successor_votes (local_votes.votes (root, successor));
-					if (!find_successor_votes.empty ())
-					{
-						cached_votes.insert (cached_votes.end (), find_successor_votes.begin (), find_successor_votes.end ());
-						generate_vote = false;
-					}
-					// Confirmation status. Generate final votes for confirmed successor
-					if (block != nullptr && generate_vote)
-					{
-						vxlnetwork::confirmation_height_info confirmation_height_info;
-						ledger.store.confirmation_height.get (transaction, block->account ().is_zero () ? block->sideband ().account : block->account (), confirmation_height_info);
-						generate_final_vote = (confirmation_height_info.height >= block->sideband ().height);
-					}
+					vxlnetwork::confirmation_height_info confirmation_height_info;
+					ledger.store.confirmation_height.get (transaction, block->account ().is_zero () ? block->sideband ().account : block->account (), confirmation_height_info);
+					generate_final_vote = (confirmation_height_info.height >= block->sideband ().height);
 				}
 			}
+		}
 
-			if (block)
+		if (block)
+		{
+			// Generate new vote
+			if (generate_vote)
 			{
-				// Generate new vote
-				if (generate_vote)
+				if (generate_final_vote)
 				{
-					if (generate_final_vote)
-					{
-						to_generate_final.push_back (block);
-					}
-					else
-					{
-						to_generate.push_back (block);
-					}
+					to_generate_final.push_back (block);
 				}
-
-				// Let the node know about the alternative block
-				if (block->hash () != hash)
+				else
 				{
-					vxlnetwork::publish publish (config.network_params.network, block);
-					channel_a->send (publish);
+					to_generate.push_back (block);
 				}
 			}
-			else
+
+			// Let the node know about the alternative block
+			if (block->hash () != hash)
 			{
-				stats.inc (vxlnetwork::stat::type::requests, vxlnetwork::stat::detail::requests_unknown, stat::dir::in);
+				vxlnetwork::publish publish (config.network_params.network, block);
+				channel_a->send (publish);
 			}
 		}
+		else
+		{
+			stats.inc (vxlnetwork::stat::type::requests, vxlnetwork::stat::detail::requests_unknown, stat::dir::in);
+		}
 	}
 	// Unique votes
 	std::sort (cached_votes.begin (), cached_votes.end ());
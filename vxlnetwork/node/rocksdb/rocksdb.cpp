@@ -1,5 +1,6 @@
 #include <vxlnetwork/crypto_lib/random_pool.hpp>
 #include <vxlnetwork/lib/rocksdbconfig.hpp>
+#include <vxlnetwork/lib/stats.hpp>
 #include <vxlnetwork/node/rocksdb/rocksdb.hpp>
 #include <vxlnetwork/node/rocksdb/rocksdb_iterator.hpp>
 #include <vxlnetwork/node/rocksdb/rocksdb_txn.hpp>
@@ -12,9 +13,11 @@
 #include <rocksdb/merge_operator.h>
 #include <rocksdb/slice.h>
 #include <rocksdb/slice_transform.h>
+#include <rocksdb/sst_file_writer.h>
 #include <rocksdb/utilities/backupable_db.h>
 #include <rocksdb/utilities/transaction.h>
 #include <rocksdb/utilities/transaction_db.h>
+#include <rocksdb/write_buffer_manager.h>
 
 namespace
 {
@@ -105,6 +108,8 @@ vxlnetwork::rocksdb_store::rocksdb_store (vxlnetwork::logger_mt & logger_a, boos
 	if (!error)
 	{
 		generate_tombstone_map ();
+		block_cache = rocksdb::NewLRUCache (block_cache_size_bytes ());
+		statistics = rocksdb::CreateDBStatistics ();
 		small_table_factory.reset (rocksdb::NewBlockBasedTableFactory (get_small_table_options ()));
 		if (!open_read_only_a)
 		{
@@ -221,12 +226,14 @@ rocksdb::ColumnFamilyOptions vxlnetwork::rocksdb_store::get_cf_options (std::str
 {
 	rocksdb::ColumnFamilyOptions cf_options;
 	auto const memtable_size_bytes = base_memtable_size_bytes ();
-	auto const block_cache_size_bytes = 1024ULL * 1024 * rocksdb_config.memory_multiplier * base_block_cache_size;
 	if (cf_name_a == "unchecked")
 	{
-		std::shared_ptr<rocksdb::TableFactory> table_factory (rocksdb::NewBlockBasedTableFactory (get_active_table_options (block_cache_size_bytes * 4)));
+		std::shared_ptr<rocksdb::TableFactory> table_factory (rocksdb::NewBlockBasedTableFactory (get_active_table_options ()));
 		cf_options = get_active_cf_options (table_factory, memtable_size_bytes);
 
+		// Blocks depending on the same hash share a prefix, filters hold both prefixes and whole keys
+		cf_options.prefix_extractor.reset (rocksdb::NewFixedPrefixTransform (key_prefix_size));
+
 		// Create prefix bloom for memtable with the size of write_buffer_size * memtable_prefix_bloom_size_ratio
 		cf_options.memtable_prefix_bloom_size_ratio = 0.25;
 
@@ -238,13 +245,18 @@ rocksdb::ColumnFamilyOptions vxlnetwork::rocksdb_store::get_cf_options (std::str
 	}
 	else if (cf_name_a == "blocks")
 	{
-		std::shared_ptr<rocksdb::TableFactory> table_factory (rocksdb::NewBlockBasedTableFactory (get_active_table_options (block_cache_size_bytes * 4)));
+		// Blocks are only read by hash
+		std::shared_ptr<rocksdb::TableFactory> table_factory (rocksdb::NewBlockBasedTableFactory (get_point_lookup_table_options ()));
 		cf_options = get_active_cf_options (table_factory, blocks_memtable_size_bytes ());
+
+		// Whole key bloom in memtables, lookups of unknown blocks are common while processing
+		cf_options.memtable_whole_key_filtering = true;
+		cf_options.memtable_prefix_bloom_size_ratio = 0.02;
 	}
 	else if (cf_name_a == "confirmation_height")
 	{
 		// Entries will not be deleted in the normal case, so can make memtables a lot bigger
-		std::shared_ptr<rocksdb::TableFactory> table_factory (rocksdb::NewBlockBasedTableFactory (get_active_table_options (block_cache_size_bytes)));
+		std::shared_ptr<rocksdb::TableFactory> table_factory (rocksdb::NewBlockBasedTableFactory (get_active_table_options ()));
 		cf_options = get_active_cf_options (table_factory, memtable_size_bytes * 2);
 	}
 	else if (cf_name_a == "meta" || cf_name_a == "online_weight" || cf_name_a == "peers")
@@ -262,9 +274,13 @@ rocksdb::ColumnFamilyOptions vxlnetwork::rocksdb_store::get_cf_options (std::str
 	else if (cf_name_a == "pending")
 	{
 		// Pending can have a lot of deletions too
-		std::shared_ptr<rocksdb::TableFactory> table_factory (rocksdb::NewBlockBasedTableFactory (get_active_table_options (block_cache_size_bytes)));
+		std::shared_ptr<rocksdb::TableFactory> table_factory (rocksdb::NewBlockBasedTableFactory (get_active_table_options ()));
 		cf_options = get_active_cf_options (table_factory, memtable_size_bytes);
 
+		// Receivable entries of an account share a prefix, looking up an account without any skips files through the prefix filters
+		cf_options.prefix_extractor.reset (rocksdb::NewFixedPrefixTransform (key_prefix_size));
+		cf_options.memtable_prefix_bloom_size_ratio = 0.1;
+
 		// Number of files in level 0 which triggers compaction. Size of L0 and L1 should be kept similar as this is the only compaction which is single threaded
 		cf_options.level0_file_num_compaction_trigger = 2;
 
@@ -274,29 +290,29 @@ rocksdb::ColumnFamilyOptions vxlnetwork::rocksdb_store::get_cf_options (std::str
 	else if (cf_name_a == "frontiers")
 	{
 		// Frontiers is only needed during bootstrap for legacy blocks
-		std::shared_ptr<rocksdb::TableFactory> table_factory (rocksdb::NewBlockBasedTableFactory (get_active_table_options (block_cache_size_bytes)));
+		std::shared_ptr<rocksdb::TableFactory> table_factory (rocksdb::NewBlockBasedTableFactory (get_active_table_options ()));
 		cf_options = get_active_cf_options (table_factory, memtable_size_bytes);
 	}
 	else if (cf_name_a == "accounts")
 	{
 		// Can have deletions from rollbacks
-		std::shared_ptr<rocksdb::TableFactory> table_factory (rocksdb::NewBlockBasedTableFactory (get_active_table_options (block_cache_size_bytes * 2)));
+		std::shared_ptr<rocksdb::TableFactory> table_factory (rocksdb::NewBlockBasedTableFactory (get_active_table_options ()));
 		cf_options = get_active_cf_options (table_factory, memtable_size_bytes);
 	}
 	else if (cf_name_a == "vote")
 	{
 		// No deletes it seems, only overwrites.
-		std::shared_ptr<rocksdb::TableFactory> table_factory (rocksdb::NewBlockBasedTableFactory (get_active_table_options (block_cache_size_bytes * 2)));
+		std::shared_ptr<rocksdb::TableFactory> table_factory (rocksdb::NewBlockBasedTableFactory (get_active_table_options ()));
 		cf_options = get_active_cf_options (table_factory, memtable_size_bytes);
 	}
 	else if (cf_name_a == "pruned")
 	{
-		std::shared_ptr<rocksdb::TableFactory> table_factory (rocksdb::NewBlockBasedTableFactory (get_active_table_options (block_cache_size_bytes * 2)));
+		std::shared_ptr<rocksdb::TableFactory> table_factory (rocksdb::NewBlockBasedTableFactory (get_active_table_options ()));
 		cf_options = get_active_cf_options (table_factory, memtable_size_bytes);
 	}
 	else if (cf_name_a == "final_votes")
 	{
-		std::shared_ptr<rocksdb::TableFactory> table_factory (rocksdb::NewBlockBasedTableFactory (get_active_table_options (block_cache_size_bytes * 2)));
+		std::shared_ptr<rocksdb::TableFactory> table_factory (rocksdb::NewBlockBasedTableFactory (get_active_table_options ()));
 		cf_options = get_active_cf_options (table_factory, memtable_size_bytes);
 	}
 	else if (cf_name_a == rocksdb::kDefaultColumnFamilyName)
@@ -481,6 +497,36 @@ int vxlnetwork::rocksdb_store::get (vxlnetwork::transaction const & transaction_
 	return status.code ();
 }
 
+void vxlnetwork::rocksdb_store::batch_get (vxlnetwork::transaction const & transaction_a, tables table_a, std::vector<vxlnetwork::rocksdb_val> const & keys_a, std::vector<vxlnetwork::rocksdb_val> & values_a, std::vector<int> & statuses_a) const
+{
+	auto const count (keys_a.size ());
+	std::vector<rocksdb::Slice> keys (keys_a.begin (), keys_a.end ());
+	std::vector<rocksdb::PinnableSlice> slices (count);
+	std::vector<rocksdb::Status> statuses (count);
+	auto handle = table_to_column_family (table_a);
+	if (is_read (transaction_a))
+	{
+		db->MultiGet (snapshot_options (transaction_a), handle, count, keys.data (), slices.data (), statuses.data ());
+	}
+	else
+	{
+		// Also sees the writes pending in this transaction
+		tx (transaction_a)->MultiGet (rocksdb::ReadOptions{}, handle, count, keys.data (), slices.data (), statuses.data ());
+	}
+	values_a.assign (count, vxlnetwork::rocksdb_val{});
+	statuses_a.resize (count);
+	for (std::size_t i = 0; i < count; ++i)
+	{
+		statuses_a[i] = statuses[i].code ();
+		if (statuses[i].ok ())
+		{
+			values_a[i].buffer = std::make_shared<std::vector<uint8_t>> (slices[i].size ());
+			std::memcpy (values_a[i].buffer->data (), slices[i].data (), slices[i].size ());
+			values_a[i].convert_buffer_to_value ();
+		}
+	}
+}
+
 int vxlnetwork::rocksdb_store::put (vxlnetwork::write_transaction const & transaction_a, tables table_a, vxlnetwork::rocksdb_val const & key_a, vxlnetwork::rocksdb_val const & value_a)
 {
 	debug_assert (transaction_a.contains (table_a));
@@ -503,6 +549,18 @@ int vxlnetwork::rocksdb_store::status_code_not_found () const
 	return static_cast<int> (rocksdb::Status::Code::kNotFound);
 }
 
+uint64_t vxlnetwork::rocksdb_store::snapshot_version (vxlnetwork::transaction const & transaction_a) const
+{
+	debug_assert (is_read (transaction_a));
+	return snapshot_options (transaction_a).snapshot->GetSequenceNumber ();
+}
+
+uint64_t vxlnetwork::rocksdb_store::committed_version () const
+{
+	// Not smaller than the sequence number of any committed write, later snapshots see all of them
+	return db->GetLatestSequenceNumber ();
+}
+
 uint64_t vxlnetwork::rocksdb_store::count (vxlnetwork::transaction const & transaction_a, tables table_a) const
 {
 	uint64_t sum = 0;
@@ -663,13 +721,19 @@ rocksdb::Options vxlnetwork::rocksdb_store::get_db_options ()
 	// Not compressing any SST files for compatibility reasons.
 	db_options.compression = rocksdb::kNoCompression;
 
+	// Memtables reserve their memory in the shared block cache, which bounds the memory used by both. Flushes are still triggered per table.
+	db_options.write_buffer_manager = std::make_shared<rocksdb::WriteBufferManager> (0, block_cache);
+
+	// Tickers are exported to the node stats by export_stats
+	db_options.statistics = statistics;
+
 	auto event_listener_l = new event_listener ([this] (rocksdb::FlushJobInfo const & flush_job_info_a) { this->on_flush (flush_job_info_a); });
 	db_options.listeners.emplace_back (event_listener_l);
 
 	return db_options;
 }
 
-rocksdb::BlockBasedTableOptions vxlnetwork::rocksdb_store::get_active_table_options (std::size_t lru_size) const
+rocksdb::BlockBasedTableOptions vxlnetwork::rocksdb_store::get_active_table_options () const
 {
 	rocksdb::BlockBasedTableOptions table_options;
 
@@ -684,7 +748,7 @@ rocksdb::BlockBasedTableOptions vxlnetwork::rocksdb_store::get_active_table_opti
 	table_options.index_block_restart_interval = 16;
 
 	// Block cache for reads
-	table_options.block_cache = rocksdb::NewLRUCache (lru_size);
+	table_options.block_cache = block_cache;
 
 	// Bloom filter to help with point reads. 10bits gives 1% false positive rate.
 	table_options.filter_policy.reset (rocksdb::NewBloomFilterPolicy (10, false));
@@ -698,6 +762,20 @@ rocksdb::BlockBasedTableOptions vxlnetwork::rocksdb_store::get_active_table_opti
 	return table_options;
 }
 
+rocksdb::BlockBasedTableOptions vxlnetwork::rocksdb_store::get_point_lookup_table_options () const
+{
+	auto table_options (get_active_table_options ());
+
+	// Smaller data blocks, a lookup reads and caches less data around the requested entry
+	table_options.block_size = 4 * 1024ULL;
+
+	// Index and filter blocks compete with data blocks for the cache and are kept hot by the lookups themselves
+	table_options.cache_index_and_filter_blocks = true;
+	table_options.cache_index_and_filter_blocks_with_high_priority = true;
+
+	return table_options;
+}
+
 rocksdb::BlockBasedTableOptions vxlnetwork::rocksdb_store::get_small_table_options () const
 {
 	rocksdb::BlockBasedTableOptions table_options;
@@ -752,6 +830,67 @@ std::vector<vxlnetwork::tables> vxlnetwork::rocksdb_store::all_tables () const
 	return std::vector<vxlnetwork::tables>{ tables::accounts, tables::blocks, tables::confirmation_height, tables::final_votes, tables::frontiers, tables::meta, tables::online_weight, tables::peers, tables::pending, tables::pruned, tables::unchecked, tables::vote };
 }
 
+void vxlnetwork::rocksdb_store::raw_for_each (vxlnetwork::transaction const & transaction_a, tables table_a, std::function<void (vxlnetwork::raw_entry const &)> const & action_a) const
+{
+	std::unique_ptr<rocksdb::Iterator> cursor;
+	if (is_read (transaction_a))
+	{
+		auto read_options = snapshot_options (transaction_a);
+		read_options.fill_cache = false;
+		read_options.total_order_seek = true;
+		cursor.reset (db->NewIterator (read_options, table_to_column_family (table_a)));
+	}
+	else
+	{
+		rocksdb::ReadOptions read_options;
+		read_options.fill_cache = false;
+		read_options.total_order_seek = true;
+		cursor.reset (tx (transaction_a)->GetIterator (read_options, table_to_column_family (table_a)));
+	}
+	for (cursor->SeekToFirst (); cursor->Valid (); cursor->Next ())
+	{
+		auto const key (cursor->key ());
+		auto const value (cursor->value ());
+		action_a ({ reinterpret_cast<uint8_t const *> (key.data ()), key.size (), reinterpret_cast<uint8_t const *> (value.data ()), value.size () });
+	}
+}
+
+bool vxlnetwork::rocksdb_store::raw_bulk_load (tables table_a, std::vector<vxlnetwork::raw_entry> const & entries_a)
+{
+	if (entries_a.empty ())
+	{
+		return false;
+	}
+	// The entries are written to a sorted table file which is ingested as a whole, bypassing the memtables and write-ahead log
+	auto handle (table_to_column_family (table_a));
+	rocksdb::SstFileWriter writer (rocksdb::EnvOptions{}, rocksdb::Options{ rocksdb::DBOptions{}, get_cf_options (handle->GetName ()) }, handle);
+	// Several tables may be loaded concurrently
+	auto const file ((boost::filesystem::path (db->GetName ()) / boost::filesystem::unique_path ("ingest-%%%%-%%%%-%%%%-%%%%.sst")).string ());
+	auto status (writer.Open (file));
+	for (auto i (entries_a.begin ()), n (entries_a.end ()); i != n && status.ok (); ++i)
+	{
+		status = writer.Put (rocksdb::Slice (reinterpret_cast<char const *> (i->key), i->key_size), rocksdb::Slice (reinterpret_cast<char const *> (i->value), i->value_size));
+	}
+	if (status.ok ())
+	{
+		status = writer.Finish ();
+	}
+	if (status.ok ())
+	{
+		rocksdb::IngestExternalFileOptions options;
+		options.move_files = true;
+		status = db->IngestExternalFile (handle, { file }, options);
+	}
+	// Only left behind when the file couldn't be ingested
+	boost::system::error_code ec;
+	boost::filesystem::remove (file, ec);
+	if (!status.ok ())
+	{
+		logger.always_log ("Bulk load failed: ", status.ToString ());
+	}
+	return !status.ok ();
+}
+
 bool vxlnetwork::rocksdb_store::copy_db (boost::filesystem::path const & destination_path)
 {
 	std::unique_ptr<rocksdb::BackupEngine> backup_engine;
@@ -870,13 +1009,35 @@ void vxlnetwork::rocksdb_store::serialize_memory_stats (boost::property_tree::pt
 	db->GetAggregatedIntProperty (rocksdb::DB::Properties::kTotalSstFilesSize, &val);
 	json.put ("total-sst-files-size", val);
 
-	// Block cache capacity.
-	db->GetAggregatedIntProperty (rocksdb::DB::Properties::kBlockCacheCapacity, &val);
-	json.put ("block-cache-capacity", val);
+	// Block cache capacity. The aggregated property sums the cache over every column family, which all share this one
+	json.put ("block-cache-capacity", block_cache->GetCapacity ());
 
 	// Memory size for the entries residing in block cache.
-	db->GetAggregatedIntProperty (rocksdb::DB::Properties::kBlockCacheUsage, &val);
-	json.put ("block-cache-usage", val);
+	json.put ("block-cache-usage", block_cache->GetUsage ());
+}
+
+void vxlnetwork::rocksdb_store::export_stats (vxlnetwork::stat & stats_a)
+{
+	static std::array<std::pair<rocksdb::Tickers, vxlnetwork::stat::detail>, 11> const tickers{ {
+	{ rocksdb::BLOCK_CACHE_HIT, vxlnetwork::stat::detail::hit },
+	{ rocksdb::BLOCK_CACHE_MISS, vxlnetwork::stat::detail::miss },
+	{ rocksdb::BLOOM_FILTER_USEFUL, vxlnetwork::stat::detail::bloom_filter_useful },
+	{ rocksdb::BLOOM_FILTER_PREFIX_USEFUL, vxlnetwork::stat::detail::bloom_filter_prefix_useful },
+	{ rocksdb::MEMTABLE_HIT, vxlnetwork::stat::detail::memtable_hit },
+	{ rocksdb::MEMTABLE_MISS, vxlnetwork::stat::detail::memtable_miss },
+	{ rocksdb::BYTES_READ, vxlnetwork::stat::detail::bytes_read },
+	{ rocksdb::BYTES_WRITTEN, vxlnetwork::stat::detail::bytes_written },
+	{ rocksdb::COMPACT_READ_BYTES, vxlnetwork::stat::detail::compaction_bytes_read },
+	{ rocksdb::COMPACT_WRITE_BYTES, vxlnetwork::stat::detail::compaction_bytes_written },
+	{ rocksdb::STALL_MICROS, vxlnetwork::stat::detail::write_stall_us } } };
+	for (auto const & [ticker, detail] : tickers)
+	{
+		auto const count (statistics->getAndResetTickerCount (ticker));
+		if (count != 0)
+		{
+			stats_a.add (vxlnetwork::stat::type::rocksdb, detail, vxlnetwork::stat::dir::in, count);
+		}
+	}
 }
 
 unsigned long long vxlnetwork::rocksdb_store::blocks_memtable_size_bytes () const
@@ -889,6 +1050,18 @@ unsigned long long vxlnetwork::rocksdb_store::base_memtable_size_bytes () const
 	return 1024ULL * 1024 * rocksdb_config.memory_multiplier * base_memtable_size;
 }
 
+unsigned long long vxlnetwork::rocksdb_store::block_cache_size_bytes () const
+{
+	if (rocksdb_config.block_cache != 0)
+	{
+		return 1024ULL * 1024 * rocksdb_config.block_cache;
+	}
+	// Sum of the caches tables used to have individually, plus room for the memtables charged against it (two per table, confirmation height's twice as large)
+	auto const data_blocks (1024ULL * 1024 * rocksdb_config.memory_multiplier * base_block_cache_size * 19);
+	auto const memtables (base_memtable_size_bytes () * 2 * 10);
+	return data_blocks + memtables;
+}
+
 // This is a ratio of the blocks memtable size to keep total write transaction commit size down.
 unsigned vxlnetwork::rocksdb_store::max_block_write_batch_num () const
 {
@@ -17,10 +17,12 @@
 #include <vxlnetwork/secure/store/version_store_partial.hpp>
 #include <vxlnetwork/secure/store_partial.hpp>
 
+#include <rocksdb/cache.h>
 #include <rocksdb/db.h>
 #include <rocksdb/filter_policy.h>
 #include <rocksdb/options.h>
 #include <rocksdb/slice.h>
+#include <rocksdb/statistics.h>
 #include <rocksdb/table.h>
 #include <rocksdb/utilities/optimistic_transaction_db.h>
 #include <rocksdb/utilities/transaction.h>
@@ -83,13 +85,17 @@ public:
 
 	bool exists (vxlnetwork::transaction const & transaction_a, tables table_a, vxlnetwork::rocksdb_val const & key_a) const;
 	int get (vxlnetwork::transaction const & transaction_a, tables table_a, vxlnetwork::rocksdb_val const & key_a, vxlnetwork::rocksdb_val & value_a) const;
+	void batch_get (vxlnetwork::transaction const & transaction_a, tables table_a, std::vector<vxlnetwork::rocksdb_val> const & keys_a, std::vector<vxlnetwork::rocksdb_val> & values_a, std::vector<int> & statuses_a) const;
 	int put (vxlnetwork::write_transaction const & transaction_a, tables table_a, vxlnetwork::rocksdb_val const & key_a, vxlnetwork::rocksdb_val const & value_a);
 	int del (vxlnetwork::write_transaction const & transaction_a, tables table_a, vxlnetwork::rocksdb_val const & key_a);
 
 	void serialize_memory_stats (boost::property_tree::ptree &) override;
+	void export_stats (vxlnetwork::stat &) override;
 
 	bool copy_db (boost::filesystem::path const & destination) override;
 	void rebuild_db (vxlnetwork::write_transaction const & transaction_a) override;
+	void raw_for_each (vxlnetwork::transaction const & transaction_a, tables table_a, std::function<void (vxlnetwork::raw_entry const &)> const & action_a) const override;
+	bool raw_bulk_load (tables table_a, std::vector<vxlnetwork::raw_entry> const & entries_a) override;
 
 	unsigned max_block_write_batch_num () const override;
 
@@ -105,6 +111,13 @@ public:
 		return vxlnetwork::store_iterator<Key, Value> (std::make_unique<vxlnetwork::rocksdb_iterator<Key, Value>> (db.get (), transaction_a, table_to_column_family (table_a), &key, true));
 	}
 
+	/** Iterates the entries sharing the key prefix of \p key in tables with a prefix extractor, skipping files through their prefix filters */
+	template <typename Key, typename Value>
+	vxlnetwork::store_iterator<Key, Value> make_prefix_iterator (vxlnetwork::transaction const & transaction_a, tables table_a, vxlnetwork::rocksdb_val const & key) const
+	{
+		return vxlnetwork::store_iterator<Key, Value> (std::make_unique<vxlnetwork::rocksdb_iterator<Key, Value>> (db.get (), transaction_a, table_to_column_family (table_a), &key, true, true));
+	}
+
 	bool init_error () const override;
 
 	std::string error_string (int status) const override;
@@ -118,6 +131,9 @@ private:
 	std::unique_ptr<rocksdb::DB> db;
 	std::vector<std::unique_ptr<rocksdb::ColumnFamilyHandle>> handles;
 	std::shared_ptr<rocksdb::TableFactory> small_table_factory;
+	/** Shared by all tables, memtables are charged against it through the write buffer manager */
+	std::shared_ptr<rocksdb::Cache> block_cache;
+	std::shared_ptr<rocksdb::Statistics> statistics;
 	std::unordered_map<vxlnetwork::tables, vxlnetwork::mutex> write_lock_mutexes;
 	vxlnetwork::rocksdb_config rocksdb_config;
 	unsigned const max_block_write_batch_num_m;
@@ -139,6 +155,8 @@ private:
 	bool not_found (int status) const override;
 	bool success (int status) const override;
 	int status_code_not_found () const override;
+	uint64_t snapshot_version (vxlnetwork::transaction const & transaction_a) const override;
+	uint64_t committed_version () const override;
 	int drop (vxlnetwork::write_transaction const &, tables) override;
 
 	rocksdb::ColumnFamilyHandle * table_to_column_family (tables table_a) const;
@@ -151,7 +169,8 @@ private:
 	rocksdb::ColumnFamilyOptions get_common_cf_options (std::shared_ptr<rocksdb::TableFactory> const & table_factory_a, unsigned long long memtable_size_bytes_a) const;
 	rocksdb::ColumnFamilyOptions get_active_cf_options (std::shared_ptr<rocksdb::TableFactory> const & table_factory_a, unsigned long long memtable_size_bytes_a) const;
 	rocksdb::ColumnFamilyOptions get_small_cf_options (std::shared_ptr<rocksdb::TableFactory> const & table_factory_a) const;
-	rocksdb::BlockBasedTableOptions get_active_table_options (std::size_t lru_size) const;
+	rocksdb::BlockBasedTableOptions get_active_table_options () const;
+	rocksdb::BlockBasedTableOptions get_point_lookup_table_options () const;
 	rocksdb::BlockBasedTableOptions get_small_table_options () const;
 	rocksdb::ColumnFamilyOptions get_cf_options (std::string const & cf_name_a) const;
 
@@ -164,11 +183,15 @@ private:
 	std::vector<rocksdb::ColumnFamilyDescriptor> create_column_families ();
 	unsigned long long base_memtable_size_bytes () const;
 	unsigned long long blocks_memtable_size_bytes () const;
+	unsigned long long block_cache_size_bytes () const;
 
 	constexpr static int base_memtable_size = 16;
 	constexpr static int base_block_cache_size = 8;
+	/** Pending keys are prefixed by the receiving account and unchecked keys by their dependency */
+	constexpr static std::size_t key_prefix_size = 32;
 
 	friend class rocksdb_block_store_tombstone_count_Test;
+	friend class rocksdb_block_store_pending_prefix_Test;
 };
 
 extern template class store_partial<rocksdb::Slice, rocksdb_store>;
@@ -33,19 +33,24 @@ class rocksdb_iterator : public store_iterator_impl<T, U>
 public:
 	rocksdb_iterator () = default;
 
-	rocksdb_iterator (rocksdb::DB * db, vxlnetwork::transaction const & transaction_a, rocksdb::ColumnFamilyHandle * handle_a, rocksdb_val const * val_a, bool const direction_asc)
+	/** A \p prefix_a iterator ends after the last entry sharing the key prefix of \p val_a, others iterate in total order */
+	rocksdb_iterator (rocksdb::DB * db, vxlnetwork::transaction const & transaction_a, rocksdb::ColumnFamilyHandle * handle_a, rocksdb_val const * val_a, bool const direction_asc, bool const prefix_a = false)
 	{
 		// Don't fill the block cache for any blocks read as a result of an iterator
 		if (is_read (transaction_a))
 		{
 			auto read_options = snapshot_options (transaction_a);
 			read_options.fill_cache = false;
+			read_options.total_order_seek = !prefix_a;
+			read_options.prefix_same_as_start = prefix_a;
 			cursor.reset (db->NewIterator (read_options, handle_a));
 		}
 		else
 		{
 			rocksdb::ReadOptions ropts;
 			ropts.fill_cache = false;
+			ropts.total_order_seek = !prefix_a;
+			ropts.prefix_same_as_start = prefix_a;
 			cursor.reset (tx (transaction_a)->GetIterator (ropts, handle_a));
 		}
 
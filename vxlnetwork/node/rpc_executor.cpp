@@ -0,0 +1,225 @@
+#include <vxlnetwork/lib/stats.hpp>
+#include <vxlnetwork/lib/threading.hpp>
+#include <vxlnetwork/node/rpc_executor.hpp>
+
+#include <algorithm>
+#include <unordered_set>
+
+namespace
+{
+/** Actions whose cost grows with the size of the ledger, a wallet or the unchecked table */
+std::unordered_set<std::string> const heavy_actions{
+	"account_history",
+	"accounts_frontiers",
+	"accounts_pending",
+	"accounts_receivable",
+	"chain",
+	"confirmation_history",
+	"delegators",
+	"delegators_count",
+	"frontiers",
+	"history",
+	"ledger",
+	"representatives",
+	"representatives_online",
+	"republish",
+	"search_pending_all",
+	"search_receivable_all",
+	"stats",
+	"successors",
+	"unchecked",
+	"unchecked_keys",
+	"unopened",
+	"wallet_balances",
+	"wallet_export",
+	"wallet_frontiers",
+	"wallet_history",
+	"wallet_info",
+	"wallet_ledger",
+	"wallet_pending",
+	"wallet_receivable",
+	"wallet_republish",
+	"wallet_work_get"
+};
+
+vxlnetwork::stat::detail to_stat_detail (vxlnetwork::rpc_cost cost_a)
+{
+	return cost_a == vxlnetwork::rpc_cost::heavy ? vxlnetwork::stat::detail::heavy : vxlnetwork::stat::detail::light;
+}
+}
+
+vxlnetwork::rpc_executor::rpc_executor (vxlnetwork::rpc_executor_config const & config_a, vxlnetwork::stat & stats_a) :
+	stats{ stats_a }
+{
+	stats.define_histogram (vxlnetwork::stat::type::rpc, vxlnetwork::stat::detail::queue_wait_us, vxlnetwork::stat::dir::in, { 0, 100, 1000, 10000, 100000, 1000000 });
+	stats.define_histogram (vxlnetwork::stat::type::rpc, vxlnetwork::stat::detail::execution_us, vxlnetwork::stat::dir::in, { 0, 100, 1000, 10000, 100000, 1000000 });
+	for (std::size_t i (0); i < rpc_cost_count; ++i)
+	{
+		auto & class_l (classes[i]);
+		class_l.config = config_a[static_cast<vxlnetwork::rpc_cost> (i)];
+		for (std::size_t j (0), n (std::max<std::size_t> (class_l.config.threads, 1)); j < n; ++j)
+		{
+			class_l.threads.emplace_back ([this, &class_l] () {
+				vxlnetwork::thread_role::set (vxlnetwork::thread_role::name::rpc_executor);
+				run (class_l);
+			});
+		}
+	}
+}
+
+vxlnetwork::rpc_executor::~rpc_executor ()
+{
+	stop ();
+}
+
+vxlnetwork::rpc_cost vxlnetwork::rpc_executor::classify (std::string const & action_a)
+{
+	return heavy_actions.count (action_a) != 0 ? vxlnetwork::rpc_cost::heavy : vxlnetwork::rpc_cost::light;
+}
+
+void vxlnetwork::rpc_executor::execute (std::string const & action_a, task const & task_a, rejection const & reject_a)
+{
+	auto & class_l (classes[static_cast<std::size_t> (classify (action_a))]);
+	vxlnetwork::unique_lock<vxlnetwork::mutex> lock{ mutex };
+	if (stopped)
+	{
+		lock.unlock ();
+		reject_a ("Node is stopping");
+	}
+	else if (class_l.queue.size () >= class_l.config.max_queued)
+	{
+		lock.unlock ();
+		stats.inc (vxlnetwork::stat::type::rpc, vxlnetwork::stat::detail::overflow);
+		record (action_a, false, 0, 0);
+		reject_a ("RPC server busy, too many queued requests");
+	}
+	else
+	{
+		class_l.queue.push_back ({ action_a, task_a, reject_a, std::chrono::steady_clock::now () });
+		lock.unlock ();
+		class_l.condition.notify_one ();
+	}
+}
+
+void vxlnetwork::rpc_executor::stop ()
+{
+	std::deque<entry> rejected;
+	{
+		vxlnetwork::lock_guard<vxlnetwork::mutex> lock{ mutex };
+		if (stopped)
+		{
+			return;
+		}
+		stopped = true;
+		for (auto & class_l : classes)
+		{
+			std::move (class_l.queue.begin (), class_l.queue.end (), std::back_inserter (rejected));
+			class_l.queue.clear ();
+		}
+	}
+	for (auto & class_l : classes)
+	{
+		class_l.condition.notify_all ();
+		for (auto & thread : class_l.threads)
+		{
+			debug_assert (thread.get_id () != std::this_thread::get_id ());
+			thread.join ();
+		}
+	}
+	for (auto & entry_l : rejected)
+	{
+		entry_l.reject ("Node is stopping");
+	}
+}
+
+void vxlnetwork::rpc_executor::run (cost_class & class_a)
+{
+	vxlnetwork::unique_lock<vxlnetwork::mutex> lock{ mutex };
+	while (!stopped)
+	{
+		if (!class_a.queue.empty ())
+		{
+			auto entry_l (std::move (class_a.queue.front ()));
+			class_a.queue.pop_front ();
+			lock.unlock ();
+			auto const started (std::chrono::steady_clock::now ());
+			auto const waited (std::chrono::duration_cast<std::chrono::microseconds> (started - entry_l.queued));
+			stats.add (vxlnetwork::stat::type::rpc, vxlnetwork::stat::detail::queue_wait_us, vxlnetwork::stat::dir::in, waited.count ());
+			stats.update_histogram (vxlnetwork::stat::type::rpc, vxlnetwork::stat::detail::queue_wait_us, vxlnetwork::stat::dir::in, waited.count ());
+			if (waited <= class_a.config.queue_timeout)
+			{
+				entry_l.task ();
+				auto const elapsed (std::chrono::duration_cast<std::chrono::microseconds> (std::chrono::steady_clock::now () - started).count ());
+				stats.inc (vxlnetwork::stat::type::rpc, to_stat_detail (classify (entry_l.action)));
+				stats.add (vxlnetwork::stat::type::rpc, vxlnetwork::stat::detail::execution_us, vxlnetwork::stat::dir::in, elapsed);
+				stats.update_histogram (vxlnetwork::stat::type::rpc, vxlnetwork::stat::detail::execution_us, vxlnetwork::stat::dir::in, elapsed);
+				record (entry_l.action, true, waited.count (), elapsed);
+			}
+			else
+			{
+				stats.inc (vxlnetwork::stat::type::rpc, vxlnetwork::stat::detail::queue_timeout);
+				record (entry_l.action, false, waited.count (), 0);
+				entry_l.reject ("RPC server busy, request timed out in queue");
+			}
+			lock.lock ();
+		}
+		else
+		{
+			class_a.condition.wait (lock);
+		}
+	}
+}
+
+void vxlnetwork::rpc_executor::record (std::string const & action_a, bool executed_a, uint64_t queue_us_a, uint64_t execution_us_a)
+{
+	vxlnetwork::lock_guard<vxlnetwork::mutex> lock{ actions_mutex };
+	auto existing (actions_m.find (action_a));
+	if (existing == actions_m.end ())
+	{
+		existing = actions_m.emplace (actions_m.size () < max_tracked_actions ? action_a : "other", action_stats{}).first;
+	}
+	auto & totals (existing->second);
+	if (executed_a)
+	{
+		++totals.executed;
+		totals.execution_us += execution_us_a;
+		totals.max_execution_us = std::max (totals.max_execution_us, execution_us_a);
+	}
+	else
+	{
+		++totals.rejected;
+	}
+	totals.queue_us += queue_us_a;
+}
+
+std::size_t vxlnetwork::rpc_executor::size () const
+{
+	vxlnetwork::lock_guard<vxlnetwork::mutex> lock{ mutex };
+	std::size_t result (0);
+	for (auto const & class_l : classes)
+	{
+		result += class_l.queue.size ();
+	}
+	return result;
+}
+
+std::map<std::string, vxlnetwork::rpc_executor::action_stats> vxlnetwork::rpc_executor::actions () const
+{
+	vxlnetwork::lock_guard<vxlnetwork::mutex> lock{ actions_mutex };
+	return { actions_m.begin (), actions_m.end () };
+}
+
+std::unique_ptr<vxlnetwork::container_info_component> vxlnetwork::collect_container_info (rpc_executor & rpc_executor, std::string const & name)
+{
+	std::size_t actions_count;
+	{
+		vxlnetwork::lock_guard<vxlnetwork::mutex> lock{ rpc_executor.actions_mutex };
+		actions_count = rpc_executor.actions_m.size ();
+	}
+	auto composite = std::make_unique<vxlnetwork::container_info_composite> (name);
+	composite->add_component (std::make_unique<vxlnetwork::container_info_leaf> (container_info{ "queued", rpc_executor.size (), sizeof (vxlnetwork::rpc_executor::entry) }));
+	composite->add_component (std::make_unique<vxlnetwork::container_info_leaf> (container_info{ "actions", actions_count, sizeof (decltype (rpc_executor.actions_m)::value_type) }));
+	return composite;
+}
+
+constexpr std::size_t vxlnetwork::rpc_executor::max_tracked_actions;
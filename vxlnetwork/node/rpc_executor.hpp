@@ -0,0 +1,101 @@
+#pragma once
+
+#include <vxlnetwork/lib/locks.hpp>
+#include <vxlnetwork/lib/utility.hpp>
+#include <vxlnetwork/node/rpc_executor_config.hpp>
+
+#include <array>
+#include <chrono>
+#include <deque>
+#include <functional>
+#include <map>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace vxlnetwork
+{
+class stat;
+
+/**
+ * Executes RPC actions on dedicated threads instead of the node's I/O threads.
+ * Actions are classified by cost and every class has its own threads and queue, so a burst of expensive
+ * requests only delays other expensive requests. A request is rejected straight away when its queue is full,
+ * and instead of being executed when it waited longer than the queue timeout of its class.
+ * Actions which complete asynchronously occupy a thread only until they have been dispatched.
+ * @note This class is thread-safe.
+ */
+class rpc_executor final
+{
+public:
+	using task = std::function<void ()>;
+	/** Called with the reason when a request is not executed */
+	using rejection = std::function<void (std::string const &)>;
+
+	/** Totals for a single action, times in microseconds */
+	class action_stats final
+	{
+	public:
+		uint64_t executed{ 0 };
+		uint64_t rejected{ 0 };
+		uint64_t queue_us{ 0 };
+		uint64_t execution_us{ 0 };
+		uint64_t max_execution_us{ 0 };
+	};
+
+	rpc_executor (vxlnetwork::rpc_executor_config const &, vxlnetwork::stat &);
+	~rpc_executor ();
+
+	/** Cost class of \p action_a, actions not known to be expensive are light */
+	static vxlnetwork::rpc_cost classify (std::string const & action_a);
+
+	/**
+	 * Queues \p task_a on the threads of the cost class of \p action_a.
+	 * \p reject_a is called instead, on the calling thread, if the queue is full or the executor is stopped,
+	 * or later on an executor thread if the request waited too long.
+	 */
+	void execute (std::string const & action_a, task const & task_a, rejection const & reject_a);
+	/** Rejects queued requests and joins the threads once the executing actions return */
+	void stop ();
+	std::size_t size () const;
+	/** Snapshot of the totals per action, ordered by action name */
+	std::map<std::string, action_stats> actions () const;
+
+	/** Actions are tracked individually up to this amount, further ones are accounted as "other" */
+	static std::size_t constexpr max_tracked_actions{ 256 };
+
+private:
+	class entry final
+	{
+	public:
+		std::string action;
+		vxlnetwork::rpc_executor::task task;
+		vxlnetwork::rpc_executor::rejection reject;
+		std::chrono::steady_clock::time_point queued;
+	};
+
+	class cost_class final
+	{
+	public:
+		vxlnetwork::rpc_cost_config config;
+		std::deque<entry> queue;
+		vxlnetwork::condition_variable condition;
+		std::vector<std::thread> threads;
+	};
+
+	void run (cost_class &);
+	void record (std::string const & action_a, bool executed_a, uint64_t queue_us_a, uint64_t execution_us_a);
+
+	vxlnetwork::stat & stats;
+	std::array<cost_class, rpc_cost_count> classes;
+	bool stopped{ false };
+	mutable vxlnetwork::mutex mutex;
+	mutable vxlnetwork::mutex actions_mutex;
+	std::unordered_map<std::string, action_stats> actions_m;
+
+	friend std::unique_ptr<container_info_component> collect_container_info (rpc_executor &, std::string const &);
+};
+
+std::unique_ptr<container_info_component> collect_container_info (rpc_executor & rpc_executor, std::string const & name);
+}
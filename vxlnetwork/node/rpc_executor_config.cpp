@@ -0,0 +1,73 @@
+#include <vxlnetwork/lib/tomlconfig.hpp>
+#include <vxlnetwork/lib/utility.hpp>
+#include <vxlnetwork/node/rpc_executor_config.hpp>
+
+std::string vxlnetwork::to_string (vxlnetwork::rpc_cost cost_a)
+{
+	switch (cost_a)
+	{
+		case vxlnetwork::rpc_cost::light:
+			return "light";
+		case vxlnetwork::rpc_cost::heavy:
+			return "heavy";
+	}
+	debug_assert (false);
+	return "light";
+}
+
+vxlnetwork::rpc_executor_config::rpc_executor_config ()
+{
+	// A few expensive actions at a time are enough to keep the database busy, clients retry after a rejection
+	auto & heavy ((*this)[vxlnetwork::rpc_cost::heavy]);
+	heavy.threads = 2;
+	heavy.max_queued = 64;
+	heavy.queue_timeout = std::chrono::seconds (30);
+}
+
+vxlnetwork::rpc_cost_config const & vxlnetwork::rpc_executor_config::operator[] (vxlnetwork::rpc_cost cost_a) const
+{
+	return classes[static_cast<std::size_t> (cost_a)];
+}
+
+vxlnetwork::rpc_cost_config & vxlnetwork::rpc_executor_config::operator[] (vxlnetwork::rpc_cost cost_a)
+{
+	return classes[static_cast<std::size_t> (cost_a)];
+}
+
+vxlnetwork::error vxlnetwork::rpc_executor_config::serialize_toml (vxlnetwork::tomlconfig & toml) const
+{
+	for (std::size_t i (0); i < rpc_cost_count; ++i)
+	{
+		auto const & config (classes[i]);
+		vxlnetwork::tomlconfig class_l;
+		class_l.put ("threads", config.threads, "Number of RPC actions of this class executed concurrently.\ntype:uint64,[1..]");
+		class_l.put ("max_queued", config.max_queued, "Maximum number of RPC requests of this class waiting for a thread. Further requests are rejected with an error.\ntype:uint64");
+		class_l.put ("queue_timeout", config.queue_timeout.count (), "RPC requests of this class waiting longer than this are rejected with an error instead of being executed.\ntype:milliseconds");
+		toml.put_child (vxlnetwork::to_string (static_cast<vxlnetwork::rpc_cost> (i)), class_l);
+	}
+	return toml.get_error ();
+}
+
+vxlnetwork::error vxlnetwork::rpc_executor_config::deserialize_toml (vxlnetwork::tomlconfig & toml)
+{
+	for (std::size_t i (0); i < rpc_cost_count; ++i)
+	{
+		auto const name (vxlnetwork::to_string (static_cast<vxlnetwork::rpc_cost> (i)));
+		auto class_l (toml.get_optional_child (name));
+		if (class_l)
+		{
+			auto & config (classes[i]);
+			class_l->get_optional<std::size_t> ("threads", config.threads);
+			class_l->get_optional<std::size_t> ("max_queued", config.max_queued);
+			auto queue_timeout_l (config.queue_timeout.count ());
+			class_l->get_optional ("queue_timeout", queue_timeout_l);
+			config.queue_timeout = std::chrono::milliseconds (queue_timeout_l);
+
+			if (config.threads == 0)
+			{
+				toml.get_error ().set ("threads of RPC cost class " + name + " must be non-zero");
+			}
+		}
+	}
+	return toml.get_error ();
+}
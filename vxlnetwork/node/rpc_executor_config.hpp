@@ -0,0 +1,49 @@
+#pragma once
+
+#include <vxlnetwork/lib/errors.hpp>
+
+#include <array>
+#include <chrono>
+#include <string>
+
+namespace vxlnetwork
+{
+class tomlconfig;
+
+/** Cost class of an RPC action. Each class runs on its own threads, so expensive actions cannot starve cheap ones */
+enum class rpc_cost : uint8_t
+{
+	/** Lookups of a single account or block, conversions and node status */
+	light,
+	/** Actions iterating over the ledger, wallets or unchecked table */
+	heavy
+};
+
+std::size_t constexpr rpc_cost_count = static_cast<std::size_t> (vxlnetwork::rpc_cost::heavy) + 1;
+
+std::string to_string (vxlnetwork::rpc_cost);
+
+/** Admission settings of a single cost class */
+class rpc_cost_config final
+{
+public:
+	/** Number of actions of this class executing at the same time */
+	std::size_t threads{ 4 };
+	/** Requests waiting for a thread, further ones are rejected immediately */
+	std::size_t max_queued{ 1024 };
+	/** Requests waiting longer than this are rejected instead of executed */
+	std::chrono::milliseconds queue_timeout{ 5000 };
+};
+
+/** RPC execution pool configuration */
+class rpc_executor_config final
+{
+public:
+	rpc_executor_config ();
+	vxlnetwork::error serialize_toml (vxlnetwork::tomlconfig &) const;
+	vxlnetwork::error deserialize_toml (vxlnetwork::tomlconfig &);
+	vxlnetwork::rpc_cost_config const & operator[] (vxlnetwork::rpc_cost) const;
+	vxlnetwork::rpc_cost_config & operator[] (vxlnetwork::rpc_cost);
+	std::array<vxlnetwork::rpc_cost_config, rpc_cost_count> classes;
+};
+}
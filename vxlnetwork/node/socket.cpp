@@ -10,6 +10,7 @@
 
 #include <boost/format.hpp>
 
+#include <algorithm>
 #include <cstdint>
 #include <iterator>
 #include <limits>
@@ -36,9 +37,17 @@ bool is_temporary_error (boost::system::error_code const & ec_a)
 }
 
 vxlnetwork::socket::socket (vxlnetwork::node & node_a, endpoint_type_t endpoint_type_a) :
-	strand{ node_a.io_ctx.get_executor () },
-	tcp_socket{ node_a.io_ctx },
+	socket{ node_a, endpoint_type_a, node_a.io_shards.pick () }
+{
+	acquire_shard ();
+}
+
+vxlnetwork::socket::socket (vxlnetwork::node & node_a, endpoint_type_t endpoint_type_a, std::size_t shard_a) :
+	shard{ shard_a },
+	strand{ node_a.io_shards.context (shard).get_executor () },
+	tcp_socket{ node_a.io_shards.context (shard) },
 	node{ node_a },
+	write_timer{ node_a.io_shards.context (shard) },
 	endpoint_type_m{ endpoint_type_a },
 	timeout{ std::numeric_limits<uint64_t>::max () },
 	last_completion_time_or_init{ vxlnetwork::seconds_since_epoch () },
@@ -51,6 +60,17 @@ vxlnetwork::socket::socket (vxlnetwork::node & node_a, endpoint_type_t endpoint_
 vxlnetwork::socket::~socket ()
 {
 	close_internal ();
+	if (shard_acquired)
+	{
+		node.io_shards.release (shard);
+	}
+}
+
+void vxlnetwork::socket::acquire_shard ()
+{
+	debug_assert (!shard_acquired);
+	node.io_shards.acquire (shard);
+	shard_acquired = true;
 }
 
 void vxlnetwork::socket::async_connect (vxlnetwork::tcp_endpoint const & endpoint_a, std::function<void (boost::system::error_code const &)> callback_a)
@@ -110,7 +130,7 @@ void vxlnetwork::socket::async_read (std::shared_ptr<std::vector<uint8_t>> const
 	}
 }
 
-void vxlnetwork::socket::async_write (vxlnetwork::shared_const_buffer const & buffer_a, std::function<void (boost::system::error_code const &, std::size_t)> callback_a)
+void vxlnetwork::socket::async_write (vxlnetwork::shared_const_buffer const & buffer_a, std::function<void (boost::system::error_code const &, std::size_t)> callback_a, vxlnetwork::traffic_class traffic_a)
 {
 	if (closed)
 	{
@@ -125,10 +145,13 @@ void vxlnetwork::socket::async_write (vxlnetwork::shared_const_buffer const & bu
 	}
 
 	++queue_size;
+	++class_queue_size[static_cast<std::size_t> (traffic_a)];
 
-	boost::asio::post (strand, boost::asio::bind_executor (strand, [buffer_a, callback = std::move (callback_a), this_l = shared_from_this ()] () mutable {
+	boost::asio::post (strand, boost::asio::bind_executor (strand, [buffer_a, callback = std::move (callback_a), traffic_a, this_l = shared_from_this ()] () mutable {
 		if (this_l->closed)
 		{
+			--this_l->queue_size;
+			--this_l->class_queue_size[static_cast<std::size_t> (traffic_a)];
 			if (callback)
 			{
 				callback (boost::system::errc::make_error_code (boost::system::errc::not_supported), 0);
@@ -139,26 +162,164 @@ void vxlnetwork::socket::async_write (vxlnetwork::shared_const_buffer const & bu
 
 		this_l->set_default_timeout ();
 
-		vxlnetwork::async_write (this_l->tcp_socket, buffer_a,
-		boost::asio::bind_executor (this_l->strand,
-		[buffer_a, cbk = std::move (callback), this_l] (boost::system::error_code ec, std::size_t size_a) {
-			--this_l->queue_size;
+		this_l->send_queue_bytes += buffer_a.size ();
+		++this_l->send_queue_items;
+		this_l->send_queues[static_cast<std::size_t> (traffic_a)].push_back (queue_item{ buffer_a, std::move (callback), traffic_a });
+
+		if (this_l->writing)
+		{
+			// Picked up when the write in progress completes
+			return;
+		}
+
+		auto const & config = this_l->node.config;
+		auto const batch_full = this_l->send_queue_bytes >= config.tcp_write_coalesce_max_bytes || this_l->send_queue_items >= max_write_buffers;
+		if (this_l->write_timer_armed)
+		{
+			if (batch_full)
+			{
+				// The handler observes the cancellation and starts the write
+				this_l->write_timer.cancel ();
+			}
+		}
+		else if (batch_full || config.tcp_write_coalesce_delay.count () == 0)
+		{
+			this_l->write_queued ();
+		}
+		else
+		{
+			this_l->write_timer_armed = true;
+			this_l->write_timer.expires_after (config.tcp_write_coalesce_delay);
+			this_l->write_timer.async_wait (boost::asio::bind_executor (this_l->strand, [this_l] (boost::system::error_code const &) {
+				this_l->write_timer_armed = false;
+				this_l->write_queued ();
+			}));
+		}
+	}));
+}
+
+bool vxlnetwork::socket::max (vxlnetwork::traffic_class traffic_a) const
+{
+	return queued (traffic_a) >= node.config.traffic[traffic_a].queue_max;
+}
+
+bool vxlnetwork::socket::full (vxlnetwork::traffic_class traffic_a) const
+{
+	return queued (traffic_a) >= node.config.traffic[traffic_a].queue_max * 2;
+}
+
+void vxlnetwork::socket::write_queued ()
+{
+	if (writing || send_queue_items == 0)
+	{
+		return;
+	}
 
-			if (ec)
+	if (closed)
+	{
+		auto queues (std::move (send_queues));
+		for (auto & queue : send_queues)
+		{
+			queue.clear ();
+		}
+		send_queue_items = 0;
+		send_queue_bytes = 0;
+		for (auto & queue : queues)
+		{
+			for (auto & item : queue)
 			{
-				this_l->node.stats.inc (vxlnetwork::stat::type::tcp, vxlnetwork::stat::detail::tcp_write_error, vxlnetwork::stat::dir::in);
+				--queue_size;
+				--class_queue_size[static_cast<std::size_t> (item.traffic)];
+				if (item.callback)
+				{
+					item.callback (boost::system::errc::make_error_code (boost::system::errc::not_supported), 0);
+				}
 			}
-			else
+		}
+		return;
+	}
+
+	// Gather as many queued buffers as fit in one write, always taking at least one so oversized messages are not stuck.
+	// Classes take turns, each sending up to its weight times the quantum per turn, with unused allowance carried over while it has messages queued.
+	auto const & traffic (node.config.traffic);
+	auto items (std::make_shared<std::vector<queue_item>> ());
+	std::vector<boost::asio::const_buffer> buffers;
+	std::size_t bytes{ 0 };
+	while (send_queue_items > 0 && items->size () < max_write_buffers)
+	{
+		auto & queue (send_queues[current_class]);
+		auto & deficit (deficits[current_class]);
+		if (queue.empty ())
+		{
+			deficit = 0;
+			current_class_started = false;
+			current_class = (current_class + 1) % send_queues.size ();
+			continue;
+		}
+		if (!current_class_started)
+		{
+			deficit += quantum * std::max (traffic.classes[current_class].weight, 1u);
+			current_class_started = true;
+		}
+		auto const size (queue.front ().buffer.size ());
+		if (size > deficit)
+		{
+			current_class_started = false;
+			current_class = (current_class + 1) % send_queues.size ();
+			continue;
+		}
+		if (!items->empty () && bytes + size > node.config.tcp_write_coalesce_max_bytes)
+		{
+			break;
+		}
+		deficit -= size;
+		bytes += size;
+		auto & item (queue.front ());
+		buffers.insert (buffers.end (), item.buffer.begin (), item.buffer.end ());
+		items->push_back (std::move (item));
+		queue.pop_front ();
+		--send_queue_items;
+	}
+	send_queue_bytes -= bytes;
+	writing = true;
+
+	boost::asio::async_write (tcp_socket, buffers,
+	boost::asio::bind_executor (strand,
+	[items, this_l = shared_from_this ()] (boost::system::error_code ec, std::size_t size_a) {
+		this_l->writing = false;
+		this_l->queue_size -= items->size ();
+		for (auto const & item : *items)
+		{
+			--this_l->class_queue_size[static_cast<std::size_t> (item.traffic)];
+		}
+
+		if (ec)
+		{
+			this_l->node.stats.inc (vxlnetwork::stat::type::tcp, vxlnetwork::stat::detail::tcp_write_error, vxlnetwork::stat::dir::in);
+		}
+		else
+		{
+			this_l->node.stats.add (vxlnetwork::stat::type::traffic_tcp, vxlnetwork::stat::dir::out, size_a);
+			this_l->set_last_completion ();
+			if (items->size () > 1)
 			{
-				this_l->node.stats.add (vxlnetwork::stat::type::traffic_tcp, vxlnetwork::stat::dir::out, size_a);
-				this_l->set_last_completion ();
+				this_l->node.stats.inc (vxlnetwork::stat::type::tcp, vxlnetwork::stat::detail::tcp_write_coalesced, vxlnetwork::stat::dir::out);
+				this_l->node.stats.add (vxlnetwork::stat::type::tcp, vxlnetwork::stat::detail::tcp_write_calls_saved, vxlnetwork::stat::dir::out, items->size () - 1);
 			}
+		}
 
-			if (cbk)
+		// Buffers are written in order, so partial writes on error are attributed to the earliest items
+		for (auto & item : *items)
+		{
+			auto const written = std::min (size_a, item.buffer.size ());
+			size_a -= written;
+			if (item.callback)
 			{
-				cbk (ec, size_a);
+				item.callback (ec, written);
 			}
-		}));
+		}
+
+		this_l->write_queued ();
 	}));
 }
 
@@ -268,6 +429,7 @@ void vxlnetwork::socket::close_internal ()
 	if (!closed.exchange (true))
 	{
 		default_timeout = std::chrono::seconds (0);
+		write_timer.cancel ();
 		boost::system::error_code ec;
 
 		// Ignore error code for shutdown as it is best-effort
@@ -292,7 +454,7 @@ vxlnetwork::tcp_endpoint vxlnetwork::socket::local_endpoint () const
 }
 
 vxlnetwork::server_socket::server_socket (vxlnetwork::node & node_a, boost::asio::ip::tcp::endpoint local_a, std::size_t max_connections_a) :
-	socket{ node_a, endpoint_type_t::server },
+	socket{ node_a, endpoint_type_t::server, vxlnetwork::io_shards::none },
 	acceptor{ node_a.io_ctx },
 	local{ std::move (local_a) },
 	max_inbound_connections{ max_connections_a }
@@ -404,8 +566,8 @@ void vxlnetwork::server_socket::on_connection (std::function<bool (std::shared_p
 			return;
 		}
 
-		// Prepare new connection
-		auto new_connection = std::make_shared<vxlnetwork::socket> (this_l->node, endpoint_type_t::server);
+		// Prepare new connection, it runs on the least loaded shard but is only counted there once accepted
+		std::shared_ptr<vxlnetwork::socket> new_connection (new vxlnetwork::socket (this_l->node, endpoint_type_t::server, this_l->node.io_shards.pick ()));
 		this_l->acceptor.async_accept (new_connection->tcp_socket, new_connection->remote,
 		boost::asio::bind_executor (this_l->strand,
 		[this_l, new_connection, cbk = std::move (callback)] (boost::system::error_code const & ec_a) mutable {
@@ -450,6 +612,7 @@ void vxlnetwork::server_socket::on_connection (std::function<bool (std::shared_p
 			{
 				// Make sure the new connection doesn't idle. Note that in most cases, the callback is going to start
 				// an IO operation immediately, which will start a timer.
+				new_connection->acquire_shard ();
 				new_connection->checkup ();
 				new_connection->set_timeout (this_l->node.network_params.network.idle_timeout);
 				this_l->node.stats.inc (vxlnetwork::stat::type::tcp, vxlnetwork::stat::detail::tcp_accept_success, vxlnetwork::stat::dir::in);
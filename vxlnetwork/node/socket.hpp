@@ -1,11 +1,14 @@
 #pragma once
 
 #include <vxlnetwork/boost/asio/ip/tcp.hpp>
+#include <vxlnetwork/boost/asio/steady_timer.hpp>
 #include <vxlnetwork/boost/asio/strand.hpp>
 #include <vxlnetwork/lib/asio.hpp>
+#include <vxlnetwork/node/trafficconfig.hpp>
 
 #include <boost/optional.hpp>
 
+#include <array>
 #include <chrono>
 #include <deque>
 #include <map>
@@ -19,17 +22,6 @@ class network_v6;
 
 namespace vxlnetwork
 {
-/** Policy to affect at which stage a buffer can be dropped */
-enum class buffer_drop_policy
-{
-	/** Can be dropped by bandwidth limiter (default) */
-	limiter,
-	/** Should not be dropped by bandwidth limiter */
-	no_limiter_drop,
-	/** Should not be dropped by bandwidth limiter or socket write queue limiter */
-	no_socket_drop
-};
-
 class node;
 class server_socket;
 
@@ -54,7 +46,7 @@ public:
 	};
 
 	/**
-	 * Constructor
+	 * Constructor, the socket is assigned to the least loaded io shard
 	 * @param node Owning node
 	 * @param endpoint_type_a The endpoint's type: either server or client
 	 */
@@ -62,7 +54,12 @@ public:
 	virtual ~socket ();
 	void async_connect (boost::asio::ip::tcp::endpoint const &, std::function<void (boost::system::error_code const &)>);
 	void async_read (std::shared_ptr<std::vector<uint8_t>> const &, std::size_t, std::function<void (boost::system::error_code const &, std::size_t)>);
-	void async_write (vxlnetwork::shared_const_buffer const &, std::function<void (boost::system::error_code const &, std::size_t)> = {});
+	/**
+	 * Queues a buffer for writing. Buffers queued while a write is in progress are sent together in a single vectored write.
+	 * Each traffic class has its own queue, queues are drained by deficit round robin according to node_config::traffic weights.
+	 * The callback is called once the buffer is written, with the number of bytes of this buffer that were written.
+	 */
+	void async_write (vxlnetwork::shared_const_buffer const &, std::function<void (boost::system::error_code const &, std::size_t)> = {}, vxlnetwork::traffic_class = vxlnetwork::traffic_class::generic);
 
 	void close ();
 	boost::asio::ip::tcp::endpoint remote_endpoint () const;
@@ -81,6 +78,14 @@ public:
 	{
 		return queue_size >= queue_size_max * 2;
 	}
+	/** Whether the queue of \p traffic_a reached its configured queue_max */
+	bool max (vxlnetwork::traffic_class traffic_a) const;
+	/** Whether the queue of \p traffic_a reached twice its configured queue_max */
+	bool full (vxlnetwork::traffic_class traffic_a) const;
+	std::size_t queued (vxlnetwork::traffic_class traffic_a) const
+	{
+		return class_queue_size[static_cast<std::size_t> (traffic_a)];
+	}
 	type_t type () const
 	{
 		return type_m;
@@ -109,12 +114,37 @@ protected:
 	public:
 		vxlnetwork::shared_const_buffer buffer;
 		std::function<void (boost::system::error_code const &, std::size_t)> callback;
+		vxlnetwork::traffic_class traffic;
 	};
 
+	/**
+	 * Runs the socket on the context of \p shard_a, io_shards::none for the shared one.
+	 * The shard only counts the socket once acquire_shard is called.
+	 */
+	socket (vxlnetwork::node & node, endpoint_type_t endpoint_type_a, std::size_t shard_a);
+	/** Counts this socket in its io shard, called once a pending connection is accepted */
+	void acquire_shard ();
+
+	/** The io_shards shard whose context runs all handlers of this socket */
+	std::size_t const shard;
+	bool shard_acquired{ false };
 	boost::asio::strand<boost::asio::io_context::executor_type> strand;
 	boost::asio::ip::tcp::socket tcp_socket;
 	vxlnetwork::node & node;
 
+	/** Buffers waiting for the current write to complete per traffic class, only accessed from the strand */
+	std::array<std::deque<queue_item>, vxlnetwork::traffic_class_count> send_queues;
+	std::size_t send_queue_items{ 0 };
+	std::size_t send_queue_bytes{ 0 };
+	/** Deficit round robin state, the class being served and the bytes each class may still send in its turn */
+	std::size_t current_class{ 0 };
+	bool current_class_started{ false };
+	std::array<std::size_t, vxlnetwork::traffic_class_count> deficits{};
+	bool writing{ false };
+	/** Delays a write to gather more buffers, see node_config::tcp_write_coalesce_delay */
+	boost::asio::steady_timer write_timer;
+	bool write_timer_armed{ false };
+
 	/** The other end of the connection */
 	boost::asio::ip::tcp::endpoint remote;
 
@@ -151,11 +181,15 @@ protected:
 	 *  socket buffer queue -> TCP send queue -> (network) -> TCP receive queue of peer
 	 */
 	std::atomic<std::size_t> queue_size{ 0 };
+	/** Same as queue_size, per traffic class */
+	std::array<std::atomic<std::size_t>, vxlnetwork::traffic_class_count> class_queue_size{};
 
 	/** Set by close() - completion handlers must check this. This is more reliable than checking
 	 error codes as the OS may have already completed the async operation. */
 	std::atomic<bool> closed{ false };
 	void close_internal ();
+	/** Starts a write of the queued buffers unless one is in progress, must be called from the strand */
+	void write_queued ();
 	void set_default_timeout ();
 	void set_last_completion ();
 	void set_last_receive_time ();
@@ -167,6 +201,10 @@ private:
 
 public:
 	static std::size_t constexpr queue_size_max = 128;
+	/** Upper bound of buffers gathered in one write, larger sequences would be split over several system calls by asio anyway */
+	static std::size_t constexpr max_write_buffers = 64;
+	/** Bytes a traffic class may send per round for each unit of weight */
+	static std::size_t constexpr quantum = 512;
 };
 
 using address_socket_mmap = std::multimap<boost::asio::ip::address, std::weak_ptr<socket>>;
@@ -0,0 +1,136 @@
+#include <vxlnetwork/lib/tomlconfig.hpp>
+#include <vxlnetwork/lib/utility.hpp>
+#include <vxlnetwork/node/trafficconfig.hpp>
+
+namespace
+{
+std::string drop_policy_to_string (vxlnetwork::buffer_drop_policy policy_a)
+{
+	switch (policy_a)
+	{
+		case vxlnetwork::buffer_drop_policy::limiter:
+			return "limiter";
+		case vxlnetwork::buffer_drop_policy::no_limiter_drop:
+			return "no_limiter_drop";
+		case vxlnetwork::buffer_drop_policy::no_socket_drop:
+			return "no_socket_drop";
+	}
+	debug_assert (false);
+	return "limiter";
+}
+}
+
+std::string vxlnetwork::to_string (vxlnetwork::traffic_class traffic_a)
+{
+	switch (traffic_a)
+	{
+		case vxlnetwork::traffic_class::vote:
+			return "vote";
+		case vxlnetwork::traffic_class::confirm_req:
+			return "confirm_req";
+		case vxlnetwork::traffic_class::publish:
+			return "publish";
+		case vxlnetwork::traffic_class::bootstrap:
+			return "bootstrap";
+		case vxlnetwork::traffic_class::telemetry:
+			return "telemetry";
+		case vxlnetwork::traffic_class::generic:
+			return "generic";
+	}
+	debug_assert (false);
+	return "generic";
+}
+
+vxlnetwork::stat::detail vxlnetwork::to_stat_detail (vxlnetwork::traffic_class traffic_a)
+{
+	switch (traffic_a)
+	{
+		case vxlnetwork::traffic_class::vote:
+			return vxlnetwork::stat::detail::vote;
+		case vxlnetwork::traffic_class::confirm_req:
+			return vxlnetwork::stat::detail::confirm_req;
+		case vxlnetwork::traffic_class::publish:
+			return vxlnetwork::stat::detail::publish;
+		case vxlnetwork::traffic_class::bootstrap:
+			return vxlnetwork::stat::detail::bootstrap;
+		case vxlnetwork::traffic_class::telemetry:
+			return vxlnetwork::stat::detail::telemetry;
+		case vxlnetwork::traffic_class::generic:
+			return vxlnetwork::stat::detail::generic;
+	}
+	debug_assert (false);
+	return vxlnetwork::stat::detail::generic;
+}
+
+vxlnetwork::traffic_config::traffic_config ()
+{
+	// Votes decide how quickly elections confirm, followed by the requests and blocks they depend on
+	(*this)[vxlnetwork::traffic_class::vote].weight = 8;
+	(*this)[vxlnetwork::traffic_class::confirm_req].weight = 4;
+	(*this)[vxlnetwork::traffic_class::publish].weight = 4;
+	(*this)[vxlnetwork::traffic_class::generic].weight = 2;
+}
+
+vxlnetwork::traffic_class_config const & vxlnetwork::traffic_config::operator[] (vxlnetwork::traffic_class traffic_a) const
+{
+	return classes[static_cast<std::size_t> (traffic_a)];
+}
+
+vxlnetwork::traffic_class_config & vxlnetwork::traffic_config::operator[] (vxlnetwork::traffic_class traffic_a)
+{
+	return classes[static_cast<std::size_t> (traffic_a)];
+}
+
+vxlnetwork::error vxlnetwork::traffic_config::serialize_toml (vxlnetwork::tomlconfig & toml) const
+{
+	for (std::size_t i (0); i < traffic_class_count; ++i)
+	{
+		auto const & config (classes[i]);
+		vxlnetwork::tomlconfig class_l;
+		class_l.put ("weight", config.weight, "Share of a peer connection's outbound bandwidth given to this class while other classes also have messages waiting.\ntype:uint32,[1..]");
+		class_l.put ("drop_policy", drop_policy_to_string (config.drop_policy), "Least strict drop policy for messages of this class. no_limiter_drop exempts them from the bandwidth limit, no_socket_drop also allows them to exceed queue_max.\ntype:string,{limiter, no_limiter_drop, no_socket_drop}");
+		class_l.put ("queue_max", config.queue_max, "Maximum number of messages of this class waiting to be written to a peer connection.\ntype:uint64");
+		toml.put_child (vxlnetwork::to_string (static_cast<vxlnetwork::traffic_class> (i)), class_l);
+	}
+	return toml.get_error ();
+}
+
+vxlnetwork::error vxlnetwork::traffic_config::deserialize_toml (vxlnetwork::tomlconfig & toml)
+{
+	for (std::size_t i (0); i < traffic_class_count; ++i)
+	{
+		auto const name (vxlnetwork::to_string (static_cast<vxlnetwork::traffic_class> (i)));
+		auto class_l (toml.get_optional_child (name));
+		if (class_l)
+		{
+			auto & config (classes[i]);
+			class_l->get_optional<unsigned> ("weight", config.weight);
+			class_l->get_optional<std::size_t> ("queue_max", config.queue_max);
+
+			auto drop_policy_l (drop_policy_to_string (config.drop_policy));
+			class_l->get_optional<std::string> ("drop_policy", drop_policy_l);
+			if (drop_policy_l == "limiter")
+			{
+				config.drop_policy = vxlnetwork::buffer_drop_policy::limiter;
+			}
+			else if (drop_policy_l == "no_limiter_drop")
+			{
+				config.drop_policy = vxlnetwork::buffer_drop_policy::no_limiter_drop;
+			}
+			else if (drop_policy_l == "no_socket_drop")
+			{
+				config.drop_policy = vxlnetwork::buffer_drop_policy::no_socket_drop;
+			}
+			else
+			{
+				toml.get_error ().set (drop_policy_l + " is not a valid drop policy for traffic class " + name);
+			}
+
+			if (config.weight == 0)
+			{
+				toml.get_error ().set ("weight of traffic class " + name + " must be non-zero");
+			}
+		}
+	}
+	return toml.get_error ();
+}
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <vxlnetwork/lib/errors.hpp>
+#include <vxlnetwork/lib/stats.hpp>
+
+#include <array>
+#include <string>
+
+namespace vxlnetwork
+{
+class tomlconfig;
+
+/** Policy to affect at which stage a buffer can be dropped */
+enum class buffer_drop_policy
+{
+	/** Can be dropped by bandwidth limiter (default) */
+	limiter,
+	/** Should not be dropped by bandwidth limiter */
+	no_limiter_drop,
+	/** Should not be dropped by bandwidth limiter or socket write queue limiter */
+	no_socket_drop
+};
+
+/** Outbound message classes, each queued separately on a socket and scheduled by weight */
+enum class traffic_class : uint8_t
+{
+	vote,
+	confirm_req,
+	publish,
+	bootstrap,
+	telemetry,
+	/** Keepalives, handshakes and raw buffers */
+	generic
+};
+
+std::size_t constexpr traffic_class_count = static_cast<std::size_t> (vxlnetwork::traffic_class::generic) + 1;
+
+std::string to_string (vxlnetwork::traffic_class);
+vxlnetwork::stat::detail to_stat_detail (vxlnetwork::traffic_class);
+
+/** Outbound settings of a single traffic class */
+class traffic_class_config final
+{
+public:
+	/** Relative share of a channel's outbound bandwidth while other classes also have messages queued */
+	unsigned weight{ 1 };
+	/** Messages are never dropped more eagerly than this, a stricter policy requested by the sender still applies */
+	vxlnetwork::buffer_drop_policy drop_policy{ vxlnetwork::buffer_drop_policy::limiter };
+	/** Number of messages of this class queued on a socket before further ones are dropped, doubled for no_socket_drop */
+	std::size_t queue_max{ 128 };
+};
+
+/** Outbound traffic classes configuration */
+class traffic_config final
+{
+public:
+	traffic_config ();
+	vxlnetwork::error serialize_toml (vxlnetwork::tomlconfig &) const;
+	vxlnetwork::error deserialize_toml (vxlnetwork::tomlconfig &);
+	vxlnetwork::traffic_class_config const & operator[] (vxlnetwork::traffic_class) const;
+	vxlnetwork::traffic_class_config & operator[] (vxlnetwork::traffic_class);
+	std::array<vxlnetwork::traffic_class_config, traffic_class_count> classes;
+};
+}
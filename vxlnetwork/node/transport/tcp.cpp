@@ -40,11 +40,11 @@ bool vxlnetwork::transport::channel_tcp::operator== (vxlnetwork::transport::chan
 	return result;
 }
 
-void vxlnetwork::transport::channel_tcp::send_buffer (vxlnetwork::shared_const_buffer const & buffer_a, std::function<void (boost::system::error_code const &, std::size_t)> const & callback_a, vxlnetwork::buffer_drop_policy policy_a)
+void vxlnetwork::transport::channel_tcp::send_buffer (vxlnetwork::shared_const_buffer const & buffer_a, std::function<void (boost::system::error_code const &, std::size_t)> const & callback_a, vxlnetwork::buffer_drop_policy policy_a, vxlnetwork::traffic_class traffic_a)
 {
 	if (auto socket_l = socket.lock ())
 	{
-		if (!socket_l->max () || (policy_a == vxlnetwork::buffer_drop_policy::no_socket_drop && !socket_l->full ()))
+		if (!socket_l->max (traffic_a) || (policy_a == vxlnetwork::buffer_drop_policy::no_socket_drop && !socket_l->full (traffic_a)))
 		{
 			socket_l->async_write (
 			buffer_a, [endpoint_a = socket_l->remote_endpoint (), node = std::weak_ptr<vxlnetwork::node> (node.shared ()), callback_a] (boost::system::error_code const & ec, std::size_t size_a) {
@@ -63,7 +63,8 @@ void vxlnetwork::transport::channel_tcp::send_buffer (vxlnetwork::shared_const_b
 						callback_a (ec, size_a);
 					}
 				}
-			});
+			},
+			traffic_a);
 		}
 		else
 		{
@@ -75,6 +76,7 @@ void vxlnetwork::transport::channel_tcp::send_buffer (vxlnetwork::shared_const_b
 			{
 				node.stats.inc (vxlnetwork::stat::type::tcp, vxlnetwork::stat::detail::tcp_write_drop, vxlnetwork::stat::dir::out);
 			}
+			node.stats.inc (vxlnetwork::stat::type::traffic_drop, vxlnetwork::to_stat_detail (traffic_a), vxlnetwork::stat::dir::out);
 			if (callback_a)
 			{
 				callback_a (boost::system::errc::make_error_code (boost::system::errc::no_buffer_space), 0);
@@ -223,15 +225,17 @@ bool vxlnetwork::transport::tcp_channels::store_all (bool clear_peers)
 	if (!endpoints.empty ())
 	{
 		// Clear all peers then refresh with the current list of peers
-		auto transaction (node.store.tx_begin_write ({ tables::peers }));
-		if (clear_peers)
-		{
-			node.store.peer.clear (transaction);
-		}
-		for (auto const & endpoint : endpoints)
-		{
-			node.store.peer.put (transaction, vxlnetwork::endpoint_key{ endpoint.address ().to_v6 ().to_bytes (), endpoint.port () });
-		}
+		node.group_commit.submit (vxlnetwork::writer::peers, { tables::peers }, [this, clear_peers, &endpoints] (vxlnetwork::write_transaction const & transaction_a) {
+			if (clear_peers)
+			{
+				node.store.peer.clear (transaction_a);
+			}
+			for (auto const & endpoint : endpoints)
+			{
+				node.store.peer.put (transaction_a, vxlnetwork::endpoint_key{ endpoint.address ().to_v6 ().to_bytes (), endpoint.port () });
+			}
+		})
+		.wait ();
 		result = true;
 	}
 	return result;
@@ -427,15 +431,30 @@ std::unique_ptr<vxlnetwork::container_info_component> vxlnetwork::transport::tcp
 	std::size_t channels_count;
 	std::size_t attemps_count;
 	std::size_t node_id_handshake_sockets_count;
+	std::array<std::size_t, vxlnetwork::traffic_class_count> queued{};
 	{
 		vxlnetwork::lock_guard<vxlnetwork::mutex> guard (mutex);
 		channels_count = channels.size ();
 		attemps_count = attempts.size ();
+		for (auto const & channel : channels)
+		{
+			for (std::size_t i (0); i < vxlnetwork::traffic_class_count; ++i)
+			{
+				queued[i] += channel.socket->queued (static_cast<vxlnetwork::traffic_class> (i));
+			}
+		}
 	}
 
 	auto composite = std::make_unique<container_info_composite> (name);
 	composite->add_component (std::make_unique<container_info_leaf> (container_info{ "channels", channels_count, sizeof (decltype (channels)::value_type) }));
 	composite->add_component (std::make_unique<container_info_leaf> (container_info{ "attempts", attemps_count, sizeof (decltype (attempts)::value_type) }));
+	// Writes waiting in the socket queues of all channels, per traffic class
+	auto queued_composite = std::make_unique<container_info_composite> ("queued");
+	for (std::size_t i (0); i < vxlnetwork::traffic_class_count; ++i)
+	{
+		queued_composite->add_component (std::make_unique<container_info_leaf> (container_info{ vxlnetwork::to_string (static_cast<vxlnetwork::traffic_class> (i)), queued[i], sizeof (vxlnetwork::shared_const_buffer) }));
+	}
+	composite->add_component (std::move (queued_composite));
 
 	return composite;
 }
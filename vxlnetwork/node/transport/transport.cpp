@@ -17,48 +17,60 @@ public:
 	void keepalive (vxlnetwork::keepalive const & message_a) override
 	{
 		result = vxlnetwork::stat::detail::keepalive;
+		traffic = vxlnetwork::traffic_class::generic;
 	}
 	void publish (vxlnetwork::publish const & message_a) override
 	{
 		result = vxlnetwork::stat::detail::publish;
+		traffic = vxlnetwork::traffic_class::publish;
 	}
 	void confirm_req (vxlnetwork::confirm_req const & message_a) override
 	{
 		result = vxlnetwork::stat::detail::confirm_req;
+		traffic = vxlnetwork::traffic_class::confirm_req;
 	}
 	void confirm_ack (vxlnetwork::confirm_ack const & message_a) override
 	{
 		result = vxlnetwork::stat::detail::confirm_ack;
+		traffic = vxlnetwork::traffic_class::vote;
 	}
 	void bulk_pull (vxlnetwork::bulk_pull const & message_a) override
 	{
 		result = vxlnetwork::stat::detail::bulk_pull;
+		traffic = vxlnetwork::traffic_class::bootstrap;
 	}
 	void bulk_pull_account (vxlnetwork::bulk_pull_account const & message_a) override
 	{
 		result = vxlnetwork::stat::detail::bulk_pull_account;
+		traffic = vxlnetwork::traffic_class::bootstrap;
 	}
 	void bulk_push (vxlnetwork::bulk_push const & message_a) override
 	{
 		result = vxlnetwork::stat::detail::bulk_push;
+		traffic = vxlnetwork::traffic_class::bootstrap;
 	}
 	void frontier_req (vxlnetwork::frontier_req const & message_a) override
 	{
 		result = vxlnetwork::stat::detail::frontier_req;
+		traffic = vxlnetwork::traffic_class::bootstrap;
 	}
 	void node_id_handshake (vxlnetwork::node_id_handshake const & message_a) override
 	{
 		result = vxlnetwork::stat::detail::node_id_handshake;
+		traffic = vxlnetwork::traffic_class::generic;
 	}
 	void telemetry_req (vxlnetwork::telemetry_req const & message_a) override
 	{
 		result = vxlnetwork::stat::detail::telemetry_req;
+		traffic = vxlnetwork::traffic_class::telemetry;
 	}
 	void telemetry_ack (vxlnetwork::telemetry_ack const & message_a) override
 	{
 		result = vxlnetwork::stat::detail::telemetry_ack;
+		traffic = vxlnetwork::traffic_class::telemetry;
 	}
 	vxlnetwork::stat::detail result;
+	vxlnetwork::traffic_class traffic;
 };
 }
 
@@ -103,17 +115,31 @@ vxlnetwork::transport::channel::channel (vxlnetwork::node & node_a) :
 	set_network_version (node_a.network_params.network.protocol_version);
 }
 
-void vxlnetwork::transport::channel::send (vxlnetwork::message & message_a, std::function<void (boost::system::error_code const &, std::size_t)> const & callback_a, vxlnetwork::buffer_drop_policy drop_policy_a)
+vxlnetwork::transport::shared_message::shared_message (vxlnetwork::message const & message_a) :
+	buffer (message_a.to_shared_const_buffer ())
 {
 	callback_visitor visitor;
 	message_a.visit (visitor);
-	auto buffer (message_a.to_shared_const_buffer ());
-	auto detail (visitor.result);
-	auto is_droppable_by_limiter = drop_policy_a == vxlnetwork::buffer_drop_policy::limiter;
+	detail = visitor.result;
+	traffic = visitor.traffic;
+}
+
+void vxlnetwork::transport::channel::send (vxlnetwork::message & message_a, std::function<void (boost::system::error_code const &, std::size_t)> const & callback_a, vxlnetwork::buffer_drop_policy drop_policy_a)
+{
+	send (vxlnetwork::transport::shared_message{ message_a }, callback_a, drop_policy_a);
+}
+
+void vxlnetwork::transport::channel::send (vxlnetwork::transport::shared_message const & message_a, std::function<void (boost::system::error_code const &, std::size_t)> const & callback_a, vxlnetwork::buffer_drop_policy drop_policy_a)
+{
+	auto const & buffer (message_a.buffer);
+	auto detail (message_a.detail);
+	// The traffic class can relax the drop policy requested by the sender, never tighten it
+	auto const drop_policy_l (std::max (drop_policy_a, node.config.traffic[message_a.traffic].drop_policy));
+	auto is_droppable_by_limiter = drop_policy_l == vxlnetwork::buffer_drop_policy::limiter;
 	auto should_drop (node.network.limiter.should_drop (buffer.size ()));
 	if (!is_droppable_by_limiter || !should_drop)
 	{
-		send_buffer (buffer, callback_a, drop_policy_a);
+		send_buffer (buffer, callback_a, drop_policy_l, message_a.traffic);
 		node.stats.inc (vxlnetwork::stat::type::message, detail, vxlnetwork::stat::dir::out);
 	}
 	else
@@ -126,6 +152,7 @@ void vxlnetwork::transport::channel::send (vxlnetwork::message & message_a, std:
 		}
 
 		node.stats.inc (vxlnetwork::stat::type::drop, detail, vxlnetwork::stat::dir::out);
+		node.stats.inc (vxlnetwork::stat::type::traffic_drop, vxlnetwork::to_stat_detail (message_a.traffic), vxlnetwork::stat::dir::out);
 		if (node.config.logging.network_packet_logging ())
 		{
 			node.logger.always_log (boost::str (boost::format ("%1% of size %2% dropped") % node.stats.detail_to_string (detail) % buffer.size ()));
@@ -151,7 +178,7 @@ bool vxlnetwork::transport::channel_loopback::operator== (vxlnetwork::transport:
 	return endpoint == other_a.get_endpoint ();
 }
 
-void vxlnetwork::transport::channel_loopback::send_buffer (vxlnetwork::shared_const_buffer const & buffer_a, std::function<void (boost::system::error_code const &, std::size_t)> const & callback_a, vxlnetwork::buffer_drop_policy drop_policy_a)
+void vxlnetwork::transport::channel_loopback::send_buffer (vxlnetwork::shared_const_buffer const & buffer_a, std::function<void (boost::system::error_code const &, std::size_t)> const & callback_a, vxlnetwork::buffer_drop_policy drop_policy_a, vxlnetwork::traffic_class traffic_a)
 {
 	release_assert (false && "sending to a loopback channel is not supported");
 }
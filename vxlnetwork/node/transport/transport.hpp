@@ -43,6 +43,18 @@ namespace transport
 		tcp = 2,
 		loopback = 3
 	};
+	/**
+	 * A message serialized once into an immutable reference counted buffer, so it can be sent to any number of channels without serializing it again
+	 */
+	class shared_message final
+	{
+	public:
+		explicit shared_message (vxlnetwork::message const &);
+		vxlnetwork::shared_const_buffer buffer;
+		/** Message type used for the message and drop stats */
+		vxlnetwork::stat::detail detail;
+		vxlnetwork::traffic_class traffic;
+	};
 	class channel
 	{
 	public:
@@ -51,9 +63,11 @@ namespace transport
 		virtual std::size_t hash_code () const = 0;
 		virtual bool operator== (vxlnetwork::transport::channel const &) const = 0;
 		void send (vxlnetwork::message & message_a, std::function<void (boost::system::error_code const &, std::size_t)> const & callback_a = nullptr, vxlnetwork::buffer_drop_policy policy_a = vxlnetwork::buffer_drop_policy::limiter);
+		/** Sends an already serialized message, the bandwidth limiter is consulted for every channel as with send (message) */
+		void send (vxlnetwork::transport::shared_message const & message_a, std::function<void (boost::system::error_code const &, std::size_t)> const & callback_a = nullptr, vxlnetwork::buffer_drop_policy policy_a = vxlnetwork::buffer_drop_policy::limiter);
 		// TODO: investigate clang-tidy warning about default parameters on virtual/override functions
 		//
-		virtual void send_buffer (vxlnetwork::shared_const_buffer const &, std::function<void (boost::system::error_code const &, std::size_t)> const & = nullptr, vxlnetwork::buffer_drop_policy = vxlnetwork::buffer_drop_policy::limiter) = 0;
+		virtual void send_buffer (vxlnetwork::shared_const_buffer const &, std::function<void (boost::system::error_code const &, std::size_t)> const & = nullptr, vxlnetwork::buffer_drop_policy = vxlnetwork::buffer_drop_policy::limiter, vxlnetwork::traffic_class = vxlnetwork::traffic_class::generic) = 0;
 		virtual std::string to_string () const = 0;
 		virtual vxlnetwork::endpoint get_endpoint () const = 0;
 		virtual vxlnetwork::tcp_endpoint get_tcp_endpoint () const = 0;
@@ -151,7 +165,7 @@ namespace transport
 		bool operator== (vxlnetwork::transport::channel const &) const override;
 		// TODO: investigate clang-tidy warning about default parameters on virtual/override functions
 		//
-		void send_buffer (vxlnetwork::shared_const_buffer const &, std::function<void (boost::system::error_code const &, std::size_t)> const & = nullptr, vxlnetwork::buffer_drop_policy = vxlnetwork::buffer_drop_policy::limiter) override;
+		void send_buffer (vxlnetwork::shared_const_buffer const &, std::function<void (boost::system::error_code const &, std::size_t)> const & = nullptr, vxlnetwork::buffer_drop_policy = vxlnetwork::buffer_drop_policy::limiter, vxlnetwork::traffic_class = vxlnetwork::traffic_class::generic) override;
 		std::string to_string () const override;
 		bool operator== (vxlnetwork::transport::channel_loopback const & other_a) const
 		{
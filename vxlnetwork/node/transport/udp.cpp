@@ -33,7 +33,7 @@ bool vxlnetwork::transport::channel_udp::operator== (vxlnetwork::transport::chan
 	return result;
 }
 
-void vxlnetwork::transport::channel_udp::send_buffer (vxlnetwork::shared_const_buffer const & buffer_a, std::function<void (boost::system::error_code const &, std::size_t)> const & callback_a, vxlnetwork::buffer_drop_policy drop_policy_a)
+void vxlnetwork::transport::channel_udp::send_buffer (vxlnetwork::shared_const_buffer const & buffer_a, std::function<void (boost::system::error_code const &, std::size_t)> const & callback_a, vxlnetwork::buffer_drop_policy drop_policy_a, vxlnetwork::traffic_class traffic_a)
 {
 	set_last_packet_sent (std::chrono::steady_clock::now ());
 	channels.send (buffer_a, endpoint, [node = std::weak_ptr<vxlnetwork::node> (channels.node.shared ()), callback_a] (boost::system::error_code const & ec, std::size_t size_a) {
@@ -200,16 +200,18 @@ bool vxlnetwork::transport::udp_channels::store_all (bool clear_peers)
 	if (!endpoints.empty ())
 	{
 		// Clear all peers then refresh with the current list of peers
-		auto transaction (node.store.tx_begin_write ({ tables::peers }));
-		if (clear_peers)
-		{
-			node.store.peer.clear (transaction);
-		}
-		for (auto endpoint : endpoints)
-		{
-			vxlnetwork::endpoint_key endpoint_key (endpoint.address ().to_v6 ().to_bytes (), endpoint.port ());
-			node.store.peer.put (transaction, std::move (endpoint_key));
-		}
+		node.group_commit.submit (vxlnetwork::writer::peers, { tables::peers }, [this, clear_peers, &endpoints] (vxlnetwork::write_transaction const & transaction_a) {
+			if (clear_peers)
+			{
+				node.store.peer.clear (transaction_a);
+			}
+			for (auto endpoint : endpoints)
+			{
+				vxlnetwork::endpoint_key endpoint_key (endpoint.address ().to_v6 ().to_bytes (), endpoint.port ());
+				node.store.peer.put (transaction_a, std::move (endpoint_key));
+			}
+		})
+		.wait ();
 		result = true;
 	}
 	return result;
@@ -541,7 +543,11 @@ void vxlnetwork::transport::udp_channels::receive_action (vxlnetwork::message_bu
 	if (allowed_sender)
 	{
 		udp_message_visitor visitor (node, data_a->endpoint, sink);
-		vxlnetwork::message_parser parser (node.network.publish_filter, node.block_uniquer, node.vote_uniquer, visitor, node.work, node.network_params.network);
+		vxlnetwork::message_parser parser (node.network.publish_filter, node.network.vote_filter, node.block_uniquer, node.vote_uniquer, visitor, node.work, node.network_params.network);
+		// A representative's own reply to a rep crawler query must not be lost behind a relayed copy of the same vote
+		parser.vote_filter_exempt = [this, endpoint = data_a->endpoint] () {
+			return node.rep_crawler.is_queried (endpoint);
+		};
 		parser.deserialize_buffer (data_a->buffer, data_a->size);
 		if (parser.status == vxlnetwork::message_parser::parse_status::success)
 		{
@@ -551,6 +557,10 @@ void vxlnetwork::transport::udp_channels::receive_action (vxlnetwork::message_bu
 		{
 			node.stats.inc (vxlnetwork::stat::type::filter, vxlnetwork::stat::detail::duplicate_publish);
 		}
+		else if (parser.status == vxlnetwork::message_parser::parse_status::duplicate_confirm_ack_message)
+		{
+			node.stats.inc (vxlnetwork::stat::type::filter, vxlnetwork::stat::detail::duplicate_confirm_ack);
+		}
 		else
 		{
 			node.stats.inc (vxlnetwork::stat::type::error);
@@ -592,6 +602,7 @@ void vxlnetwork::transport::udp_channels::receive_action (vxlnetwork::message_bu
 					node.stats.inc (vxlnetwork::stat::type::udp, vxlnetwork::stat::detail::outdated_version);
 					break;
 				case vxlnetwork::message_parser::parse_status::duplicate_publish_message:
+				case vxlnetwork::message_parser::parse_status::duplicate_confirm_ack_message:
 				case vxlnetwork::message_parser::parse_status::success:
 					/* Already checked, unreachable */
 					break;
@@ -31,7 +31,7 @@ namespace transport
 		bool operator== (vxlnetwork::transport::channel const &) const override;
 		// TODO: investigate clang-tidy warning about default parameters on virtual/override functions
 		//
-		void send_buffer (vxlnetwork::shared_const_buffer const &, std::function<void (boost::system::error_code const &, std::size_t)> const & = nullptr, vxlnetwork::buffer_drop_policy = vxlnetwork::buffer_drop_policy::limiter) override;
+		void send_buffer (vxlnetwork::shared_const_buffer const &, std::function<void (boost::system::error_code const &, std::size_t)> const & = nullptr, vxlnetwork::buffer_drop_policy = vxlnetwork::buffer_drop_policy::limiter, vxlnetwork::traffic_class = vxlnetwork::traffic_class::generic) override;
 		std::string to_string () const override;
 		bool operator== (vxlnetwork::transport::channel_udp const & other_a) const
 		{
@@ -1,12 +1,19 @@
+#include <vxlnetwork/lib/blocks.hpp>
 #include <vxlnetwork/lib/locks.hpp>
+#include <vxlnetwork/lib/stats.hpp>
 #include <vxlnetwork/lib/threading.hpp>
 #include <vxlnetwork/lib/timer.hpp>
 #include <vxlnetwork/node/unchecked_map.hpp>
 #include <vxlnetwork/secure/store.hpp>
 
 #include <boost/range/join.hpp>
+#include <boost/variant/get.hpp>
 
-vxlnetwork::unchecked_map::unchecked_map (vxlnetwork::store & store, bool const & disable_delete) :
+constexpr std::size_t vxlnetwork::unchecked_map::for_each_batch_size;
+
+vxlnetwork::unchecked_map::unchecked_map (vxlnetwork::store & store, bool const & disable_delete, std::size_t memory_limit) :
+	use_memory{ memory_limit > 0 },
+	memory_limit{ memory_limit },
 	store{ store },
 	disable_delete{ disable_delete },
 	thread{ [this] () { run (); } }
@@ -27,38 +34,101 @@ void vxlnetwork::unchecked_map::put (vxlnetwork::hash_or_account const & depende
 	condition.notify_all (); // Notify run ()
 }
 
-auto vxlnetwork::unchecked_map::equal_range (vxlnetwork::transaction const & transaction, vxlnetwork::block_hash const & dependency) -> std::pair<iterator, iterator>
+void vxlnetwork::unchecked_map::for_each (vxlnetwork::transaction const & transaction, std::function<void (vxlnetwork::unchecked_key const &, vxlnetwork::unchecked_info const &)> action, std::function<bool ()> predicate)
 {
-	return store.unchecked.equal_range (transaction, dependency);
+	if (use_memory)
+	{
+		memory_for_each (
+		vxlnetwork::unchecked_key{}, [] (vxlnetwork::unchecked_key const &) { return true; }, action, predicate);
+	}
+	else
+	{
+		for (auto [i, n] = store.unchecked.full_range (transaction); predicate () && i != n; ++i)
+		{
+			action (i->first, i->second);
+		}
+	}
 }
 
-auto vxlnetwork::unchecked_map::full_range (vxlnetwork::transaction const & transaction) -> std::pair<iterator, iterator>
+void vxlnetwork::unchecked_map::for_each (vxlnetwork::transaction const & transaction, vxlnetwork::hash_or_account const & dependency, std::function<void (vxlnetwork::unchecked_key const &, vxlnetwork::unchecked_info const &)> action, std::function<bool ()> predicate)
 {
-	return store.unchecked.full_range (transaction);
+	if (use_memory)
+	{
+		memory_for_each (
+		vxlnetwork::unchecked_key{ dependency, 0 }, [hash = dependency.as_block_hash ()] (vxlnetwork::unchecked_key const & key) { return key.key () == hash; }, action, predicate);
+	}
+	else
+	{
+		for (auto [i, n] = store.unchecked.equal_range (transaction, dependency.as_block_hash ()); predicate () && i != n; ++i)
+		{
+			action (i->first, i->second);
+		}
+	}
 }
 
 std::vector<vxlnetwork::unchecked_info> vxlnetwork::unchecked_map::get (vxlnetwork::transaction const & transaction, vxlnetwork::block_hash const & hash)
 {
+	if (use_memory)
+	{
+		std::vector<vxlnetwork::unchecked_info> result;
+		for_each (transaction, hash, [&result] (vxlnetwork::unchecked_key const & key, vxlnetwork::unchecked_info const & info) {
+			result.push_back (info);
+		});
+		return result;
+	}
 	return store.unchecked.get (transaction, hash);
 }
 
 bool vxlnetwork::unchecked_map::exists (vxlnetwork::transaction const & transaction, vxlnetwork::unchecked_key const & key) const
 {
+	if (use_memory)
+	{
+		vxlnetwork::lock_guard<vxlnetwork::mutex> guard{ entries_mutex };
+		return entries.get<tag_key> ().count (key) != 0;
+	}
 	return store.unchecked.exists (transaction, key);
 }
 
 void vxlnetwork::unchecked_map::del (vxlnetwork::write_transaction const & transaction, vxlnetwork::unchecked_key const & key)
 {
-	store.unchecked.del (transaction, key);
+	if (use_memory)
+	{
+		vxlnetwork::lock_guard<vxlnetwork::mutex> guard{ entries_mutex };
+		auto & by_key = entries.get<tag_key> ();
+		auto existing = by_key.find (key);
+		if (existing != by_key.end ())
+		{
+			entries_memory -= existing->size;
+			by_key.erase (existing);
+		}
+	}
+	else
+	{
+		store.unchecked.del (transaction, key);
+	}
 }
 
 void vxlnetwork::unchecked_map::clear (vxlnetwork::write_transaction const & transaction)
 {
-	store.unchecked.clear (transaction);
+	if (use_memory)
+	{
+		vxlnetwork::lock_guard<vxlnetwork::mutex> guard{ entries_mutex };
+		entries.clear ();
+		entries_memory = 0;
+	}
+	else
+	{
+		store.unchecked.clear (transaction);
+	}
 }
 
 size_t vxlnetwork::unchecked_map::count (vxlnetwork::transaction const & transaction) const
 {
+	if (use_memory)
+	{
+		vxlnetwork::lock_guard<vxlnetwork::mutex> guard{ entries_mutex };
+		return entries.size ();
+	}
 	return store.unchecked.count (transaction);
 }
 
@@ -80,6 +150,23 @@ void vxlnetwork::unchecked_map::flush ()
 	});
 }
 
+void vxlnetwork::unchecked_map::set_stats (vxlnetwork::stat & stats_a)
+{
+	stats = &stats_a;
+}
+
+std::size_t vxlnetwork::unchecked_map::memory_size () const
+{
+	vxlnetwork::lock_guard<vxlnetwork::mutex> guard{ entries_mutex };
+	return entries_memory;
+}
+
+std::size_t vxlnetwork::unchecked_map::entry_size (vxlnetwork::unchecked_info const & info)
+{
+	// Deserialized blocks are larger than their wire size, account for the vtable, cached hash and shared_ptr control block as well as the two index nodes
+	return vxlnetwork::block::size (info.block->type ()) + sizeof (vxlnetwork::block_hash) + sizeof (entry) + 7 * sizeof (void *) + 64;
+}
+
 void vxlnetwork::unchecked_map::trigger (vxlnetwork::hash_or_account const & dependency)
 {
 	vxlnetwork::unique_lock<vxlnetwork::mutex> lock{ mutex };
@@ -109,6 +196,11 @@ void vxlnetwork::unchecked_map::item_visitor::operator() (query const & item)
 		auto const & key = i->first;
 		auto const & info = i->second;
 		delete_queue.push_back (key);
+		++unchecked.satisfied_count;
+		if (auto stats_l = unchecked.stats.load ())
+		{
+			stats_l->inc (vxlnetwork::stat::type::unchecked, vxlnetwork::stat::detail::satisfied);
+		}
 		unchecked.satisfied (info);
 	}
 	if (!unchecked.disable_delete)
@@ -120,13 +212,132 @@ void vxlnetwork::unchecked_map::item_visitor::operator() (query const & item)
 	}
 }
 
+void vxlnetwork::unchecked_map::memory_put (vxlnetwork::hash_or_account const & dependency, vxlnetwork::unchecked_info const & info)
+{
+	auto const size = entry_size (info);
+	uint64_t evicted{ 0 };
+	bool stored{ false };
+	if (size <= memory_limit)
+	{
+		vxlnetwork::lock_guard<vxlnetwork::mutex> guard{ entries_mutex };
+		stored = entries.get<tag_sequenced> ().push_back (entry{ vxlnetwork::unchecked_key{ dependency, info.block->hash () }, { info.block, info.account, info.verified }, size }).second;
+		if (stored)
+		{
+			entries_memory += size;
+			auto & by_arrival = entries.get<tag_sequenced> ();
+			while (entries_memory > memory_limit)
+			{
+				entries_memory -= by_arrival.front ().size;
+				by_arrival.pop_front ();
+				++evicted;
+			}
+		}
+	}
+	evictions += evicted;
+	drops += stored ? 0 : 1;
+	if (auto stats_l = stats.load ())
+	{
+		stats_l->inc (vxlnetwork::stat::type::unchecked, stored ? vxlnetwork::stat::detail::put : vxlnetwork::stat::detail::drop);
+		if (evicted > 0)
+		{
+			stats_l->add (vxlnetwork::stat::type::unchecked, vxlnetwork::stat::detail::eviction, vxlnetwork::stat::dir::in, evicted);
+		}
+	}
+}
+
+void vxlnetwork::unchecked_map::memory_for_each (vxlnetwork::unchecked_key const & start, std::function<bool (vxlnetwork::unchecked_key const &)> const & in_range, std::function<void (vxlnetwork::unchecked_key const &, vxlnetwork::unchecked_info const &)> const & action, std::function<bool ()> const & predicate)
+{
+	std::vector<std::pair<vxlnetwork::unchecked_key, vxlnetwork::unchecked_info>> batch;
+	auto first (true);
+	auto last (start);
+	auto done (false);
+	while (!done && predicate ())
+	{
+		batch.clear ();
+		{
+			vxlnetwork::lock_guard<vxlnetwork::mutex> guard{ entries_mutex };
+			auto & by_key = entries.get<tag_key> ();
+			// Continue after the last key handed out, entries may have been added or removed since
+			auto i = first ? by_key.lower_bound (last) : by_key.upper_bound (last);
+			for (auto n = by_key.end (); i != n && batch.size () < for_each_batch_size && in_range (i->key); ++i)
+			{
+				batch.emplace_back (i->key, i->info);
+			}
+		}
+		done = batch.size () < for_each_batch_size;
+		first = false;
+		for (auto j = batch.begin (), n = batch.end (); j != n && predicate (); ++j)
+		{
+			action (j->first, j->second);
+		}
+		if (!batch.empty ())
+		{
+			last = batch.back ().first;
+		}
+	}
+}
+
+void vxlnetwork::unchecked_map::memory_trigger (vxlnetwork::hash_or_account const & dependency)
+{
+	std::vector<vxlnetwork::unchecked_info> ready;
+	{
+		vxlnetwork::lock_guard<vxlnetwork::mutex> guard{ entries_mutex };
+		auto & by_key = entries.get<tag_key> ();
+		auto i = by_key.lower_bound (vxlnetwork::unchecked_key{ dependency, 0 });
+		while (i != by_key.end () && i->key.key () == dependency.as_block_hash ())
+		{
+			ready.push_back (i->info);
+			if (!disable_delete)
+			{
+				entries_memory -= i->size;
+				i = by_key.erase (i);
+			}
+			else
+			{
+				++i;
+			}
+		}
+	}
+	satisfied_count += ready.size ();
+	if (auto stats_l = stats.load ())
+	{
+		stats_l->inc (vxlnetwork::stat::type::unchecked, vxlnetwork::stat::detail::trigger);
+		if (!ready.empty ())
+		{
+			stats_l->add (vxlnetwork::stat::type::unchecked, vxlnetwork::stat::detail::satisfied, vxlnetwork::stat::dir::in, ready.size ());
+		}
+	}
+	// Called without holding the lock, satisfied may put new entries
+	for (auto const & info : ready)
+	{
+		satisfied (info);
+	}
+}
+
 void vxlnetwork::unchecked_map::write_buffer (decltype (buffer) const & back_buffer)
 {
-	auto transaction = store.tx_begin_write ();
-	item_visitor visitor{ *this, transaction };
-	for (auto const & item : back_buffer)
+	if (use_memory)
+	{
+		for (auto const & item : back_buffer)
+		{
+			if (auto insert_l = boost::get<insert> (&item))
+			{
+				memory_put (insert_l->first, insert_l->second);
+			}
+			else
+			{
+				memory_trigger (boost::get<query> (item));
+			}
+		}
+	}
+	else
 	{
-		boost::apply_visitor (visitor, item);
+		auto transaction = store.tx_begin_write ();
+		item_visitor visitor{ *this, transaction };
+		for (auto const & item : back_buffer)
+		{
+			boost::apply_visitor (visitor, item);
+		}
 	}
 }
 
@@ -155,3 +366,24 @@ void vxlnetwork::unchecked_map::run ()
 		}
 	}
 }
+
+std::unique_ptr<vxlnetwork::container_info_component> vxlnetwork::collect_container_info (unchecked_map & unchecked_map, std::string const & name)
+{
+	std::size_t buffered{ 0 };
+	std::size_t entries_count{ 0 };
+	{
+		vxlnetwork::lock_guard<vxlnetwork::mutex> guard{ unchecked_map.mutex };
+		buffered = unchecked_map.buffer.size () + unchecked_map.back_buffer.size ();
+	}
+	{
+		vxlnetwork::lock_guard<vxlnetwork::mutex> guard{ unchecked_map.entries_mutex };
+		entries_count = unchecked_map.entries.size ();
+	}
+	auto composite = std::make_unique<vxlnetwork::container_info_composite> (name);
+	composite->add_component (std::make_unique<vxlnetwork::container_info_leaf> (container_info{ "buffer", buffered, sizeof (decltype (unchecked_map.buffer)::value_type) }));
+	composite->add_component (std::make_unique<vxlnetwork::container_info_leaf> (container_info{ "entries", entries_count, unchecked_map.memory_size () / std::max<std::size_t> (entries_count, 1) }));
+	composite->add_component (std::make_unique<vxlnetwork::container_info_leaf> (container_info{ "drops", unchecked_map.drops, 0 }));
+	composite->add_component (std::make_unique<vxlnetwork::container_info_leaf> (container_info{ "evictions", unchecked_map.evictions, 0 }));
+	composite->add_component (std::make_unique<vxlnetwork::container_info_leaf> (container_info{ "satisfied", unchecked_map.satisfied_count, 0 }));
+	return composite;
+}
@@ -2,30 +2,44 @@
 
 #include <vxlnetwork/lib/locks.hpp>
 #include <vxlnetwork/lib/numbers.hpp>
+#include <vxlnetwork/lib/utility.hpp>
 #include <vxlnetwork/secure/store.hpp>
 
+#include <boost/multi_index/member.hpp>
+#include <boost/multi_index/ordered_index.hpp>
+#include <boost/multi_index/sequenced_index.hpp>
+#include <boost/multi_index_container.hpp>
+
 #include <atomic>
+#include <functional>
 #include <thread>
 #include <unordered_map>
 
 namespace vxlnetwork
 {
+class stat;
 class store;
 class transaction;
 class unchecked_info;
 class unchecked_key;
 class write_transaction;
+/**
+ * Blocks waiting for a dependency (previous block or source) to arrive.
+ *
+ * By default entries are kept in the unchecked table of the store. With a non-zero memory limit they are kept in memory
+ * only, bounded by that many bytes with the oldest entries evicted first, and the store is never written to. Transactions
+ * passed to an in-memory map are ignored.
+ */
 class unchecked_map
 {
 public:
-	using iterator = vxlnetwork::unchecked_store::iterator;
-
-public:
-	unchecked_map (vxlnetwork::store & store, bool const & do_delete);
+	unchecked_map (vxlnetwork::store & store, bool const & do_delete, std::size_t memory_limit = 0);
 	~unchecked_map ();
 	void put (vxlnetwork::hash_or_account const & dependency, vxlnetwork::unchecked_info const & info);
-	std::pair<iterator, iterator> equal_range (vxlnetwork::transaction const & transaction, vxlnetwork::block_hash const & dependency);
-	std::pair<iterator, iterator> full_range (vxlnetwork::transaction const & transaction);
+	/** Calls \p action for every entry in key order while \p predicate returns true */
+	void for_each (vxlnetwork::transaction const & transaction, std::function<void (vxlnetwork::unchecked_key const &, vxlnetwork::unchecked_info const &)> action, std::function<bool ()> predicate = [] () { return true; });
+	/** Calls \p action for every entry waiting on \p dependency while \p predicate returns true */
+	void for_each (vxlnetwork::transaction const & transaction, vxlnetwork::hash_or_account const & dependency, std::function<void (vxlnetwork::unchecked_key const &, vxlnetwork::unchecked_info const &)> action, std::function<bool ()> predicate = [] () { return true; });
 	std::vector<vxlnetwork::unchecked_info> get (vxlnetwork::transaction const &, vxlnetwork::block_hash const &);
 	bool exists (vxlnetwork::transaction const & transaction, vxlnetwork::unchecked_key const & key) const;
 	void del (vxlnetwork::write_transaction const & transaction, vxlnetwork::unchecked_key const & key);
@@ -33,6 +47,25 @@ public:
 	size_t count (vxlnetwork::transaction const & transaction) const;
 	void stop ();
 	void flush ();
+	void set_stats (vxlnetwork::stat & stats_a);
+	/** Approximate memory used by the in-memory entries */
+	std::size_t memory_size () const;
+
+	/** Entries are kept in memory instead of the store */
+	bool const use_memory;
+	std::size_t const memory_limit;
+
+	/** Puts not stored because the entry was already present or can never fit the memory limit */
+	std::atomic<uint64_t> drops{ 0 };
+	/** Oldest entries removed to stay within the memory limit */
+	std::atomic<uint64_t> evictions{ 0 };
+	/** Entries handed to satisfied after their dependency arrived */
+	std::atomic<uint64_t> satisfied_count{ 0 };
+
+	/** Approximate memory used by an in-memory entry, includes the node and index overhead */
+	static std::size_t entry_size (vxlnetwork::unchecked_info const &);
+	/** In-memory entries copied out under the lock at a time while iterating */
+	static std::size_t constexpr for_each_batch_size{ 256 };
 
 public: // Trigger requested dependencies
 	void trigger (vxlnetwork::hash_or_account const & dependency);
@@ -50,16 +83,48 @@ private:
 		unchecked_map & unchecked;
 		vxlnetwork::write_transaction const & transaction;
 	};
+	class entry final
+	{
+	public:
+		vxlnetwork::unchecked_key key;
+		vxlnetwork::unchecked_info info;
+		std::size_t size;
+	};
 	void run ();
+	/** In-memory counterparts of the store operations, the entries mutex must not be held */
+	void memory_put (vxlnetwork::hash_or_account const & dependency, vxlnetwork::unchecked_info const & info);
+	void memory_trigger (vxlnetwork::hash_or_account const & dependency);
+	/** Calls \p action for the entries from \p start on while \p in_range holds, copying them out in batches so \p action runs without the entries mutex */
+	void memory_for_each (vxlnetwork::unchecked_key const & start, std::function<bool (vxlnetwork::unchecked_key const &)> const & in_range, std::function<void (vxlnetwork::unchecked_key const &, vxlnetwork::unchecked_info const &)> const & action, std::function<bool ()> const & predicate);
 	vxlnetwork::store & store;
 	bool const & disable_delete;
 	std::deque<boost::variant<insert, query>> buffer;
 	std::deque<boost::variant<insert, query>> back_buffer;
 	bool writing_back_buffer{ false };
 	bool stopped{ false };
+	void write_buffer (decltype (buffer) const & back_buffer);
+
+	// clang-format off
+	class tag_sequenced {};
+	class tag_key {};
+	using ordered_entries = boost::multi_index_container<entry,
+	boost::multi_index::indexed_by<
+		boost::multi_index::sequenced<boost::multi_index::tag<tag_sequenced>>,
+		boost::multi_index::ordered_unique<boost::multi_index::tag<tag_key>,
+			boost::multi_index::member<entry, vxlnetwork::unchecked_key, &entry::key>>>>;
+	// clang-format on
+	/** Oldest arrival at the front */
+	ordered_entries entries;
+	std::size_t entries_memory{ 0 };
+	mutable vxlnetwork::mutex entries_mutex;
+	std::atomic<vxlnetwork::stat *> stats{ nullptr };
+
 	vxlnetwork::condition_variable condition;
 	vxlnetwork::mutex mutex;
 	std::thread thread;
-	void write_buffer (decltype (buffer) const & back_buffer);
+
+	friend std::unique_ptr<container_info_component> collect_container_info (unchecked_map &, std::string const &);
 };
+
+std::unique_ptr<container_info_component> collect_container_info (unchecked_map & unchecked_map, std::string const & name);
 }
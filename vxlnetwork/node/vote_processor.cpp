@@ -15,6 +15,9 @@
 
 #include <boost/format.hpp>
 
+#include <algorithm>
+#include <iterator>
+
 vxlnetwork::vote_processor::vote_processor (vxlnetwork::signature_checker & checker_a, vxlnetwork::active_transactions & active_a, vxlnetwork::node_observers & observers_a, vxlnetwork::stat & stats_a, vxlnetwork::node_config & config_a, vxlnetwork::node_flags & flags_a, vxlnetwork::logger_mt & logger_a, vxlnetwork::online_reps & online_reps_a, vxlnetwork::rep_crawler & rep_crawler_a, vxlnetwork::ledger & ledger_a, vxlnetwork::network_params & network_params_a) :
 	checker (checker_a),
 	active (active_a),
@@ -27,36 +30,44 @@ vxlnetwork::vote_processor::vote_processor (vxlnetwork::signature_checker & chec
 	ledger (ledger_a),
 	network_params (network_params_a),
 	max_votes (flags_a.vote_processor_capacity),
-	started (false),
-	stopped (false),
-	is_active (false),
-	thread ([this] () {
-		vxlnetwork::thread_role::set (vxlnetwork::thread_role::name::vote_processing);
-		process_loop ();
-	})
+	representatives (std::make_shared<representative_tiers> ())
 {
-	vxlnetwork::unique_lock<vxlnetwork::mutex> lock (mutex);
-	condition.wait (lock, [&started = started] { return started; });
+	auto const threads_count (std::max<unsigned> (config_a.vote_processor_threads, 1));
+	workers.reserve (threads_count);
+	for (unsigned i = 0; i < threads_count; ++i)
+	{
+		workers.push_back (std::make_unique<worker> ());
+	}
+	for (auto & worker_l : workers)
+	{
+		worker_l->thread = std::thread ([this, &worker_a = *worker_l] () {
+			vxlnetwork::thread_role::set (vxlnetwork::thread_role::name::vote_processing);
+			process_loop (worker_a);
+		});
+	}
 }
 
-void vxlnetwork::vote_processor::process_loop ()
+void vxlnetwork::vote_processor::process_loop (worker & worker_a)
 {
 	vxlnetwork::timer<std::chrono::milliseconds> elapsed;
 	bool log_this_iteration;
 
-	vxlnetwork::unique_lock<vxlnetwork::mutex> lock (mutex);
-	started = true;
-
-	lock.unlock ();
-	condition.notify_all ();
-	lock.lock ();
-
+	vxlnetwork::unique_lock<vxlnetwork::mutex> lock (worker_a.mutex);
 	while (!stopped)
 	{
-		if (!votes.empty ())
+		if (worker_a.size != 0)
 		{
-			decltype (votes) votes_l;
-			votes_l.swap (votes);
+			// Higher tiers first. Votes of a representative stay in order unless its tier changed while some were queued
+			std::deque<entry> votes_l;
+			for (auto tier_l = tiers_count; tier_l-- > 0 && votes_l.size () < max_batch_size;)
+			{
+				auto & queue_l (worker_a.queues[tier_l]);
+				auto const count_l (std::min (queue_l.size (), max_batch_size - votes_l.size ()));
+				std::move (queue_l.begin (), queue_l.begin () + count_l, std::back_inserter (votes_l));
+				queue_l.erase (queue_l.begin (), queue_l.begin () + count_l);
+			}
+			worker_a.size -= votes_l.size ();
+			queued -= votes_l.size ();
 
 			log_this_iteration = false;
 			if (config.logging.network_logging () && votes_l.size () > 50)
@@ -68,14 +79,14 @@ void vxlnetwork::vote_processor::process_loop ()
 				log_this_iteration = true;
 				elapsed.restart ();
 			}
-			is_active = true;
+			worker_a.active = true;
 			lock.unlock ();
 			verify_votes (votes_l);
 			lock.lock ();
-			is_active = false;
+			worker_a.active = false;
 
 			lock.unlock ();
-			condition.notify_all ();
+			worker_a.condition.notify_all ();
 			total_processed += votes_l.size ();
 			lock.lock ();
 
@@ -86,44 +97,49 @@ void vxlnetwork::vote_processor::process_loop ()
 		}
 		else
 		{
-			condition.wait (lock);
+			worker_a.condition.wait (lock);
 		}
 	}
 }
 
+vxlnetwork::vote_processor::worker & vxlnetwork::vote_processor::worker_for (vxlnetwork::account const & account_a)
+{
+	// Accounts are public keys and uniformly distributed
+	return *workers[account_a.qwords[0] % workers.size ()];
+}
+
+bool vxlnetwork::vote_processor::reserve (unsigned tier_a)
+{
+	// Level 0 (< 0.1%) is accepted below 6/9 of the capacity, each higher level gets another 1/9
+	auto const limit ((6.0 + tier_a) / 9.0 * max_votes);
+	auto current (queued.load ());
+	do
+	{
+		if (current >= limit)
+		{
+			return false;
+		}
+	} while (!queued.compare_exchange_weak (current, current + 1));
+	return true;
+}
+
 bool vxlnetwork::vote_processor::vote (std::shared_ptr<vxlnetwork::vote> const & vote_a, std::shared_ptr<vxlnetwork::transport::channel> const & channel_a)
 {
 	debug_assert (channel_a != nullptr);
 	bool process (false);
-	vxlnetwork::unique_lock<vxlnetwork::mutex> lock (mutex);
 	if (!stopped)
 	{
-		// Level 0 (< 0.1%)
-		if (votes.size () < 6.0 / 9.0 * max_votes)
-		{
-			process = true;
-		}
-		// Level 1 (0.1-1%)
-		else if (votes.size () < 7.0 / 9.0 * max_votes)
-		{
-			process = (representatives_1.find (vote_a->account) != representatives_1.end ());
-		}
-		// Level 2 (1-5%)
-		else if (votes.size () < 8.0 / 9.0 * max_votes)
-		{
-			process = (representatives_2.find (vote_a->account) != representatives_2.end ());
-		}
-		// Level 3 (> 5%)
-		else if (votes.size () < max_votes)
-		{
-			process = (representatives_3.find (vote_a->account) != representatives_3.end ());
-		}
+		auto const tier_l (tier (vote_a->account));
+		process = reserve (tier_l);
 		if (process)
 		{
-			votes.emplace_back (vote_a, channel_a);
-			lock.unlock ();
-			condition.notify_all ();
-			// Lock no longer required
+			auto & worker_l (worker_for (vote_a->account));
+			{
+				vxlnetwork::lock_guard<vxlnetwork::mutex> guard (worker_l.mutex);
+				worker_l.queues[tier_l].emplace_back (vote_a, channel_a);
+				++worker_l.size;
+			}
+			worker_l.condition.notify_all ();
 		}
 		else
 		{
@@ -133,7 +149,7 @@ bool vxlnetwork::vote_processor::vote (std::shared_ptr<vxlnetwork::vote> const &
 	return !process;
 }
 
-void vxlnetwork::vote_processor::verify_votes (decltype (votes) const & votes_a)
+void vxlnetwork::vote_processor::verify_votes (std::deque<entry> const & votes_a)
 {
 	auto size (votes_a.size ());
 	std::vector<unsigned char const *> messages;
@@ -205,45 +221,53 @@ vxlnetwork::vote_code vxlnetwork::vote_processor::vote_blocking (std::shared_ptr
 
 void vxlnetwork::vote_processor::stop ()
 {
+	stopped = true;
+	for (auto & worker_l : workers)
 	{
-		vxlnetwork::lock_guard<vxlnetwork::mutex> lock (mutex);
-		stopped = true;
-	}
-	condition.notify_all ();
-	if (thread.joinable ())
-	{
-		thread.join ();
+		{
+			// Synchronizes with the worker checking the flag before waiting
+			vxlnetwork::lock_guard<vxlnetwork::mutex> guard (worker_l->mutex);
+		}
+		worker_l->condition.notify_all ();
+		if (worker_l->thread.joinable ())
+		{
+			worker_l->thread.join ();
+		}
 	}
 }
 
 void vxlnetwork::vote_processor::flush ()
 {
-	vxlnetwork::unique_lock<vxlnetwork::mutex> lock (mutex);
-	while (is_active || !votes.empty ())
+	for (auto & worker_l : workers)
 	{
-		condition.wait (lock);
+		vxlnetwork::unique_lock<vxlnetwork::mutex> lock (worker_l->mutex);
+		while (!stopped && (worker_l->active || worker_l->size != 0))
+		{
+			worker_l->condition.wait (lock);
+		}
 	}
 }
 
 void vxlnetwork::vote_processor::flush_active ()
 {
-	vxlnetwork::unique_lock<vxlnetwork::mutex> lock (mutex);
-	while (is_active)
+	for (auto & worker_l : workers)
 	{
-		condition.wait (lock);
+		vxlnetwork::unique_lock<vxlnetwork::mutex> lock (worker_l->mutex);
+		while (!stopped && worker_l->active)
+		{
+			worker_l->condition.wait (lock);
+		}
 	}
 }
 
 std::size_t vxlnetwork::vote_processor::size ()
 {
-	vxlnetwork::lock_guard<vxlnetwork::mutex> guard (mutex);
-	return votes.size ();
+	return queued;
 }
 
 bool vxlnetwork::vote_processor::empty ()
 {
-	vxlnetwork::lock_guard<vxlnetwork::mutex> guard (mutex);
-	return votes.empty ();
+	return queued == 0;
 }
 
 bool vxlnetwork::vote_processor::half_full ()
@@ -253,53 +277,72 @@ bool vxlnetwork::vote_processor::half_full ()
 
 void vxlnetwork::vote_processor::calculate_weights ()
 {
-	vxlnetwork::unique_lock<vxlnetwork::mutex> lock (mutex);
 	if (!stopped)
 	{
-		representatives_1.clear ();
-		representatives_2.clear ();
-		representatives_3.clear ();
+		auto representatives_l (std::make_shared<representative_tiers> ());
 		auto supply (online_reps.trended ());
-		auto rep_amounts = ledger.cache.rep_weights.get_rep_amounts ();
+		auto rep_amounts = ledger.cache.rep_weights.get_snapshot ();
 		for (auto const & rep_amount : rep_amounts)
 		{
 			vxlnetwork::account const & representative (rep_amount.first);
 			auto weight (ledger.weight (representative));
 			if (weight > supply / 1000) // 0.1% or above (level 1)
 			{
-				representatives_1.insert (representative);
+				representatives_l->representatives_1.insert (representative);
 				if (weight > supply / 100) // 1% or above (level 2)
 				{
-					representatives_2.insert (representative);
+					representatives_l->representatives_2.insert (representative);
 					if (weight > supply / 20) // 5% or above (level 3)
 					{
-						representatives_3.insert (representative);
+						representatives_l->representatives_3.insert (representative);
 					}
 				}
 			}
 		}
+		std::atomic_store (&representatives, std::shared_ptr<representative_tiers const> (representatives_l));
 	}
 }
 
-std::unique_ptr<vxlnetwork::container_info_component> vxlnetwork::collect_container_info (vote_processor & vote_processor, std::string const & name)
+unsigned vxlnetwork::vote_processor::tier (vxlnetwork::account const & account_a) const
 {
-	std::size_t votes_count;
-	std::size_t representatives_1_count;
-	std::size_t representatives_2_count;
-	std::size_t representatives_3_count;
+	auto representatives_l (std::atomic_load (&representatives));
+	unsigned result (0);
+	if (representatives_l->representatives_3.count (account_a) != 0)
+	{
+		result = 3;
+	}
+	else if (representatives_l->representatives_2.count (account_a) != 0)
+	{
+		result = 2;
+	}
+	else if (representatives_l->representatives_1.count (account_a) != 0)
+	{
+		result = 1;
+	}
+	return result;
+}
 
+std::unique_ptr<vxlnetwork::container_info_component> vxlnetwork::collect_container_info (vote_processor & vote_processor, std::string const & name)
+{
+	std::array<std::size_t, vxlnetwork::vote_processor::tiers_count> tiers_counts{};
+	for (auto & worker_l : vote_processor.workers)
 	{
-		vxlnetwork::lock_guard<vxlnetwork::mutex> guard (vote_processor.mutex);
-		votes_count = vote_processor.votes.size ();
-		representatives_1_count = vote_processor.representatives_1.size ();
-		representatives_2_count = vote_processor.representatives_2.size ();
-		representatives_3_count = vote_processor.representatives_3.size ();
+		vxlnetwork::lock_guard<vxlnetwork::mutex> guard (worker_l->mutex);
+		for (std::size_t i = 0; i < tiers_counts.size (); ++i)
+		{
+			tiers_counts[i] += worker_l->queues[i].size ();
+		}
 	}
+	auto representatives_l (std::atomic_load (&vote_processor.representatives));
 
 	auto composite = std::make_unique<container_info_composite> (name);
-	composite->add_component (std::make_unique<container_info_leaf> (container_info{ "votes", votes_count, sizeof (decltype (vote_processor.votes)::value_type) }));
-	composite->add_component (std::make_unique<container_info_leaf> (container_info{ "representatives_1", representatives_1_count, sizeof (decltype (vote_processor.representatives_1)::value_type) }));
-	composite->add_component (std::make_unique<container_info_leaf> (container_info{ "representatives_2", representatives_2_count, sizeof (decltype (vote_processor.representatives_2)::value_type) }));
-	composite->add_component (std::make_unique<container_info_leaf> (container_info{ "representatives_3", representatives_3_count, sizeof (decltype (vote_processor.representatives_3)::value_type) }));
+	composite->add_component (std::make_unique<container_info_leaf> (container_info{ "votes", vote_processor.size (), sizeof (vxlnetwork::vote_processor::entry) }));
+	for (std::size_t i = 0; i < tiers_counts.size (); ++i)
+	{
+		composite->add_component (std::make_unique<container_info_leaf> (container_info{ "votes_tier_" + std::to_string (i), tiers_counts[i], sizeof (vxlnetwork::vote_processor::entry) }));
+	}
+	composite->add_component (std::make_unique<container_info_leaf> (container_info{ "representatives_1", representatives_l->representatives_1.size (), sizeof (decltype (representatives_l->representatives_1)::value_type) }));
+	composite->add_component (std::make_unique<container_info_leaf> (container_info{ "representatives_2", representatives_l->representatives_2.size (), sizeof (decltype (representatives_l->representatives_2)::value_type) }));
+	composite->add_component (std::make_unique<container_info_leaf> (container_info{ "representatives_3", representatives_l->representatives_3.size (), sizeof (decltype (representatives_l->representatives_3)::value_type) }));
 	return composite;
 }
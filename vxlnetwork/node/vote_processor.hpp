@@ -4,11 +4,14 @@
 #include <vxlnetwork/lib/utility.hpp>
 #include <vxlnetwork/secure/common.hpp>
 
+#include <array>
+#include <atomic>
 #include <deque>
 #include <memory>
 #include <mutex>
 #include <thread>
 #include <unordered_set>
+#include <vector>
 
 namespace vxlnetwork
 {
@@ -32,13 +35,18 @@ namespace transport
 	class channel;
 }
 
+/**
+ * Verifies and applies incoming votes on a pool of worker threads.
+ * Votes are partitioned by representative so all votes of one representative are handled by the same worker, in order.
+ * Each worker queues votes per representative tier and drains higher tiers first, signatures of a batch are verified together.
+ * Admission is shared between workers: as the total amount of queued votes grows, only representatives of increasing tiers are accepted.
+ */
 class vote_processor final
 {
 public:
 	explicit vote_processor (vxlnetwork::signature_checker & checker_a, vxlnetwork::active_transactions & active_a, vxlnetwork::node_observers & observers_a, vxlnetwork::stat & stats_a, vxlnetwork::node_config & config_a, vxlnetwork::node_flags & flags_a, vxlnetwork::logger_mt & logger_a, vxlnetwork::online_reps & online_reps_a, vxlnetwork::rep_crawler & rep_crawler_a, vxlnetwork::ledger & ledger_a, vxlnetwork::network_params & network_params_a);
 	/** Returns false if the vote was processed */
 	bool vote (std::shared_ptr<vxlnetwork::vote> const &, std::shared_ptr<vxlnetwork::transport::channel> const &);
-	/** Note: node.active.mutex lock is required */
 	vxlnetwork::vote_code vote_blocking (std::shared_ptr<vxlnetwork::vote> const &, std::shared_ptr<vxlnetwork::transport::channel> const &, bool = false);
 	void verify_votes (std::deque<std::pair<std::shared_ptr<vxlnetwork::vote>, std::shared_ptr<vxlnetwork::transport::channel>>> const &);
 	void flush ();
@@ -48,11 +56,43 @@ public:
 	bool empty ();
 	bool half_full ();
 	void calculate_weights ();
+	/** Returns the tier of a representative as of the last calculate_weights: 0 under 0.1% of the online stake, 1 under 1%, 2 under 5% and 3 above */
+	unsigned tier (vxlnetwork::account const &) const;
 	void stop ();
 	std::atomic<uint64_t> total_processed{ 0 };
 
+	static std::size_t constexpr tiers_count{ 4 };
+	/** Maximum number of votes a worker verifies in one batch */
+	static std::size_t constexpr max_batch_size{ 4096 };
+
 private:
-	void process_loop ();
+	using entry = std::pair<std::shared_ptr<vxlnetwork::vote>, std::shared_ptr<vxlnetwork::transport::channel>>;
+
+	class worker final
+	{
+	public:
+		vxlnetwork::mutex mutex{ mutex_identifier (mutexes::vote_processor) };
+		vxlnetwork::condition_variable condition;
+		/** Indexed by tier */
+		std::array<std::deque<entry>, tiers_count> queues;
+		std::size_t size{ 0 };
+		bool active{ false };
+		std::thread thread;
+	};
+
+	/** Representatives levels for random early detection, replaced as a whole by calculate_weights */
+	class representative_tiers final
+	{
+	public:
+		std::unordered_set<vxlnetwork::account> representatives_1;
+		std::unordered_set<vxlnetwork::account> representatives_2;
+		std::unordered_set<vxlnetwork::account> representatives_3;
+	};
+
+	void process_loop (worker &);
+	worker & worker_for (vxlnetwork::account const &);
+	/** Reserves a slot in the shared queue budget for a vote of the given tier, returns false if the vote must be dropped */
+	bool reserve (unsigned tier_a);
 
 	vxlnetwork::signature_checker & checker;
 	vxlnetwork::active_transactions & active;
@@ -65,20 +105,14 @@ private:
 	vxlnetwork::ledger & ledger;
 	vxlnetwork::network_params & network_params;
 	std::size_t max_votes;
-	std::deque<std::pair<std::shared_ptr<vxlnetwork::vote>, std::shared_ptr<vxlnetwork::transport::channel>>> votes;
-	/** Representatives levels for random early detection */
-	std::unordered_set<vxlnetwork::account> representatives_1;
-	std::unordered_set<vxlnetwork::account> representatives_2;
-	std::unordered_set<vxlnetwork::account> representatives_3;
-	vxlnetwork::condition_variable condition;
-	vxlnetwork::mutex mutex{ mutex_identifier (mutexes::vote_processor) };
-	bool started;
-	bool stopped;
-	bool is_active;
-	std::thread thread;
+	/** Votes queued over all workers */
+	std::atomic<std::size_t> queued{ 0 };
+	/** Read and replaced with std::atomic_load and std::atomic_store */
+	std::shared_ptr<representative_tiers const> representatives;
+	std::vector<std::unique_ptr<worker>> workers;
+	std::atomic<bool> stopped{ false };
 
 	friend std::unique_ptr<container_info_component> collect_container_info (vote_processor & vote_processor, std::string const & name);
-	friend class vote_processor_weights_Test;
 };
 
 std::unique_ptr<container_info_component> collect_container_info (vote_processor & vote_processor, std::string const & name);
@@ -1,6 +1,7 @@
 #include <vxlnetwork/lib/stats.hpp>
 #include <vxlnetwork/lib/threading.hpp>
 #include <vxlnetwork/lib/utility.hpp>
+#include <vxlnetwork/node/group_commit.hpp>
 #include <vxlnetwork/node/network.hpp>
 #include <vxlnetwork/node/nodeconfig.hpp>
 #include <vxlnetwork/node/vote_processor.hpp>
@@ -161,9 +162,10 @@ std::unique_ptr<vxlnetwork::container_info_component> vxlnetwork::collect_contai
 	return composite;
 }
 
-vxlnetwork::vote_generator::vote_generator (vxlnetwork::node_config const & config_a, vxlnetwork::ledger & ledger_a, vxlnetwork::wallets & wallets_a, vxlnetwork::vote_processor & vote_processor_a, vxlnetwork::local_vote_history & history_a, vxlnetwork::network & network_a, vxlnetwork::stat & stats_a, bool is_final_a) :
+vxlnetwork::vote_generator::vote_generator (vxlnetwork::node_config const & config_a, vxlnetwork::ledger & ledger_a, vxlnetwork::group_commit & group_commit_a, vxlnetwork::wallets & wallets_a, vxlnetwork::vote_processor & vote_processor_a, vxlnetwork::local_vote_history & history_a, vxlnetwork::network & network_a, vxlnetwork::stat & stats_a, bool is_final_a) :
 	config (config_a),
 	ledger (ledger_a),
+	group_commit (group_commit_a),
 	wallets (wallets_a),
 	vote_processor (vote_processor_a),
 	history (history_a),
@@ -192,10 +194,12 @@ void vxlnetwork::vote_generator::add (vxlnetwork::root const & root_a, vxlnetwor
 		auto should_vote (false);
 		if (is_final)
 		{
-			auto transaction (ledger.store.tx_begin_write ({ tables::final_votes }));
-			auto block (ledger.store.block.get (transaction, hash_a));
-			should_vote = block != nullptr && ledger.dependents_confirmed (transaction, *block) && ledger.store.final_vote.put (transaction, block->qualified_root (), hash_a);
-			debug_assert (block == nullptr || root_a == block->root ());
+			group_commit.submit (vxlnetwork::writer::final_votes, { tables::final_votes }, [this, &root_a, &hash_a, &should_vote] (vxlnetwork::write_transaction const & transaction_a) {
+				auto block (ledger.store.block.get (transaction_a, hash_a));
+				should_vote = block != nullptr && ledger.dependents_confirmed (transaction_a, *block) && ledger.store.final_vote.put (transaction_a, block->qualified_root (), hash_a);
+				debug_assert (block == nullptr || root_a == block->root ());
+			})
+			.wait ();
 		}
 		else
 		{
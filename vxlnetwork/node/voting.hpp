@@ -21,6 +21,7 @@ namespace mi = boost::multi_index;
 
 namespace vxlnetwork
 {
+class group_commit;
 class ledger;
 class network;
 class node_config;
@@ -120,7 +121,7 @@ private:
 	using request_t = std::pair<std::vector<candidate_t>, std::shared_ptr<vxlnetwork::transport::channel>>;
 
 public:
-	vote_generator (vxlnetwork::node_config const & config_a, vxlnetwork::ledger & ledger_a, vxlnetwork::wallets & wallets_a, vxlnetwork::vote_processor & vote_processor_a, vxlnetwork::local_vote_history & history_a, vxlnetwork::network & network_a, vxlnetwork::stat & stats_a, bool is_final_a);
+	vote_generator (vxlnetwork::node_config const & config_a, vxlnetwork::ledger & ledger_a, vxlnetwork::group_commit & group_commit_a, vxlnetwork::wallets & wallets_a, vxlnetwork::vote_processor & vote_processor_a, vxlnetwork::local_vote_history & history_a, vxlnetwork::network & network_a, vxlnetwork::stat & stats_a, bool is_final_a);
 	/** Queue items for vote generation, or broadcast votes already in cache */
 	void add (vxlnetwork::root const &, vxlnetwork::block_hash const &);
 	/** Queue blocks for vote generation, returning the number of successful candidates.*/
@@ -137,6 +138,7 @@ private:
 	std::function<void (std::shared_ptr<vxlnetwork::vote> const &, std::shared_ptr<vxlnetwork::transport::channel> &)> reply_action; // must be set only during initialization by using set_reply_action
 	vxlnetwork::node_config const & config;
 	vxlnetwork::ledger & ledger;
+	vxlnetwork::group_commit & group_commit;
 	vxlnetwork::wallets & wallets;
 	vxlnetwork::vote_processor & vote_processor;
 	vxlnetwork::local_vote_history & history;
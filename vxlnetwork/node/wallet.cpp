@@ -1388,7 +1388,8 @@ vxlnetwork::wallets::wallets (bool error_a, vxlnetwork::node & node_a) :
 	if (backup_required)
 	{
 		char const * store_path;
-		mdb_env_get_path (env, &store_path);
+		auto environment (env.current ());
+		mdb_env_get_path (environment.get (), &store_path);
 		boost::filesystem::path const path (store_path);
 		vxlnetwork::mdb_store::create_backup_file (env, path, node_a.logger);
 	}
@@ -1,6 +1,8 @@
 #include <vxlnetwork/boost/asio/bind_executor.hpp>
 #include <vxlnetwork/boost/asio/dispatch.hpp>
 #include <vxlnetwork/boost/asio/strand.hpp>
+#include <vxlnetwork/lib/json_writer.hpp>
+#include <vxlnetwork/lib/stats.hpp>
 #include <vxlnetwork/lib/tlsconfig.hpp>
 #include <vxlnetwork/lib/work.hpp>
 #include <vxlnetwork/node/transport/transport.hpp>
@@ -292,37 +294,73 @@ void vxlnetwork::websocket::session::close ()
 	});
 }
 
-void vxlnetwork::websocket::session::write (vxlnetwork::websocket::message message_a)
+void vxlnetwork::websocket::session::write (vxlnetwork::websocket::message const & message_a)
+{
+	vxlnetwork::websocket::payload payload_l;
+	write (message_a, payload_l);
+}
+
+void vxlnetwork::websocket::session::write (vxlnetwork::websocket::message const & message_a, vxlnetwork::websocket::payload & payload_a)
 {
 	vxlnetwork::unique_lock<vxlnetwork::mutex> lk (subscriptions_mutex);
 	auto subscription (subscriptions.find (message_a.topic));
 	if (message_a.topic == vxlnetwork::websocket::topic::ack || (subscription != subscriptions.end () && !subscription->second->should_filter (message_a)))
 	{
 		lk.unlock ();
+		if (payload_a == nullptr)
+		{
+			payload_a = ws_listener.encode (message_a);
+		}
 		auto this_l (shared_from_this ());
 		boost::asio::post (ws.get_strand (),
-		[message_a, this_l] () {
-			bool write_in_progress = !this_l->send_queue.empty ();
-			this_l->send_queue.emplace_back (message_a);
+		[payload_l = payload_a, this_l] () {
+			this_l->enqueue (payload_l);
+		});
+	}
+}
+
+void vxlnetwork::websocket::session::enqueue (vxlnetwork::websocket::payload const & payload_a)
+{
+	if (!overflowed)
+	{
+		if (!send_queue.empty () && send_queue_bytes + payload_a->size () > ws_listener.max_queued_bytes)
+		{
+			// The client does not keep up. Skipping messages would leave it with an inconsistent view, so the session is closed
+			// once the write in progress completes, and the remaining queue is released right away
+			overflowed = true;
+			send_queue.erase (send_queue.begin () + 1, send_queue.end ());
+			send_queue_bytes = send_queue.front ()->size ();
+			ws_listener.stats.inc (vxlnetwork::stat::type::websocket, vxlnetwork::stat::detail::overflow, vxlnetwork::stat::dir::out);
+			ws_listener.get_logger ().always_log ("Websocket: send queue limit exceeded, closing session");
+		}
+		else
+		{
+			bool write_in_progress = !send_queue.empty ();
+			send_queue_bytes += payload_a->size ();
+			send_queue.push_back (payload_a);
 			if (!write_in_progress)
 			{
-				this_l->write_queued_messages ();
+				write_queued_messages ();
 			}
-		});
+		}
 	}
 }
 
 void vxlnetwork::websocket::session::write_queued_messages ()
 {
-	auto msg (send_queue.front ().to_string ());
 	auto this_l (shared_from_this ());
 
-	ws.async_write (vxlnetwork::shared_const_buffer (msg),
+	ws.async_write (vxlnetwork::shared_const_buffer (send_queue.front ()),
 	[this_l] (boost::system::error_code ec, std::size_t bytes_transferred) {
+		this_l->send_queue_bytes -= this_l->send_queue.front ()->size ();
 		this_l->send_queue.pop_front ();
 		if (!ec)
 		{
-			if (!this_l->send_queue.empty ())
+			if (this_l->overflowed)
+			{
+				this_l->close ();
+			}
+			else if (!this_l->send_queue.empty ())
 			{
 				this_l->write_queued_messages ();
 			}
@@ -550,10 +588,12 @@ void vxlnetwork::websocket::listener::stop ()
 	sessions.clear ();
 }
 
-vxlnetwork::websocket::listener::listener (std::shared_ptr<vxlnetwork::tls_config> const & tls_config_a, vxlnetwork::logger_mt & logger_a, vxlnetwork::wallets & wallets_a, boost::asio::io_context & io_ctx_a, boost::asio::ip::tcp::endpoint endpoint_a) :
+vxlnetwork::websocket::listener::listener (std::shared_ptr<vxlnetwork::tls_config> const & tls_config_a, vxlnetwork::logger_mt & logger_a, vxlnetwork::wallets & wallets_a, vxlnetwork::stat & stats_a, boost::asio::io_context & io_ctx_a, boost::asio::ip::tcp::endpoint endpoint_a, std::size_t max_queued_bytes_a) :
 	tls_config (tls_config_a),
 	logger (logger_a),
 	wallets (wallets_a),
+	stats (stats_a),
+	max_queued_bytes (max_queued_bytes_a),
 	acceptor (io_ctx_a),
 	socket (io_ctx_a)
 {
@@ -628,11 +668,13 @@ void vxlnetwork::websocket::listener::on_accept (boost::system::error_code ec)
 
 void vxlnetwork::websocket::listener::broadcast_confirmation (std::shared_ptr<vxlnetwork::block> const & block_a, vxlnetwork::account const & account_a, vxlnetwork::amount const & amount_a, std::string const & subtype, vxlnetwork::election_status const & election_status_a, std::vector<vxlnetwork::vote_with_weight_info> const & election_votes_a)
 {
+	auto const start (std::chrono::steady_clock::now ());
 	vxlnetwork::websocket::message_builder builder;
 
+	// Messages and their encoding are shared by all sessions with the same combination of options
+	std::array<boost::optional<vxlnetwork::websocket::message>, vxlnetwork::websocket::confirmation_options::variants> messages;
+	std::array<vxlnetwork::websocket::payload, vxlnetwork::websocket::confirmation_options::variants> payloads;
 	vxlnetwork::lock_guard<vxlnetwork::mutex> lk (sessions_mutex);
-	boost::optional<vxlnetwork::websocket::message> msg_with_block;
-	boost::optional<vxlnetwork::websocket::message> msg_without_block;
 	for (auto & weak_session : sessions)
 	{
 		auto session_ptr (weak_session.lock ());
@@ -647,34 +689,73 @@ void vxlnetwork::websocket::listener::broadcast_confirmation (std::shared_ptr<vx
 				{
 					conf_options = &default_options;
 				}
-				auto include_block (conf_options == nullptr ? true : conf_options->get_include_block ());
-
-				if (include_block && !msg_with_block)
-				{
-					msg_with_block = builder.block_confirmed (block_a, account_a, amount_a, subtype, include_block, election_status_a, election_votes_a, *conf_options);
-				}
-				else if (!include_block && !msg_without_block)
+				auto variant (conf_options->variant ());
+				auto & message_l (messages[variant]);
+				if (!message_l)
 				{
-					msg_without_block = builder.block_confirmed (block_a, account_a, amount_a, subtype, include_block, election_status_a, election_votes_a, *conf_options);
+					message_l = builder.block_confirmed (block_a, account_a, amount_a, subtype, conf_options->get_include_block (), election_status_a, election_votes_a, *conf_options);
 				}
 
-				session_ptr->write (include_block ? msg_with_block.get () : msg_without_block.get ());
+				session_ptr->write (*message_l, payloads[variant]);
 			}
 		}
 	}
+	stats.inc (vxlnetwork::stat::type::websocket, vxlnetwork::stat::detail::fanout, vxlnetwork::stat::dir::out);
+	stats.add (vxlnetwork::stat::type::websocket, vxlnetwork::stat::detail::fanout_us, vxlnetwork::stat::dir::out, std::chrono::duration_cast<std::chrono::microseconds> (std::chrono::steady_clock::now () - start).count ());
 }
 
 void vxlnetwork::websocket::listener::broadcast (vxlnetwork::websocket::message message_a)
 {
-	vxlnetwork::lock_guard<vxlnetwork::mutex> lk (sessions_mutex);
-	for (auto & weak_session : sessions)
+	auto const start (std::chrono::steady_clock::now ());
+	vxlnetwork::websocket::payload payload_l;
 	{
-		auto session_ptr (weak_session.lock ());
-		if (session_ptr)
+		vxlnetwork::lock_guard<vxlnetwork::mutex> lk (sessions_mutex);
+		for (auto & weak_session : sessions)
 		{
-			session_ptr->write (message_a);
+			auto session_ptr (weak_session.lock ());
+			if (session_ptr)
+			{
+				session_ptr->write (message_a, payload_l);
+			}
 		}
 	}
+	stats.inc (vxlnetwork::stat::type::websocket, vxlnetwork::stat::detail::fanout, vxlnetwork::stat::dir::out);
+	stats.add (vxlnetwork::stat::type::websocket, vxlnetwork::stat::detail::fanout_us, vxlnetwork::stat::dir::out, std::chrono::duration_cast<std::chrono::microseconds> (std::chrono::steady_clock::now () - start).count ());
+}
+
+namespace
+{
+vxlnetwork::stat::detail topic_stat_detail (vxlnetwork::websocket::topic topic_a)
+{
+	switch (topic_a)
+	{
+		case vxlnetwork::websocket::topic::ack:
+			return vxlnetwork::stat::detail::ack;
+		case vxlnetwork::websocket::topic::confirmation:
+			return vxlnetwork::stat::detail::confirmation;
+		case vxlnetwork::websocket::topic::stopped_election:
+			return vxlnetwork::stat::detail::stopped_election;
+		case vxlnetwork::websocket::topic::vote:
+			return vxlnetwork::stat::detail::vote;
+		case vxlnetwork::websocket::topic::work:
+			return vxlnetwork::stat::detail::work;
+		case vxlnetwork::websocket::topic::bootstrap:
+			return vxlnetwork::stat::detail::bootstrap;
+		case vxlnetwork::websocket::topic::telemetry:
+			return vxlnetwork::stat::detail::telemetry;
+		case vxlnetwork::websocket::topic::new_unconfirmed_block:
+			return vxlnetwork::stat::detail::new_unconfirmed_block;
+		default:
+			return vxlnetwork::stat::detail::all;
+	}
+}
+}
+
+vxlnetwork::websocket::payload vxlnetwork::websocket::listener::encode (vxlnetwork::websocket::message const & message_a)
+{
+	stats.inc (vxlnetwork::stat::type::websocket, topic_stat_detail (message_a.topic), vxlnetwork::stat::dir::out);
+	auto text (message_a.to_string ());
+	return std::make_shared<std::vector<uint8_t>> (text.begin (), text.end ());
 }
 
 void vxlnetwork::websocket::listener::increase_subscriber_count (vxlnetwork::websocket::topic const & topic_a)
@@ -936,8 +1017,5 @@ void vxlnetwork::websocket::message_builder::set_common_fields (vxlnetwork::webs
 
 std::string vxlnetwork::websocket::message::to_string () const
 {
-	std::ostringstream ostream;
-	boost::property_tree::write_json (ostream, contents);
-	ostream.flush ();
-	return ostream.str ();
+	return vxlnetwork::json_writer::write (contents);
 }
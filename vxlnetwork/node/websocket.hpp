@@ -22,6 +22,7 @@ namespace vxlnetwork
 {
 class wallets;
 class logger_mt;
+class stat;
 class vote;
 class election_status;
 class telemetry_data;
@@ -76,6 +77,9 @@ namespace websocket
 		boost::property_tree::ptree contents;
 	};
 
+	/** An encoded message. Broadcasts encode a message once and share the buffer between all sessions receiving it */
+	using payload = std::shared_ptr<std::vector<uint8_t>>;
+
 	/** Message builder. This is expanded with new builder functions are necessary. */
 	class message_builder final
 	{
@@ -180,6 +184,13 @@ namespace websocket
 			return include_sideband_info;
 		}
 
+		/** Identifies the combination of the options above, confirmation messages built with the same variant have the same contents */
+		std::size_t variant () const
+		{
+			return static_cast<std::size_t> (include_block) | static_cast<std::size_t> (include_election_info) << 1 | static_cast<std::size_t> (include_election_info_with_votes) << 2 | static_cast<std::size_t> (include_sideband_info) << 3;
+		}
+		static constexpr std::size_t variants{ 1 << 4 };
+
 		static constexpr uint8_t const type_active_quorum = 1;
 		static constexpr uint8_t const type_active_confirmation_height = 2;
 		static constexpr uint8_t const type_inactive = 4;
@@ -249,7 +260,13 @@ namespace websocket
 		void read ();
 
 		/** Enqueue \p message_a for writing to the websockets */
-		void write (vxlnetwork::websocket::message message_a);
+		void write (vxlnetwork::websocket::message const & message_a);
+
+		/**
+		 * Enqueue \p message_a for writing to the websockets if it passes the subscription filter.
+		 * The message is encoded into \p payload_a if that is still empty, so callers writing the same message to several sessions encode it only once.
+		 */
+		void write (vxlnetwork::websocket::message const & message_a, vxlnetwork::websocket::payload & payload_a);
 
 	private:
 		/** The owning listener */
@@ -259,7 +276,11 @@ namespace websocket
 		/** Buffer for received messages */
 		boost::beast::multi_buffer read_buffer;
 		/** Outgoing messages. The send queue is protected by accessing it only through the strand */
-		std::deque<message> send_queue;
+		std::deque<vxlnetwork::websocket::payload> send_queue;
+		/** Size of all messages in the send queue, the session is closed instead of exceeding the listener's max_queued_bytes */
+		std::size_t send_queue_bytes{ 0 };
+		/** Set once the send queue overflowed, no further messages are queued. Only accessed through the strand */
+		bool overflowed{ false };
 
 		/** Hash functor for topic enums */
 		struct topic_hash
@@ -280,13 +301,15 @@ namespace websocket
 		void send_ack (std::string action_a, std::string id_a);
 		/** Send all queued messages. This must be called from the write strand. */
 		void write_queued_messages ();
+		/** Queue an encoded message. This must be called from the write strand. */
+		void enqueue (vxlnetwork::websocket::payload const & payload_a);
 	};
 
 	/** Creates a new session for each incoming connection */
 	class listener final : public std::enable_shared_from_this<listener>
 	{
 	public:
-		listener (std::shared_ptr<vxlnetwork::tls_config> const & tls_config_a, vxlnetwork::logger_mt & logger_a, vxlnetwork::wallets & wallets_a, boost::asio::io_context & io_ctx_a, boost::asio::ip::tcp::endpoint endpoint_a);
+		listener (std::shared_ptr<vxlnetwork::tls_config> const & tls_config_a, vxlnetwork::logger_mt & logger_a, vxlnetwork::wallets & wallets_a, vxlnetwork::stat & stats_a, boost::asio::io_context & io_ctx_a, boost::asio::ip::tcp::endpoint endpoint_a, std::size_t max_queued_bytes_a);
 
 		/** Start accepting connections */
 		void run ();
@@ -296,7 +319,10 @@ namespace websocket
 		/** Close all websocket sessions and stop listening for new connections */
 		void stop ();
 
-		/** Broadcast block confirmation. The content of the message depends on subscription options (such as "include_block") */
+		/**
+		 * Broadcast block confirmation. The content of the message depends on subscription options (such as "include_block"),
+		 * the message is built and encoded once for every combination of options in use.
+		 */
 		void broadcast_confirmation (std::shared_ptr<vxlnetwork::block> const & block_a, vxlnetwork::account const & account_a, vxlnetwork::amount const & amount_a, std::string const & subtype, vxlnetwork::election_status const & election_status_a, std::vector<vxlnetwork::vote_with_weight_info> const & election_votes_a);
 
 		/** Broadcast \p message to all session subscribing to the message topic. */
@@ -335,6 +361,9 @@ namespace websocket
 		/** A websocket session can increase and decrease subscription counts. */
 		friend vxlnetwork::websocket::session;
 
+		/** Encodes \p message_a, counting the encodings per topic */
+		vxlnetwork::websocket::payload encode (vxlnetwork::websocket::message const & message_a);
+
 		/** Adds to subscription count of a specific topic*/
 		void increase_subscriber_count (vxlnetwork::websocket::topic const & topic_a);
 		/** Removes from subscription count of a specific topic*/
@@ -343,6 +372,9 @@ namespace websocket
 		std::shared_ptr<vxlnetwork::tls_config> tls_config;
 		vxlnetwork::logger_mt & logger;
 		vxlnetwork::wallets & wallets;
+		vxlnetwork::stat & stats;
+		/** Upper bound for the send queue of a single session */
+		std::size_t const max_queued_bytes;
 		boost::asio::ip::tcp::acceptor acceptor;
 		socket_type socket;
 		vxlnetwork::mutex sessions_mutex;
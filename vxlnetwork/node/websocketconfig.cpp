@@ -14,6 +14,7 @@ vxlnetwork::error vxlnetwork::websocket::config::serialize_toml (vxlnetwork::tom
 	toml.put ("enable", enabled, "Enable or disable WebSocket server.\ntype:bool");
 	toml.put ("address", address, "WebSocket server bind address.\ntype:string,ip");
 	toml.put ("port", port, "WebSocket server listening port.\ntype:uint16");
+	toml.put ("max_queued_bytes", max_queued_bytes, "Maximum size of the messages queued for a single client. Clients which do not keep up and exceed it are disconnected.\ntype:uint64");
 	return toml.get_error ();
 }
 
@@ -24,5 +25,6 @@ vxlnetwork::error vxlnetwork::websocket::config::deserialize_toml (vxlnetwork::t
 	toml.get_optional<boost::asio::ip::address_v6> ("address", address_l, boost::asio::ip::address_v6::loopback ());
 	address = address_l.to_string ();
 	toml.get<uint16_t> ("port", port);
+	toml.get<std::size_t> ("max_queued_bytes", max_queued_bytes);
 	return toml.get_error ();
 }
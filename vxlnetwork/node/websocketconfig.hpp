@@ -22,6 +22,8 @@ namespace websocket
 		bool enabled{ false };
 		uint16_t port;
 		std::string address;
+		/** Sessions whose queue of outgoing messages would grow beyond this size are closed */
+		std::size_t max_queued_bytes{ 16 * 1024 * 1024 };
 		/** Optional TLS config */
 		std::shared_ptr<vxlnetwork::tls_config> tls_config;
 	};
@@ -15,7 +15,11 @@ enum class writer
 	confirmation_height,
 	process_batch,
 	pruning,
-	testing // Used in tests to emulate a write lock
+	final_votes,
+	online_weight,
+	peers,
+	testing, // Used in tests to emulate a write lock
+	count // Number of writers, not a writer itself
 };
 
 class write_guard final
@@ -47,8 +47,16 @@ void vxlnetwork::rpc_connection::write_result (std::string body, unsigned versio
 	if (!responded.test_and_set ())
 	{
 		prepare_head (version, status);
-		res.body () = body;
-		res.prepare_payload ();
+		res.body () = std::move (body);
+		// The complete body is held until the last chunk is written, chunking bounds each socket write rather than memory use
+		if (version >= 11 && res.body ().size () > chunk_size)
+		{
+			res.chunked (true);
+		}
+		else
+		{
+			res.prepare_payload ();
+		}
 	}
 	else
 	{
@@ -61,6 +69,60 @@ void vxlnetwork::rpc_connection::write_completion_handler (std::shared_ptr<vxlne
 	// Intentional no-op
 }
 
+template <typename STREAM_TYPE>
+void vxlnetwork::rpc_connection::write_response (STREAM_TYPE & stream)
+{
+	auto this_l (shared_from_this ());
+	if (!res.chunked ())
+	{
+		boost::beast::http::async_write (stream, res, boost::asio::bind_executor (strand, [this_l] (boost::system::error_code const & ec, size_t bytes_transferred) {
+			this_l->write_completion_handler (this_l);
+		}));
+	}
+	else
+	{
+		// Only the header goes through the serializer, the body follows in chunks of chunk_size
+		auto serializer (std::make_shared<boost::beast::http::response_serializer<boost::beast::http::string_body>> (res));
+		boost::beast::http::async_write_header (stream, *serializer, boost::asio::bind_executor (strand, [this_l, serializer, &stream] (boost::system::error_code const & ec, size_t bytes_transferred) {
+			if (!ec)
+			{
+				this_l->write_chunks (stream, 0);
+			}
+			else
+			{
+				this_l->write_completion_handler (this_l);
+			}
+		}));
+	}
+}
+
+template <typename STREAM_TYPE>
+void vxlnetwork::rpc_connection::write_chunks (STREAM_TYPE & stream, std::size_t offset_a)
+{
+	auto this_l (shared_from_this ());
+	auto const & body (res.body ());
+	if (offset_a < body.size ())
+	{
+		auto size (std::min (chunk_size, body.size () - offset_a));
+		boost::asio::async_write (stream, boost::beast::http::make_chunk (boost::asio::buffer (body.data () + offset_a, size)), boost::asio::bind_executor (strand, [this_l, &stream, next = offset_a + size] (boost::system::error_code const & ec, size_t bytes_transferred) {
+			if (!ec)
+			{
+				this_l->write_chunks (stream, next);
+			}
+			else
+			{
+				this_l->write_completion_handler (this_l);
+			}
+		}));
+	}
+	else
+	{
+		boost::asio::async_write (stream, boost::beast::http::make_chunk_last (), boost::asio::bind_executor (strand, [this_l] (boost::system::error_code const & ec, size_t bytes_transferred) {
+			this_l->write_completion_handler (this_l);
+		}));
+	}
+}
+
 template <typename STREAM_TYPE>
 void vxlnetwork::rpc_connection::read (STREAM_TYPE & stream)
 {
@@ -89,9 +151,7 @@ void vxlnetwork::rpc_connection::read (STREAM_TYPE & stream)
 			// Respond with the reason for the invalid header
 			auto response_handler ([this_l, &stream] (std::string const & tree_a) {
 				this_l->write_result (tree_a, 11);
-				boost::beast::http::async_write (stream, this_l->res, boost::asio::bind_executor (this_l->strand, [this_l] (boost::system::error_code const & ec, size_t bytes_transferred) {
-					this_l->write_completion_handler (this_l);
-				}));
+				this_l->write_response (stream);
 			});
 			vxlnetwork::json_error_response (response_handler, std::string ("Invalid header: ") + ec.message ());
 		}
@@ -117,11 +177,8 @@ void vxlnetwork::rpc_connection::parse_request (STREAM_TYPE & stream, std::share
 				ss << std::hex << std::showbase << reinterpret_cast<uintptr_t> (this_l.get ());
 				auto request_id = ss.str ();
 				auto response_handler ([this_l, version, start, request_id, &stream] (std::string const & tree_a) {
-					auto body = tree_a;
-					this_l->write_result (body, version);
-					boost::beast::http::async_write (stream, this_l->res, boost::asio::bind_executor (this_l->strand, [this_l] (boost::system::error_code const & ec, size_t bytes_transferred) {
-						this_l->write_completion_handler (this_l);
-					}));
+					this_l->write_result (tree_a, version);
+					this_l->write_response (stream);
 
 					std::stringstream ss;
 					if (this_l->rpc_config.rpc_logging.log_rpc)
@@ -173,6 +230,8 @@ void vxlnetwork::rpc_connection::parse_request (STREAM_TYPE & stream, std::share
 	}));
 }
 
+constexpr std::size_t vxlnetwork::rpc_connection::chunk_size;
+
 template void vxlnetwork::rpc_connection::read (socket_type &);
 template void vxlnetwork::rpc_connection::parse_request (socket_type &, std::shared_ptr<boost::beast::http::request_parser<boost::beast::http::empty_body>> const &);
 #ifdef VXLNETWORK_SECURE_RPC
@@ -32,6 +32,12 @@ public:
 	void prepare_head (unsigned version, boost::beast::http::status status = boost::beast::http::status::ok);
 	void write_result (std::string body, unsigned version, boost::beast::http::status status = boost::beast::http::status::ok);
 
+	/**
+	 * HTTP/1.1 responses with a larger body are sent with chunked transfer encoding, in chunks of this size.
+	 * Only the transport is chunked: the handler still produces the whole body before the first chunk is written.
+	 */
+	static std::size_t constexpr chunk_size{ 64 * 1024 };
+
 	socket_type socket;
 	boost::beast::flat_buffer buffer;
 	boost::beast::http::response<boost::beast::http::string_body> res;
@@ -48,5 +54,12 @@ protected:
 
 	template <typename STREAM_TYPE>
 	void parse_request (STREAM_TYPE & stream, std::shared_ptr<boost::beast::http::request_parser<boost::beast::http::empty_body>> const & header_parser);
+
+	/** Writes the response prepared by write_result and calls write_completion_handler once done */
+	template <typename STREAM_TYPE>
+	void write_response (STREAM_TYPE & stream);
+
+	template <typename STREAM_TYPE>
+	void write_chunks (STREAM_TYPE & stream, std::size_t offset);
 };
 }
@@ -6,6 +6,7 @@
 #include <vxlnetwork/node/json_handler.hpp>
 #include <vxlnetwork/node/node_rpc_config.hpp>
 #include <vxlnetwork/rpc/rpc.hpp>
+#include <vxlnetwork/rpc/rpc_connection.hpp>
 #include <vxlnetwork/rpc/rpc_request_processor.hpp>
 #include <vxlnetwork/test_common/system.hpp>
 #include <vxlnetwork/test_common/telemetry.hpp>
@@ -1265,6 +1266,39 @@ TEST (rpc, account_history)
 	}
 }
 
+// Responses larger than rpc_connection::chunk_size are sent with chunked transfer encoding
+TEST (rpc, account_history_chunked)
+{
+	vxlnetwork::system system;
+	auto node = add_ipc_enabled_node (system);
+	vxlnetwork::keypair key;
+	auto latest (node->latest (vxlnetwork::dev::genesis_key.pub));
+	auto balance (vxlnetwork::dev::constants.genesis_amount);
+	auto const sends (400u);
+	for (auto i (0u); i < sends; ++i)
+	{
+		balance -= 1;
+		vxlnetwork::send_block send (latest, key.pub, balance, vxlnetwork::dev::genesis_key.prv, vxlnetwork::dev::genesis_key.pub, *node->work_generate_blocking (latest));
+		ASSERT_EQ (vxlnetwork::process_result::progress, node->process (send).code);
+		latest = send.hash ();
+	}
+	auto const rpc_ctx = add_rpc (system, node);
+	boost::property_tree::ptree request;
+	request.put ("action", "account_history");
+	request.put ("account", vxlnetwork::dev::genesis_key.pub.to_account ());
+	request.put ("count", std::to_string (sends + 1));
+	test_response response (request, rpc_ctx.rpc->listening_port (), system.io_ctx);
+	ASSERT_TIMELY (5s, response.status != 0);
+	ASSERT_EQ (200, response.status);
+	ASSERT_TRUE (response.resp.chunked ());
+	ASSERT_GT (response.resp.body ().size (), vxlnetwork::rpc_connection::chunk_size);
+	auto & history (response.json.get_child ("history"));
+	ASSERT_EQ (sends + 1, history.size ());
+	ASSERT_EQ (latest.to_string (), history.front ().second.get<std::string> ("hash"));
+	ASSERT_EQ (vxlnetwork::dev::genesis->hash ().to_string (), history.back ().second.get<std::string> ("hash"));
+	ASSERT_FALSE (response.json.get_optional<std::string> ("previous").is_initialized ());
+}
+
 TEST (rpc, history_count)
 {
 	vxlnetwork::system system;
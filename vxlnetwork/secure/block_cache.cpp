@@ -0,0 +1,266 @@
+#include <vxlnetwork/lib/blocks.hpp>
+#include <vxlnetwork/lib/stats.hpp>
+#include <vxlnetwork/secure/block_cache.hpp>
+
+std::size_t constexpr vxlnetwork::block_cache::default_max_size;
+std::size_t constexpr vxlnetwork::block_cache::default_shard_count;
+std::size_t constexpr vxlnetwork::block_cache::max_tombstones;
+
+vxlnetwork::block_cache::block_cache (std::size_t max_size_a, std::size_t shard_count_a) :
+	max_shard_size (max_size_a / std::max<std::size_t> (shard_count_a, 1))
+{
+	debug_assert (shard_count_a > 0);
+	shards.reserve (shard_count_a);
+	for (std::size_t i = 0; i < std::max<std::size_t> (shard_count_a, 1); ++i)
+	{
+		shards.push_back (std::make_unique<shard> ());
+	}
+}
+
+std::shared_ptr<vxlnetwork::block> vxlnetwork::block_cache::get (vxlnetwork::block_hash const & hash_a, uint64_t version_a)
+{
+	std::shared_ptr<vxlnetwork::block> result;
+	if (enabled ())
+	{
+		auto & shard_l (shard_for (hash_a));
+		{
+			vxlnetwork::lock_guard<vxlnetwork::mutex> guard (shard_l.mutex);
+			auto existing (shard_l.index.find (hash_a));
+			// Entries are the latest committed state from their version onwards, older snapshots may not see them yet
+			if (existing != shard_l.index.end () && existing->second->version <= version_a)
+			{
+				// Move to the front of the LRU list
+				shard_l.lru.splice (shard_l.lru.begin (), shard_l.lru, existing->second);
+				result = existing->second->block;
+			}
+		}
+		auto stats_l (stats.load ());
+		if (result != nullptr)
+		{
+			++hits;
+			if (stats_l != nullptr)
+			{
+				stats_l->inc (vxlnetwork::stat::type::block_cache, vxlnetwork::stat::detail::hit);
+			}
+		}
+		else
+		{
+			++misses;
+			if (stats_l != nullptr)
+			{
+				stats_l->inc (vxlnetwork::stat::type::block_cache, vxlnetwork::stat::detail::miss);
+			}
+		}
+	}
+	return result;
+}
+
+void vxlnetwork::block_cache::put (std::shared_ptr<vxlnetwork::block> const & block_a, uint64_t version_a)
+{
+	debug_assert (block_a != nullptr && block_a->has_sideband ());
+	auto max_shard_size_l (max_shard_size.load ());
+	auto const size_l (entry_size (*block_a));
+	if (max_shard_size_l >= size_l)
+	{
+		auto const & hash_l (block_a->hash ());
+		auto & shard_l (shard_for (hash_l));
+		uint64_t evicted (0);
+		{
+			vxlnetwork::lock_guard<vxlnetwork::mutex> guard (shard_l.mutex);
+			// Checked under the shard lock so an invalidation of this hash cannot interleave between the check and the insertion
+			auto admit (version_a >= shard_l.min_version && shard_l.index.find (hash_l) == shard_l.index.end ());
+			if (admit)
+			{
+				auto tombstone_l (shard_l.tombstones.find (hash_l));
+				if (tombstone_l != shard_l.tombstones.end ())
+				{
+					admit = tombstone_l->second.pending == 0 && version_a >= tombstone_l->second.version;
+					if (admit)
+					{
+						// The entry now carries the version, its position in resolved is skipped when dropped
+						shard_l.tombstones.erase (tombstone_l);
+					}
+				}
+			}
+			if (admit)
+			{
+				shard_l.lru.push_front (entry{ hash_l, block_a, size_l, version_a });
+				shard_l.index.emplace (hash_l, shard_l.lru.begin ());
+				shard_l.memory += size_l;
+				evicted = trim (shard_l, max_shard_size_l);
+			}
+		}
+		if (evicted > 0)
+		{
+			evictions += evicted;
+			if (auto stats_l = stats.load ())
+			{
+				stats_l->add (vxlnetwork::stat::type::block_cache, vxlnetwork::stat::detail::eviction, vxlnetwork::stat::dir::in, evicted);
+			}
+		}
+	}
+}
+
+void vxlnetwork::block_cache::invalidate (vxlnetwork::block_hash const & hash_a)
+{
+	auto & shard_l (shard_for (hash_a));
+	bool erased (false);
+	{
+		vxlnetwork::lock_guard<vxlnetwork::mutex> guard (shard_l.mutex);
+		// Pending until commit, readers cannot re-insert the old block nor can the uncommitted one be admitted
+		++shard_l.tombstones[hash_a].pending;
+		auto existing (shard_l.index.find (hash_a));
+		if (existing != shard_l.index.end ())
+		{
+			shard_l.memory -= existing->second->size;
+			shard_l.lru.erase (existing->second);
+			shard_l.index.erase (existing);
+			erased = true;
+		}
+	}
+	if (erased)
+	{
+		++invalidations;
+		if (auto stats_l = stats.load ())
+		{
+			stats_l->inc (vxlnetwork::stat::type::block_cache, vxlnetwork::stat::detail::invalidation);
+		}
+	}
+}
+
+void vxlnetwork::block_cache::commit (vxlnetwork::block_hash const & hash_a, uint64_t version_a)
+{
+	auto & shard_l (shard_for (hash_a));
+	vxlnetwork::lock_guard<vxlnetwork::mutex> guard (shard_l.mutex);
+	auto existing (shard_l.tombstones.find (hash_a));
+	debug_assert (existing != shard_l.tombstones.end () && existing->second.pending > 0);
+	if (existing != shard_l.tombstones.end () && existing->second.pending > 0)
+	{
+		auto & tombstone_l (existing->second);
+		tombstone_l.version = std::max (tombstone_l.version, version_a);
+		if (--tombstone_l.pending == 0)
+		{
+			shard_l.resolved.emplace_back (hash_a, tombstone_l.version);
+			while (shard_l.resolved.size () > max_tombstones)
+			{
+				auto const & [hash_l, version_l] = shard_l.resolved.front ();
+				auto oldest (shard_l.tombstones.find (hash_l));
+				// Skip positions superseded by an admission or a later write of the same hash
+				if (oldest != shard_l.tombstones.end () && oldest->second.pending == 0 && oldest->second.version == version_l)
+				{
+					shard_l.min_version = std::max (shard_l.min_version, version_l);
+					shard_l.tombstones.erase (oldest);
+				}
+				shard_l.resolved.pop_front ();
+			}
+		}
+	}
+}
+
+void vxlnetwork::block_cache::clear ()
+{
+	for (auto & shard_l : shards)
+	{
+		vxlnetwork::lock_guard<vxlnetwork::mutex> guard (shard_l->mutex);
+		shard_l->lru.clear ();
+		shard_l->index.clear ();
+		shard_l->memory = 0;
+		shard_l->tombstones.clear ();
+		shard_l->resolved.clear ();
+		shard_l->min_version = 0;
+	}
+}
+
+void vxlnetwork::block_cache::set_max_size (std::size_t max_size_a)
+{
+	auto max_shard_size_l (max_size_a / shards.size ());
+	max_shard_size = max_shard_size_l;
+	uint64_t evicted (0);
+	for (auto & shard_l : shards)
+	{
+		vxlnetwork::lock_guard<vxlnetwork::mutex> guard (shard_l->mutex);
+		evicted += trim (*shard_l, max_shard_size_l);
+	}
+	evictions += evicted;
+}
+
+void vxlnetwork::block_cache::set_stats (vxlnetwork::stat & stats_a)
+{
+	stats = &stats_a;
+}
+
+std::size_t vxlnetwork::block_cache::size () const
+{
+	std::size_t result (0);
+	for (auto const & shard_l : shards)
+	{
+		vxlnetwork::lock_guard<vxlnetwork::mutex> guard (shard_l->mutex);
+		result += shard_l->index.size ();
+	}
+	return result;
+}
+
+std::size_t vxlnetwork::block_cache::memory_size () const
+{
+	std::size_t result (0);
+	for (auto const & shard_l : shards)
+	{
+		vxlnetwork::lock_guard<vxlnetwork::mutex> guard (shard_l->mutex);
+		result += shard_l->memory;
+	}
+	return result;
+}
+
+std::size_t vxlnetwork::block_cache::tombstone_count () const
+{
+	std::size_t result (0);
+	for (auto const & shard_l : shards)
+	{
+		vxlnetwork::lock_guard<vxlnetwork::mutex> guard (shard_l->mutex);
+		result += shard_l->tombstones.size ();
+	}
+	return result;
+}
+
+bool vxlnetwork::block_cache::enabled () const
+{
+	return max_shard_size.load () > 0;
+}
+
+std::size_t vxlnetwork::block_cache::entry_size (vxlnetwork::block const & block_a)
+{
+	auto type (block_a.type ());
+	// Deserialized objects are larger than their wire size, account for the vtable, cached hash and shared_ptr control block as well
+	return vxlnetwork::block::size (type) + sizeof (vxlnetwork::block_sideband) + sizeof (vxlnetwork::block_hash) + sizeof (entry) + 2 * sizeof (void *) + 64;
+}
+
+vxlnetwork::block_cache::shard & vxlnetwork::block_cache::shard_for (vxlnetwork::block_hash const & hash_a)
+{
+	// Block hashes are uniformly distributed, no need to hash them again
+	return *shards[hash_a.qwords[0] % shards.size ()];
+}
+
+uint64_t vxlnetwork::block_cache::trim (shard & shard_a, std::size_t max_shard_size_a)
+{
+	uint64_t result (0);
+	while (shard_a.memory > max_shard_size_a && !shard_a.lru.empty ())
+	{
+		auto & last (shard_a.lru.back ());
+		shard_a.memory -= last.size;
+		shard_a.index.erase (last.hash);
+		shard_a.lru.pop_back ();
+		++result;
+	}
+	return result;
+}
+
+std::unique_ptr<vxlnetwork::container_info_component> vxlnetwork::collect_container_info (block_cache & block_cache, std::string const & name)
+{
+	auto composite = std::make_unique<vxlnetwork::container_info_composite> (name);
+	composite->add_component (std::make_unique<vxlnetwork::container_info_leaf> (container_info{ "blocks", block_cache.size (), block_cache.memory_size () / std::max<std::size_t> (block_cache.size (), 1) }));
+	composite->add_component (std::make_unique<vxlnetwork::container_info_leaf> (container_info{ "tombstones", block_cache.tombstone_count (), sizeof (decltype (block_cache::shard::tombstones)::value_type) }));
+	composite->add_component (std::make_unique<vxlnetwork::container_info_leaf> (container_info{ "hits", block_cache.hits, 0 }));
+	composite->add_component (std::make_unique<vxlnetwork::container_info_leaf> (container_info{ "misses", block_cache.misses, 0 }));
+	composite->add_component (std::make_unique<vxlnetwork::container_info_leaf> (container_info{ "evictions", block_cache.evictions, 0 }));
+	return composite;
+}
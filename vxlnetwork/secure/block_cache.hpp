@@ -0,0 +1,118 @@
+#pragma once
+
+#include <vxlnetwork/lib/locks.hpp>
+#include <vxlnetwork/lib/numbers.hpp>
+#include <vxlnetwork/lib/utility.hpp>
+
+#include <atomic>
+#include <deque>
+#include <list>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+namespace vxlnetwork
+{
+class block;
+class stat;
+
+/**
+ * Sharded, size bounded LRU cache of deserialized blocks (including their sideband) sitting behind block_store::get.
+ * Entries are invalidated by every block store write touching the hash (put, raw_put, successor_clear and del).
+ *
+ * Entries are tagged with the version of the snapshot they were read from and only returned to readers whose snapshot
+ * is at least as new. An invalidation leaves a tombstone for the hash which stays pending until the writing transaction
+ * commits, then records the committed version. Blocks read under a snapshot older than the tombstone are returned to the
+ * caller but not admitted. Resolved tombstones are kept per shard up to a bound, dropping one raises the shard's admission floor.
+ * @note This class is thread-safe.
+ */
+class block_cache final
+{
+public:
+	explicit block_cache (std::size_t max_size_a = default_max_size, std::size_t shard_count_a = default_shard_count);
+
+	/** Returns the cached block or nullptr if not present or cached from a snapshot newer than \p version_a */
+	std::shared_ptr<vxlnetwork::block> get (vxlnetwork::block_hash const & hash_a, uint64_t version_a);
+
+	/** Inserts \p block_a read under snapshot \p version_a unless the hash was written since, evicting least recently used entries when over budget */
+	void put (std::shared_ptr<vxlnetwork::block> const & block_a, uint64_t version_a);
+
+	/** Removes \p hash_a and blocks its admission until a matching call to commit */
+	void invalidate (vxlnetwork::block_hash const & hash_a);
+
+	/** Called once the transaction which invalidated \p hash_a committed, snapshots from \p version_a onwards see the write */
+	void commit (vxlnetwork::block_hash const & hash_a, uint64_t version_a);
+
+	/** Drops all entries and tombstones, must not run concurrently with users of the store */
+	void clear ();
+
+	/** Sets the approximate memory budget in bytes, 0 disables the cache */
+	void set_max_size (std::size_t max_size_a);
+	void set_stats (vxlnetwork::stat & stats_a);
+
+	std::size_t size () const;
+	std::size_t memory_size () const;
+	std::size_t tombstone_count () const;
+	bool enabled () const;
+
+	std::atomic<uint64_t> hits{ 0 };
+	std::atomic<uint64_t> misses{ 0 };
+	std::atomic<uint64_t> evictions{ 0 };
+	std::atomic<uint64_t> invalidations{ 0 };
+
+	static std::size_t constexpr default_max_size = 64 * 1024 * 1024;
+	static std::size_t constexpr default_shard_count = 16;
+	/** Resolved tombstones kept per shard before the oldest ones are folded into the shard's admission floor */
+	static std::size_t constexpr max_tombstones = 1024;
+
+	/** Approximate memory used by a cached block, includes the node and index overhead */
+	static std::size_t entry_size (vxlnetwork::block const &);
+
+private:
+	class entry final
+	{
+	public:
+		vxlnetwork::block_hash hash;
+		std::shared_ptr<vxlnetwork::block> block;
+		std::size_t size;
+		/** Snapshot the block was read from */
+		uint64_t version;
+	};
+
+	class tombstone final
+	{
+	public:
+		/** Oldest snapshot which sees every committed write of the hash */
+		uint64_t version{ 0 };
+		/** Writing transactions not committed yet */
+		unsigned pending{ 0 };
+	};
+
+	class shard final
+	{
+	public:
+		mutable vxlnetwork::mutex mutex{ mutex_identifier (mutexes::blockstore_cache) };
+		/** Most recently used at the front */
+		std::list<entry> lru;
+		std::unordered_map<vxlnetwork::block_hash, std::list<entry>::iterator> index;
+		std::size_t memory{ 0 };
+		std::unordered_map<vxlnetwork::block_hash, tombstone> tombstones;
+		/** Resolved tombstones in commit order */
+		std::deque<std::pair<vxlnetwork::block_hash, uint64_t>> resolved;
+		/** Blocks read under snapshots older than this are not admitted, raised when resolved tombstones are dropped */
+		uint64_t min_version{ 0 };
+	};
+
+	shard & shard_for (vxlnetwork::block_hash const &);
+	/** Must be called with the shard mutex held, returns the number of evicted entries */
+	uint64_t trim (shard &, std::size_t max_shard_size_a);
+
+	std::vector<std::unique_ptr<shard>> shards;
+	std::atomic<std::size_t> max_shard_size;
+	std::atomic<vxlnetwork::stat *> stats{ nullptr };
+
+	friend std::unique_ptr<container_info_component> collect_container_info (block_cache &, std::string const &);
+};
+
+std::unique_ptr<container_info_component> collect_container_info (block_cache & block_cache, std::string const & name);
+}
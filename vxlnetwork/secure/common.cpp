@@ -917,6 +917,11 @@ bool vxlnetwork::unchecked_key::operator== (vxlnetwork::unchecked_key const & ot
 	return previous == other_a.previous && hash == other_a.hash;
 }
 
+bool vxlnetwork::unchecked_key::operator< (vxlnetwork::unchecked_key const & other_a) const
+{
+	return previous != other_a.previous ? previous < other_a.previous : hash < other_a.hash;
+}
+
 vxlnetwork::block_hash const & vxlnetwork::unchecked_key::key () const
 {
 	return previous;
@@ -176,6 +176,7 @@ public:
 	unchecked_key (vxlnetwork::uint512_union const &);
 	bool deserialize (vxlnetwork::stream &);
 	bool operator== (vxlnetwork::unchecked_key const &) const;
+	bool operator< (vxlnetwork::unchecked_key const &) const;
 	vxlnetwork::block_hash const & key () const;
 	vxlnetwork::block_hash previous{ 0 };
 	vxlnetwork::block_hash hash{ 0 };
@@ -750,24 +750,41 @@ vxlnetwork::ledger::ledger (vxlnetwork::store & store_a, vxlnetwork::stat & stat
 
 void vxlnetwork::ledger::initialize (vxlnetwork::generate_cache const & generate_cache_a)
 {
+	vxlnetwork::timer<std::chrono::milliseconds> timer;
+	timer.start ();
 	if (generate_cache_a.reps || generate_cache_a.account_count || generate_cache_a.block_count)
 	{
+		// Every key range sums the weights of its own accounts, the partial sums are merged once the traversal is done
+		vxlnetwork::mutex partial_weights_mutex;
+		std::vector<std::unordered_map<vxlnetwork::account, vxlnetwork::uint128_t>> partial_weights;
 		store.account.for_each_par (
-		[this] (vxlnetwork::read_transaction const & /*unused*/, vxlnetwork::store_iterator<vxlnetwork::account, vxlnetwork::account_info> i, vxlnetwork::store_iterator<vxlnetwork::account, vxlnetwork::account_info> n) {
+		[this, &partial_weights_mutex, &partial_weights] (vxlnetwork::read_transaction const & /*unused*/, vxlnetwork::store_iterator<vxlnetwork::account, vxlnetwork::account_info> i, vxlnetwork::store_iterator<vxlnetwork::account, vxlnetwork::account_info> n) {
 			uint64_t block_count_l{ 0 };
 			uint64_t account_count_l{ 0 };
-			decltype (this->cache.rep_weights) rep_weights_l;
+			std::unordered_map<vxlnetwork::account, vxlnetwork::uint128_t> rep_weights_l;
 			for (; i != n; ++i)
 			{
 				vxlnetwork::account_info const & info (i->second);
 				block_count_l += info.block_count;
 				++account_count_l;
-				rep_weights_l.representation_add (info.representative, info.balance.number ());
+				rep_weights_l[info.representative] += info.balance.number ();
 			}
 			this->cache.block_count += block_count_l;
 			this->cache.account_count += account_count_l;
-			this->cache.rep_weights.copy_from (rep_weights_l);
+			vxlnetwork::lock_guard<vxlnetwork::mutex> guard (partial_weights_mutex);
+			partial_weights.push_back (std::move (rep_weights_l));
 		});
+		initialize_timings.emplace_back ("accounts", timer.restart ());
+		std::unordered_map<vxlnetwork::account, vxlnetwork::uint128_t> rep_weights_l;
+		for (auto const & partial : partial_weights)
+		{
+			for (auto const & [representative, weight] : partial)
+			{
+				rep_weights_l[representative] += weight;
+			}
+		}
+		cache.rep_weights.representation_add_batch ({ rep_weights_l.begin (), rep_weights_l.end () });
+		initialize_timings.emplace_back ("representative weights", timer.restart ());
 	}
 
 	if (generate_cache_a.cemented_count)
@@ -781,10 +798,12 @@ void vxlnetwork::ledger::initialize (vxlnetwork::generate_cache const & generate
 			}
 			this->cache.cemented_count += cemented_count_l;
 		});
+		initialize_timings.emplace_back ("confirmation heights", timer.restart ());
 	}
 
 	auto transaction (store.tx_begin_read ());
 	cache.pruned_count = store.pruned.count (transaction);
+	initialize_timings.emplace_back ("pruned", timer.restart ());
 
 	// Final votes requirement for confirmation canary block
 	vxlnetwork::confirmation_height_info confirmation_height_info;
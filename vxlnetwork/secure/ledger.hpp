@@ -79,6 +79,8 @@ public:
 	uint64_t bootstrap_weight_max_blocks{ 1 };
 	std::atomic<bool> check_bootstrap_weights;
 	bool pruning{ false };
+	/** Time spent in each phase of building the ledger cache, logged at node startup */
+	std::vector<std::pair<std::string, std::chrono::milliseconds>> initialize_timings;
 
 private:
 	void initialize (vxlnetwork::generate_cache const &);
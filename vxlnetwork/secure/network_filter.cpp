@@ -4,8 +4,15 @@
 #include <vxlnetwork/secure/common.hpp>
 #include <vxlnetwork/secure/network_filter.hpp>
 
-vxlnetwork::network_filter::network_filter (size_t size_a) :
-	items (size_a, vxlnetwork::uint128_t{ 0 })
+#include <algorithm>
+
+size_t constexpr vxlnetwork::network_filter::bucket_ways;
+size_t constexpr vxlnetwork::network_filter::stripe_count;
+
+vxlnetwork::network_filter::network_filter (size_t size_a, size_t ways_a) :
+	ways (std::clamp<size_t> (std::min (ways_a, size_a), 1, bucket_ways)),
+	buckets (std::max<size_t> (1, size_a / ways)),
+	stripes (std::make_unique<stripe[]> (stripe_count))
 {
 	vxlnetwork::random_pool::generate_block (key, key.size ());
 }
@@ -13,49 +20,76 @@ vxlnetwork::network_filter::network_filter (size_t size_a) :
 bool vxlnetwork::network_filter::apply (uint8_t const * bytes_a, size_t count_a, vxlnetwork::uint128_t * digest_a)
 {
 	// Get hash before locking
-	auto digest (hash (bytes_a, count_a));
-
-	vxlnetwork::lock_guard<vxlnetwork::mutex> lock (mutex);
-	auto & element (get_element (digest));
-	bool existed (element == digest);
-	if (!existed)
+	auto const digest_l (digest (bytes_a, count_a));
+	auto const index (bucket_index (digest_l));
+	auto & bucket_l (buckets[index]);
+	bool existed;
 	{
-		// Replace likely old element with a new one
-		element = digest;
+		auto & stripe_l (stripe_for (index));
+		vxlnetwork::lock_guard<vxlnetwork::mutex> lock (stripe_l.mutex);
+		auto way (find (bucket_l, digest_l));
+		existed = way < ways;
+		if (existed)
+		{
+			++stripe_l.duplicates;
+		}
+		else
+		{
+			// Take a free way if there is one, otherwise replace the way selected by the digest
+			for (size_t i (0); i < ways && way == ways; ++i)
+			{
+				if (bucket_l.low[i] == 0 && bucket_l.high[i] == 0)
+				{
+					way = i;
+				}
+			}
+			if (way == ways)
+			{
+				way = digest_l[1] % ways;
+				++stripe_l.evictions;
+			}
+			bucket_l.low[way] = digest_l[0];
+			bucket_l.high[way] = digest_l[1];
+		}
 	}
 	if (digest_a)
 	{
-		*digest_a = digest;
+		vxlnetwork::uint128_union digest_union;
+		digest_union.qwords = digest_l;
+		*digest_a = digest_union.number ();
 	}
 	return existed;
 }
 
 void vxlnetwork::network_filter::clear (vxlnetwork::uint128_t const & digest_a)
 {
-	vxlnetwork::lock_guard<vxlnetwork::mutex> lock (mutex);
-	auto & element (get_element (digest_a));
-	if (element == digest_a)
-	{
-		element = vxlnetwork::uint128_t{ 0 };
-	}
+	clear (vxlnetwork::uint128_union{ digest_a }.qwords);
 }
 
 void vxlnetwork::network_filter::clear (std::vector<vxlnetwork::uint128_t> const & digests_a)
 {
-	vxlnetwork::lock_guard<vxlnetwork::mutex> lock (mutex);
 	for (auto const & digest : digests_a)
 	{
-		auto & element (get_element (digest));
-		if (element == digest)
-		{
-			element = vxlnetwork::uint128_t{ 0 };
-		}
+		clear (digest);
 	}
 }
 
 void vxlnetwork::network_filter::clear (uint8_t const * bytes_a, size_t count_a)
 {
-	clear (hash (bytes_a, count_a));
+	clear (digest (bytes_a, count_a));
+}
+
+void vxlnetwork::network_filter::clear (digest_t const & digest_a)
+{
+	auto const index (bucket_index (digest_a));
+	auto & bucket_l (buckets[index]);
+	vxlnetwork::lock_guard<vxlnetwork::mutex> lock (stripe_for (index).mutex);
+	auto way (find (bucket_l, digest_a));
+	if (way < ways)
+	{
+		bucket_l.low[way] = 0;
+		bucket_l.high[way] = 0;
+	}
 }
 
 template <typename OBJECT>
@@ -66,8 +100,14 @@ void vxlnetwork::network_filter::clear (OBJECT const & object_a)
 
 void vxlnetwork::network_filter::clear ()
 {
-	vxlnetwork::lock_guard<vxlnetwork::mutex> lock (mutex);
-	items.assign (items.size (), vxlnetwork::uint128_t{ 0 });
+	for (size_t i (0); i < stripe_count; ++i)
+	{
+		vxlnetwork::lock_guard<vxlnetwork::mutex> lock (stripes[i].mutex);
+		for (auto index (i); index < buckets.size (); index += stripe_count)
+		{
+			buckets[index] = bucket{};
+		}
+	}
 }
 
 template <typename OBJECT>
@@ -81,20 +121,86 @@ vxlnetwork::uint128_t vxlnetwork::network_filter::hash (OBJECT const & object_a)
 	return hash (bytes.data (), bytes.size ());
 }
 
-vxlnetwork::uint128_t & vxlnetwork::network_filter::get_element (vxlnetwork::uint128_t const & hash_a)
+size_t vxlnetwork::network_filter::find (vxlnetwork::network_filter::bucket const & bucket_a, digest_t const & digest_a) const
 {
-	debug_assert (!mutex.try_lock ());
-	debug_assert (items.size () > 0);
-	size_t index (hash_a % items.size ());
-	return items[index];
+	// Compare every way without branching so the loop can be vectorized, the empty digest is never stored
+	unsigned matches (0);
+	for (size_t way (0); way < bucket_ways; ++way)
+	{
+		matches |= static_cast<unsigned> ((bucket_a.low[way] == digest_a[0]) & (bucket_a.high[way] == digest_a[1])) << way;
+	}
+	matches &= (1u << ways) - 1;
+	size_t result (ways);
+	for (size_t way (0); way < ways && result == ways; ++way)
+	{
+		if (matches & (1u << way))
+		{
+			result = way;
+		}
+	}
+	return result;
 }
 
-vxlnetwork::uint128_t vxlnetwork::network_filter::hash (uint8_t const * bytes_a, size_t count_a) const
+size_t vxlnetwork::network_filter::bucket_index (digest_t const & digest_a) const
+{
+	debug_assert (!buckets.empty ());
+	return digest_a[0] % buckets.size ();
+}
+
+vxlnetwork::network_filter::stripe & vxlnetwork::network_filter::stripe_for (size_t bucket_index_a) const
+{
+	return stripes[bucket_index_a % stripe_count];
+}
+
+size_t vxlnetwork::network_filter::size () const
+{
+	return buckets.size () * ways;
+}
+
+uint64_t vxlnetwork::network_filter::evictions () const
+{
+	uint64_t result (0);
+	for (size_t i (0); i < stripe_count; ++i)
+	{
+		vxlnetwork::lock_guard<vxlnetwork::mutex> lock (stripes[i].mutex);
+		result += stripes[i].evictions;
+	}
+	return result;
+}
+
+uint64_t vxlnetwork::network_filter::duplicates () const
+{
+	uint64_t result (0);
+	for (size_t i (0); i < stripe_count; ++i)
+	{
+		vxlnetwork::lock_guard<vxlnetwork::mutex> lock (stripes[i].mutex);
+		result += stripes[i].duplicates;
+	}
+	return result;
+}
+
+std::unique_ptr<vxlnetwork::container_info_component> vxlnetwork::network_filter::collect_container_info (std::string const & name) const
+{
+	auto composite = std::make_unique<container_info_composite> (name);
+	composite->add_component (std::make_unique<container_info_leaf> (container_info{ "items", size (), sizeof (digest_t) }));
+	composite->add_component (std::make_unique<container_info_leaf> (container_info{ "evictions", evictions (), 0 }));
+	composite->add_component (std::make_unique<container_info_leaf> (container_info{ "duplicates", duplicates (), 0 }));
+	return composite;
+}
+
+vxlnetwork::network_filter::digest_t vxlnetwork::network_filter::digest (uint8_t const * bytes_a, size_t count_a) const
 {
 	vxlnetwork::uint128_union digest{ 0 };
 	siphash_t siphash (key, static_cast<unsigned int> (key.size ()));
 	siphash.CalculateDigest (digest.bytes.data (), bytes_a, count_a);
-	return digest.number ();
+	return digest.qwords;
+}
+
+vxlnetwork::uint128_t vxlnetwork::network_filter::hash (uint8_t const * bytes_a, size_t count_a) const
+{
+	vxlnetwork::uint128_union digest_union;
+	digest_union.qwords = digest (bytes_a, count_a);
+	return digest_union.number ();
 }
 
 // Explicitly instantiate
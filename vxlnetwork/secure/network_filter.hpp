@@ -1,26 +1,34 @@
 
 #pragma once
 
+#include <vxlnetwork/lib/locks.hpp>
 #include <vxlnetwork/lib/numbers.hpp>
+#include <vxlnetwork/lib/utility.hpp>
 
 #include <crypto/cryptopp/seckey.h>
 #include <crypto/cryptopp/siphash.h>
 
-#include <mutex>
+#include <array>
+#include <memory>
 
 namespace vxlnetwork
 {
 /**
- * A probabilistic duplicate filter based on directed map caches, using SipHash 2/4/128
+ * A probabilistic duplicate filter based on set associative caches, using SipHash 2/4/128
+ * Digests are stored in cache line sized buckets of up to bucket_ways entries, a full bucket evicts the entry selected by the digest.
  * The probability of false negatives (unique packet marked as duplicate) is the probability of a 128-bit SipHash collision.
- * The probability of false positives (duplicate packet marked as unique) shrinks with a larger filter.
- * @note This class is thread-safe.
+ * The probability of false positives (duplicate packet marked as unique) shrinks with a larger filter and more ways per bucket.
+ * @note This class is thread-safe, buckets are guarded by a fixed number of striped locks.
  */
 class network_filter final
 {
 public:
 	network_filter () = delete;
-	network_filter (size_t size_a);
+	/**
+	 * @param size_a number of digests the filter holds
+	 * @param ways_a number of digests sharing a bucket, 1 makes the filter direct mapped
+	 */
+	network_filter (size_t size_a, size_t ways_a = bucket_ways);
 	/**
 	 * Reads \p count_a bytes starting from \p bytes_a and inserts the siphash digest in the filter.
 	 * @param \p digest_a if given, will be set to the resulting siphash digest
@@ -62,15 +70,50 @@ public:
 	template <typename OBJECT>
 	vxlnetwork::uint128_t hash (OBJECT const & object_a) const;
 
+	/** Number of digests the filter holds */
+	size_t size () const;
+	/** Number of stored digests replaced by a different one, each may let a later duplicate through */
+	uint64_t evictions () const;
+	/** Number of applied digests found in the filter */
+	uint64_t duplicates () const;
+
+	std::unique_ptr<container_info_component> collect_container_info (std::string const & name) const;
+
+	/** Ways that fill one 64 byte cache line, the most a filter can be configured with */
+	static size_t constexpr bucket_ways = 4;
+	/** Number of locks buckets are spread over, it bounds contention only and does not change which digests are kept */
+	static size_t constexpr stripe_count = 64;
+
 private:
 	using siphash_t = CryptoPP::SipHash<2, 4, true>;
+	using digest_t = std::array<uint64_t, 2>;
+
+	/** Halves of each digest are kept in separate arrays so a bucket is probed with two compares over contiguous words */
+	class alignas (64) bucket final
+	{
+	public:
+		std::array<uint64_t, bucket_ways> low{};
+		std::array<uint64_t, bucket_ways> high{};
+	};
+
+	class alignas (64) stripe final
+	{
+	public:
+		vxlnetwork::mutex mutex{ mutex_identifier (mutexes::network_filter) };
+		uint64_t evictions{ 0 };
+		uint64_t duplicates{ 0 };
+	};
 
 	/**
-	 * Get element from digest.
-	 * @note must have a lock on mutex
-	 * @return a reference to the element with key \p hash_a
+	 * Finds \p digest_a in its bucket.
+	 * @note must have a lock on the bucket's stripe
+	 * @return the way holding the digest, or ways if not present
 	 **/
-	vxlnetwork::uint128_t & get_element (vxlnetwork::uint128_t const & hash_a);
+	size_t find (vxlnetwork::network_filter::bucket const &, digest_t const & digest_a) const;
+	size_t bucket_index (digest_t const & digest_a) const;
+	vxlnetwork::network_filter::stripe & stripe_for (size_t bucket_index_a) const;
+	void clear (digest_t const & digest_a);
+	digest_t digest (uint8_t const * bytes_a, size_t count_a) const;
 
 	/**
 	 * Hashes \p count_a bytes starting from \p bytes_a .
@@ -78,8 +121,9 @@ private:
 	 **/
 	vxlnetwork::uint128_t hash (uint8_t const * bytes_a, size_t count_a) const;
 
-	std::vector<vxlnetwork::uint128_t> items;
+	size_t const ways;
+	std::vector<bucket> buckets;
+	std::unique_ptr<stripe[]> stripes;
 	CryptoPP::SecByteBlock key{ siphash_t::KEYLENGTH };
-	vxlnetwork::mutex mutex{ mutex_identifier (mutexes::network_filter) };
 };
 }
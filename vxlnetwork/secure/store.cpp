@@ -79,6 +79,15 @@ vxlnetwork::write_transaction::write_transaction (std::unique_ptr<vxlnetwork::wr
 	debug_assert (vxlnetwork::thread_role::get () != vxlnetwork::thread_role::name::io);
 }
 
+vxlnetwork::write_transaction::~write_transaction ()
+{
+	// Committing here instead of in the implementation's destructor runs the commit callbacks
+	if (impl != nullptr)
+	{
+		commit ();
+	}
+}
+
 void * vxlnetwork::write_transaction::get_handle () const
 {
 	return impl->get_handle ();
@@ -87,6 +96,12 @@ void * vxlnetwork::write_transaction::get_handle () const
 void vxlnetwork::write_transaction::commit ()
 {
 	impl->commit ();
+	auto callbacks (std::move (commit_callbacks));
+	commit_callbacks.clear ();
+	for (auto const & callback : callbacks)
+	{
+		callback ();
+	}
 }
 
 void vxlnetwork::write_transaction::renew ()
@@ -96,7 +111,7 @@ void vxlnetwork::write_transaction::renew ()
 
 void vxlnetwork::write_transaction::refresh ()
 {
-	impl->commit ();
+	commit ();
 	impl->renew ();
 }
 
@@ -105,6 +120,11 @@ bool vxlnetwork::write_transaction::contains (vxlnetwork::tables table_a) const
 	return impl->contains (table_a);
 }
 
+void vxlnetwork::write_transaction::on_commit (std::function<void ()> callback_a) const
+{
+	commit_callbacks.push_back (std::move (callback_a));
+}
+
 // clang-format off
 vxlnetwork::store::store (
 	vxlnetwork::block_store & block_store_a,
@@ -6,6 +6,7 @@
 #include <vxlnetwork/lib/logger_mt.hpp>
 #include <vxlnetwork/lib/memory.hpp>
 #include <vxlnetwork/lib/rocksdbconfig.hpp>
+#include <vxlnetwork/secure/block_cache.hpp>
 #include <vxlnetwork/secure/buffer.hpp>
 #include <vxlnetwork/secure/common.hpp>
 #include <vxlnetwork/secure/versioning.hpp>
@@ -439,6 +440,7 @@ private:
 
 class transaction;
 class store;
+class stat;
 
 /**
  * Determine the representative for this block
@@ -608,14 +610,19 @@ class write_transaction final : public transaction
 {
 public:
 	explicit write_transaction (std::unique_ptr<vxlnetwork::write_transaction_impl> write_transaction_impl);
+	write_transaction (write_transaction &&) = default;
+	~write_transaction ();
 	void * get_handle () const override;
 	void commit ();
 	void renew ();
 	void refresh ();
 	bool contains (vxlnetwork::tables table_a) const;
+	/** Runs \p callback_a once the current transaction has committed, used to publish state derived from its writes */
+	void on_commit (std::function<void ()> callback_a) const;
 
 private:
 	std::unique_ptr<vxlnetwork::write_transaction_impl> impl;
+	mutable std::vector<std::function<void ()>> commit_callbacks;
 };
 
 class ledger_cache;
@@ -643,6 +650,8 @@ class account_store
 public:
 	virtual void put (vxlnetwork::write_transaction const &, vxlnetwork::account const &, vxlnetwork::account_info const &) = 0;
 	virtual bool get (vxlnetwork::transaction const &, vxlnetwork::account const &, vxlnetwork::account_info &) = 0;
+	/** Looks up all \p accounts in a single batch, results are in the same order as the input and empty when not found */
+	virtual std::vector<boost::optional<vxlnetwork::account_info>> batch_get (vxlnetwork::transaction const &, std::vector<vxlnetwork::account> const & accounts) = 0;
 	virtual void del (vxlnetwork::write_transaction const &, vxlnetwork::account const &) = 0;
 	virtual bool exists (vxlnetwork::transaction const &, vxlnetwork::account const &) = 0;
 	virtual size_t count (vxlnetwork::transaction const &) = 0;
@@ -662,6 +671,8 @@ public:
 	virtual void put (vxlnetwork::write_transaction const &, vxlnetwork::pending_key const &, vxlnetwork::pending_info const &) = 0;
 	virtual void del (vxlnetwork::write_transaction const &, vxlnetwork::pending_key const &) = 0;
 	virtual bool get (vxlnetwork::transaction const &, vxlnetwork::pending_key const &, vxlnetwork::pending_info &) = 0;
+	/** Looks up all \p keys in a single batch, results are in the same order as the input and empty when not found */
+	virtual std::vector<boost::optional<vxlnetwork::pending_info>> batch_get (vxlnetwork::transaction const &, std::vector<vxlnetwork::pending_key> const & keys) = 0;
 	virtual bool exists (vxlnetwork::transaction const &, vxlnetwork::pending_key const &) = 0;
 	virtual bool any (vxlnetwork::transaction const &, vxlnetwork::account const &) = 0;
 	virtual vxlnetwork::store_iterator<vxlnetwork::pending_key, vxlnetwork::pending_info> begin (vxlnetwork::transaction const &, vxlnetwork::pending_key const &) const = 0;
@@ -805,6 +816,8 @@ public:
 	virtual vxlnetwork::block_hash successor (vxlnetwork::transaction const &, vxlnetwork::block_hash const &) const = 0;
 	virtual void successor_clear (vxlnetwork::write_transaction const &, vxlnetwork::block_hash const &) = 0;
 	virtual std::shared_ptr<vxlnetwork::block> get (vxlnetwork::transaction const &, vxlnetwork::block_hash const &) const = 0;
+	/** Looks up all \p hashes in a single batch, results are in the same order as the input and nullptr when not found */
+	virtual std::vector<std::shared_ptr<vxlnetwork::block>> batch_get (vxlnetwork::transaction const &, std::vector<vxlnetwork::block_hash> const & hashes) const = 0;
 	virtual std::shared_ptr<vxlnetwork::block> get_no_sideband (vxlnetwork::transaction const &, vxlnetwork::block_hash const &) const = 0;
 	virtual std::shared_ptr<vxlnetwork::block> random (vxlnetwork::transaction const &) = 0;
 	virtual void del (vxlnetwork::write_transaction const &, vxlnetwork::block_hash const &) = 0;
@@ -822,6 +835,16 @@ public:
 	virtual uint64_t account_height (vxlnetwork::transaction const & transaction_a, vxlnetwork::block_hash const & hash_a) const = 0;
 };
 
+/** Serialized key and value of a table entry, pointing into memory owned by the caller */
+class raw_entry final
+{
+public:
+	uint8_t const * key;
+	std::size_t key_size;
+	uint8_t const * value;
+	std::size_t value_size;
+};
+
 class unchecked_map;
 /**
  * Store manager
@@ -864,14 +887,31 @@ public:
 	final_vote_store & final_vote;
 	version_store & version;
 
+	/** Deserialized blocks shared by all block_store::get callers */
+	vxlnetwork::block_cache block_cache;
+
 	virtual unsigned max_block_write_batch_num () const = 0;
 
 	virtual bool copy_db (boost::filesystem::path const & destination) = 0;
 	virtual void rebuild_db (vxlnetwork::write_transaction const & transaction_a) = 0;
 
+	/** Visits the serialized key and value of every entry in \p table_a, in key order */
+	virtual void raw_for_each (vxlnetwork::transaction const & transaction_a, vxlnetwork::tables table_a, std::function<void (vxlnetwork::raw_entry const &)> const & action_a) const = 0;
+	/**
+	 * Writes \p entries_a, sorted by key, to \p table_a in its own write transaction using the backend's bulk loading path.
+	 * Keys must sort after every key already in the table and must not be present in the block cache. Returns true on error
+	 */
+	virtual bool raw_bulk_load (vxlnetwork::tables table_a, std::vector<vxlnetwork::raw_entry> const & entries_a) = 0;
+
 	/** Not applicable to all sub-classes */
 	virtual void serialize_mdb_tracker (boost::property_tree::ptree &, std::chrono::milliseconds, std::chrono::milliseconds){};
 	virtual void serialize_memory_stats (boost::property_tree::ptree &) = 0;
+	/** Adds counters kept by the database engine since the previous call to \p stats. Not applicable to all sub-classes */
+	virtual void export_stats (vxlnetwork::stat &){};
+	/** Starts compacting the database in the background if it is enabled and enough space can be reclaimed. Not applicable to all sub-classes */
+	virtual void compact_if_needed (){};
+	/** Stops a running compaction and waits for it to finish, compact_if_needed does nothing afterwards. Not applicable to all sub-classes */
+	virtual void stop_compaction (){};
 
 	virtual bool init_error () const = 0;
 
@@ -51,6 +51,29 @@ public:
 		return result;
 	}
 
+	std::vector<boost::optional<vxlnetwork::account_info>> batch_get (vxlnetwork::transaction const & transaction_a, std::vector<vxlnetwork::account> const & accounts_a) override
+	{
+		std::vector<vxlnetwork::db_val<Val>> keys (accounts_a.begin (), accounts_a.end ());
+		std::vector<vxlnetwork::db_val<Val>> values;
+		std::vector<int> statuses;
+		store.batch_get (transaction_a, tables::accounts, keys, values, statuses);
+		std::vector<boost::optional<vxlnetwork::account_info>> result (accounts_a.size ());
+		for (std::size_t i = 0; i < accounts_a.size (); ++i)
+		{
+			release_assert (store.success (statuses[i]) || store.not_found (statuses[i]));
+			if (store.success (statuses[i]))
+			{
+				vxlnetwork::account_info info;
+				vxlnetwork::bufferstream stream (reinterpret_cast<uint8_t const *> (values[i].data ()), values[i].size ());
+				if (!info.deserialize (stream))
+				{
+					result[i] = info;
+				}
+			}
+		}
+		return result;
+	}
+
 	void del (vxlnetwork::write_transaction const & transaction_a, vxlnetwork::account const & account_a) override
 	{
 		auto status = store.del (transaction_a, tables::accounts, account_a);
@@ -51,6 +51,7 @@ public:
 		vxlnetwork::db_val<Val> value{ data.size (), (void *)data.data () };
 		auto status = store.put (transaction_a, tables::blocks, hash_a, value);
 		release_assert_success (store, status);
+		invalidate (transaction_a, hash_a);
 	}
 
 	vxlnetwork::block_hash successor (vxlnetwork::transaction const & transaction_a, vxlnetwork::block_hash const & hash_a) const override
@@ -85,20 +86,56 @@ public:
 
 	std::shared_ptr<vxlnetwork::block> get (vxlnetwork::transaction const & transaction_a, vxlnetwork::block_hash const & hash_a) const override
 	{
-		auto value (block_raw_get (transaction_a, hash_a));
-		std::shared_ptr<vxlnetwork::block> result;
-		if (value.size () != 0)
+		auto const version (cache_version (transaction_a));
+		auto result (store.block_cache.get (hash_a, version));
+		if (result == nullptr)
 		{
-			vxlnetwork::bufferstream stream (reinterpret_cast<uint8_t const *> (value.data ()), value.size ());
-			vxlnetwork::block_type type;
-			auto error (try_read (stream, type));
-			release_assert (!error);
-			result = vxlnetwork::deserialize_block (stream, type);
-			release_assert (result != nullptr);
-			vxlnetwork::block_sideband sideband;
-			error = (sideband.deserialize (stream, type));
-			release_assert (!error);
-			result->sideband_set (sideband);
+			result = get_uncached (transaction_a, hash_a);
+			if (result != nullptr && store.block_cache.enabled () && version != write_version)
+			{
+				store.block_cache.put (result, version);
+			}
+		}
+		return result;
+	}
+
+	std::shared_ptr<vxlnetwork::block> get_uncached (vxlnetwork::transaction const & transaction_a, vxlnetwork::block_hash const & hash_a) const
+	{
+		return block_from_raw (block_raw_get (transaction_a, hash_a));
+	}
+
+	std::vector<std::shared_ptr<vxlnetwork::block>> batch_get (vxlnetwork::transaction const & transaction_a, std::vector<vxlnetwork::block_hash> const & hashes_a) const override
+	{
+		std::vector<std::shared_ptr<vxlnetwork::block>> result (hashes_a.size ());
+		auto const version (cache_version (transaction_a));
+		// Only blocks missing from the cache go to the database
+		std::vector<std::size_t> missing;
+		std::vector<vxlnetwork::db_val<Val>> keys;
+		for (std::size_t i = 0; i < hashes_a.size (); ++i)
+		{
+			result[i] = store.block_cache.get (hashes_a[i], version);
+			if (result[i] == nullptr)
+			{
+				missing.push_back (i);
+				keys.emplace_back (hashes_a[i]);
+			}
+		}
+		if (!keys.empty ())
+		{
+			std::vector<vxlnetwork::db_val<Val>> values;
+			std::vector<int> statuses;
+			store.batch_get (transaction_a, tables::blocks, keys, values, statuses);
+			auto const cache_enabled (store.block_cache.enabled () && version != write_version);
+			for (std::size_t i = 0; i < missing.size (); ++i)
+			{
+				release_assert (store.success (statuses[i]) || store.not_found (statuses[i]));
+				auto & block (result[missing[i]]);
+				block = block_from_raw (values[i]);
+				if (block != nullptr && cache_enabled)
+				{
+					store.block_cache.put (block, version);
+				}
+			}
 		}
 		return result;
 	}
@@ -134,6 +171,7 @@ public:
 	{
 		auto status = store.del (transaction_a, tables::blocks, hash_a);
 		release_assert_success (store, status);
+		invalidate (transaction_a, hash_a);
 	}
 
 	bool exists (vxlnetwork::transaction const & transaction_a, vxlnetwork::block_hash const & hash_a) override
@@ -241,6 +279,30 @@ public:
 	}
 
 protected:
+	/** Write transactions read the latest committed state, their own writes are tombstoned until commit */
+	static uint64_t constexpr write_version = std::numeric_limits<uint64_t>::max ();
+
+	/**
+	 * Version blocks read by \p transaction_a are cached and looked up with. Write transactions may use every cached block
+	 * but never insert, what they read could be one of their own uncommitted writes.
+	 */
+	uint64_t cache_version (vxlnetwork::transaction const & transaction_a) const
+	{
+		if (dynamic_cast<vxlnetwork::write_transaction const *> (&transaction_a) != nullptr)
+		{
+			return write_version;
+		}
+		return store.snapshot_version (transaction_a);
+	}
+
+	void invalidate (vxlnetwork::write_transaction const & transaction_a, vxlnetwork::block_hash const & hash_a)
+	{
+		store.block_cache.invalidate (hash_a);
+		transaction_a.on_commit ([&store = store, hash_a] () {
+			store.block_cache.commit (hash_a, store.committed_version ());
+		});
+	}
+
 	vxlnetwork::db_val<Val> block_raw_get (vxlnetwork::transaction const & transaction_a, vxlnetwork::block_hash const & hash_a) const
 	{
 		vxlnetwork::db_val<Val> result;
@@ -249,6 +311,26 @@ protected:
 		return result;
 	}
 
+	/** Deserializes a block and its sideband, nullptr if \p value_a is empty */
+	static std::shared_ptr<vxlnetwork::block> block_from_raw (vxlnetwork::db_val<Val> const & value_a)
+	{
+		std::shared_ptr<vxlnetwork::block> result;
+		if (value_a.size () != 0)
+		{
+			vxlnetwork::bufferstream stream (reinterpret_cast<uint8_t const *> (value_a.data ()), value_a.size ());
+			vxlnetwork::block_type type;
+			auto error (try_read (stream, type));
+			release_assert (!error);
+			result = vxlnetwork::deserialize_block (stream, type);
+			release_assert (result != nullptr);
+			vxlnetwork::block_sideband sideband;
+			error = (sideband.deserialize (stream, type));
+			release_assert (!error);
+			result->sideband_set (sideband);
+		}
+		return result;
+	}
+
 	size_t block_successor_offset (vxlnetwork::transaction const & transaction_a, size_t entry_size_a, vxlnetwork::block_type type_a) const
 	{
 		return entry_size_a - vxlnetwork::block_sideband::size (type_a);
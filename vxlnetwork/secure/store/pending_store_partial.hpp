@@ -56,15 +56,38 @@ public:
 		return result;
 	}
 
+	std::vector<boost::optional<vxlnetwork::pending_info>> batch_get (vxlnetwork::transaction const & transaction_a, std::vector<vxlnetwork::pending_key> const & keys_a) override
+	{
+		std::vector<vxlnetwork::db_val<Val>> keys (keys_a.begin (), keys_a.end ());
+		std::vector<vxlnetwork::db_val<Val>> values;
+		std::vector<int> statuses;
+		store.batch_get (transaction_a, tables::pending, keys, values, statuses);
+		std::vector<boost::optional<vxlnetwork::pending_info>> result (keys_a.size ());
+		for (std::size_t i = 0; i < keys_a.size (); ++i)
+		{
+			release_assert (store.success (statuses[i]) || store.not_found (statuses[i]));
+			if (store.success (statuses[i]))
+			{
+				vxlnetwork::pending_info info;
+				vxlnetwork::bufferstream stream (reinterpret_cast<uint8_t const *> (values[i].data ()), values[i].size ());
+				if (!info.deserialize (stream))
+				{
+					result[i] = info;
+				}
+			}
+		}
+		return result;
+	}
+
 	bool exists (vxlnetwork::transaction const & transaction_a, vxlnetwork::pending_key const & key_a) override
 	{
-		auto iterator (begin (transaction_a, key_a));
+		auto iterator (store.template make_prefix_iterator<vxlnetwork::pending_key, vxlnetwork::pending_info> (transaction_a, tables::pending, vxlnetwork::db_val<Val> (key_a)));
 		return iterator != end () && vxlnetwork::pending_key (iterator->first) == key_a;
 	}
 
 	bool any (vxlnetwork::transaction const & transaction_a, vxlnetwork::account const & account_a) override
 	{
-		auto iterator (begin (transaction_a, vxlnetwork::pending_key (account_a, 0)));
+		auto iterator (store.template make_prefix_iterator<vxlnetwork::pending_key, vxlnetwork::pending_info> (transaction_a, tables::pending, vxlnetwork::db_val<Val> (vxlnetwork::pending_key (account_a, 0))));
 		return iterator != end () && vxlnetwork::pending_key (iterator->first).account == account_a;
 	}
 
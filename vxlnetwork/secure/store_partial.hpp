@@ -20,6 +20,7 @@
 
 #include <crypto/cryptopp/words.h>
 
+#include <future>
 #include <thread>
 
 class store_partial;
@@ -149,6 +150,13 @@ protected:
 		return static_cast<Derived_Store const &> (*this).template make_iterator<Key, Value> (transaction_a, table_a, key);
 	}
 
+	/** Iterator for entries sharing the key prefix of \p key, it may or may not continue past them so callers still compare prefixes */
+	template <typename Key, typename Value>
+	vxlnetwork::store_iterator<Key, Value> make_prefix_iterator (vxlnetwork::transaction const & transaction_a, tables table_a, vxlnetwork::db_val<Val> const & key) const
+	{
+		return static_cast<Derived_Store const &> (*this).template make_prefix_iterator<Key, Value> (transaction_a, table_a, key);
+	}
+
 	uint64_t count (vxlnetwork::transaction const & transaction_a, std::initializer_list<tables> dbs_a) const
 	{
 		uint64_t total_count = 0;
@@ -164,6 +172,12 @@ protected:
 		return static_cast<Derived_Store const &> (*this).get (transaction_a, table_a, key_a, value_a);
 	}
 
+	/** Point lookup of every key in \p keys_a, \p values_a and \p statuses_a are filled in the same order as the keys */
+	void batch_get (vxlnetwork::transaction const & transaction_a, tables table_a, std::vector<vxlnetwork::db_val<Val>> const & keys_a, std::vector<vxlnetwork::db_val<Val>> & values_a, std::vector<int> & statuses_a) const
+	{
+		static_cast<Derived_Store const &> (*this).batch_get (transaction_a, table_a, keys_a, values_a, statuses_a);
+	}
+
 	int put (vxlnetwork::write_transaction const & transaction_a, tables table_a, vxlnetwork::db_val<Val> const & key_a, vxlnetwork::db_val<Val> const & value_a)
 	{
 		return static_cast<Derived_Store &> (*this).put (transaction_a, table_a, key_a, value_a);
@@ -186,6 +200,11 @@ protected:
 	virtual bool success (int status) const = 0;
 	virtual int status_code_not_found () const = 0;
 	virtual std::string error_string (int status) const = 0;
+
+	/** Monotonic version of the snapshot seen by the read transaction \p transaction_a, used to version block cache entries */
+	virtual uint64_t snapshot_version (vxlnetwork::transaction const & transaction_a) const = 0;
+	/** Version of the latest committed write, snapshots with at least this version see it */
+	virtual uint64_t committed_version () const = 0;
 };
 }
 
@@ -196,24 +215,36 @@ void parallel_traversal (std::function<void (T const &, T const &, bool const)>
 {
 	// Between 10 and 40 threads, scales well even in low power systems as long as actions are I/O bound
 	unsigned const thread_count = std::max (10u, std::min (40u, 10 * std::thread::hardware_concurrency ()));
+	// The key space is split into more ranges than threads so that a slow range (cold pages, denser keys) doesn't hold up the whole traversal
+	unsigned const range_count = thread_count * 4;
 	T const value_max{ std::numeric_limits<T>::max () };
-	T const split = value_max / thread_count;
-	std::vector<std::thread> threads;
-	threads.reserve (thread_count);
-	for (unsigned thread (0); thread < thread_count; ++thread)
+	T const split = value_max / range_count;
+	vxlnetwork::thread_pool pool (thread_count, vxlnetwork::thread_role::name::db_parallel_traversal);
+	std::vector<std::future<void>> ranges;
+	ranges.reserve (range_count);
+	for (unsigned range (0); range < range_count; ++range)
 	{
-		T const start = thread * split;
-		T const end = (thread + 1) * split;
-		bool const is_last = thread == thread_count - 1;
+		T const start = range * split;
+		T const end = (range + 1) * split;
+		bool const is_last = range == range_count - 1;
 
-		threads.emplace_back ([&action, start, end, is_last] {
-			vxlnetwork::thread_role::set (vxlnetwork::thread_role::name::db_parallel_traversal);
+		// An exception thrown by the action is stored in the future instead of leaving it unset
+		auto task (std::make_shared<std::packaged_task<void ()>> ([&action, start, end, is_last] {
 			action (start, end, is_last);
+		}));
+		ranges.push_back (task->get_future ());
+		pool.push_task ([task] {
+			(*task) ();
 		});
 	}
-	for (auto & thread : threads)
+	// Every range finishes before rethrowing, the actions reference state owned by the caller
+	for (auto & range : ranges)
+	{
+		range.wait ();
+	}
+	for (auto & range : ranges)
 	{
-		thread.join ();
+		range.get ();
 	}
 }
 }
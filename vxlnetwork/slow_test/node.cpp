@@ -1,6 +1,13 @@
+#include <vxlnetwork/boost/asio/local/stream_protocol.hpp>
+#include <vxlnetwork/boost/asio/read.hpp>
+#include <vxlnetwork/boost/asio/write.hpp>
 #include <vxlnetwork/crypto_lib/random_pool.hpp>
+#include <vxlnetwork/lib/ipc_client.hpp>
+#include <vxlnetwork/lib/ipc_shm.hpp>
 #include <vxlnetwork/lib/threading.hpp>
+#include <vxlnetwork/lib/timer.hpp>
 #include <vxlnetwork/node/election.hpp>
+#include <vxlnetwork/node/ipc/ipc_server.hpp>
 #include <vxlnetwork/node/transport/udp.hpp>
 #include <vxlnetwork/node/unchecked_map.hpp>
 #include <vxlnetwork/test_common/network.hpp>
@@ -9,9 +16,12 @@
 
 #include <gtest/gtest.h>
 
+#include <boost/asio/local/connect_pair.hpp>
+#include <boost/endian/conversion.hpp>
 #include <boost/format.hpp>
 #include <boost/unordered_set.hpp>
 
+#include <future>
 #include <numeric>
 #include <random>
 
@@ -260,15 +270,14 @@ TEST (node, fork_storm)
 		auto empty = 0;
 		auto single = 0;
 		std::for_each (system.nodes.begin (), system.nodes.end (), [&] (std::shared_ptr<vxlnetwork::node> const & node_a) {
-			if (node_a->active.empty ())
+			auto elections = node_a->active.list_active (1);
+			if (elections.empty ())
 			{
 				++empty;
 			}
 			else
 			{
-				vxlnetwork::unique_lock<vxlnetwork::mutex> lock (node_a->active.mutex);
-				auto election = node_a->active.roots.begin ()->election;
-				lock.unlock ();
+				auto election = elections.front ();
 				if (election->votes ().size () == 1)
 				{
 					++single;
@@ -1788,11 +1797,7 @@ TEST (node, mass_block_new)
 		next_block_count += num_blocks;
 		node.block_processor.flush ();
 		// Clear all active
-		{
-			vxlnetwork::lock_guard<vxlnetwork::mutex> guard (node.active.mutex);
-			node.active.roots.clear ();
-			node.active.blocks.clear ();
-		}
+		node.active.clear ();
 	};
 
 	vxlnetwork::keypair key;
@@ -1933,3 +1938,576 @@ TEST (node, wallet_create_block_confirm_conflicts)
 		t.join ();
 	}
 }
+
+namespace
+{
+/** The previous representative weight table, a single mutex around an unordered_map, kept as a baseline */
+class locked_rep_weights
+{
+public:
+	void representation_add (vxlnetwork::account const & representative_a, vxlnetwork::uint128_t const & amount_a)
+	{
+		vxlnetwork::lock_guard<vxlnetwork::mutex> guard (mutex);
+		rep_amounts[representative_a] += amount_a;
+	}
+	vxlnetwork::uint128_t representation_get (vxlnetwork::account const & representative_a) const
+	{
+		vxlnetwork::lock_guard<vxlnetwork::mutex> guard (mutex);
+		auto existing (rep_amounts.find (representative_a));
+		return existing != rep_amounts.end () ? existing->second : vxlnetwork::uint128_t{ 0 };
+	}
+	std::unordered_map<vxlnetwork::account, vxlnetwork::uint128_t> get_rep_amounts () const
+	{
+		vxlnetwork::lock_guard<vxlnetwork::mutex> guard (mutex);
+		return rep_amounts;
+	}
+
+private:
+	mutable vxlnetwork::mutex mutex;
+	std::unordered_map<vxlnetwork::account, vxlnetwork::uint128_t> rep_amounts;
+};
+
+/**
+ * Reader threads look up random representatives for a fixed duration while one writer keeps applying deltas,
+ * as the block processor does while votes are processed. Returns the number of lookups per second
+ */
+template <typename Weights>
+double rep_weights_read_throughput (Weights & weights_a, std::vector<vxlnetwork::account> const & representatives_a, unsigned readers_a, std::chrono::milliseconds duration_a)
+{
+	std::atomic<bool> stop{ false };
+	std::atomic<uint64_t> reads{ 0 };
+	std::vector<std::thread> threads;
+	for (auto i (0u); i < readers_a; ++i)
+	{
+		threads.emplace_back ([&, i] () {
+			std::mt19937 rng (i);
+			std::uniform_int_distribution<std::size_t> distribution (0, representatives_a.size () - 1);
+			uint64_t reads_l{ 0 };
+			vxlnetwork::uint128_t total{ 0 };
+			while (!stop)
+			{
+				total += weights_a.representation_get (representatives_a[distribution (rng)]);
+				++reads_l;
+			}
+			reads += reads_l;
+			ASSERT_NE (0, total);
+		});
+	}
+	threads.emplace_back ([&] () {
+		std::mt19937 rng (readers_a);
+		std::uniform_int_distribution<std::size_t> distribution (0, representatives_a.size () - 1);
+		while (!stop)
+		{
+			auto const & representative (representatives_a[distribution (rng)]);
+			weights_a.representation_add (representative, 1);
+			weights_a.representation_add (representative, 0 - vxlnetwork::uint128_t{ 1 });
+		}
+	});
+	std::this_thread::sleep_for (duration_a);
+	stop = true;
+	for (auto & thread : threads)
+	{
+		thread.join ();
+	}
+	return reads / std::chrono::duration<double> (duration_a).count ();
+}
+}
+
+TEST (rep_weights, read_throughput_benchmark)
+{
+	std::size_t count (100000);
+	auto count_env_var = std::getenv ("SLOW_TEST_REP_WEIGHTS_COUNT");
+	if (count_env_var)
+	{
+		count = boost::lexical_cast<std::size_t> (count_env_var);
+		std::cout << "count override due to env variable set, count=" << count << std::endl;
+	}
+	std::vector<vxlnetwork::account> representatives (count);
+	vxlnetwork::rep_weights weights;
+	locked_rep_weights baseline;
+	for (auto & representative : representatives)
+	{
+		vxlnetwork::random_pool::generate_block (representative.bytes.data (), representative.bytes.size ());
+		weights.representation_add (representative, vxlnetwork::Gxrb_ratio);
+		baseline.representation_add (representative, vxlnetwork::Gxrb_ratio);
+	}
+	ASSERT_EQ (count, weights.size ());
+	auto const threads (std::max (2u, std::thread::hardware_concurrency ()));
+	for (auto readers : { 1u, threads / 2, threads })
+	{
+		auto const baseline_reads (rep_weights_read_throughput (baseline, representatives, readers, 1s));
+		auto const reads (rep_weights_read_throughput (weights, representatives, readers, 1s));
+		std::cout << boost::str (boost::format ("%1% readers: mutex %2$.0f reads/s, lock-free %3$.0f reads/s (x%4$.2f)") % readers % baseline_reads % reads % (reads / baseline_reads)) << std::endl;
+	}
+	vxlnetwork::timer<std::chrono::microseconds> timer;
+	timer.start ();
+	auto rep_amounts (baseline.get_rep_amounts ());
+	auto const baseline_copy (timer.restart ());
+	auto snapshot (weights.get_snapshot ());
+	auto const snapshot_copy (timer.stop ());
+	ASSERT_EQ (rep_amounts.size (), snapshot.size ());
+	std::cout << boost::str (boost::format ("Copy of %1% weights: unordered_map %2% us, snapshot %3% us") % count % baseline_copy.count () % snapshot_copy.count ()) << std::endl;
+}
+
+namespace vxlnetwork
+{
+// Representatives keep switching between two forks, compares the incremental tally with recomputing it on every vote.
+// Both paths vote through election::vote and read the tally after every vote, alternating round by round
+TEST (election, tally_benchmark)
+{
+	std::size_t voters (1000);
+	auto voters_env_var = std::getenv ("SLOW_TEST_ELECTION_VOTERS");
+	if (voters_env_var)
+	{
+		voters = boost::lexical_cast<std::size_t> (voters_env_var);
+		std::cout << "voters override due to env variable set, voters=" << voters << std::endl;
+	}
+	std::size_t const rounds (10);
+	vxlnetwork::system system{};
+	vxlnetwork::node_config node_config{ vxlnetwork::get_available_port (), system.logging };
+	node_config.online_weight_minimum = vxlnetwork::dev::constants.genesis_amount;
+	node_config.frontiers_confirmation = vxlnetwork::frontiers_confirmation_mode::disabled;
+	auto & node = *system.add_node (node_config);
+	std::array<std::shared_ptr<vxlnetwork::block>, 2> forks;
+	auto election (vxlnetwork::start_fork_election (system, node, forks));
+	ASSERT_NE (nullptr, election);
+
+	// All voters together stay far below quorum
+	std::vector<vxlnetwork::account> reps (voters);
+	for (auto & rep : reps)
+	{
+		vxlnetwork::random_pool::generate_block (rep.bytes.data (), rep.bytes.size ());
+		node.ledger.cache.rep_weights.representation_put (rep, vxlnetwork::dev::constants.genesis_amount / (100 * voters));
+	}
+	// Let the election take the new weights
+	node.online_reps.sample ();
+	std::chrono::microseconds incremental{ 0 };
+	std::chrono::microseconds recomputed{ 0 };
+	vxlnetwork::timer<std::chrono::microseconds> timer;
+	for (std::size_t round (0); round < rounds; ++round)
+	{
+		// The baseline reads a tally recomputed from every vote with the current ledger weights, as elections did before
+		auto const baseline (round % 2 == 0);
+		for (std::size_t i (0); i < reps.size (); ++i)
+		{
+			timer.start ();
+			auto result (election->vote (reps[i], round + 1, forks[(i + round) % 2]->hash ()));
+			if (baseline)
+			{
+				vxlnetwork::lock_guard<vxlnetwork::mutex> guard (election->mutex);
+				ASSERT_FALSE (vxlnetwork::recompute_tally (node.ledger, election->last_votes).empty ());
+			}
+			else
+			{
+				ASSERT_FALSE (election->tally ().empty ());
+			}
+			(baseline ? recomputed : incremental) += timer.stop ();
+			ASSERT_TRUE (result.processed);
+		}
+		// Let the next round pass the vote cooldown
+		vxlnetwork::lock_guard<vxlnetwork::mutex> guard (election->mutex);
+		for (auto & [account, info] : election->last_votes)
+		{
+			info.time = std::chrono::steady_clock::now () - std::chrono::seconds (20);
+		}
+	}
+	ASSERT_FALSE (election->confirmed ());
+	ASSERT_EQ (vxlnetwork::recompute_tally (node.ledger, election->votes ()), vxlnetwork::tally_weights (election->tally ()));
+	auto const incremental_votes (voters * (rounds / 2));
+	auto const recomputed_votes (voters * (rounds - rounds / 2));
+	std::cout << boost::str (boost::format ("%1% voters: incremental %2% votes in %3% us (%4$.2f us/vote), recomputing %5% votes in %6% us (%7$.2f us/vote)") % voters % incremental_votes % incremental.count () % (incremental.count () / static_cast<double> (incremental_votes)) % recomputed_votes % recomputed.count () % (recomputed.count () / static_cast<double> (recomputed_votes))) << std::endl;
+}
+}
+
+// Concurrent election lookups as done by vote processing, compares the sharded container with every lookup serialized on the active mutex as before
+TEST (active_transactions, lookup_contention_benchmark)
+{
+	std::size_t const elections_count (1000);
+	std::size_t const lookups_per_thread (200000);
+	std::size_t const threads_count (std::max (4u, std::thread::hardware_concurrency ()));
+	vxlnetwork::system system{};
+	vxlnetwork::node_config node_config{ vxlnetwork::get_available_port (), system.logging };
+	node_config.frontiers_confirmation = vxlnetwork::frontiers_confirmation_mode::disabled;
+	node_config.active_elections_size = 2 * elections_count;
+	auto & node = *system.add_node (node_config);
+	vxlnetwork::state_block_builder builder{};
+	std::vector<vxlnetwork::block_hash> hashes;
+	auto latest_hash = vxlnetwork::dev::genesis->hash ();
+	for (std::size_t i (0); i < elections_count; ++i)
+	{
+		auto send = builder.make_block ()
+					.previous (latest_hash)
+					.account (vxlnetwork::dev::genesis_key.pub)
+					.representative (vxlnetwork::dev::genesis_key.pub)
+					.balance (vxlnetwork::dev::constants.genesis_amount - i - 1)
+					.link (vxlnetwork::dev::genesis_key.pub)
+					.work (*system.work.generate (latest_hash))
+					.sign (vxlnetwork::dev::genesis_key.prv, vxlnetwork::dev::genesis_key.pub)
+					.build_shared ();
+		ASSERT_EQ (vxlnetwork::process_result::progress, node.process (*send).code);
+		latest_hash = send->hash ();
+		hashes.push_back (latest_hash);
+		node.block_confirm (send);
+	}
+	node.scheduler.flush ();
+	ASSERT_EQ (elections_count, node.active.size ());
+
+	// One thread lists the elections like the request loop, the others look up block hashes like vote processing
+	auto run = [&] (bool serialized_a) {
+		std::atomic<bool> done{ false };
+		std::atomic<std::size_t> found{ 0 };
+		std::atomic<std::size_t> listed{ 0 };
+		std::thread request_loop ([&] () {
+			while (!done)
+			{
+				if (serialized_a)
+				{
+					vxlnetwork::lock_guard<vxlnetwork::mutex> guard (node.active.mutex);
+					listed += node.active.list_active ().size ();
+				}
+				else
+				{
+					listed += node.active.list_active ().size ();
+				}
+			}
+		});
+		vxlnetwork::timer<std::chrono::milliseconds> timer (vxlnetwork::timer_state::started);
+		std::vector<std::thread> threads;
+		for (std::size_t t (0); t < threads_count; ++t)
+		{
+			threads.emplace_back ([&, t] () {
+				std::size_t found_l (0);
+				for (std::size_t i (0); i < lookups_per_thread; ++i)
+				{
+					auto const & hash (hashes[(i * 7 + t) % hashes.size ()]);
+					if (serialized_a)
+					{
+						vxlnetwork::lock_guard<vxlnetwork::mutex> guard (node.active.mutex);
+						found_l += node.active.active (hash);
+					}
+					else
+					{
+						found_l += node.active.active (hash);
+					}
+				}
+				found += found_l;
+			});
+		}
+		for (auto & thread : threads)
+		{
+			thread.join ();
+		}
+		auto const elapsed (timer.stop ());
+		done = true;
+		request_loop.join ();
+		// Without votes the elections stay active far longer than the benchmark runs, every lookup finds its election
+		EXPECT_EQ (elections_count, node.active.size ());
+		EXPECT_EQ (threads_count * lookups_per_thread, found);
+		return std::make_pair (elapsed, listed.load ());
+	};
+
+	auto const [serialized, serialized_listed] = run (true);
+	auto const [sharded, sharded_listed] = run (false);
+	auto const lookups (threads_count * lookups_per_thread);
+	auto per_second = [lookups] (std::chrono::milliseconds const & elapsed_a) {
+		return lookups * 1000 / std::max<uint64_t> (elapsed_a.count (), 1);
+	};
+	std::cout << boost::str (boost::format ("%1% threads, %2% lookups over %3% elections: active mutex %4% ms (%5% lookups/s, %6% elections listed), sharded %7% ms (%8% lookups/s, %9% elections listed)") % threads_count % lookups % elections_count % serialized.count () % per_second (serialized) % serialized_listed % sharded.count () % per_second (sharded) % sharded_listed) << std::endl;
+}
+
+namespace
+{
+/** Counts the distinct payloads sent through a set of channels, holding on to the last one so its address cannot be reused by the next allocation */
+class payload_counter final
+{
+public:
+	void add (vxlnetwork::shared_const_buffer const & buffer_a)
+	{
+		if (!last || last->begin ()->data () != buffer_a.begin ()->data ())
+		{
+			last = buffer_a;
+			++payloads;
+		}
+		bytes += buffer_a.size ();
+	}
+	boost::optional<vxlnetwork::shared_const_buffer> last;
+	std::size_t payloads{ 0 };
+	std::size_t bytes{ 0 };
+};
+
+/** Hands every buffer to a payload_counter instead of writing it to a socket */
+class counting_channel final : public vxlnetwork::transport::channel
+{
+public:
+	counting_channel (vxlnetwork::node & node_a, payload_counter & counter_a, uint16_t port_a) :
+		channel (node_a),
+		counter (counter_a),
+		endpoint (boost::asio::ip::address_v6::loopback (), port_a)
+	{
+	}
+	std::size_t hash_code () const override
+	{
+		return std::hash<vxlnetwork::endpoint> () (endpoint);
+	}
+	bool operator== (vxlnetwork::transport::channel const & other_a) const override
+	{
+		return endpoint == other_a.get_endpoint ();
+	}
+	void send_buffer (vxlnetwork::shared_const_buffer const & buffer_a, std::function<void (boost::system::error_code const &, std::size_t)> const & = nullptr, vxlnetwork::buffer_drop_policy = vxlnetwork::buffer_drop_policy::limiter, vxlnetwork::traffic_class = vxlnetwork::traffic_class::generic) override
+	{
+		counter.add (buffer_a);
+	}
+	std::string to_string () const override
+	{
+		return boost::str (boost::format ("%1%") % endpoint);
+	}
+	vxlnetwork::endpoint get_endpoint () const override
+	{
+		return endpoint;
+	}
+	vxlnetwork::tcp_endpoint get_tcp_endpoint () const override
+	{
+		return vxlnetwork::transport::map_endpoint_to_tcp (endpoint);
+	}
+	vxlnetwork::transport::transport_type get_type () const override
+	{
+		return vxlnetwork::transport::transport_type::loopback;
+	}
+
+private:
+	payload_counter & counter;
+	vxlnetwork::endpoint const endpoint;
+};
+}
+
+/*
+ * Compares broadcasting a vote to 256 peers by serializing it for every channel against serializing it once and sharing the buffer.
+ * Reports the number of serialized payloads and the time spent per broadcast.
+ */
+TEST (network, flood_fanout_benchmark)
+{
+	std::size_t const peers_count (256);
+	std::size_t const broadcasts (2000);
+	vxlnetwork::system system;
+	vxlnetwork::node_config node_config (vxlnetwork::get_available_port (), system.logging);
+	// Unlimited bandwidth so the limiter does not drop any of the copies
+	node_config.bandwidth_limit = 0;
+	auto & node = *system.add_node (node_config);
+	std::vector<vxlnetwork::block_hash> hashes;
+	for (std::size_t i (0); i < vxlnetwork::network::confirm_ack_hashes_max; ++i)
+	{
+		hashes.push_back (vxlnetwork::block_hash (i + 1));
+	}
+	auto vote (std::make_shared<vxlnetwork::vote> (vxlnetwork::dev::genesis_key.pub, vxlnetwork::dev::genesis_key.prv, 0, 0, hashes));
+	vxlnetwork::confirm_ack message{ node.network_params.network, vote };
+
+	auto run = [&] (bool shared_a) {
+		payload_counter counter;
+		std::vector<std::shared_ptr<counting_channel>> channels;
+		for (std::size_t i (0); i < peers_count; ++i)
+		{
+			channels.push_back (std::make_shared<counting_channel> (node, counter, static_cast<uint16_t> (10000 + i)));
+		}
+		vxlnetwork::timer<std::chrono::microseconds> timer (vxlnetwork::timer_state::started);
+		for (std::size_t i (0); i < broadcasts; ++i)
+		{
+			if (shared_a)
+			{
+				vxlnetwork::transport::shared_message shared{ message };
+				for (auto const & channel : channels)
+				{
+					channel->send (shared);
+				}
+			}
+			else
+			{
+				for (auto const & channel : channels)
+				{
+					channel->send (message);
+				}
+			}
+		}
+		auto const elapsed (timer.stop ());
+		EXPECT_EQ (peers_count * broadcasts * message.to_shared_const_buffer ().size (), counter.bytes);
+		return std::make_pair (elapsed.count () / broadcasts, counter.payloads);
+	};
+
+	auto const [per_channel_us, per_channel_payloads] = run (false);
+	auto const [shared_us, shared_payloads] = run (true);
+	std::cout << boost::str (boost::format ("%1% broadcasts to %2% peers: serialized per channel %3% us/broadcast (%4% payloads allocated), serialized once %5% us/broadcast (%6% payloads allocated)") % broadcasts % peers_count % per_channel_us % per_channel_payloads % shared_us % shared_payloads) << std::endl;
+}
+
+/**
+ * Measures network_filter throughput from several threads applying publish sized messages, half of them duplicates.
+ * Also reports how many duplicates slip through after evictions for direct mapped and 4-way buckets of the same total size.
+ */
+TEST (network_filter, throughput_benchmark)
+{
+	constexpr std::size_t filter_size = 256 * 1024;
+	constexpr std::size_t message_size = 216;
+	constexpr std::size_t ops_per_thread = 4 * 1024 * 1024;
+	std::vector<std::vector<uint8_t>> messages (64 * 1024, std::vector<uint8_t> (message_size));
+	for (auto & message : messages)
+	{
+		vxlnetwork::random_pool::generate_block (message.data (), message.size ());
+	}
+	for (auto threads_count : { 1u, 2u, 4u, 8u })
+	{
+		vxlnetwork::network_filter filter (filter_size);
+		std::vector<std::thread> threads;
+		vxlnetwork::timer<std::chrono::microseconds> timer (vxlnetwork::timer_state::started);
+		for (auto t (0u); t < threads_count; ++t)
+		{
+			threads.emplace_back ([&filter, &messages, t] () {
+				for (std::size_t i (0); i < ops_per_thread; ++i)
+				{
+					// Every message is applied twice in a row, once as new and once as duplicate
+					auto const & message (messages[(t * ops_per_thread + i / 2) % messages.size ()]);
+					filter.apply (message.data (), message.size ());
+				}
+			});
+		}
+		for (auto & thread : threads)
+		{
+			thread.join ();
+		}
+		auto const elapsed (timer.stop ().count ());
+		auto const ops (threads_count * ops_per_thread);
+		std::cout << boost::str (boost::format ("%1% threads: %2% Mops/s (%3% ops in %4% ms)") % threads_count % (ops / std::max<double> (1, elapsed)) % ops % (elapsed / 1000)) << std::endl;
+	}
+
+	// Fill the filter to its size with distinct digests, then replay them in order as duplicates arriving late
+	for (auto ways : { std::size_t{ 1 }, vxlnetwork::network_filter::bucket_ways })
+	{
+		vxlnetwork::network_filter filter (4 * 1024, ways);
+		auto const inserted (filter.size ());
+		for (std::size_t i (0); i < inserted; ++i)
+		{
+			filter.apply (messages[i].data (), messages[i].size ());
+		}
+		std::size_t recognised (0);
+		for (std::size_t i (0); i < inserted; ++i)
+		{
+			recognised += filter.apply (messages[i].data (), messages[i].size ()) ? 1 : 0;
+		}
+		std::cout << boost::str (boost::format ("%1%-way buckets, %2% digests inserted: %3% %% recognised as duplicates, %4% evictions") % ways % inserted % (100.0 * recognised / inserted) % filter.evictions ()) << std::endl;
+	}
+}
+
+#ifndef _WIN32
+TEST (ipc, shm_transport_benchmark)
+{
+	vxlnetwork::system system (1);
+	auto node (system.nodes[0]);
+	auto const suffix (std::to_string (std::chrono::steady_clock::now ().time_since_epoch ().count ()));
+	node->config.ipc_config.transport_domain.enabled = true;
+	node->config.ipc_config.transport_domain.path = "/tmp/vxlnetwork_bench_" + suffix;
+	node->config.ipc_config.transport_shared_memory.enabled = true;
+	node->config.ipc_config.transport_shared_memory.name = "/vxlnetwork_bench_" + suffix;
+	vxlnetwork::node_rpc_config node_rpc_config;
+	vxlnetwork::ipc::ipc_server ipc (*node, node_rpc_config);
+
+	// Round trips of a small flatbuffers request through the node
+	std::size_t constexpr round_trips{ 20000 };
+	vxlnetworkapi::IsAliveT alive;
+	auto request (vxlnetwork::ipc::flatbuffer_producer::make_buffer (alive));
+	uint64_t domain_us{ 0 };
+	{
+		vxlnetwork::ipc::ipc_client client (node->io_ctx);
+		ASSERT_FALSE (client.connect (node->config.ipc_config.transport_domain.path));
+		auto framed (vxlnetwork::ipc::prepare_flatbuffers_request (request));
+		auto response (std::make_shared<std::vector<uint8_t>> ());
+		vxlnetwork::timer<std::chrono::microseconds> timer (vxlnetwork::timer_state::started);
+		for (std::size_t i (0); i < round_trips; ++i)
+		{
+			std::promise<bool> done;
+			client.async_write (framed, [&client, &response, &done] (vxlnetwork::error const & error_a, std::size_t) {
+				if (error_a)
+				{
+					done.set_value (false);
+				}
+				else
+				{
+					client.async_read_message (response, 5s, [&done] (vxlnetwork::error const & error_a, std::size_t) {
+						done.set_value (!error_a);
+					});
+				}
+			});
+			ASSERT_TRUE (done.get_future ().get ());
+		}
+		domain_us = timer.stop ().count ();
+	}
+	uint64_t shared_memory_us{ 0 };
+	{
+		vxlnetwork::ipc::shm_client client;
+		ASSERT_FALSE (client.connect (node->config.ipc_config.transport_shared_memory.name));
+		vxlnetwork::timer<std::chrono::microseconds> timer (vxlnetwork::timer_state::started);
+		for (std::size_t i (0); i < round_trips; ++i)
+		{
+			ASSERT_FALSE (client.write (vxlnetwork::ipc::payload_encoding::flatbuffers, request->GetBufferPointer (), request->GetSize (), 5s));
+			ASSERT_FALSE (client.read ([] (uint8_t const *, std::size_t) {}, 5s));
+		}
+		shared_memory_us = timer.stop ().count ();
+	}
+	std::cout << boost::str (boost::format ("IsAlive round trip: domain socket %1% us, shared memory %2% us") % (static_cast<double> (domain_us) / round_trips) % (static_cast<double> (shared_memory_us) / round_trips)) << std::endl;
+	ipc.stop ();
+
+	// One way stream of messages, like broker events. The consumer touches both ends of every message as a parser would
+	for (std::size_t size : { 256, 4 * 1024, 64 * 1024 })
+	{
+		auto const count ((std::size_t{ 512 } * 1024 * 1024) / size);
+		std::vector<uint8_t> payload (size, 1);
+		uint64_t checksum_domain{ 0 };
+		uint64_t checksum_shared_memory{ 0 };
+
+		boost::asio::io_context io_ctx;
+		boost::asio::local::stream_protocol::socket writer (io_ctx);
+		boost::asio::local::stream_protocol::socket reader (io_ctx);
+		boost::asio::local::connect_pair (writer, reader);
+		vxlnetwork::timer<std::chrono::microseconds> domain_timer (vxlnetwork::timer_state::started);
+		std::thread domain_producer ([&writer, &payload, count] () {
+			auto length (boost::endian::native_to_big (static_cast<uint32_t> (payload.size ())));
+			for (std::size_t i (0); i < count; ++i)
+			{
+				std::array<boost::asio::const_buffer, 2> buffers{ boost::asio::buffer (&length, sizeof (length)), boost::asio::buffer (payload) };
+				boost::asio::write (writer, buffers);
+			}
+		});
+		std::vector<uint8_t> buffer;
+		for (std::size_t i (0); i < count; ++i)
+		{
+			uint32_t length;
+			boost::asio::read (reader, boost::asio::buffer (&length, sizeof (length)));
+			buffer.resize (boost::endian::big_to_native (length));
+			boost::asio::read (reader, boost::asio::buffer (buffer));
+			checksum_domain += buffer.front () + buffer.back ();
+		}
+		domain_producer.join ();
+		auto const domain_elapsed (domain_timer.stop ().count ());
+
+		vxlnetwork::ipc::shm_segment segment;
+		ASSERT_FALSE (segment.create ("/vxlnetwork_bench_ring_" + suffix, 1, 4 * 1024 * 1024));
+		auto & ring (segment.channels[0].responses);
+		vxlnetwork::timer<std::chrono::microseconds> shared_memory_timer (vxlnetwork::timer_state::started);
+		std::thread shared_memory_producer ([&ring, &payload, count] () {
+			for (std::size_t i (0); i < count; ++i)
+			{
+				ASSERT_FALSE (ring.write (payload.data (), payload.size (), 5s));
+			}
+		});
+		for (std::size_t i (0); i < count; ++i)
+		{
+			ASSERT_FALSE (ring.read ([&checksum_shared_memory] (uint8_t const * data_a, std::size_t size_a) {
+				checksum_shared_memory += data_a[0] + data_a[size_a - 1];
+			},
+			5s));
+		}
+		shared_memory_producer.join ();
+		auto const shared_memory_elapsed (shared_memory_timer.stop ().count ());
+
+		ASSERT_EQ (checksum_domain, checksum_shared_memory);
+		auto const megabytes (static_cast<double> (count * size) / (1024 * 1024));
+		std::cout << boost::str (boost::format ("%1% messages of %2% bytes: domain socket %3% MB/s, shared memory %4% MB/s") % count % size % (megabytes * 1000000 / std::max<uint64_t> (1, domain_elapsed)) % (megabytes * 1000000 / std::max<uint64_t> (1, shared_memory_elapsed))) << std::endl;
+	}
+}
+#endif
@@ -261,6 +261,51 @@ void vxlnetwork::blocks_confirm (vxlnetwork::node & node_a, std::vector<std::sha
 	}
 }
 
+std::shared_ptr<vxlnetwork::election> vxlnetwork::start_fork_election (vxlnetwork::system & system_a, vxlnetwork::node & node_a, std::array<std::shared_ptr<vxlnetwork::block>, 2> & forks_a)
+{
+	auto const latest_hash = vxlnetwork::dev::genesis->hash ();
+	vxlnetwork::state_block_builder builder{};
+	for (auto & fork : forks_a)
+	{
+		fork = builder.make_block ()
+			   .previous (latest_hash)
+			   .account (vxlnetwork::dev::genesis_key.pub)
+			   .representative (vxlnetwork::dev::genesis_key.pub)
+			   .balance (vxlnetwork::dev::constants.genesis_amount - 1)
+			   .link (vxlnetwork::keypair{}.pub)
+			   .work (*system_a.work.generate (latest_hash))
+			   .sign (vxlnetwork::dev::genesis_key.prv, vxlnetwork::dev::genesis_key.pub)
+			   .build_shared ();
+		node_a.process_active (fork);
+	}
+	std::shared_ptr<vxlnetwork::election> election;
+	auto const error (system_a.poll_until_true (5s, [&node_a, &forks_a, &election] () {
+		election = node_a.active.election (forks_a[0]->qualified_root ());
+		return election != nullptr && election->blocks ().size () == 2;
+	}));
+	return !error ? election : nullptr;
+}
+
+std::unordered_map<vxlnetwork::block_hash, vxlnetwork::uint128_t> vxlnetwork::tally_weights (vxlnetwork::tally_t const & tally_a)
+{
+	std::unordered_map<vxlnetwork::block_hash, vxlnetwork::uint128_t> result;
+	for (auto const & [amount, block] : tally_a)
+	{
+		result[block->hash ()] = amount;
+	}
+	return result;
+}
+
+std::unordered_map<vxlnetwork::block_hash, vxlnetwork::uint128_t> vxlnetwork::recompute_tally (vxlnetwork::ledger & ledger_a, std::unordered_map<vxlnetwork::account, vxlnetwork::vote_info> const & votes_a)
+{
+	std::unordered_map<vxlnetwork::block_hash, vxlnetwork::uint128_t> result;
+	for (auto const & [account, info] : votes_a)
+	{
+		result[info.hash] += ledger_a.weight (account);
+	}
+	return result;
+}
+
 std::unique_ptr<vxlnetwork::state_block> vxlnetwork::system::upgrade_genesis_epoch (vxlnetwork::node & node_a, vxlnetwork::epoch const epoch_a)
 {
 	return upgrade_epoch (work, node_a.ledger, epoch_a);
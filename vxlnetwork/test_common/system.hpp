@@ -3,7 +3,9 @@
 #include <vxlnetwork/lib/errors.hpp>
 #include <vxlnetwork/node/node.hpp>
 
+#include <array>
 #include <chrono>
+#include <unordered_map>
 
 namespace vxlnetwork
 {
@@ -59,6 +61,12 @@ public:
 };
 std::unique_ptr<vxlnetwork::state_block> upgrade_epoch (vxlnetwork::work_pool &, vxlnetwork::ledger &, vxlnetwork::epoch);
 void blocks_confirm (vxlnetwork::node &, std::vector<std::shared_ptr<vxlnetwork::block>> const &, bool const = false);
+/** Processes two forks of the block following genesis into \p forks_a and returns their election once it holds both, nullptr if it did not in time */
+std::shared_ptr<vxlnetwork::election> start_fork_election (vxlnetwork::system &, vxlnetwork::node &, std::array<std::shared_ptr<vxlnetwork::block>, 2> & forks_a);
+/** Weight of every block in \p tally_a */
+std::unordered_map<vxlnetwork::block_hash, vxlnetwork::uint128_t> tally_weights (vxlnetwork::tally_t const & tally_a);
+/** Tally of \p votes_a computed from scratch with the current ledger weights, as elections did before tallying incrementally */
+std::unordered_map<vxlnetwork::block_hash, vxlnetwork::uint128_t> recompute_tally (vxlnetwork::ledger &, std::unordered_map<vxlnetwork::account, vxlnetwork::vote_info> const & votes_a);
 uint16_t get_available_port ();
 void cleanup_dev_directories_on_exit ();
 }